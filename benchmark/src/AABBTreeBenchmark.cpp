@@ -0,0 +1,161 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "TrenchBroom.h"
+#include "AABBTree.h"
+#include "FlatAABBTree.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    static constexpr size_t NumObjects = 150'000;
+    static constexpr size_t NumRays = 100'000;
+
+    /**
+     * Creates boxes of brush-like sizes scattered over a map-sized volume.
+     */
+    static std::vector<vm::bbox3> makeBounds(const size_t count) {
+        std::mt19937 random(0);
+        std::uniform_real_distribution<double> positions(-4096.0, 4096.0);
+        std::uniform_real_distribution<double> sizes(8.0, 256.0);
+
+        std::vector<vm::bbox3> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto min = vm::vec3(positions(random), positions(random), positions(random));
+            result.emplace_back(min, min + vm::vec3(sizes(random), sizes(random), sizes(random)));
+        }
+        return result;
+    }
+
+    static std::vector<vm::ray3> makeRays(const size_t count) {
+        std::mt19937 random(1);
+        std::uniform_real_distribution<double> coords(-1.0, 1.0);
+
+        std::vector<vm::ray3> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto origin = vm::vec3(coords(random), coords(random), coords(random)) * 4096.0;
+            const auto direction = normalize(vm::vec3(coords(random), coords(random), coords(random)));
+            result.emplace_back(origin, direction);
+        }
+        return result;
+    }
+
+    template <typename Tree>
+    static size_t pickAll(const Tree& tree, const std::vector<vm::ray3>& rays) {
+        size_t hits = 0;
+        std::vector<size_t> result;
+        for (const auto& ray : rays) {
+            result.clear();
+            tree.findIntersectors(ray, std::back_inserter(result));
+            hits += result.size();
+        }
+        return hits;
+    }
+
+    template <typename Tree>
+    static void benchTree(const std::string& name, const std::vector<vm::bbox3>& bounds, const std::vector<size_t>& objects, const std::vector<vm::ray3>& rays, size_t& hits) {
+        const auto getBounds = [&](const size_t i) { return bounds[i]; };
+
+        Tree tree;
+        timeLambda([&]() {
+            for (const auto i : objects) {
+                tree.insert(bounds[i], i);
+            }
+        }, "insert " + std::to_string(objects.size()) + " objects into " + name);
+
+        timeLambda([&]() { hits = pickAll(tree, rays); }, "pick " + std::to_string(rays.size()) + " rays in incrementally built " + name);
+
+        timeLambda([&]() {
+            tree.clearAndBuild(objects, getBounds);
+        }, "bulk build " + name + " with " + std::to_string(objects.size()) + " objects");
+
+        size_t bulkHits = 0;
+        timeLambda([&]() { bulkHits = pickAll(tree, rays); }, "pick " + std::to_string(rays.size()) + " rays in bulk built " + name);
+        ASSERT_EQ(hits, bulkHits);
+    }
+
+    TEST(AABBTreeBenchmark, benchRayPicking) {
+        const auto bounds = makeBounds(NumObjects);
+        const auto rays = makeRays(NumRays);
+
+        std::vector<size_t> objects;
+        objects.reserve(bounds.size());
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            objects.push_back(i);
+        }
+
+        size_t treeHits = 0;
+        benchTree<AABBTree<double, 3, size_t>>("AABBTree", bounds, objects, rays, treeHits);
+
+        size_t flatHits = 0;
+        benchTree<FlatAABBTree<double, 3, size_t>>("FlatAABBTree", bounds, objects, rays, flatHits);
+
+        ASSERT_EQ(treeHits, flatHits);
+    }
+
+    TEST(AABBTreeBenchmark, benchNearestFirstRayPicking) {
+        const auto bounds = makeBounds(NumObjects);
+        const auto rays = makeRays(NumRays);
+
+        std::vector<size_t> objects;
+        objects.reserve(bounds.size());
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            objects.push_back(i);
+        }
+
+        FlatAABBTree<double, 3, size_t> tree;
+        tree.clearAndBuild(objects, [&](const size_t i) { return bounds[i]; });
+
+        // the boxes stand in for objects, so the first box that is hit is the closest hit
+        size_t hits = 0;
+        timeLambda([&]() {
+            for (const auto& ray : rays) {
+                tree.findIntersectorsNearestFirst(ray, [&](const size_t, const double) {
+                    ++hits;
+                    return false;
+                });
+            }
+        }, "pick closest of " + std::to_string(rays.size()) + " rays nearest first");
+
+        size_t allHits = 0;
+        timeLambda([&]() {
+            for (const auto& ray : rays) {
+                tree.findIntersectorsNearestFirst(ray, [&](const size_t, const double) {
+                    ++allHits;
+                    return true;
+                });
+            }
+        }, "pick all of " + std::to_string(rays.size()) + " rays nearest first");
+
+        ASSERT_LE(hits, rays.size());
+        ASSERT_LE(hits, allHits);
+    }
+}
@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "EL.h"
+#include "Assets/ModelDefinition.h"
+#include "IO/ELParser.h"
+#include "Model/EntityAttributes.h"
+#include "Model/EntityAttributesVariableStore.h"
+
+#include <cstdio>
+#include <string>
+
+namespace TrenchBroom {
+    namespace Assets {
+        static constexpr size_t NumEvaluations = 1'000'000;
+
+        /**
+         * Evaluates the given model expression for the given attributes many times, once by evaluating the expression
+         * tree as model definitions used to, and once with the compiled model definition.
+         */
+        static void benchExpression(const String& expressionStr, const Model::EntityAttributes& attributes, const String& message) {
+            const EL::Expression expression = IO::ELParser::parseStrict(expressionStr);
+            const ModelDefinition definition(expression);
+
+            size_t treeSkins = 0;
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumEvaluations; ++i) {
+                    const Model::EntityAttributesVariableStore store(attributes);
+                    const EL::EvaluationContext context(store);
+                    const EL::Value value = expression.evaluate(context);
+                    if (value.type() == EL::Type_Map) {
+                        treeSkins += static_cast<size_t>(value["skin"].convertTo(EL::Type_Number).integerValue());
+                    }
+                }
+            }, "evaluate " + message + " " + std::to_string(NumEvaluations) + " times as a tree");
+
+            size_t compiledSkins = 0;
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumEvaluations; ++i) {
+                    compiledSkins += definition.modelSpecification(attributes).skinIndex;
+                }
+            }, "evaluate " + message + " " + std::to_string(NumEvaluations) + " times compiled");
+
+            ASSERT_EQ(treeSkins, compiledSkins);
+        }
+
+        TEST(ModelDefinitionBenchmark, benchSpawnflagSwitch) {
+            const String expression(
+                "{{"
+                "  spawnflags == 1 -> { \"path\": \"progs/armor.mdl\", \"skin\": 1 },"
+                "  spawnflags == 2 -> { \"path\": \"progs/armor.mdl\", \"skin\": 2 },"
+                "  spawnflags == 4 -> { \"path\": \"progs/armor.mdl\", \"skin\": 3 },"
+                "  classname == \"item_armorInv\" -> { \"path\": \"progs/armor.mdl\", \"skin\": 4 },"
+                "  { \"path\": \"progs/armor.mdl\", \"skin\": 0 }"
+                " }}");
+
+            Model::EntityAttributes attributes;
+            attributes.addOrUpdateAttribute("classname", "item_armorInv", nullptr);
+            attributes.addOrUpdateAttribute("spawnflags", "8", nullptr);
+            attributes.addOrUpdateAttribute("origin", "0 0 0", nullptr);
+
+            benchExpression(expression, attributes, "spawnflag switch");
+        }
+
+        TEST(ModelDefinitionBenchmark, benchAttributeMap) {
+            const String expression("{ \"path\": model, \"skin\": skin, \"frame\": frame }");
+
+            Model::EntityAttributes attributes;
+            attributes.addOrUpdateAttribute("classname", "misc_model", nullptr);
+            attributes.addOrUpdateAttribute("model", "progs/player.mdl", nullptr);
+            attributes.addOrUpdateAttribute("skin", "1", nullptr);
+            attributes.addOrUpdateAttribute("frame", "4", nullptr);
+
+            benchExpression(expression, attributes, "attribute map");
+        }
+    }
+}
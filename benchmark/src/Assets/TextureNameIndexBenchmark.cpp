@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "StringUtils.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureNameIndex.h"
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        static constexpr size_t NumTextures = 20'000;
+
+        TEST(TextureNameIndexBenchmark, benchFilterTextures) {
+            static const StringList Prefixes = { "base_wall", "gothic_block", "e1u1", "sfx", "liquids", "common", "sky" };
+            static const StringList Words = { "metal", "concrete", "Trim", "floor", "wall", "tech", "grate", "light", "lava", "stone" };
+
+            std::mt19937 random(0);
+            std::vector<std::unique_ptr<Texture>> textures;
+            TextureList textureList;
+            for (size_t i = 0; i < NumTextures; ++i) {
+                const auto name = Prefixes[random() % Prefixes.size()] + "/" + Words[random() % Words.size()] + std::to_string(i % 97) + "_" + Words[random() % Words.size()];
+                textures.push_back(std::make_unique<Texture>(name, 64, 64));
+                textureList.push_back(textures.back().get());
+            }
+
+            // what the texture browser does while the user types a filter
+            static const StringList Patterns = { "m", "me", "met", "meta", "metal", "metal4", "metal42", "metal42_", "metal42_s" };
+            static const size_t Repetitions = 20;
+
+            size_t scanned = 0;
+            timeLambda([&]() {
+                for (size_t i = 0; i < Repetitions; ++i) {
+                    for (const auto& pattern : Patterns) {
+                        for (const auto* texture : textureList) {
+                            if (StringUtils::containsCaseInsensitive(texture->name(), pattern)) {
+                                ++scanned;
+                            }
+                        }
+                    }
+                }
+            }, "filter " + std::to_string(NumTextures) + " textures by scanning");
+
+            std::unique_ptr<TextureNameIndex> index;
+            timeLambda([&]() {
+                index = std::make_unique<TextureNameIndex>(textureList);
+            }, "index " + std::to_string(NumTextures) + " textures");
+
+            size_t found = 0;
+            timeLambda([&]() {
+                for (size_t i = 0; i < Repetitions; ++i) {
+                    for (const auto& pattern : Patterns) {
+                        found += index->find(pattern).size();
+                    }
+                }
+            }, "filter " + std::to_string(NumTextures) + " textures with the index");
+
+            ASSERT_EQ(scanned, found);
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "IO/DirectoryIndex.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumDirectories = 50;
+        static constexpr size_t NumSubDirectories = 10;
+        static constexpr size_t NumFiles = 100;
+
+        /**
+         * Creates a tree of mixed case directories and files below the given directory and returns the paths of the
+         * files in lower case.
+         */
+        static Path::List makeTree(const Path& root) {
+            Path::List result;
+            for (size_t i = 0; i < NumDirectories; ++i) {
+                const auto directory = root + Path("Textures_" + std::to_string(i));
+                ::wxMkdir(directory.asString());
+                for (size_t j = 0; j < NumSubDirectories; ++j) {
+                    const auto subDirectory = directory + Path("Set_" + std::to_string(j));
+                    ::wxMkdir(subDirectory.asString());
+                    for (size_t k = 0; k < NumFiles; ++k) {
+                        const auto file = subDirectory + Path("Wall_" + std::to_string(k) + ".TGA");
+                        std::ofstream stream(file.asString().c_str());
+                        result.push_back(file.makeLowerCase());
+                    }
+                }
+            }
+            return result;
+        }
+
+        /**
+         * The implementation previously used by Disk::fixCase, for comparison.
+         */
+        static Path fixCaseByListing(const Path& path) {
+            Path result(path.firstComponent());
+            Path remainder(path.deleteFirstComponent());
+            while (!remainder.isEmpty()) {
+                const auto next = result + remainder.firstComponent();
+                if (!::wxDirExists(next.asString()) && !::wxFileExists(next.asString())) {
+                    Path part;
+                    for (const auto& entry : Disk::getDirectoryContents(result)) {
+                        if (StringUtils::caseInsensitiveEqual(entry.asString(), remainder.firstComponent().asString())) {
+                            part = entry;
+                            break;
+                        }
+                    }
+                    if (part.isEmpty()) {
+                        return path;
+                    }
+                    result = result + part;
+                } else {
+                    result = next;
+                }
+                remainder = remainder.deleteFirstComponent();
+            }
+            return result;
+        }
+
+        TEST(DiskIOBenchmark, benchFixPath) {
+            if (!Disk::isCaseSensitive()) {
+                return;
+            }
+
+            const auto root = Disk::getCurrentWorkingDir() + Path("DiskIOBenchmark");
+            wxFileName::Rmdir(root.asString(), wxPATH_RMDIR_RECURSIVE);
+            ASSERT_TRUE(::wxMkdir(root.asString()));
+
+            Path::List paths;
+            timeLambda([&]() { paths = makeTree(root); }, "create " + std::to_string(NumDirectories * NumSubDirectories * NumFiles) + " files");
+
+            // only fix a sample of the paths with the previous implementation because it is very slow
+            size_t listingMatches = 0;
+            timeLambda([&]() {
+                for (size_t i = 0; i < paths.size(); i += 100) {
+                    if (::wxFileExists(fixCaseByListing(paths[i]).asString())) {
+                        ++listingMatches;
+                    }
+                }
+            }, "fix " + std::to_string(paths.size() / 100) + " paths by listing directories");
+            ASSERT_EQ(paths.size() / 100, listingMatches);
+
+            Disk::directoryIndex().clear();
+            size_t matches = 0;
+            timeLambda([&]() {
+                for (const auto& path : paths) {
+                    if (::wxFileExists(Disk::fixPath(path).asString())) {
+                        ++matches;
+                    }
+                }
+            }, "fix " + std::to_string(paths.size()) + " paths with an empty directory index");
+            ASSERT_EQ(paths.size(), matches);
+
+            matches = 0;
+            timeLambda([&]() {
+                for (const auto& path : paths) {
+                    if (::wxFileExists(Disk::fixPath(path).asString())) {
+                        ++matches;
+                    }
+                }
+            }, "fix " + std::to_string(paths.size()) + " paths with a populated directory index");
+            ASSERT_EQ(paths.size(), matches);
+
+            Disk::directoryIndex().clear();
+            ASSERT_TRUE(wxFileName::Rmdir(root.asString(), wxPATH_RMDIR_RECURSIVE));
+        }
+    }
+}
@@ -0,0 +1,232 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "Logger.h"
+#include "NumberParser.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureName.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/StandardMapParser.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/CollectMatchingBrushFacesVisitor.h"
+#include "Model/World.h"
+
+#include <vecmath/bbox.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumBrushes = 50'000;
+
+        static const StringList TextureNames = {
+            "base/wall", "base/floor", "e1u1/metal1_2", "e1u1/tech08_1", "gothic_block/blocks18c_3",
+            "gothic_trim/baseboard09_e", "Sky/Sky_Stars", "common/caulk", "liquids/lavahell_750", "base_wall/concrete_dark"
+        };
+
+        /**
+         * Creates a Valve format map with a worldspawn containing the given number of cuboids at random positions.
+         * Like maps saved by TrenchBroom, it contains many numbers with a fractional part.
+         */
+        static String makeMap(const size_t brushCount) {
+            std::mt19937 random(0);
+            std::uniform_real_distribution<double> positions(-4096.0, 4096.0);
+            std::uniform_real_distribution<double> sizes(8.0, 256.0);
+
+            StringStream str;
+            str << "// Game: Quake\n"
+                << "// Format: Valve\n"
+                << "{\n"
+                << "\"classname\" \"worldspawn\"\n"
+                << "\"mapversion\" \"220\"\n";
+
+            char buffer[512];
+            for (size_t i = 0; i < brushCount; ++i) {
+                const auto& textureName = TextureNames[i % TextureNames.size()];
+                const auto x1 = positions(random), y1 = positions(random), z1 = positions(random);
+                const auto x2 = x1 + sizes(random), y2 = y1 + sizes(random), z2 = z1 + sizes(random);
+                const double faces[6][9] = {
+                    { x1, y1, z1, x1, y1 + 1.0, z1, x1, y1, z1 + 1.0 },
+                    { x2, y2, z2, x2, y2, z2 + 1.0, x2, y2 + 1.0, z2 },
+                    { x1, y1, z1, x1, y1, z1 + 1.0, x1 + 1.0, y1, z1 },
+                    { x2, y2, z2, x2 + 1.0, y2, z2, x2, y2, z2 + 1.0 },
+                    { x1, y1, z1, x1 + 1.0, y1, z1, x1, y1 + 1.0, z1 },
+                    { x2, y2, z2, x2, y2 + 1.0, z2, x2 + 1.0, y2, z2 }
+                };
+
+                str << "{\n";
+                for (const auto& f : faces) {
+                    snprintf(buffer, sizeof(buffer),
+                             "( %.6f %.6f %.6f ) ( %.6f %.6f %.6f ) ( %.6f %.6f %.6f ) %s [ 1 0 0 %.4f ] [ 0 -1 0 %.4f ] 0 1 1\n",
+                             f[0], f[1], f[2], f[3], f[4], f[5], f[6], f[7], f[8], textureName.c_str(), f[0], f[1]);
+                    str << buffer;
+                }
+                str << "}\n";
+            }
+            str << "}\n";
+            return str.str();
+        }
+
+        static void printAllocatorStatistics(const std::string& message) {
+            const auto stats = Model::BrushGeometry::allocatorStatistics();
+            printf("Brush geometry memory %s: %zu live objects, %zu allocations in total, %zu chunks, %zu KiB\n",
+                   message.c_str(), stats.liveObjects, stats.totalAllocations, stats.chunks, stats.bytes / 1024);
+        }
+
+        /**
+         * The conversion previously used by TokenTemplate::toFloat, for comparison.
+         */
+        static double atofConversion(const QuakeMapTokenizer::Token& token) {
+            static char buffer[256];
+            memcpy(buffer, token.begin(), token.length());
+            buffer[token.length()] = 0;
+            return std::atof(buffer);
+        }
+
+        TEST(MapReaderBenchmark, benchNumberConversion) {
+            const auto map = makeMap(NumBrushes);
+
+            std::vector<QuakeMapTokenizer::Token> numbers;
+            QuakeMapTokenizer tokenizer(map.data(), map.data() + map.size());
+            for (auto token = tokenizer.nextToken(); token.type() != QuakeMapToken::Eof; token = tokenizer.nextToken()) {
+                if (token.hasType(QuakeMapToken::Number)) {
+                    numbers.push_back(token);
+                }
+            }
+
+            double atofSum = 0.0;
+            timeLambda([&]() {
+                for (const auto& token : numbers) {
+                    atofSum += atofConversion(token);
+                }
+            }, "convert " + std::to_string(numbers.size()) + " numbers with atof");
+
+            double parserSum = 0.0;
+            timeLambda([&]() {
+                for (const auto& token : numbers) {
+                    parserSum += token.toFloat<double>();
+                }
+            }, "convert " + std::to_string(numbers.size()) + " numbers with NumberParser");
+
+            ASSERT_EQ(atofSum, parserSum);
+        }
+
+        TEST(MapReaderBenchmark, benchReadMap) {
+            const auto map = makeMap(NumBrushes);
+            const vm::bbox3 worldBounds(8192.0);
+
+            NullLogger logger;
+            SimpleParserStatus status(logger);
+            WorldReader reader(map, nullptr);
+
+            const auto before = Model::BrushGeometry::allocatorStatistics();
+            printAllocatorStatistics("before reading");
+
+            std::unique_ptr<Model::World> world;
+            timeLambda([&]() {
+                world = reader.read(Model::MapFormat::Valve, worldBounds, status);
+            }, "read map with " + std::to_string(NumBrushes) + " brushes (" + std::to_string(map.size() / 1024) + " KiB)");
+
+            ASSERT_TRUE(world != nullptr);
+            printAllocatorStatistics("after reading");
+
+            timeLambda([&]() {
+                world.reset();
+                Model::BrushGeometry::releaseUnusedMemory();
+            }, "delete map with " + std::to_string(NumBrushes) + " brushes");
+            printAllocatorStatistics("after deleting");
+
+            const auto after = Model::BrushGeometry::allocatorStatistics();
+            ASSERT_EQ(before.liveObjects, after.liveObjects);
+            ASSERT_LE(after.bytes, before.bytes);
+        }
+
+        TEST(MapReaderBenchmark, benchTextureNames) {
+            const auto map = makeMap(NumBrushes);
+            const vm::bbox3 worldBounds(8192.0);
+
+            NullLogger logger;
+            SimpleParserStatus status(logger);
+            WorldReader reader(map, nullptr);
+            auto world = reader.read(Model::MapFormat::Valve, worldBounds, status);
+            ASSERT_TRUE(world != nullptr);
+
+            Model::CollectBrushFacesVisitor visitor;
+            world->acceptAndRecurse(visitor);
+            const auto& faces = visitor.faces();
+
+            // what each face would use if it stored its own copy of the texture name
+            size_t stringBytes = 0;
+            for (const auto* face : faces) {
+                const auto copy = face->textureName();
+                stringBytes += sizeof(String) + (copy.capacity() > String().capacity() ? copy.capacity() + 1 : 0);
+            }
+            printf("Texture name memory per face: %zu bytes interned, %.1f bytes as a string (%zu distinct names)\n",
+                   sizeof(Assets::TextureName), static_cast<double>(stringBytes) / static_cast<double>(faces.size()),
+                   Assets::TextureName::count());
+
+            // resolve textures as the texture manager used to: lower case the name and look it up in a map
+            std::vector<std::unique_ptr<Assets::Texture>> textures;
+            std::map<String, Assets::Texture*> texturesByName;
+            std::vector<Assets::Texture*> texturesById;
+            for (const auto& name : TextureNames) {
+                textures.push_back(std::make_unique<Assets::Texture>(name, 64, 64));
+                texturesByName[StringUtils::toLower(name)] = textures.back().get();
+            }
+            texturesById.resize(Assets::TextureName::count(), nullptr);
+            for (const auto& texture : textures) {
+                texturesById[texture->internedName().caseInsensitiveId()] = texture.get();
+            }
+
+            size_t foundByName = 0;
+            timeLambda([&]() {
+                for (const auto* face : faces) {
+                    if (texturesByName.find(StringUtils::toLower(face->textureName())) != std::end(texturesByName)) {
+                        ++foundByName;
+                    }
+                }
+            }, "resolve textures of " + std::to_string(faces.size()) + " faces by name");
+
+            size_t foundById = 0;
+            timeLambda([&]() {
+                for (const auto* face : faces) {
+                    const auto id = face->attribs().internedTextureName().caseInsensitiveId();
+                    if (id < texturesById.size() && texturesById[id] != nullptr) {
+                        ++foundById;
+                    }
+                }
+            }, "resolve textures of " + std::to_string(faces.size()) + " faces by id");
+
+            ASSERT_EQ(faces.size(), foundByName);
+            ASSERT_EQ(faces.size(), foundById);
+        }
+    }
+}
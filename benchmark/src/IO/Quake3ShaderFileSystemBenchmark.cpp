@@ -0,0 +1,149 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "Logger.h"
+#include "Assets/Quake3Shader.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "IO/Quake3ShaderFileSystem.h"
+#include "IO/Quake3ShaderParser.h"
+#include "IO/SimpleParserStatus.h"
+
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        static constexpr size_t NumScripts = 40;
+        static constexpr size_t NumShadersPerScript = 500;
+        static constexpr size_t NumTextureDirectories = 40;
+        static constexpr size_t NumTexturesPerDirectory = 500;
+
+        /**
+         * Creates shader scripts and texture images below the given directory. Script i defines the shaders of texture
+         * directory i, but only every other texture has a shader, and every script also defines shaders without a
+         * texture.
+         */
+        static void makeTree(const Path& root) {
+            ::wxMkdir((root + Path("scripts")).asString());
+            ::wxMkdir((root + Path("textures")).asString());
+
+            for (size_t i = 0; i < NumTextureDirectories; ++i) {
+                const auto directory = root + Path("textures/set_" + std::to_string(i));
+                ::wxMkdir(directory.asString());
+                for (size_t j = 0; j < NumTexturesPerDirectory; ++j) {
+                    std::ofstream stream((directory + Path("wall_" + std::to_string(j) + ".tga")).asString().c_str());
+                }
+            }
+
+            for (size_t i = 0; i < NumScripts; ++i) {
+                std::ofstream stream((root + Path("scripts/set_" + std::to_string(i) + ".shader")).asString().c_str());
+                for (size_t j = 0; j < NumShadersPerScript; ++j) {
+                    const auto name = j % 2 == 0 ? "wall_" + std::to_string(j) : "decal_" + std::to_string(j);
+                    stream << "textures/set_" << i << "/" << name << "\n"
+                           << "{\n"
+                           << "    qer_editorimage textures/set_" << i << "/wall_" << j << ".tga\n"
+                           << "    surfaceparm nonsolid\n"
+                           << "    {\n"
+                           << "        map $lightmap\n"
+                           << "        rgbGen identity\n"
+                           << "    }\n"
+                           << "    {\n"
+                           << "        map textures/set_" << i << "/wall_" << j << ".tga\n"
+                           << "        blendFunc GL_DST_COLOR GL_ZERO\n"
+                           << "    }\n"
+                           << "}\n\n";
+                }
+            }
+        }
+
+        TEST(Quake3ShaderFileSystemBenchmark, benchBuildFileSystem) {
+            const auto root = Disk::getCurrentWorkingDir() + Path("Quake3ShaderFileSystemBenchmark");
+            wxFileName::Rmdir(root.asString(), wxPATH_RMDIR_RECURSIVE);
+            ASSERT_TRUE(::wxMkdir(root.asString()));
+
+            const auto numShaders = NumScripts * NumShadersPerScript;
+            const auto numTextures = NumTextureDirectories * NumTexturesPerDirectory;
+            timeLambda([&]() { makeTree(root); }, "create " + std::to_string(NumScripts) + " shader scripts and " + std::to_string(numTextures) + " textures");
+
+            NullLogger logger;
+            auto diskFS = std::make_shared<DiskFileSystem>(root);
+
+            // parse the scripts one after another as the file system used to
+            std::vector<Assets::Quake3Shader> shaders;
+            timeLambda([&]() {
+                for (const auto& path : diskFS->findItems(Path("scripts"), FileExtensionMatcher("shader"))) {
+                    const auto file = diskFS->openFile(path);
+                    Quake3ShaderParser parser(file->begin(), file->end());
+                    SimpleParserStatus status(logger, path.asString());
+                    const auto fileShaders = parser.parse(status);
+                    shaders.insert(std::end(shaders), std::begin(fileShaders), std::end(fileShaders));
+                }
+            }, "parse " + std::to_string(numShaders) + " shaders serially");
+            ASSERT_EQ(numShaders, shaders.size());
+
+            // only link a sample of the textures with a linear search because it is very slow
+            const auto textures = diskFS->findItemsRecursively(Path("textures"), FileExtensionMatcher("tga"));
+            ASSERT_EQ(numTextures, textures.size());
+
+            size_t linearMatches = 0;
+            timeLambda([&]() {
+                for (size_t i = 0; i < textures.size(); i += 100) {
+                    const auto shaderPath = textures[i].deleteExtension();
+                    const auto shaderIt = std::find_if(std::begin(shaders), std::end(shaders), [&shaderPath](const auto& shader) {
+                        return shaderPath == shader.shaderPath;
+                    });
+                    if (shaderIt != std::end(shaders)) {
+                        ++linearMatches;
+                    }
+                }
+            }, "link " + std::to_string(textures.size() / 100) + " textures with a linear search");
+            ASSERT_LT(0u, linearMatches);
+
+            std::unique_ptr<Quake3ShaderFileSystem> shaderFS;
+            timeLambda([&]() {
+                shaderFS = std::make_unique<Quake3ShaderFileSystem>(diskFS, Path::List { Path("textures") }, logger);
+            }, "build shader file system with " + std::to_string(numShaders) + " shaders and " + std::to_string(numTextures) + " textures");
+
+            // every texture gets a shader, and every other shader has no texture
+            const auto items = shaderFS->findItemsRecursively(Path("textures"), FileExtensionMatcher(""));
+            size_t shaderCount = 0;
+            for (const auto& item : items) {
+                if (shaderFS->fileExists(item)) {
+                    ++shaderCount;
+                }
+            }
+            ASSERT_EQ(numTextures + numShaders / 2, shaderCount);
+
+            shaderFS.reset();
+            ASSERT_TRUE(wxFileName::Rmdir(root.asString(), wxPATH_RMDIR_RECURSIVE));
+        }
+    }
+}
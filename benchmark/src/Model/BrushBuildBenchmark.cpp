@@ -0,0 +1,268 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "TrenchBroom.h"
+
+#include <vecmath/vec.h>
+#include <vecmath/bbox.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+#include <vecmath/plane.h>
+#include <vecmath/scalar.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumBrushes = 20'000;
+
+        // Where more than three planes almost meet in a point, healing the short edges between the intersection points
+        // may keep a different one of them depending on how the geometry was built, so vertices may differ by up to the
+        // minimum edge length.
+        static constexpr FloatType VertexEpsilon = 0.01;
+
+        using PlaneList = std::vector<vm::plane3>;
+
+        /**
+         * Creates the planes of cuboids at random positions, each with up to six of its corners cut off, so that the
+         * brushes have between 6 and 12 faces. Every other brush is rotated by a random angle.
+         */
+        static std::vector<PlaneList> makeBrushPlanes(const size_t brushCount) {
+            std::mt19937 random(0);
+            std::uniform_real_distribution<FloatType> positions(-3584.0, 3328.0);
+            std::uniform_real_distribution<FloatType> sizes(16.0, 256.0);
+            std::uniform_real_distribution<FloatType> cuts(0.05, 0.45);
+            std::uniform_real_distribution<FloatType> axes(-1.0, 1.0);
+            std::uniform_real_distribution<FloatType> angles(0.0, 360.0);
+            std::uniform_int_distribution<size_t> cornerCounts(0, 6);
+
+            std::vector<vm::vec3> corners;
+            for (const auto x : { -1.0, 1.0 }) {
+                for (const auto y : { -1.0, 1.0 }) {
+                    for (const auto z : { -1.0, 1.0 }) {
+                        corners.push_back(vm::vec3(x, y, z));
+                    }
+                }
+            }
+
+            std::vector<PlaneList> result;
+            result.reserve(brushCount);
+            for (size_t i = 0; i < brushCount; ++i) {
+                const auto min = vm::vec3(positions(random), positions(random), positions(random));
+                const auto max = min + vm::vec3(sizes(random), sizes(random), sizes(random));
+                const auto center = (min + max) / 2.0;
+                const auto size = max - min;
+
+                PlaneList planes {
+                    vm::plane3(min, vm::vec3::neg_x),
+                    vm::plane3(max, vm::vec3::pos_x),
+                    vm::plane3(min, vm::vec3::neg_y),
+                    vm::plane3(max, vm::vec3::pos_y),
+                    vm::plane3(min, vm::vec3::neg_z),
+                    vm::plane3(max, vm::vec3::pos_z)
+                };
+
+                // cutting less than half of every edge keeps the cuts from touching each other
+                std::shuffle(std::begin(corners), std::end(corners), random);
+                const auto cornerCount = cornerCounts(random);
+                for (size_t j = 0; j < cornerCount; ++j) {
+                    const auto& corner = corners[j];
+                    const auto cut = cuts(random);
+                    const auto normal = normalize(corner / size);
+                    const auto anchor = center + corner * size / 2.0 - vm::vec3(corner.x() * size.x() * cut, 0.0, 0.0);
+                    planes.push_back(vm::plane3(anchor, normal));
+                }
+
+                if (i % 2 == 1) {
+                    const auto axis = normalize(vm::vec3(axes(random), axes(random), axes(random)));
+                    const auto rotation = vm::translationMatrix(center) * vm::rotationMatrix(axis, vm::toRadians(angles(random))) * vm::translationMatrix(-center);
+                    for (auto& plane : planes) {
+                        plane = plane.transform(rotation);
+                    }
+                }
+
+                result.push_back(std::move(planes));
+            }
+            return result;
+        }
+
+        /**
+         * Builds the geometry as Brush::buildGeometry used to, by clipping a cube larger than the world bounds with
+         * every plane.
+         */
+        static void buildByClipping(const vm::bbox3& worldBounds, const PlaneList& planes, Polyhedron3& geometry) {
+            geometry = Polyhedron3(worldBounds.expand(1.0));
+            for (const auto& plane : planes) {
+                if (geometry.clip(plane).empty()) {
+                    break;
+                }
+            }
+            geometry.correctVertexPositions();
+            geometry.healEdges();
+        }
+
+        static size_t countVerticesOnPlane(const Polyhedron3& geometry, const vm::plane3& plane) {
+            size_t result = 0;
+            for (const auto* vertex : geometry.vertices()) {
+                if (std::abs(plane.pointDistance(vertex->position())) <= VertexEpsilon) {
+                    ++result;
+                }
+            }
+            return result;
+        }
+
+        TEST(BrushBuildBenchmark, benchBuildGeometry) {
+            const vm::bbox3 worldBounds(4096.0);
+            const auto brushPlanes = makeBrushPlanes(NumBrushes);
+
+            size_t faceCount = 0;
+            for (const auto& planes : brushPlanes) {
+                faceCount += planes.size();
+            }
+            const auto description = std::to_string(NumBrushes) + " brushes with " + std::to_string(faceCount) + " faces";
+
+            std::vector<Polyhedron3> clipped(NumBrushes);
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumBrushes; ++i) {
+                    buildByClipping(worldBounds, brushPlanes[i], clipped[i]);
+                }
+            }, "build " + description + " by clipping");
+
+            std::vector<Polyhedron3> built(NumBrushes);
+            std::vector<bool> fellBack(NumBrushes, false);
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumBrushes; ++i) {
+                    if (built[i].buildFromPlanes(brushPlanes[i], worldBounds).empty()) {
+                        // Brush::buildGeometry falls back to clipping
+                        fellBack[i] = true;
+                    } else {
+                        built[i].correctVertexPositions();
+                        built[i].healEdges();
+                    }
+                }
+            }, "build " + description + " from planes");
+
+            size_t fallbackCount = 0;
+            for (size_t i = 0; i < NumBrushes; ++i) {
+                const auto& planes = brushPlanes[i];
+                const auto& expected = clipped[i];
+                if (fellBack[i]) {
+                    // the planes were built to contribute a face each, so only healing may remove faces
+                    ASSERT_LT(expected.faceCount(), planes.size());
+                    ++fallbackCount;
+                    continue;
+                }
+
+                const auto& actual = built[i];
+                ASSERT_EQ(expected.vertexCount(), actual.vertexCount());
+                ASSERT_EQ(expected.edgeCount(), actual.edgeCount());
+                ASSERT_EQ(expected.faceCount(), actual.faceCount());
+                ASSERT_TRUE(actual.hasVertices(expected.vertexPositions(), VertexEpsilon));
+                for (const auto& plane : planes) {
+                    ASSERT_EQ(countVerticesOnPlane(expected, plane), countVerticesOnPlane(actual, plane));
+                }
+
+                // healing may delete faces, so check that every plane is bound to its face before healing
+                Polyhedron3 unhealed;
+                const auto faces = unhealed.buildFromPlanes(planes, worldBounds);
+                ASSERT_EQ(planes.size(), faces.size());
+                for (size_t j = 0; j < planes.size(); ++j) {
+                    for (const auto& position : faces[j]->vertexPositions()) {
+                        ASSERT_NEAR(0.0, planes[j].pointDistance(position), vm::C::almostZero());
+                    }
+                    ASSERT_LT(0.0, dot(planes[j].normal, faces[j]->normal()));
+                }
+            }
+            printf("%zu of %zu brushes fell back to clipping\n", fallbackCount, NumBrushes);
+        }
+
+        /**
+         * Creates the planes of brushes that approximate spheres at random positions, with the given number of faces
+         * each. The planes touch the sphere at points that are evenly spread over it.
+         */
+        static std::vector<PlaneList> makeSpherePlanes(const size_t brushCount, const size_t faceCount) {
+            std::mt19937 random(0);
+            std::uniform_real_distribution<FloatType> positions(-3584.0, 3328.0);
+            std::uniform_real_distribution<FloatType> radii(64.0, 256.0);
+
+            // a Fibonacci lattice spreads the points evenly
+            const auto goldenAngle = vm::C::pi() * (3.0 - std::sqrt(5.0));
+
+            std::vector<PlaneList> result;
+            result.reserve(brushCount);
+            for (size_t i = 0; i < brushCount; ++i) {
+                const auto center = vm::vec3(positions(random), positions(random), positions(random));
+                const auto radius = radii(random);
+
+                PlaneList planes;
+                planes.reserve(faceCount);
+                for (size_t j = 0; j < faceCount; ++j) {
+                    const auto z = 1.0 - 2.0 * (static_cast<FloatType>(j) + 0.5) / static_cast<FloatType>(faceCount);
+                    const auto r = std::sqrt(1.0 - z * z);
+                    const auto angle = goldenAngle * static_cast<FloatType>(j);
+                    const auto normal = vm::vec3(r * std::cos(angle), r * std::sin(angle), z);
+                    planes.push_back(vm::plane3(center + radius * normal, normal));
+                }
+                result.push_back(std::move(planes));
+            }
+            return result;
+        }
+
+        TEST(BrushBuildBenchmark, benchBuildGeometryWithManyFaces) {
+            // measures the number of faces above which Brush::buildGeometry clips instead of building from planes
+            const vm::bbox3 worldBounds(4096.0);
+
+            for (const size_t faceCount : { 16u, 24u, 32u, 64u, 128u }) {
+                const size_t brushCount = 100;
+                const auto brushPlanes = makeSpherePlanes(brushCount, faceCount);
+                const auto description = std::to_string(brushCount) + " brushes with " + std::to_string(faceCount) + " faces each";
+
+                std::vector<Polyhedron3> clipped(brushCount);
+                timeLambda([&]() {
+                    for (size_t i = 0; i < brushCount; ++i) {
+                        buildByClipping(worldBounds, brushPlanes[i], clipped[i]);
+                    }
+                }, "build " + description + " by clipping");
+
+                std::vector<Polyhedron3> built(brushCount);
+                timeLambda([&]() {
+                    for (size_t i = 0; i < brushCount; ++i) {
+                        if (!built[i].buildFromPlanes(brushPlanes[i], worldBounds).empty()) {
+                            built[i].correctVertexPositions();
+                            built[i].healEdges();
+                        }
+                    }
+                }, "build " + description + " from planes");
+
+                for (size_t i = 0; i < brushCount; ++i) {
+                    ASSERT_EQ(faceCount, clipped[i].faceCount());
+                    ASSERT_EQ(clipped[i].vertexCount(), built[i].vertexCount());
+                }
+            }
+        }
+    }
+}
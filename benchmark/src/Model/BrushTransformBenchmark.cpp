@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/Layer.h"
+#include "Model/World.h"
+
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumBrushes = 10'000;
+        static constexpr size_t NumDragSteps = 5;
+
+        /**
+         * Transforms the given brush as Brush::canTransform and Brush::transform used to, by transforming a clone to
+         * check whether the transformation is valid and then rebuilding the geometry of the brush from its faces.
+         */
+        static void transformByRebuilding(Brush* brush, const vm::mat4x4& transformation, const vm::bbox3& worldBounds) {
+            Brush* testBrush = brush->clone(worldBounds);
+            for (auto* face : testBrush->faces()) {
+                face->transform(transformation, false);
+            }
+            testBrush->rebuildGeometry(worldBounds);
+            delete testBrush;
+
+            for (auto* face : brush->faces()) {
+                face->transform(transformation, false);
+            }
+            brush->rebuildGeometry(worldBounds);
+        }
+
+        TEST(BrushTransformBenchmark, benchDragBrushes) {
+            const vm::bbox3 worldBounds(16384.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            std::mt19937 random(0);
+            std::uniform_int_distribution<int> positions(-512, 512);
+            std::uniform_int_distribution<int> sizes(1, 16);
+
+            BrushList brushes;
+            for (size_t i = 0; i < NumBrushes; ++i) {
+                const auto min = vm::vec3(positions(random), positions(random), positions(random)) * 8.0;
+                const auto max = min + vm::vec3(sizes(random), sizes(random), sizes(random)) * 8.0;
+                brushes.push_back(builder.createCuboid(vm::bbox3(min, max), "texture"));
+            }
+            world.defaultLayer()->addChildren(NodeList(std::begin(brushes), std::end(brushes)));
+
+            const auto step = vm::translationMatrix(vm::vec3(16.0, 8.0, 0.0));
+            const auto stepBack = vm::translationMatrix(vm::vec3(-16.0, -8.0, 0.0));
+
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumDragSteps; ++i) {
+                    for (auto* brush : brushes) {
+                        transformByRebuilding(brush, step, worldBounds);
+                    }
+                }
+            }, "drag " + std::to_string(NumBrushes) + " brushes by " + std::to_string(NumDragSteps) + " steps by rebuilding their geometry");
+
+            timeLambda([&]() {
+                for (size_t i = 0; i < NumDragSteps; ++i) {
+                    for (auto* brush : brushes) {
+                        ASSERT_TRUE(brush->canTransform(stepBack, worldBounds));
+                        brush->transform(stepBack, false, worldBounds);
+                    }
+                }
+            }, "drag " + std::to_string(NumBrushes) + " brushes by " + std::to_string(NumDragSteps) + " steps by moving their geometry");
+
+            const auto rotation = vm::mat4x4::rot_90_z_cw;
+            timeLambda([&]() {
+                for (auto* brush : brushes) {
+                    transformByRebuilding(brush, rotation, worldBounds);
+                }
+            }, "rotate " + std::to_string(NumBrushes) + " brushes by rebuilding their geometry");
+
+            timeLambda([&]() {
+                for (auto* brush : brushes) {
+                    ASSERT_TRUE(brush->canTransform(rotation, worldBounds));
+                    brush->transform(rotation, false, worldBounds);
+                }
+            }, "rotate " + std::to_string(NumBrushes) + " brushes by moving their geometry");
+        }
+    }
+}
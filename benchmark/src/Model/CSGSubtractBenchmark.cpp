@@ -0,0 +1,139 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "CollectionUtils.h"
+#include "ParallelUtils.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushGeometry.h"
+#include "Model/World.h"
+
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
+
+#include <cstdio>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t GridSize = 64;
+        static constexpr FloatType CellSize = 64.0;
+
+        /**
+         * Subtracts the given subtrahends from the given geometry as Brush::subtract used to, by subtracting every
+         * subtrahend from every fragment and copying the fragment lists after each step.
+         */
+        static size_t subtractWithoutPruning(const BrushGeometry& minuend, const std::vector<BrushGeometry>& subtrahends) {
+            auto result = std::list<BrushGeometry>{minuend};
+            for (const auto& subtrahend : subtrahends) {
+                auto nextResults = std::list<BrushGeometry>();
+                for (const BrushGeometry& fragment : result) {
+                    const auto subFragments = fragment.subtract(subtrahend);
+                    ListUtils::append(nextResults, subFragments);
+                }
+                result = nextResults;
+            }
+            return result.size();
+        }
+
+        static size_t countFragments(const std::vector<BrushGeometry::List>& fragments) {
+            size_t result = 0;
+            for (const auto& list : fragments) {
+                result += list.size();
+            }
+            return result;
+        }
+
+        TEST(CSGSubtractBenchmark, benchSubtractFromGrid) {
+            const vm::bbox3 worldBounds(16384.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            // a grid of blocks on the floor
+            BrushList minuends;
+            for (size_t x = 0; x < GridSize; ++x) {
+                for (size_t y = 0; y < GridSize; ++y) {
+                    const auto min = vm::vec3(static_cast<FloatType>(x) * CellSize, static_cast<FloatType>(y) * CellSize, 0.0);
+                    minuends.push_back(builder.createCuboid(vm::bbox3(min, min + vm::vec3(CellSize, CellSize, CellSize)), "minuend"));
+                }
+            }
+
+            // a large slab that carves a sloped trench through the middle of the grid
+            const auto extent = static_cast<FloatType>(GridSize) * CellSize;
+            auto* subtrahend = builder.createCuboid(vm::bbox3(vm::vec3(-extent, -extent / 8.0, -32.0), vm::vec3(extent, extent / 8.0, 32.0)), "subtrahend");
+            const auto center = vm::vec3(extent / 2.0, extent / 2.0, CellSize);
+            subtrahend->transform(vm::translationMatrix(center) * vm::rotationMatrix(vm::vec3::pos_z, vm::toRadians(30.0)) * vm::rotationMatrix(vm::vec3::pos_x, vm::toRadians(10.0)), false, worldBounds);
+            const BrushList subtrahends { subtrahend };
+
+            std::vector<BrushGeometry> minuendGeometries;
+            for (const auto* minuend : minuends) {
+                minuendGeometries.emplace_back(minuend->vertexPositions());
+            }
+            const auto subtrahendGeometries = std::vector<BrushGeometry> { BrushGeometry(subtrahend->vertexPositions()) };
+
+            size_t unprunedCount = 0;
+            timeLambda([&]() {
+                for (const auto& minuend : minuendGeometries) {
+                    unprunedCount += subtractWithoutPruning(minuend, subtrahendGeometries);
+                }
+            }, "subtract from " + std::to_string(minuends.size()) + " brushes without pruning");
+
+            std::vector<BrushGeometry::List> fragments(minuends.size());
+            timeLambda([&]() {
+                for (size_t i = 0; i < minuends.size(); ++i) {
+                    fragments[i] = minuends[i]->subtractGeometry(subtrahends, false);
+                }
+            }, "subtract from " + std::to_string(minuends.size()) + " brushes with pruning");
+            ASSERT_EQ(unprunedCount, countFragments(fragments));
+
+            timeLambda([&]() {
+                ParallelUtils::parallelFor(minuends.size(), [&](const size_t i) {
+                    fragments[i] = minuends[i]->subtractGeometry(subtrahends, false);
+                });
+            }, "subtract from " + std::to_string(minuends.size()) + " brushes with pruning on " + std::to_string(ParallelUtils::threadCount(minuends.size())) + " threads");
+            ASSERT_EQ(unprunedCount, countFragments(fragments));
+
+            timeLambda([&]() {
+                ParallelUtils::parallelFor(minuends.size(), [&](const size_t i) {
+                    fragments[i] = minuends[i]->subtractGeometry(subtrahends, true);
+                });
+            }, "subtract from " + std::to_string(minuends.size()) + " brushes and merge fragments");
+            const auto mergedCount = countFragments(fragments);
+            ASSERT_LE(mergedCount, unprunedCount);
+            printf("%zu fragments, %zu after merging\n", unprunedCount, mergedCount);
+
+            BrushList brushes;
+            timeLambda([&]() {
+                for (size_t i = 0; i < minuends.size(); ++i) {
+                    VectorUtils::append(brushes, minuends[i]->createBrushes(world, worldBounds, "default", fragments[i], subtrahends));
+                }
+            }, "create " + std::to_string(mergedCount) + " brushes");
+            ASSERT_EQ(mergedCount, brushes.size());
+
+            VectorUtils::deleteAll(brushes);
+            VectorUtils::deleteAll(minuends);
+            delete subtrahend;
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushFace.h"
+#include "Model/EditorContext.h"
+#include "Model/Layer.h"
+#include "Model/PickResult.h"
+#include "Model/World.h"
+
+#include <vecmath/ray.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumBrushes = 100'000;
+        static constexpr size_t NumRays = 10'000;
+
+        TEST(PickBenchmark, benchHoverPick) {
+            const vm::bbox3 worldBounds(16384.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            std::mt19937 random(0);
+            std::uniform_real_distribution<FloatType> positions(-8192.0, 8192.0);
+            std::uniform_real_distribution<FloatType> sizes(8.0, 256.0);
+            std::uniform_real_distribution<FloatType> directions(-1.0, 1.0);
+
+            NodeList brushes;
+            for (size_t i = 0; i < NumBrushes; ++i) {
+                const auto min = vm::vec3(positions(random), positions(random), positions(random));
+                const auto max = min + vm::vec3(sizes(random), sizes(random), sizes(random));
+                brushes.push_back(builder.createCuboid(vm::bbox3(min, max), "texture"));
+            }
+            world.defaultLayer()->addChildren(brushes);
+
+            std::vector<vm::ray3> rays;
+            for (size_t i = 0; i < NumRays; ++i) {
+                const auto origin = vm::vec3(positions(random), positions(random), positions(random));
+                const auto direction = normalize(vm::vec3(directions(random), directions(random), directions(random)));
+                rays.push_back(vm::ray3(origin, direction));
+            }
+
+            const EditorContext context;
+            std::vector<const BrushFace*> allHitFaces, closestHitFaces;
+
+            // most tools only need the closest pickable brush, see MapView3D::doPick
+            timeLambda([&]() {
+                for (const auto& ray : rays) {
+                    auto pickResult = PickResult::byDistance(context);
+                    world.pick(ray, pickResult);
+                    const auto& hit = pickResult.query().pickable().type(Brush::BrushHit).occluded().first();
+                    allHitFaces.push_back(hit.isMatch() ? hit.target<BrushFace*>() : nullptr);
+                }
+            }, "pick all hits along " + std::to_string(NumRays) + " rays through " + std::to_string(NumBrushes) + " brushes");
+            timeLambda([&]() {
+                for (const auto& ray : rays) {
+                    auto pickResult = PickResult::closestByDistance(context, Brush::BrushHit);
+                    world.pick(ray, pickResult);
+                    const auto& hit = pickResult.query().pickable().type(Brush::BrushHit).occluded().first();
+                    closestHitFaces.push_back(hit.isMatch() ? hit.target<BrushFace*>() : nullptr);
+                }
+            }, "pick the closest brush along " + std::to_string(NumRays) + " rays through " + std::to_string(NumBrushes) + " brushes");
+
+            ASSERT_EQ(allHitFaces, closestHitFaces);
+        }
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "BenchmarkUtils.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/CollectContainedNodesVisitor.h"
+#include "Model/CollectTouchingNodesVisitor.h"
+#include "Model/EditorContext.h"
+#include "Model/FindNodesInBrushes.h"
+#include "Model/Layer.h"
+#include "Model/World.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace TrenchBroom {
+    namespace Model {
+        static constexpr size_t NumBrushes = 100'000;
+
+        TEST(SelectTouchingBenchmark, benchSelectTouchingAndInside) {
+            const vm::bbox3 worldBounds(16384.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            BrushBuilder builder(&world, worldBounds);
+
+            std::mt19937 random(0);
+            std::uniform_real_distribution<FloatType> positions(-8192.0, 8192.0);
+            std::uniform_real_distribution<FloatType> sizes(8.0, 256.0);
+
+            NodeList brushes;
+            for (size_t i = 0; i < NumBrushes; ++i) {
+                const auto min = vm::vec3(positions(random), positions(random), positions(random));
+                const auto max = min + vm::vec3(sizes(random), sizes(random), sizes(random));
+                brushes.push_back(builder.createCuboid(vm::bbox3(min, max), "texture"));
+            }
+            world.defaultLayer()->addChildren(brushes);
+
+            const BrushList selection {
+                builder.createCuboid(vm::bbox3(vm::vec3(-2048.0, -2048.0, -2048.0), vm::vec3(2048.0, 2048.0, 2048.0)), "texture")
+            };
+            world.defaultLayer()->addChild(selection.front());
+
+            EditorContext context;
+            NodeList visitorNodes, treeNodes;
+
+            timeLambda([&]() {
+                CollectTouchingNodesVisitor<BrushList::const_iterator> visitor(std::begin(selection), std::end(selection), context);
+                world.acceptAndRecurse(visitor);
+                visitorNodes = visitor.nodes();
+            }, "select touching in " + std::to_string(NumBrushes) + " brushes with a visitor");
+            timeLambda([&]() {
+                treeNodes = findNodesTouchingBrushes(world, std::begin(selection), std::end(selection), context);
+            }, "select touching in " + std::to_string(NumBrushes) + " brushes with the node tree");
+            ASSERT_EQ(visitorNodes.size(), treeNodes.size());
+
+            timeLambda([&]() {
+                CollectContainedNodesVisitor<BrushList::const_iterator> visitor(std::begin(selection), std::end(selection), context);
+                world.acceptAndRecurse(visitor);
+                visitorNodes = visitor.nodes();
+            }, "select inside in " + std::to_string(NumBrushes) + " brushes with a visitor");
+            timeLambda([&]() {
+                treeNodes = findNodesContainedInBrushes(world, std::begin(selection), std::end(selection), context);
+            }, "select inside in " + std::to_string(NumBrushes) + " brushes with the node tree");
+            ASSERT_EQ(visitorNodes.size(), treeNodes.size());
+        }
+    }
+}
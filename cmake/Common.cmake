@@ -25,7 +25,7 @@ IF(common_TYPE STREQUAL "SHARED_LIBRARY")
         TARGET_LINK_LIBRARIES(common asan)
     ENDIF()
 
-    TARGET_LINK_LIBRARIES(common glew ${wxWidgets_LIBRARIES} ${FREETYPE_LIBRARIES} ${FREEIMAGE_LIBRARIES} vecmath tinyxml2 miniz)
+    TARGET_LINK_LIBRARIES(common glew ${wxWidgets_LIBRARIES} ${FREETYPE_LIBRARIES} ${FREEIMAGE_LIBRARIES} vecmath tinyxml2 miniz Threads::Threads)
 ENDIF()
 
 INCLUDE_DIRECTORIES(${COMMON_SOURCE_DIR})
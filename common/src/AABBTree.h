@@ -22,6 +22,7 @@
 
 #include "NodeTree.h"
 #include "Exceptions.h"
+#include "SurfaceAreaHeuristic.h"
 #include <vecmath/scalar.h>
 #include <vecmath/bbox.h>
 #include <vecmath/ray.h>
@@ -31,8 +32,10 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <memory>
+#include <vector>
 
 template <typename T, size_t S, typename U, typename Cmp = std::less<U>>
 class AABBTree : public NodeTree<T,S,U,Cmp> {
@@ -41,6 +44,8 @@ public:
     using Box = typename NodeTree<T,S,U,Cmp>::Box;
     using DataType = typename NodeTree<T,S,U,Cmp>::DataType;
     using FloatType = typename NodeTree<T,S,U,Cmp>::FloatType;
+    using Array = typename NodeTree<T,S,U,Cmp>::Array;
+    using GetBounds = typename NodeTree<T,S,U,Cmp>::GetBounds;
 private:
     class InnerNode;
     class LeafNode;
@@ -498,6 +503,28 @@ public:
         return false;
     }
 
+    /**
+     * Clears this tree and builds it top down from the given objects. This is much faster than inserting the objects
+     * one by one and yields a tree whose quality does not depend on the order of the objects.
+     *
+     * @param objects the objects to insert
+     * @param getBounds a function to compute the bounds from each object
+     */
+    void clearAndBuild(const List& objects, const GetBounds& getBounds) override {
+        build(std::begin(objects), std::end(objects), getBounds);
+    }
+
+    /**
+     * Clears this tree and builds it top down from the given objects. This is much faster than inserting the objects
+     * one by one and yields a tree whose quality does not depend on the order of the objects.
+     *
+     * @param objects the objects to insert
+     * @param getBounds a function to compute the bounds from each object
+     */
+    void clearAndBuild(const Array& objects, const GetBounds& getBounds) override {
+        build(std::begin(objects), std::end(objects), getBounds);
+    }
+
     void update(const Box& oldBounds, const Box& newBounds, const U& data) override {
         check(oldBounds, data);
         check(newBounds, data);
@@ -517,6 +544,59 @@ private:
             throw ex;
         }
     }
+
+    template <typename I>
+    void build(I cur, I end, const GetBounds& getBounds) {
+        clear();
+
+        // compute and check all bounds before creating any nodes so that nothing leaks if a check fails
+        std::vector<std::pair<Box, U>> objects;
+        objects.reserve(static_cast<size_t>(std::distance(cur, end)));
+        while (cur != end) {
+            const auto bounds = getBounds(*cur);
+            check(bounds, *cur);
+            objects.emplace_back(bounds, *cur);
+            ++cur;
+        }
+
+        if (!objects.empty()) {
+            std::vector<BuildEntry> entries;
+            entries.reserve(objects.size());
+            for (const auto& [bounds, data] : objects) {
+                entries.push_back(BuildEntry{ new LeafNode(bounds, data), bounds.center() });
+            }
+            m_root = build(std::begin(entries), std::end(entries));
+        }
+    }
+
+    /**
+     * A node to build a subtree from, together with the center of its bounds.
+     */
+    struct BuildEntry {
+        Node* node;
+        vm::vec<T,S> center;
+    };
+
+    using BuildIterator = typename std::vector<BuildEntry>::iterator;
+
+    /**
+     * Builds a subtree from the given nodes using the surface area heuristic.
+     *
+     * @param begin the first node
+     * @param end the end of the range of nodes
+     * @return the root of the subtree
+     */
+    static Node* build(const BuildIterator begin, const BuildIterator end) {
+        assert(begin != end);
+        if (std::next(begin) == end) {
+            return begin->node;
+        }
+
+        const auto middle = SurfaceAreaHeuristic::partition<T,S>(begin, end,
+            [](const BuildEntry& entry) -> const Box& { return entry.node->bounds(); },
+            [](const BuildEntry& entry) -> const vm::vec<T,S>& { return entry.center; });
+        return new InnerNode(build(begin, middle), build(middle, end));
+    }
 public:
     void clear() override {
         if (!empty()) {
@@ -577,6 +657,38 @@ public:
         }
     }
 
+    List findIntersectors(const Box& bounds) const override {
+        List result;
+        findIntersectors(bounds, std::back_inserter(result));
+        return result;
+    }
+
+    /**
+     * Finds every data item in this tree whose bounding box intersects with the given box and appends it to the given
+     * output iterator.
+     *
+     * @tparam O the output iterator type
+     * @param bounds the box to test
+     * @param out the output iterator to append to
+     */
+    template <typename O>
+    void findIntersectors(const Box& bounds, O out) const {
+        if (!empty()) {
+            LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return innerNode->bounds().intersects(bounds);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (leaf->bounds().intersects(bounds)) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+            );
+            m_root->accept(visitor);
+        }
+    }
+
      List findContainers(const vm::vec<T,S>& point) const override {
          List result;
          findContainers(point, std::back_inserter(result));
@@ -20,182 +20,290 @@
 #ifndef TrenchBroom_Allocator_h
 #define TrenchBroom_Allocator_h
 
+#include <atomic>
 #include <cassert>
-#include <iostream>
-#include <limits>
-#include <stack>
+#include <cstddef>
+#include <mutex>
 #include <vector>
 
 // Undefine this to prevent false positives when looking for memory leaks.
 #define TB_ENABLE_ALLOCATOR 1
 
-template <class T, size_t PoolSize = 64, size_t BlocksPerChunk = 256>
+/**
+ * Counters that describe the memory used by an allocator.
+ */
+class AllocatorStatistics {
+public:
+    // the number of objects that are currently allocated
+    size_t liveObjects;
+    // the number of objects that were allocated in total
+    size_t totalAllocations;
+    // the number of chunks that are currently reserved
+    size_t chunks;
+    // the number of bytes that are currently reserved
+    size_t bytes;
+public:
+    AllocatorStatistics() :
+    liveObjects(0),
+    totalAllocations(0),
+    chunks(0),
+    bytes(0) {}
+
+    AllocatorStatistics& operator+=(const AllocatorStatistics& other) {
+        liveObjects += other.liveObjects;
+        totalAllocations += other.totalAllocations;
+        chunks += other.chunks;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+/**
+ * Allocates objects of type T in chunks of a fixed number of blocks.
+ *
+ * Each thread allocates from its own arena, so objects can be created on several threads without contention. An
+ * object can be deleted on any thread because every block knows its chunk and every chunk knows its arena. A chunk is
+ * returned to the system as soon as all of its blocks are free, except for one spare chunk per arena, which can be
+ * released with releaseUnusedMemory.
+ */
+template <class T, size_t BlocksPerChunk = 256>
 class Allocator {
 private:
+    class Chunk;
+
+    class Block {
+    public:
+        Chunk* chunk;
+        union {
+            Block* nextFree;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+    public:
+        static Block* fromObject(void* object) {
+            return reinterpret_cast<Block*>(static_cast<unsigned char*>(object) - offsetof(Block, storage));
+        }
+    };
+
+    class Arena;
+
     class Chunk {
+    public:
+        Arena* arena;
+        // links in the arena's list of chunks that have free blocks
+        Chunk* previous;
+        Chunk* next;
+        Block* firstFree;
+        size_t freeCount;
+        Block blocks[BlocksPerChunk];
+    public:
+        explicit Chunk(Arena* i_arena) :
+        arena(i_arena),
+        previous(nullptr),
+        next(nullptr),
+        firstFree(&blocks[0]),
+        freeCount(BlocksPerChunk) {
+            for (size_t i = 0; i < BlocksPerChunk; ++i) {
+                blocks[i].chunk = this;
+                blocks[i].nextFree = i + 1 < BlocksPerChunk ? &blocks[i + 1] : nullptr;
+            }
+        }
+
+        bool full() const {
+            return freeCount == 0;
+        }
+
+        bool empty() const {
+            return freeCount == BlocksPerChunk;
+        }
+    };
+
+    class Arena {
     private:
-        unsigned char m_blocks[BlocksPerChunk * sizeof(T)];
-        unsigned char m_firstFreeBlock;
-        unsigned char m_numFreeBlocks;
+        std::mutex m_mutex;
+        Chunk* m_available;
+        Chunk* m_spare;
     public:
-        Chunk() :
-        m_firstFreeBlock(0),
-        m_numFreeBlocks(BlocksPerChunk - 1) {
-            for (size_t i = 0; i < BlocksPerChunk - 1; i++)
-                m_blocks[i * sizeof(T)] = static_cast<unsigned char>(i + 1);
+        Arena() :
+        m_available(nullptr),
+        m_spare(nullptr) {}
+
+        void* allocate() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_available == nullptr) {
+                if (m_spare != nullptr) {
+                    link(m_spare);
+                    m_spare = nullptr;
+                } else {
+                    link(new Chunk(this));
+                    ++chunkCount();
+                }
+            }
+
+            Chunk* chunk = m_available;
+            Block* block = chunk->firstFree;
+            chunk->firstFree = block->nextFree;
+            --chunk->freeCount;
+
+            if (chunk->full()) {
+                unlink(chunk);
+            }
+            return block->storage;
         }
-        
-        bool contains(const T* t) const {
-            const unsigned char* block = reinterpret_cast<const unsigned char*>(t);
-            if (block < m_blocks)
-                return false;
-            size_t offset = static_cast<size_t>(block - m_blocks);
-            return offset < (BlocksPerChunk - 1) * sizeof(T);
+
+        void deallocate(Block* block) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            Chunk* chunk = block->chunk;
+            if (chunk->full()) {
+                link(chunk);
+            }
+
+            block->nextFree = chunk->firstFree;
+            chunk->firstFree = block;
+            ++chunk->freeCount;
+
+            if (chunk->empty()) {
+                unlink(chunk);
+                if (m_spare == nullptr) {
+                    m_spare = chunk;
+                } else {
+                    delete chunk;
+                    --chunkCount();
+                }
+            }
         }
-        
-        T* allocate() {
-            if (m_numFreeBlocks == 0)
-                return nullptr;
-            
-            unsigned char* block = m_blocks + m_firstFreeBlock * sizeof(T);
-            m_firstFreeBlock = *block;
-            m_numFreeBlocks--;
-            return reinterpret_cast<T*>(block);
+
+        void releaseSpare() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_spare != nullptr) {
+                delete m_spare;
+                m_spare = nullptr;
+                --chunkCount();
+            }
         }
-        
-        void deallocate(T* t) {
-            assert(m_numFreeBlocks < BlocksPerChunk - 1);
-            assert(contains(t));
-            
-            unsigned char* block = reinterpret_cast<unsigned char*>(t);
-            assert(block >= m_blocks);
-            size_t offset = static_cast<size_t>(block - m_blocks);
-            assert(offset % sizeof(T) == 0);
-            
-            size_t index = offset / sizeof(T);
-            assert(index < BlocksPerChunk);
-            
-            *block = m_firstFreeBlock;
-            m_firstFreeBlock = static_cast<unsigned char>(index);
-            m_numFreeBlocks++;
+    private:
+        void link(Chunk* chunk) {
+            assert(chunk->previous == nullptr && chunk->next == nullptr);
+            chunk->next = m_available;
+            if (m_available != nullptr) {
+                m_available->previous = chunk;
+            }
+            m_available = chunk;
         }
-        
-        bool empty() const {
-            return m_numFreeBlocks == BlocksPerChunk - 1;
+
+        void unlink(Chunk* chunk) {
+            if (chunk->previous != nullptr) {
+                chunk->previous->next = chunk->next;
+            } else {
+                assert(m_available == chunk);
+                m_available = chunk->next;
+            }
+            if (chunk->next != nullptr) {
+                chunk->next->previous = chunk->previous;
+            }
+            chunk->previous = nullptr;
+            chunk->next = nullptr;
         }
-        
-        bool full() const {
-            return m_numFreeBlocks == 0;
+    };
+
+    /**
+     * Attaches an arena to the current thread for the lifetime of the thread. Arenas are never destroyed because they
+     * may still contain objects when their thread ends; instead, they are handed to the next thread that needs one.
+     */
+    class ThreadArena {
+    public:
+        Arena* arena;
+    public:
+        ThreadArena() :
+        arena(nullptr) {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            if (!unusedArenas().empty()) {
+                arena = unusedArenas().back();
+                unusedArenas().pop_back();
+            } else {
+                arena = new Arena();
+                allArenas().push_back(arena);
+            }
+        }
+
+        ~ThreadArena() {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            unusedArenas().push_back(arena);
         }
     };
-    
-    using ChunkList = std::vector<Chunk*>;
-    using Pool = std::stack<T*>;
-    
-    static Pool& pool() {
-        static Pool p;
-        return p;
+
+    static std::mutex& registryMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static std::vector<Arena*>& allArenas() {
+        static std::vector<Arena*> arenas;
+        return arenas;
+    }
+
+    static std::vector<Arena*>& unusedArenas() {
+        static std::vector<Arena*> arenas;
+        return arenas;
+    }
+
+    static Arena& threadArena() {
+        thread_local ThreadArena threadArena;
+        return *threadArena.arena;
     }
-    
-    static ChunkList& fullChunks() {
-        static ChunkList chunks;
-        return chunks;
+
+    static std::atomic<size_t>& liveObjectCount() {
+        static std::atomic<size_t> count(0);
+        return count;
     }
-    
-    static ChunkList& mixedChunks() {
-        static ChunkList chunks;
-        return chunks;
+
+    static std::atomic<size_t>& totalAllocationCount() {
+        static std::atomic<size_t> count(0);
+        return count;
     }
-    
-    static ChunkList emptyChunks() {
-        static ChunkList chunks;
-        return chunks;
+
+    static std::atomic<size_t>& chunkCount() {
+        static std::atomic<size_t> count(0);
+        return count;
     }
 public:
+    static AllocatorStatistics statistics() {
+        AllocatorStatistics result;
+        result.liveObjects = liveObjectCount();
+        result.totalAllocations = totalAllocationCount();
+        result.chunks = chunkCount();
+        result.bytes = result.chunks * sizeof(Chunk);
+        return result;
+    }
+
+    /**
+     * Returns the spare chunks of all arenas to the system. Call this after deleting a large number of objects, e.g.
+     * when a map was closed.
+     */
+    static void releaseUnusedMemory() {
+        std::lock_guard<std::mutex> lock(registryMutex());
+        for (Arena* arena : allArenas()) {
+            arena->releaseSpare();
+        }
+    }
 #ifdef TB_ENABLE_ALLOCATOR
     void* operator new(size_t size) {
         assert(size == sizeof(T));
-        
-        if (!pool().empty()) {
-            T* t = pool().top();
-            pool().pop();
-            return t;
-        }
-        
-        Chunk* chunk = nullptr;
-        if (mixedChunks().empty()) {
-            if (!emptyChunks().empty()) {
-                chunk = emptyChunks().back();
-                emptyChunks().pop_back();
-            } else {
-                chunk = new Chunk();
-            }
-        } else {
-            chunk = mixedChunks().back();
-            mixedChunks().pop_back();
-        }
-        
-        assert(!chunk->full());
-        T* block = chunk->allocate();
-        
-        if (chunk->full()) {
-            fullChunks().push_back(chunk);
-        } else {
-            mixedChunks().push_back(chunk);
-        }
-        return block;
+        void* result = threadArena().allocate();
+        ++liveObjectCount();
+        ++totalAllocationCount();
+        return result;
     }
-    
-    void operator delete(void* block) {
-        T* t = reinterpret_cast<T*>(block);
-        
-        if (PoolSize > 0 && pool().size() < PoolSize) {
-            pool().push(t);
+
+    void operator delete(void* object) {
+        if (object == nullptr) {
             return;
         }
-        
-        typename ChunkList::reverse_iterator fullIt, fullEnd, mixedIt, mixedEnd;
-        fullIt = fullChunks().rbegin();
-        fullEnd = fullChunks().rend();
-        mixedIt = mixedChunks().rbegin();
-        mixedEnd = mixedChunks().rend();
-        
-        Chunk* chunk = nullptr;
-        while (fullIt < fullEnd || mixedIt < mixedEnd) {
-            if (fullIt < fullEnd) {
-                Chunk* fullChunk = *fullIt;
-                if (fullChunk->contains(t)) {
-                    chunk = fullChunk;
-                    break;
-                }
-                ++fullIt;
-            }
-            if (mixedIt < mixedEnd) {
-                Chunk* mixedChunk = *mixedIt;
-                if (mixedChunk->contains(t)) {
-                    chunk = mixedChunk;
-                    break;
-                }
-                ++mixedIt;
-            }
-        }
-        
-        assert(chunk != nullptr);
-        
-        if (chunk->full()) {
-            fullChunks().erase((fullIt + 1).base());
-            mixedChunks().push_back(chunk);
-        }
-        
-        chunk->deallocate(t);
-        
-        if (chunk->empty()) {
-            mixedChunks().erase((mixedIt + 1).base());
-            if (emptyChunks().size() < 2)
-                emptyChunks().push_back(chunk);
-                else
-                    delete chunk;
-        }
+
+        Block* block = Block::fromObject(object);
+        block->chunk->arena->deallocate(block);
+        --liveObjectCount();
     }
 #endif
 };
@@ -32,6 +32,7 @@ namespace TrenchBroom {
         class PaletteLoader;
         
         class Texture;
+        class TextureName;
         using TextureList = std::vector<Texture*>;
         
         class TextureCollection;
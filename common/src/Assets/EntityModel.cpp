@@ -43,8 +43,13 @@ namespace TrenchBroom {
 
         EntityModel::Mesh::~Mesh() {}
 
+        size_t EntityModel::Mesh::sizeInBytes() const {
+            return m_vertices.capacity() * sizeof(Vertex);
+        }
+
         std::unique_ptr<Renderer::TexturedIndexRangeRenderer> EntityModel::Mesh::buildRenderer(Assets::Texture* skin) {
-            const auto vertexArray = Renderer::VertexArray::ref(m_vertices);
+            // copy the vertices because the mesh may be unloaded before the renderer is prepared
+            const auto vertexArray = Renderer::VertexArray::copy(m_vertices);
             return doBuildRenderer(skin, vertexArray);
         }
 
@@ -65,6 +70,12 @@ namespace TrenchBroom {
             return std::make_unique<Renderer::TexturedIndexRangeRenderer>(vertices, m_indices);
         }
 
+        EntityModel::FrameLoader::~FrameLoader() {}
+
+        EntityModel::MeshList EntityModel::FrameLoader::loadFrame(const size_t frameIndex) const {
+            return doLoadFrame(frameIndex);
+        }
+
         EntityModel::Surface::Surface(const String& name) :
         m_name(name),
         m_skins(std::make_unique<Assets::TextureCollection>()) {}
@@ -89,6 +100,23 @@ namespace TrenchBroom {
             m_meshes.push_back(std::make_unique<TexturedMesh>(vertices, indices));
         }
 
+        void EntityModel::Surface::setFrameCount(const size_t frameCount) {
+            m_meshes.resize(frameCount);
+        }
+
+        void EntityModel::Surface::setMesh(const size_t frameIndex, std::unique_ptr<Mesh> mesh) {
+            assert(frameIndex < m_meshes.size());
+            m_meshes[frameIndex] = std::move(mesh);
+        }
+
+        size_t EntityModel::Surface::meshSizeInBytes(const size_t frameIndex) const {
+            if (frameIndex >= m_meshes.size() || m_meshes[frameIndex] == nullptr) {
+                return 0;
+            } else {
+                return m_meshes[frameIndex]->sizeInBytes();
+            }
+        }
+
         void EntityModel::Surface::addSkin(Assets::Texture* skin) {
             m_skins->addTexture(skin);
         }
@@ -106,7 +134,7 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<Renderer::TexturedIndexRangeRenderer> EntityModel::Surface::buildRenderer(size_t skinIndex, size_t frameIndex) {
-            if (skinIndex >= skinCount() || frameIndex >= frameCount()) {
+            if (skinIndex >= skinCount() || frameIndex >= frameCount() || m_meshes[frameIndex] == nullptr) {
                 return nullptr;
             } else {
                 const auto& textures = m_skins->textures();
@@ -171,6 +199,53 @@ namespace TrenchBroom {
             return *m_surfaces.back();
         }
 
+        void EntityModel::setFrameLoader(std::unique_ptr<FrameLoader> frameLoader) {
+            m_frameLoader = std::move(frameLoader);
+            m_loadedFrames.assign(frameCount(), false);
+            for (auto& surface : m_surfaces) {
+                surface->setFrameCount(frameCount());
+            }
+        }
+
+        bool EntityModel::hasFrameLoader() const {
+            return m_frameLoader != nullptr;
+        }
+
+        bool EntityModel::frameLoaded(const size_t frameIndex) const {
+            return m_frameLoader == nullptr || (frameIndex < m_loadedFrames.size() && m_loadedFrames[frameIndex]);
+        }
+
+        bool EntityModel::loadFrame(const size_t frameIndex) {
+            if (frameIndex >= frameCount() || frameLoaded(frameIndex)) {
+                return false;
+            }
+
+            auto meshes = m_frameLoader->loadFrame(frameIndex);
+            assert(meshes.size() == m_surfaces.size());
+            for (size_t i = 0; i < m_surfaces.size() && i < meshes.size(); ++i) {
+                m_surfaces[i]->setMesh(frameIndex, std::move(meshes[i]));
+            }
+            m_loadedFrames[frameIndex] = true;
+            return true;
+        }
+
+        void EntityModel::unloadFrame(const size_t frameIndex) {
+            if (m_frameLoader != nullptr && frameIndex < frameCount()) {
+                for (auto& surface : m_surfaces) {
+                    surface->setMesh(frameIndex, nullptr);
+                }
+                m_loadedFrames[frameIndex] = false;
+            }
+        }
+
+        size_t EntityModel::frameSizeInBytes(const size_t frameIndex) const {
+            size_t result = 0;
+            for (const auto& surface : m_surfaces) {
+                result += surface->meshSizeInBytes(frameIndex);
+            }
+            return result;
+        }
+
         size_t EntityModel::frameCount() const {
             return m_frames.size();
         }
@@ -28,6 +28,7 @@
 #include <vecmath/bbox.h>
 
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -97,6 +98,13 @@ namespace TrenchBroom {
             public:
                 virtual ~Mesh();
 
+                /**
+                 Returns the approximate number of bytes occupied by this mesh's vertices.
+
+                 @return the size of this mesh in bytes
+                 */
+                size_t sizeInBytes() const;
+
                 /**
                  Returns a renderer that renders this mesh with the given texture.
 
@@ -152,6 +160,29 @@ namespace TrenchBroom {
                 std::unique_ptr<Renderer::TexturedIndexRangeRenderer> doBuildRenderer(Assets::Texture* skin, const Renderer::VertexArray& vertices) override;
             };
 
+            using MeshList = std::vector<std::unique_ptr<Mesh>>;
+
+            /**
+             Decodes the meshes of a model frame on demand. Parsers that support this index the frames of a model
+             up front, keeping only their packed vertex data, and attach a frame loader to the model.
+             */
+            class FrameLoader {
+            public:
+                virtual ~FrameLoader();
+
+                /**
+                 Decodes the meshes of the frame with the given index, one mesh per surface in the order in which the
+                 surfaces were added to the model. A mesh may be null if the corresponding surface has no data for
+                 the frame.
+
+                 @param frameIndex the index of the frame to decode
+                 @return the meshes of the frame
+                 */
+                MeshList loadFrame(size_t frameIndex) const;
+            private:
+                virtual MeshList doLoadFrame(size_t frameIndex) const = 0;
+            };
+
             /**
              A model surface represents an individual part of a model. MDL and MD2 models use only one surface, while
              more complex model formats such as MD3 contain multiple surfaces with one skin per surface.
@@ -212,6 +243,29 @@ namespace TrenchBroom {
                  */
                 void addTexturedMesh(const VertexList& vertices, const TexturedIndices& indices);
 
+                /**
+                 Sets the number of frames of this surface. Frames that are added by this are not loaded.
+
+                 @param frameCount the number of frames
+                 */
+                void setFrameCount(size_t frameCount);
+
+                /**
+                 Replaces the mesh of the frame with the given index.
+
+                 @param frameIndex the index of the frame
+                 @param mesh the new mesh, may be null
+                 */
+                void setMesh(size_t frameIndex, std::unique_ptr<Mesh> mesh);
+
+                /**
+                 Returns the number of bytes occupied by the mesh of the frame with the given index.
+
+                 @param frameIndex the index of the frame
+                 @return the size of the mesh in bytes, or 0 if the mesh is not loaded
+                 */
+                size_t meshSizeInBytes(size_t frameIndex) const;
+
                 /**
                  Adds the given texture as a skin to this surface.
 
@@ -220,9 +274,10 @@ namespace TrenchBroom {
                 void addSkin(Assets::Texture* skin);
 
                 /**
-                 Returns the number of frame meshes in this surface, should match the model's frame count.
+                 Returns the number of frames of this surface, including frames whose meshes are not loaded. Should
+                 match the model's frame count.
 
-                 @return the number of frame meshes
+                 @return the number of frames
                  */
                 size_t frameCount() const;
 
@@ -248,6 +303,8 @@ namespace TrenchBroom {
             bool m_prepared;
             std::vector<std::unique_ptr<Frame>> m_frames;
             std::vector<std::unique_ptr<Surface>> m_surfaces;
+            std::unique_ptr<FrameLoader> m_frameLoader;
+            std::vector<bool> m_loadedFrames;
         public:
             /**
              Creates a new entity model with the given name.
@@ -257,7 +314,9 @@ namespace TrenchBroom {
             explicit EntityModel(const String& name);
 
             /**
-             Creates a renderer to render the given frame of the model using the skin with the given index.
+             Creates a renderer to render the given frame of the model using the skin with the given index. If this model
+             loads its frames on demand, the frame must have been loaded by calling loadFrame. The renderer keeps its own
+             copy of the vertices, so the frame can be unloaded once the renderer was created.
 
              @param skinIndex the index of the skin to use
              @param frameIndex the index of the frame to render
@@ -314,6 +373,54 @@ namespace TrenchBroom {
              */
             Surface& addSurface(const String& name);
 
+            /**
+             Makes this model load the meshes of its frames on demand using the given loader. Must be called after all
+             frames and surfaces have been added.
+
+             @param frameLoader the frame loader
+             */
+            void setFrameLoader(std::unique_ptr<FrameLoader> frameLoader);
+
+            /**
+             Indicates whether this model loads the meshes of its frames on demand.
+
+             @return true if this model has a frame loader and false otherwise
+             */
+            bool hasFrameLoader() const;
+
+            /**
+             Indicates whether the meshes of the given frame are loaded. Always true for models without a frame loader.
+
+             @param frameIndex the index of the frame
+             @return true if the frame is loaded and false otherwise
+             */
+            bool frameLoaded(size_t frameIndex) const;
+
+            /**
+             Decodes the meshes of the given frame unless they are already loaded. Does nothing if this model has no
+             frame loader or if the frame index is out of range.
+
+             @param frameIndex the index of the frame
+             @return true if the frame was decoded by this call and false otherwise
+             */
+            bool loadFrame(size_t frameIndex);
+
+            /**
+             Releases the meshes of the given frame. Does nothing if this model has no frame loader, since the frame
+             could not be loaded again.
+
+             @param frameIndex the index of the frame
+             */
+            void unloadFrame(size_t frameIndex);
+
+            /**
+             Returns the number of bytes occupied by the meshes of the given frame.
+
+             @param frameIndex the index of the frame
+             @return the size of the frame's meshes in bytes
+             */
+            size_t frameSizeInBytes(size_t frameIndex) const;
+
             /**
              Returns the number of frames of this model.
 
@@ -0,0 +1,84 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "EntityModelFrameCache.h"
+
+#include "Assets/EntityModel.h"
+
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace Assets {
+        EntityModelFrameCache::EntityModelFrameCache(const size_t maxBytes) :
+        m_maxBytes(maxBytes),
+        m_bytes(0) {}
+
+        void EntityModelFrameCache::loadFrame(EntityModel& model, const size_t frameIndex) {
+            if (!model.hasFrameLoader() || frameIndex >= model.frameCount()) {
+                return;
+            }
+
+            const auto key = EntryKey(&model, frameIndex);
+            const auto it = m_index.find(key);
+            if (it != std::end(m_index)) {
+                m_entries.splice(std::begin(m_entries), m_entries, it->second);
+                return;
+            }
+
+            model.loadFrame(frameIndex);
+
+            const auto bytes = model.frameSizeInBytes(frameIndex);
+            m_entries.push_front(Entry { &model, frameIndex, bytes });
+            m_index.insert(std::make_pair(key, std::begin(m_entries)));
+            m_bytes += bytes;
+
+            evict();
+        }
+
+        void EntityModelFrameCache::clear() {
+            m_entries.clear();
+            m_index.clear();
+            m_bytes = 0;
+        }
+
+        size_t EntityModelFrameCache::maxBytes() const {
+            return m_maxBytes;
+        }
+
+        size_t EntityModelFrameCache::bytes() const {
+            return m_bytes;
+        }
+
+        size_t EntityModelFrameCache::frameCount() const {
+            return m_entries.size();
+        }
+
+        void EntityModelFrameCache::evict() {
+            // never evict the most recently used frame, it is about to be rendered
+            while (m_bytes > m_maxBytes && m_entries.size() > 1) {
+                const auto& entry = m_entries.back();
+                entry.model->unloadFrame(entry.frameIndex);
+                m_index.erase(EntryKey(entry.model, entry.frameIndex));
+                m_bytes -= entry.bytes;
+                m_entries.pop_back();
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_EntityModelFrameCache
+#define TrenchBroom_EntityModelFrameCache
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class EntityModel;
+
+        /**
+         Keeps track of the frames that were decoded for entity models which load their frames on demand. If the
+         meshes of the decoded frames exceed the given memory budget, the least recently used frames are unloaded.
+         */
+        class EntityModelFrameCache {
+        private:
+            struct Entry {
+                EntityModel* model;
+                size_t frameIndex;
+                size_t bytes;
+            };
+
+            using EntryList = std::list<Entry>;
+            using EntryKey = std::pair<const EntityModel*, size_t>;
+            using EntryMap = std::map<EntryKey, EntryList::iterator>;
+
+            size_t m_maxBytes;
+            size_t m_bytes;
+            EntryList m_entries;
+            EntryMap m_index;
+        public:
+            explicit EntityModelFrameCache(size_t maxBytes);
+
+            /**
+             Loads the given frame of the given model unless it is already loaded, and marks it as the most recently
+             used frame. Frames of models without a frame loader are always loaded and are not tracked.
+
+             @param model the model
+             @param frameIndex the index of the frame
+             */
+            void loadFrame(EntityModel& model, size_t frameIndex);
+
+            /**
+             Forgets all frames without unloading them. Must be called before the models are deleted.
+             */
+            void clear();
+
+            size_t maxBytes() const;
+            size_t bytes() const;
+            size_t frameCount() const;
+        private:
+            void evict();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_EntityModelFrameCache) */
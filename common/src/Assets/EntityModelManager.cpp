@@ -32,13 +32,15 @@ namespace TrenchBroom {
         m_loader(nullptr),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_frameCache(FrameCacheSize) {}
         
         EntityModelManager::~EntityModelManager() {
             clear();
         }
         
         void EntityModelManager::clear() {
+            m_frameCache.clear();
             MapUtils::clearAndDelete(m_renderers);
             MapUtils::clearAndDelete(m_models);
             m_rendererMismatches.clear();
@@ -114,6 +116,7 @@ namespace TrenchBroom {
                 return nullptr;
             }
 
+            m_frameCache.loadFrame(*entityModel, spec.frameIndex);
             auto* renderer = entityModel->buildRenderer(spec.skinIndex, spec.frameIndex);
             if (renderer == nullptr) {
                 m_rendererMismatches.insert(spec);
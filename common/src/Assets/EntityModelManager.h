@@ -20,6 +20,7 @@
 #ifndef TrenchBroom_EntityModelManager
 #define TrenchBroom_EntityModelManager
 
+#include "Assets/EntityModelFrameCache.h"
 #include "Assets/ModelDefinition.h"
 #include "IO/Path.h"
 #include "Model/ModelTypes.h"
@@ -52,6 +53,9 @@ namespace TrenchBroom {
             using RendererCache = std::map<Assets::ModelSpecification, Renderer::TexturedRenderer*>;
             using RendererMismatches = std::set<Assets::ModelSpecification>;
             using RendererList = std::vector<Renderer::TexturedRenderer*>;
+
+            // the memory budget for the decoded frames of models that load their frames on demand
+            static const size_t FrameCacheSize = 64 * 1024 * 1024;
             
             Logger& m_logger;
             const IO::EntityModelLoader* m_loader;
@@ -64,6 +68,7 @@ namespace TrenchBroom {
             mutable ModelMismatches m_modelMismatches;
             mutable RendererCache m_renderers;
             mutable RendererMismatches m_rendererMismatches;
+            mutable EntityModelFrameCache m_frameCache;
 
             mutable ModelList m_unpreparedModels;
             mutable RendererList m_unpreparedRenderers;
@@ -23,6 +23,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -76,14 +77,36 @@ namespace TrenchBroom {
             return stream;
         }
 
+        ModelDefinition::MapValue::MapValue() :
+        literal(EL::Value::Null) {}
+
+        ModelDefinition::MapValue::MapValue(const String& i_attribute) :
+        attribute(i_attribute),
+        literal(EL::Value::Null) {}
+
+        ModelDefinition::MapValue::MapValue(const EL::Value& i_literal) :
+        literal(i_literal) {}
+
+        ModelDefinition::Case::Case(const EL::ExpressionBase* i_expression) :
+        conditionType(Condition_Always),
+        numberValue(0.0),
+        resultType(Result_Expression),
+        expression(i_expression) {}
+
         ModelDefinition::ModelDefinition() :
-        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, 0, 0)) {}
+        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, 0, 0)) {
+            compile();
+        }
 
         ModelDefinition::ModelDefinition(const size_t line, const size_t column) :
-        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, line, column)) {}
+        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, line, column)) {
+            compile();
+        }
 
         ModelDefinition::ModelDefinition(const EL::Expression& expression) :
-        m_expression(expression) {}
+        m_expression(expression) {
+            compile();
+        }
 
         void ModelDefinition::append(const ModelDefinition& other) {
             EL::ExpressionBase::List cases;
@@ -93,12 +116,83 @@ namespace TrenchBroom {
             const size_t line = m_expression.line();
             const size_t column = m_expression.column();
             m_expression = EL::SwitchOperator::create(cases, line, column);
+            compile();
         }
 
         ModelSpecification ModelDefinition::modelSpecification(const Model::EntityAttributes& attributes) const {
-            const Model::EntityAttributesVariableStore store(attributes);
-            const EL::EvaluationContext context(store);
-            return convertToModel(m_expression.evaluate(context));
+            static const String NoValue("");
+
+            // consecutive cases usually test the same attribute, so remember the last one that was looked up
+            const String* lastName = nullptr;
+            const String* lastValue = nullptr;
+            const auto conditionValue = [&](const String& name) {
+                if (lastName == nullptr || *lastName != name) {
+                    lastName = &name;
+                    lastValue = attributes.attribute(name);
+                }
+                return lastValue;
+            };
+
+            for (const auto& case_ : m_cases) {
+                switch (case_.conditionType) {
+                    case Condition_Always:
+                        break;
+                    case Condition_AttributeEqualsString: {
+                        const auto* value = conditionValue(case_.attribute);
+                        if ((value != nullptr ? *value : NoValue) != case_.stringValue) {
+                            continue;
+                        }
+                        break;
+                    }
+                    case Condition_AttributeEqualsNumber: {
+                        // converts the attribute value like EL does when comparing a string to a number
+                        const auto* value = conditionValue(case_.attribute);
+                        auto number = 0.0;
+                        if (value != nullptr && !StringUtils::isBlank(*value)) {
+                            const char* begin = value->c_str();
+                            char* end;
+                            number = std::strtod(begin, &end);
+                            if (number == 0.0 && end == begin) {
+                                // not a number, let EL report the error
+                                const auto result = evaluateExpression(case_.expression, attributes);
+                                assert(result == ModelSpecification());
+                                return result;
+                            }
+                        }
+                        const auto diff = number - case_.numberValue;
+                        if (diff < 0.0 || diff > 0.0) {
+                            continue;
+                        }
+                        break;
+                    }
+                    switchDefault()
+                }
+
+                switch (case_.resultType) {
+                    case Result_Specification:
+                        return case_.specification;
+                    case Result_AttributeMap: {
+                        size_t skin, frame;
+                        if (!mapIndex(case_.skin, attributes, skin) || !mapIndex(case_.frame, attributes, frame)) {
+                            // not a plain number, let EL convert it
+                            return evaluateExpression(case_.expression, attributes);
+                        }
+                        return ModelSpecification(mapPath(case_.path, attributes), skin, frame);
+                    }
+                    case Result_Expression: {
+                        const Model::EntityAttributesVariableStore store(attributes);
+                        const EL::EvaluationContext context(store);
+                        const EL::Value result = case_.expression->evaluate(context);
+                        if (!result.undefined()) {
+                            return convertToModel(result);
+                        }
+                        break;
+                    }
+                    switchDefault()
+                }
+            }
+
+            return ModelSpecification();
         }
 
         ModelSpecification ModelDefinition::defaultModelSpecification() const {
@@ -112,6 +206,165 @@ namespace TrenchBroom {
             }
         }
 
+        void ModelDefinition::compile() {
+            m_cases.clear();
+            compileCases(m_expression.root());
+        }
+
+        void ModelDefinition::compileCases(const EL::ExpressionBase* expression) {
+            const auto* cases = expression->switchCases();
+            if (cases != nullptr) {
+                // a nested switch yields the first defined result of its cases, just like its parent, so it can be
+                // flattened into the parent
+                for (const auto* case_ : *cases) {
+                    compileCases(case_);
+                }
+            } else {
+                const auto* literal = expression->literalValue();
+                if (literal == nullptr || !literal->undefined()) {
+                    m_cases.push_back(compileCase(expression));
+                }
+            }
+        }
+
+        ModelDefinition::Case ModelDefinition::compileCase(const EL::ExpressionBase* expression) const {
+            Case result(expression);
+
+            const EL::ExpressionBase* premise = nullptr;
+            const EL::ExpressionBase* conclusion = expression;
+            if (expression->caseOperands(premise, conclusion) && !compileCondition(premise, result)) {
+                return Case(expression);
+            }
+
+            if (!compileResult(conclusion, result)) {
+                return Case(expression);
+            }
+
+            return result;
+        }
+
+        bool ModelDefinition::compileCondition(const EL::ExpressionBase* premise, Case& result) const {
+            const EL::ExpressionBase* leftOperand = nullptr;
+            const EL::ExpressionBase* rightOperand = nullptr;
+            if (!premise->equalityOperands(leftOperand, rightOperand)) {
+                return false;
+            }
+
+            // equality is symmetric, so the attribute may be on either side
+            const auto* attribute = leftOperand->variableName();
+            const auto* literal = rightOperand->literalValue();
+            if (attribute == nullptr || literal == nullptr) {
+                attribute = rightOperand->variableName();
+                literal = leftOperand->literalValue();
+            }
+            if (attribute == nullptr || literal == nullptr) {
+                return false;
+            }
+
+            result.attribute = *attribute;
+            switch (literal->type()) {
+                case EL::Type_String:
+                    result.conditionType = Condition_AttributeEqualsString;
+                    result.stringValue = literal->stringValue();
+                    return true;
+                case EL::Type_Number:
+                    result.conditionType = Condition_AttributeEqualsNumber;
+                    result.numberValue = literal->numberValue();
+                    return true;
+                case EL::Type_Boolean:
+                case EL::Type_Array:
+                case EL::Type_Map:
+                case EL::Type_Range:
+                case EL::Type_Null:
+                case EL::Type_Undefined:
+                    break;
+            }
+            return false;
+        }
+
+        bool ModelDefinition::compileResult(const EL::ExpressionBase* conclusion, Case& result) const {
+            const auto* literal = conclusion->literalValue();
+            if (literal != nullptr) {
+                // an undefined result would make the switch continue with the next case
+                if (literal->undefined()) {
+                    return false;
+                }
+                result.resultType = Result_Specification;
+                result.specification = convertToModel(*literal);
+                return true;
+            }
+
+            const auto* attribute = conclusion->variableName();
+            if (attribute != nullptr) {
+                result.resultType = Result_AttributeMap;
+                result.path = MapValue(*attribute);
+                return true;
+            }
+
+            const auto* elements = conclusion->mapElements();
+            if (elements != nullptr) {
+                for (const auto& entry : *elements) {
+                    const auto& key = entry.first;
+                    if (key == "path" && !compileMapValue(entry.second, result.path)) {
+                        return false;
+                    } else if (key == "skin" && !compileMapValue(entry.second, result.skin)) {
+                        return false;
+                    } else if (key == "frame" && !compileMapValue(entry.second, result.frame)) {
+                        return false;
+                    }
+                }
+                result.resultType = Result_AttributeMap;
+                return true;
+            }
+
+            return false;
+        }
+
+        bool ModelDefinition::compileMapValue(const EL::ExpressionBase* expression, MapValue& result) {
+            const auto* attribute = expression->variableName();
+            if (attribute != nullptr) {
+                result = MapValue(*attribute);
+                return true;
+            }
+
+            const auto* literal = expression->literalValue();
+            if (literal != nullptr) {
+                result = MapValue(*literal);
+                return true;
+            }
+
+            return false;
+        }
+
+        ModelSpecification ModelDefinition::evaluateExpression(const EL::ExpressionBase* expression, const Model::EntityAttributes& attributes) const {
+            const Model::EntityAttributesVariableStore store(attributes);
+            const EL::EvaluationContext context(store);
+            return convertToModel(expression->evaluate(context));
+        }
+
+        IO::Path ModelDefinition::mapPath(const MapValue& value, const Model::EntityAttributes& attributes) const {
+            if (value.attribute.empty()) {
+                return path(value.literal);
+            }
+
+            const auto* attributeValue = attributes.attribute(value.attribute);
+            return attributeValue != nullptr ? path(*attributeValue) : IO::Path("");
+        }
+
+        bool ModelDefinition::mapIndex(const MapValue& value, const Model::EntityAttributes& attributes, size_t& result) const {
+            if (value.attribute.empty()) {
+                result = index(value.literal);
+                return true;
+            }
+
+            const auto* attributeValue = attributes.attribute(value.attribute);
+            if (attributeValue == nullptr) {
+                result = 0;
+                return true;
+            }
+            return index(*attributeValue, result);
+        }
+
         ModelSpecification ModelDefinition::convertToModel(const EL::Value& value) const {
             switch (value.type()) {
                 case EL::Type_Map:
@@ -135,8 +388,11 @@ namespace TrenchBroom {
         IO::Path ModelDefinition::path(const EL::Value& value) const {
             if (value.type() != EL::Type_String)
                 return IO::Path();
-            const String& path = value.stringValue();
-            return IO::Path(StringUtils::isPrefix(path, ":") ? path.substr(1) : path);
+            return path(value.stringValue());
+        }
+
+        IO::Path ModelDefinition::path(const String& value) const {
+            return IO::Path(StringUtils::isPrefix(value, ":") ? value.substr(1) : value);
         }
 
         size_t ModelDefinition::index(const EL::Value& value) const {
@@ -145,5 +401,24 @@ namespace TrenchBroom {
             const EL::IntegerType intValue = value.convertTo(EL::Type_Number).integerValue();
             return static_cast<size_t>(std::max(0l, intValue));
         }
+
+        bool ModelDefinition::index(const String& value, size_t& result) const {
+            // converts the value like EL does, but without creating an EL value
+            if (StringUtils::isBlank(value)) {
+                result = 0;
+                return true;
+            }
+
+            const char* begin = value.c_str();
+            char* end;
+            const auto number = std::strtod(begin, &end);
+            if (end == begin || end != begin + value.size()) {
+                return false;
+            }
+
+            const auto intValue = static_cast<EL::IntegerType>(number);
+            result = static_cast<size_t>(std::max(0l, intValue));
+            return true;
+        }
     }
 }
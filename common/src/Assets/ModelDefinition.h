@@ -25,6 +25,7 @@
 #include "Model/EntityAttributes.h"
 
 #include <iostream>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -47,9 +48,61 @@ namespace TrenchBroom {
 
         std::ostream& operator<<(std::ostream& stream, const ModelSpecification& spec);
 
+        /**
+         The model definition of a point entity. The EL expression is compiled into a list of cases when the
+         definition is created. Each case has a condition that is either always true or compares an attribute value
+         with a literal, and a result that is either a precomputed model specification or is built from attribute
+         values directly. Cases that do not have one of these shapes fall back to evaluating their expression.
+         */
         class ModelDefinition {
         private:
+            enum ConditionType {
+                Condition_Always,
+                Condition_AttributeEqualsString,
+                Condition_AttributeEqualsNumber
+            };
+
+            enum ResultType {
+                Result_Specification,
+                Result_AttributeMap,
+                Result_Expression
+            };
+
+            /**
+             A value of a model map which is either taken from an attribute or given as a literal. Values that are
+             absent from the map are null literals.
+             */
+            struct MapValue {
+                String attribute;
+                EL::Value literal;
+
+                MapValue();
+                explicit MapValue(const String& i_attribute);
+                explicit MapValue(const EL::Value& i_literal);
+            };
+
+            struct Case {
+                ConditionType conditionType;
+                String attribute;
+                String stringValue;
+                EL::NumberType numberValue;
+
+                ResultType resultType;
+                ModelSpecification specification;
+                MapValue path;
+                MapValue skin;
+                MapValue frame;
+
+                // the original case, which is evaluated if the result type is Result_Expression or if the condition
+                // cannot be decided without it
+                const EL::ExpressionBase* expression;
+
+                explicit Case(const EL::ExpressionBase* i_expression);
+            };
+
             EL::Expression m_expression;
+            // points into the expression tree, which is shared by all copies of this definition
+            std::vector<Case> m_cases;
         public:
             ModelDefinition();
             ModelDefinition(size_t line, size_t column);
@@ -60,9 +113,25 @@ namespace TrenchBroom {
             ModelSpecification modelSpecification(const Model::EntityAttributes& attributes) const;
             ModelSpecification defaultModelSpecification() const;
         private:
+            void compile();
+            void compileCases(const EL::ExpressionBase* expression);
+            Case compileCase(const EL::ExpressionBase* expression) const;
+            bool compileCondition(const EL::ExpressionBase* premise, Case& result) const;
+            bool compileResult(const EL::ExpressionBase* conclusion, Case& result) const;
+            static bool compileMapValue(const EL::ExpressionBase* expression, MapValue& result);
+
+            ModelSpecification evaluateExpression(const EL::ExpressionBase* expression, const Model::EntityAttributes& attributes) const;
+            IO::Path mapPath(const MapValue& value, const Model::EntityAttributes& attributes) const;
+            /**
+             Returns false if the value is taken from an attribute whose value is not a plain number.
+             */
+            bool mapIndex(const MapValue& value, const Model::EntityAttributes& attributes, size_t& result) const;
+
             ModelSpecification convertToModel(const EL::Value& value) const;
             IO::Path path(const EL::Value& value) const;
+            IO::Path path(const String& value) const;
             size_t index(const EL::Value& value) const;
+            bool index(const String& value, size_t& result) const;
         };
     }
 }
@@ -20,6 +20,7 @@
 #include "Texture.h"
 #include "Assets/ImageUtils.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureDecodeQueue.h"
 #include "Renderer/GL.h"
 
 #include <cassert>
@@ -120,6 +121,9 @@ namespace TrenchBroom {
         m_textureId(0) {}
 
         Texture::~Texture() {
+            if (m_decodeJob != nullptr) {
+                m_decodeJob->cancel();
+            }
             if (m_collection == nullptr && m_textureId != 0) {
                 glAssert(glDeleteTextures(1, &m_textureId));
             }
@@ -135,6 +139,10 @@ namespace TrenchBroom {
         }
 
         const String& Texture::name() const {
+            return m_name.asString();
+        }
+
+        const TextureName& Texture::internedName() const {
             return m_name;
         }
         
@@ -182,6 +190,7 @@ namespace TrenchBroom {
         
         void Texture::incUsageCount() {
             ++m_usageCount;
+            raiseDecodePriority(TextureDecodePriority::Used);
             if (m_collection != nullptr) {
                 m_collection->incUsageCount();
             }
@@ -203,6 +212,29 @@ namespace TrenchBroom {
             m_overridden = overridden;
         }
         
+        void Texture::setDecodeJob(std::shared_ptr<TextureDecodeJob> decodeJob) {
+            assert(!isPrepared());
+            m_decodeJob = std::move(decodeJob);
+        }
+
+        const std::shared_ptr<TextureDecodeJob>& Texture::decodeJob() const {
+            return m_decodeJob;
+        }
+
+        bool Texture::decodePending() const {
+            return m_decodeJob != nullptr && !m_decodeJob->finished();
+        }
+
+        bool Texture::decodeFinished() const {
+            return m_decodeJob != nullptr && m_decodeJob->finished();
+        }
+
+        void Texture::raiseDecodePriority(const TextureDecodePriority priority) {
+            if (m_decodeJob != nullptr) {
+                m_decodeJob->raisePriority(priority);
+            }
+        }
+
         bool Texture::isPrepared() const {
             return m_textureId != 0;
         }
@@ -211,6 +243,11 @@ namespace TrenchBroom {
             assert(textureId > 0);
             assert(m_textureId == 0);
 
+            if (decodePending()) {
+                return;
+            }
+
+            acquireDecodedData();
             if (!m_buffers.empty()) {
                 glAssert(glPixelStorei(GL_UNPACK_SWAP_BYTES, false));
                 glAssert(glPixelStorei(GL_UNPACK_LSB_FIRST, false));
@@ -333,6 +370,22 @@ namespace TrenchBroom {
             return m_type;
         }
 
+        void Texture::acquireDecodedData() {
+            if (decodeFinished()) {
+                auto decoded = m_decodeJob->takeResult();
+                m_decodeJob.reset();
+
+                // the dimensions were already read from the texture header and may be in use, so we discard textures
+                // that turned out to be corrupt
+                if (decoded != nullptr && decoded->m_width == m_width && decoded->m_height == m_height) {
+                    m_averageColor = decoded->m_averageColor;
+                    m_format = decoded->m_format;
+                    m_type = decoded->m_type;
+                    m_buffers = std::move(decoded->m_buffers);
+                }
+            }
+        }
+
         void Texture::setCollection(TextureCollection* collection) {
             m_collection = collection;
         }
@@ -23,17 +23,20 @@
 #include "ByteBuffer.h"
 #include "Color.h"
 #include "StringUtils.h"
+#include "Assets/TextureName.h"
 #include "Renderer/GL.h"
 
 #include <vecmath/forward.h>
 
 #include <utility>
 #include <cassert>
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
         class TextureCollection;
+        class TextureDecodeJob;
         
         using TextureBuffer = Buffer<unsigned char>;
 
@@ -53,6 +56,16 @@ namespace TrenchBroom {
             CullBoth
         };
 
+        /**
+         * The order in which the pixel data of textures is decoded in the background. Textures with a higher priority
+         * are decoded first.
+         */
+        enum class TextureDecodePriority {
+            Background = 0,
+            Visible = 1,
+            Used = 2
+        };
+
         struct TextureBlendFunc {
             bool enable;
             GLenum srcFactor;
@@ -66,7 +79,7 @@ namespace TrenchBroom {
         class Texture {
         private:
             TextureCollection* m_collection;
-            String m_name;
+            TextureName m_name;
             
             size_t m_width;
             size_t m_height;
@@ -89,6 +102,8 @@ namespace TrenchBroom {
 
             mutable GLuint m_textureId;
             mutable TextureBuffer::List m_buffers;
+
+            std::shared_ptr<TextureDecodeJob> m_decodeJob;
         public:
             Texture(const String& name, size_t width, size_t height, const Color& averageColor, const TextureBuffer& buffer, GLenum format, TextureType type);
             Texture(const String& name, size_t width, size_t height, const Color& averageColor, const TextureBuffer::List& buffers, GLenum format, TextureType type);
@@ -98,6 +113,7 @@ namespace TrenchBroom {
             static TextureType selectTextureType(bool masked);
 
             const String& name() const;
+            const TextureName& internedName() const;
             
             size_t width() const;
             size_t height() const;
@@ -118,7 +134,21 @@ namespace TrenchBroom {
             bool overridden() const;
             void setOverridden(const bool overridden);
 
+            /**
+             * Defers decoding the pixel data of this texture to the given job. The texture can be used right away, but
+             * it can only be prepared once the job has finished.
+             */
+            void setDecodeJob(std::shared_ptr<TextureDecodeJob> decodeJob);
+            const std::shared_ptr<TextureDecodeJob>& decodeJob() const;
+            bool decodePending() const;
+            bool decodeFinished() const;
+            void raiseDecodePriority(TextureDecodePriority priority);
+
             bool isPrepared() const;
+            /**
+             * Uploads the pixel data of this texture. Does nothing if the pixel data is still being decoded; in that
+             * case, call this function again once decodeFinished() returns true.
+             */
             void prepare(GLuint textureId, int minFilter, int magFilter);
             void setMode(int minFilter, int magFilter);
 
@@ -137,6 +167,7 @@ namespace TrenchBroom {
             TextureType type() const;
 
         private:
+            void acquireDecodedData();
             void setCollection(TextureCollection* collection);
             friend class TextureCollection;
         };
@@ -127,6 +127,17 @@ namespace TrenchBroom {
             }
         }
 
+        void TextureCollection::prepareDecodedTextures(const int minFilter, const int magFilter) {
+            assert(prepared());
+
+            for (size_t i = 0; i < textureCount(); ++i) {
+                Texture* texture = m_textures[i];
+                if (texture->decodeFinished()) {
+                    texture->prepare(m_textureIds[i], minFilter, magFilter);
+                }
+            }
+        }
+
         void TextureCollection::setTextureMode(const int minFilter, const int magFilter) {
             for (auto* texture : m_textures) {
                 texture->setMode(minFilter, magFilter);
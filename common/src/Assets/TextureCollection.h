@@ -67,6 +67,10 @@ namespace TrenchBroom {
             
             bool prepared() const;
             void prepare(int minFilter, int magFilter);
+            /**
+             * Uploads the textures whose pixel data was decoded in the background after this collection was prepared.
+             */
+            void prepareDecodedTextures(int minFilter, int magFilter);
             void setTextureMode(int minFilter, int magFilter);
         private:
             void incUsageCount();
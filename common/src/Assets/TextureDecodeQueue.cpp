@@ -0,0 +1,217 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureDecodeQueue.h"
+
+#include "ParallelUtils.h"
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <limits>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TextureDecodeJob::TextureDecodeJob(DecodeFunc decode) :
+        m_decode(std::move(decode)),
+        m_priority(TextureDecodePriority::Background),
+        m_cancelled(false),
+        m_taken(false),
+        m_finished(false) {}
+
+        TextureDecodeJob::~TextureDecodeJob() = default;
+
+        TextureDecodePriority TextureDecodeJob::priority() const {
+            return m_priority;
+        }
+
+        void TextureDecodeJob::raisePriority(const TextureDecodePriority priority) {
+            auto current = m_priority.load();
+            while (current < priority) {
+                if (m_priority.compare_exchange_weak(current, priority)) {
+                    std::lock_guard<std::mutex> lock(m_priorityRaisedMutex);
+                    if (m_priorityRaised) {
+                        m_priorityRaised();
+                    }
+                    return;
+                }
+            }
+        }
+
+        void TextureDecodeJob::setPriorityRaisedFunc(PriorityRaisedFunc priorityRaised) {
+            std::lock_guard<std::mutex> lock(m_priorityRaisedMutex);
+            m_priorityRaised = std::move(priorityRaised);
+        }
+
+        void TextureDecodeJob::cancel() {
+            m_cancelled = true;
+        }
+
+        bool TextureDecodeJob::cancelled() const {
+            return m_cancelled;
+        }
+
+        bool TextureDecodeJob::take() {
+            return !m_taken.exchange(true);
+        }
+
+        bool TextureDecodeJob::finished() const {
+            return m_finished;
+        }
+
+        void TextureDecodeJob::run() {
+            assert(!finished());
+
+            if (!cancelled()) {
+                try {
+                    m_result.reset(m_decode());
+                } catch (const std::exception&) {
+                    // the texture remains without pixel data, just like the placeholders created by the readers
+                    m_result.reset();
+                }
+            }
+
+            // release the file the texture was read from
+            m_decode = nullptr;
+            m_finished = true;
+        }
+
+        std::unique_ptr<Texture> TextureDecodeJob::takeResult() {
+            assert(finished());
+            return std::move(m_result);
+        }
+
+        TextureDecodeQueue::TextureDecodeQueue() :
+        m_raisedJobs(std::make_shared<RaisedJobs>()),
+        m_stop(false),
+        m_finishedCount(0) {}
+
+        TextureDecodeQueue::~TextureDecodeQueue() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+
+            for (auto& worker : m_workers) {
+                worker.join();
+            }
+        }
+
+        void TextureDecodeQueue::enqueue(const JobList& jobs) {
+            if (jobs.empty()) {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_workers.empty()) {
+                    startWorkers();
+                }
+
+                for (const auto& job : jobs) {
+                    std::weak_ptr<RaisedJobs> raisedJobs = m_raisedJobs;
+                    std::weak_ptr<TextureDecodeJob> raisedJob = job;
+                    job->setPriorityRaisedFunc([raisedJobs, raisedJob]() {
+                        if (auto jobs = raisedJobs.lock()) {
+                            std::lock_guard<std::mutex> lock(jobs->mutex);
+                            jobs->jobs.push_back(raisedJob);
+                        }
+                    });
+                    pushJob(job);
+                }
+            }
+            m_condition.notify_all();
+        }
+
+        size_t TextureDecodeQueue::takeFinishedCount() {
+            return m_finishedCount.exchange(0);
+        }
+
+        bool TextureDecodeQueue::hasFinishedJobs() const {
+            return m_finishedCount > 0;
+        }
+
+        void TextureDecodeQueue::startWorkers() {
+            // leave one hardware thread to the UI, but always use at least one worker so that decoding never blocks it
+            const auto hardwareThreads = ParallelUtils::threadCount(std::numeric_limits<size_t>::max());
+            const auto workerCount = std::max(hardwareThreads, size_t(2)) - 1;
+
+            m_workers.reserve(workerCount);
+            for (size_t i = 0; i < workerCount; ++i) {
+                m_workers.emplace_back([this]() { work(); });
+            }
+        }
+
+        void TextureDecodeQueue::work() {
+            while (true) {
+                std::shared_ptr<TextureDecodeJob> job;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stop || hasJobs(); });
+                    if (m_stop) {
+                        return;
+                    }
+                    job = takeNextJob();
+                }
+
+                if (job != nullptr) {
+                    job->run();
+                    if (!job->cancelled()) {
+                        ++m_finishedCount;
+                    }
+                }
+            }
+        }
+
+        bool TextureDecodeQueue::hasJobs() const {
+            return std::any_of(std::begin(m_jobs), std::end(m_jobs), [](const auto& jobs) { return !jobs.empty(); });
+        }
+
+        void TextureDecodeQueue::pushJob(std::shared_ptr<TextureDecodeJob> job) {
+            m_jobs[static_cast<size_t>(job->priority())].push_back(std::move(job));
+        }
+
+        std::shared_ptr<TextureDecodeJob> TextureDecodeQueue::takeNextJob() {
+            std::vector<std::weak_ptr<TextureDecodeJob>> raisedJobs;
+            {
+                std::lock_guard<std::mutex> lock(m_raisedJobs->mutex);
+                raisedJobs.swap(m_raisedJobs->jobs);
+            }
+            for (const auto& raisedJob : raisedJobs) {
+                if (auto job = raisedJob.lock()) {
+                    pushJob(std::move(job));
+                }
+            }
+
+            // among the jobs with the highest priority, the oldest one wins; jobs of deleted textures and jobs that
+            // were taken from another list after their priority was raised are dropped here
+            for (auto jobs = m_jobs.rbegin(); jobs != m_jobs.rend(); ++jobs) {
+                while (!jobs->empty()) {
+                    auto job = std::move(jobs->front());
+                    jobs->pop_front();
+                    if (!job->cancelled() && job->take()) {
+                        return job;
+                    }
+                }
+            }
+            return nullptr;
+        }
+    }
+}
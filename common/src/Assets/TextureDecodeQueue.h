@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_TextureDecodeQueue
+#define TrenchBroom_TextureDecodeQueue
+
+#include "Macros.h"
+#include "Assets/Texture.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        /**
+         * Decodes the pixel data of a texture that was created from its header only. The job is shared between the
+         * texture and the queue that runs it; the texture cancels the job when it is deleted.
+         */
+        class TextureDecodeJob {
+        public:
+            using DecodeFunc = std::function<Texture*()>;
+            using PriorityRaisedFunc = std::function<void()>;
+        private:
+            DecodeFunc m_decode;
+            std::unique_ptr<Texture> m_result;
+            std::atomic<TextureDecodePriority> m_priority;
+            std::atomic<bool> m_cancelled;
+            std::atomic<bool> m_taken;
+            std::atomic<bool> m_finished;
+
+            std::mutex m_priorityRaisedMutex;
+            PriorityRaisedFunc m_priorityRaised;
+        public:
+            explicit TextureDecodeJob(DecodeFunc decode);
+            ~TextureDecodeJob();
+
+            TextureDecodePriority priority() const;
+            void raisePriority(TextureDecodePriority priority);
+
+            /**
+             * Sets the function that is called whenever the priority of this job is raised. Set by the queue that runs
+             * this job so that it can move the job ahead.
+             */
+            void setPriorityRaisedFunc(PriorityRaisedFunc priorityRaised);
+
+            void cancel();
+            bool cancelled() const;
+
+            /**
+             * Marks this job as taken by a worker. Returns false if it was taken already.
+             */
+            bool take();
+            bool finished() const;
+
+            /**
+             * Decodes the texture unless the job was cancelled. Called on a worker thread.
+             */
+            void run();
+
+            /**
+             * Returns the decoded texture, or nullptr if decoding failed. May only be called once the job has finished.
+             */
+            std::unique_ptr<Texture> takeResult();
+
+            deleteCopyAndMove(TextureDecodeJob)
+        };
+
+        /**
+         * Runs texture decode jobs on a pool of worker threads, always picking the job with the highest priority next.
+         *
+         * The jobs are kept in one list per priority. A job whose priority is raised is added to the list of its new
+         * priority and left in its old one, where it is skipped once it has been taken.
+         */
+        class TextureDecodeQueue {
+        public:
+            using JobList = std::vector<std::shared_ptr<TextureDecodeJob>>;
+        private:
+            // the jobs whose priority was raised since the last job was taken; the jobs only hold weak pointers to this so
+            // that jobs which outlive the queue stop reporting to it
+            struct RaisedJobs {
+                std::mutex mutex;
+                std::vector<std::weak_ptr<TextureDecodeJob>> jobs;
+            };
+
+            static constexpr size_t PriorityCount = static_cast<size_t>(TextureDecodePriority::Used) + 1;
+
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::array<std::deque<std::shared_ptr<TextureDecodeJob>>, PriorityCount> m_jobs;
+            std::shared_ptr<RaisedJobs> m_raisedJobs;
+            std::vector<std::thread> m_workers;
+            bool m_stop;
+
+            std::atomic<size_t> m_finishedCount;
+        public:
+            TextureDecodeQueue();
+            ~TextureDecodeQueue();
+
+            void enqueue(const JobList& jobs);
+
+            /**
+             * Returns the number of jobs that have finished since the last call to takeFinishedCount and resets it.
+             */
+            size_t takeFinishedCount();
+            bool hasFinishedJobs() const;
+        private:
+            void startWorkers();
+            void work();
+            bool hasJobs() const;
+            void pushJob(std::shared_ptr<TextureDecodeJob> job);
+            std::shared_ptr<TextureDecodeJob> takeNextJob();
+
+            deleteCopyAndMove(TextureDecodeQueue)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureDecodeQueue) */
@@ -24,6 +24,7 @@
 #include "Logger.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureDecodeQueue.h"
 #include "IO/TextureLoader.h"
 
 #include <algorithm>
@@ -52,6 +53,7 @@ namespace TrenchBroom {
         
         TextureManager::TextureManager(int magFilter, int minFilter, Logger& logger) :
         m_logger(logger),
+        m_decodeQueue(std::make_unique<TextureDecodeQueue>()),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
         m_resetTextureMode(false) {}
@@ -72,6 +74,7 @@ namespace TrenchBroom {
                         auto collection = loader.loadTextureCollection(path);
                         m_logger.info() << "Loaded texture collection '" << path << "'";
                         collection->usageCountDidChange.addObserver(usageCountDidChange);
+                        enqueueDecodeJobs(collection.get());
                         addTextureCollection(collection.release());
                     } catch (const Exception& e) {
                         addTextureCollection(new Assets::TextureCollection(path));
@@ -108,6 +111,16 @@ namespace TrenchBroom {
             m_logger.debug() << "Added texture collection " << collection->path();
         }
 
+        void TextureManager::enqueueDecodeJobs(const Assets::TextureCollection* collection) {
+            TextureDecodeQueue::JobList jobs;
+            for (auto* texture : collection->textures()) {
+                if (texture->decodePending()) {
+                    jobs.push_back(texture->decodeJob());
+                }
+            }
+            m_decodeQueue->enqueue(jobs);
+        }
+
         void TextureManager::clear() {
             VectorUtils::clearAndDelete(m_collections);
             VectorUtils::clearAndDelete(m_toRemove);
@@ -115,6 +128,8 @@ namespace TrenchBroom {
             m_toPrepare.clear();
             m_texturesByName.clear();
             m_textures.clear();
+            m_texturesById.clear();
+            m_nameIndex = TextureNameIndex();
             
             // Remove logging because it might fail when the document is already destroyed.
         }
@@ -130,6 +145,10 @@ namespace TrenchBroom {
             prepare();
             VectorUtils::clearAndDelete(m_toRemove);
         }
+
+        bool TextureManager::hasDecodedTextures() const {
+            return m_decodeQueue->hasFinishedJobs();
+        }
         
         Texture* TextureManager::texture(const String& name) const {
             auto it = m_texturesByName.find(StringUtils::toLower(name));
@@ -139,11 +158,20 @@ namespace TrenchBroom {
                 return it->second;
             }
         }
+
+        Texture* TextureManager::texture(const TextureName& name) const {
+            const auto id = name.caseInsensitiveId();
+            return id < m_texturesById.size() ? m_texturesById[id] : nullptr;
+        }
         
         const TextureList& TextureManager::textures() const {
             return m_textures;
         }
         
+        TextureList TextureManager::findTextures(const String& pattern) const {
+            return m_nameIndex.find(pattern);
+        }
+
         const TextureCollectionList& TextureManager::collections() const {
             return m_collections;
         }
@@ -168,14 +196,26 @@ namespace TrenchBroom {
             std::for_each(std::begin(m_toPrepare), std::end(m_toPrepare),
                           [this](auto collection) { collection->prepare(m_minFilter, m_magFilter); });
             m_toPrepare.clear();
+
+            if (m_decodeQueue->takeFinishedCount() > 0) {
+                for (auto* collection : m_collections) {
+                    if (collection->prepared()) {
+                        collection->prepareDecodedTextures(m_minFilter, m_magFilter);
+                    }
+                }
+            }
         }
         
         void TextureManager::updateTextures() {
             m_texturesByName.clear();
             m_textures.clear();
-            
+            m_texturesById.clear();
+
+            TextureList allTextures;
             for (auto* collection : m_collections) {
                 for (auto* texture : collection->textures()) {
+                    allTextures.push_back(texture);
+
                     const auto key = StringUtils::toLower(texture->name());
                     texture->setOverridden(false);
                     
@@ -190,6 +230,13 @@ namespace TrenchBroom {
             }
 
             m_textures = MapUtils::valueList(m_texturesByName);
+
+            m_texturesById.assign(TextureName::count(), nullptr);
+            for (auto* texture : m_textures) {
+                m_texturesById[texture->internedName().caseInsensitiveId()] = texture;
+            }
+
+            m_nameIndex = TextureNameIndex(allTextures);
         }
     }
 }
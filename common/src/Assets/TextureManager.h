@@ -22,10 +22,12 @@
 
 #include "Notifier.h"
 #include "Assets/AssetTypes.h"
+#include "Assets/TextureNameIndex.h"
 #include "IO/Path.h"
 #include "Model/ModelTypes.h"
 
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -36,6 +38,8 @@ namespace TrenchBroom {
     }
     
     namespace Assets {
+        class TextureDecodeQueue;
+
         class TextureManager {
         private:
             using TextureCollectionMap = std::map<IO::Path, TextureCollection*>;
@@ -43,6 +47,7 @@ namespace TrenchBroom {
             using TextureMap = std::map<String, Texture*>;
             
             Logger& m_logger;
+            std::unique_ptr<TextureDecodeQueue> m_decodeQueue;
             
             TextureCollectionList m_collections;
             
@@ -51,6 +56,10 @@ namespace TrenchBroom {
             
             TextureMap m_texturesByName;
             TextureList m_textures;
+            // indexed by the case insensitive IDs of the texture names
+            TextureList m_texturesById;
+            // all textures of all collections, including overridden ones
+            TextureNameIndex m_nameIndex;
             
             int m_minFilter;
             int m_magFilter;
@@ -65,14 +74,30 @@ namespace TrenchBroom {
         private:
             TextureCollectionMap collectionMap() const;
             void addTextureCollection(Assets::TextureCollection* collection);
+            void enqueueDecodeJobs(const Assets::TextureCollection* collection);
         public:
             void clear();
             
             void setTextureMode(int minFilter, int magFilter);
             void commitChanges();
+            /**
+             * Indicates whether textures were decoded in the background that will be uploaded by the next call to
+             * commitChanges.
+             */
+            bool hasDecodedTextures() const;
             
             Texture* texture(const String& name) const;
+            /**
+             * Finds a texture by its interned name. This is a single array lookup, so prefer this over looking up a
+             * texture by its name string when resolving the textures of many faces.
+             */
+            Texture* texture(const TextureName& name) const;
             const TextureList& textures() const;
+            /**
+             * Returns the textures of all collections whose names contain the given string, ignoring case. This
+             * includes overridden textures.
+             */
+            TextureList findTextures(const String& pattern) const;
             const TextureCollectionList& collections() const;
             const StringList collectionNames() const;
         private:
@@ -0,0 +1,120 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TextureName.h"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace Assets {
+        struct TextureName::Entry {
+            String name;
+            size_t id;
+            size_t caseInsensitiveId;
+        };
+
+        class TextureName::Table {
+        private:
+            // the index keys are views of the names stored in the entries, which never move because entries are
+            // only ever appended to the deque
+            using Index = std::unordered_map<std::string_view, const Entry*>;
+
+            mutable std::shared_mutex m_mutex;
+            std::deque<Entry> m_entries;
+            Index m_index;
+        public:
+            const Entry* intern(const String& name) {
+                {
+                    std::shared_lock<std::shared_mutex> lock(m_mutex);
+                    const auto it = m_index.find(name);
+                    if (it != std::end(m_index)) {
+                        return it->second;
+                    }
+                }
+
+                std::unique_lock<std::shared_mutex> lock(m_mutex);
+                return internLocked(name);
+            }
+
+            size_t count() const {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                return m_entries.size();
+            }
+        private:
+            const Entry* internLocked(const String& name) {
+                // another thread may have added the name while we were waiting for the lock
+                const auto it = m_index.find(name);
+                if (it != std::end(m_index)) {
+                    return it->second;
+                }
+
+                const auto lowerName = StringUtils::toLower(name);
+                const auto caseInsensitiveId = lowerName == name ? m_entries.size() : internLocked(lowerName)->id;
+
+                m_entries.push_back(Entry{ name, m_entries.size(), caseInsensitiveId });
+                const Entry* entry = &m_entries.back();
+                m_index.insert(std::make_pair(std::string_view(entry->name), entry));
+                return entry;
+            }
+        };
+
+        TextureName::TextureName() {
+            static const Entry* empty = table().intern("");
+            m_entry = empty;
+        }
+
+        TextureName::TextureName(const String& name) :
+        m_entry(table().intern(name)) {}
+
+        const String& TextureName::asString() const {
+            return m_entry->name;
+        }
+
+        size_t TextureName::id() const {
+            return m_entry->id;
+        }
+
+        size_t TextureName::caseInsensitiveId() const {
+            return m_entry->caseInsensitiveId;
+        }
+
+        bool TextureName::operator==(const TextureName& other) const {
+            return m_entry == other.m_entry;
+        }
+
+        bool TextureName::operator!=(const TextureName& other) const {
+            return !(*this == other);
+        }
+
+        size_t TextureName::count() {
+            return table().count();
+        }
+
+        TextureName::Table& TextureName::table() {
+            // never destroyed so that names can still be used during static destruction
+            static Table* table = new Table();
+            return *table;
+        }
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_TextureName
+#define TrenchBroom_TextureName
+
+#include "StringUtils.h"
+
+#include <cstddef>
+
+namespace TrenchBroom {
+    namespace Assets {
+        /**
+         * A texture name that is interned in a global table. All texture names with the same spelling share a single
+         * table entry, so a texture name is as cheap to copy and compare as a pointer, and every name has a stable
+         * numeric ID that can be used to index arrays.
+         *
+         * Since texture names are case insensitive, every name also knows the ID of its lower case spelling. Names
+         * are never removed from the table, which is fine because a map uses only a small number of distinct
+         * textures. The table is thread safe.
+         */
+        class TextureName {
+        private:
+            struct Entry;
+            class Table;
+
+            const Entry* m_entry;
+        public:
+            /**
+             * Creates the empty texture name.
+             */
+            TextureName();
+            explicit TextureName(const String& name);
+
+            const String& asString() const;
+
+            /**
+             * Returns the ID of this name. IDs are assigned consecutively starting at 0.
+             */
+            size_t id() const;
+
+            /**
+             * Returns the ID of the lower case spelling of this name. Two names that differ only in case have the
+             * same case insensitive ID.
+             */
+            size_t caseInsensitiveId() const;
+
+            bool operator==(const TextureName& other) const;
+            bool operator!=(const TextureName& other) const;
+
+            /**
+             * Returns the number of names in the table, which is one more than the largest ID that was handed out.
+             */
+            static size_t count();
+        private:
+            static Table& table();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureName) */
@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "TextureNameIndex.h"
+
+#include "Assets/Texture.h"
+
+namespace TrenchBroom {
+    namespace Assets {
+        TextureNameIndex::TextureNameIndex() = default;
+
+        TextureNameIndex::TextureNameIndex(const TextureList& textures) :
+        m_textures(textures) {
+            m_names.reserve(m_textures.size());
+            for (size_t i = 0; i < m_textures.size(); ++i) {
+                m_names.push_back(StringUtils::toLower(m_textures[i]->name()));
+
+                const String& name = m_names.back();
+                for (size_t j = 0; j + 3 <= name.size(); ++j) {
+                    auto& indices = m_trigrams[trigram(name, j)];
+                    // a name may contain the same trigram several times
+                    if (indices.empty() || indices.back() != i) {
+                        indices.push_back(i);
+                    }
+                }
+            }
+        }
+
+        TextureList TextureNameIndex::find(const String& pattern) const {
+            if (pattern.empty()) {
+                return m_textures;
+            }
+
+            const String lowerPattern = StringUtils::toLower(pattern);
+            TextureList result;
+
+            if (lowerPattern.size() < 3) {
+                for (size_t i = 0; i < m_names.size(); ++i) {
+                    if (m_names[i].find(lowerPattern) != String::npos) {
+                        result.push_back(m_textures[i]);
+                    }
+                }
+                return result;
+            }
+
+            const IndexList* candidates = nullptr;
+            for (size_t j = 0; j + 3 <= lowerPattern.size(); ++j) {
+                const auto it = m_trigrams.find(trigram(lowerPattern, j));
+                if (it == std::end(m_trigrams)) {
+                    return result;
+                }
+                if (candidates == nullptr || it->second.size() < candidates->size()) {
+                    candidates = &it->second;
+                }
+            }
+
+            for (const size_t i : *candidates) {
+                if (m_names[i].find(lowerPattern) != String::npos) {
+                    result.push_back(m_textures[i]);
+                }
+            }
+            return result;
+        }
+
+        TextureNameIndex::Trigram TextureNameIndex::trigram(const String& str, const size_t offset) {
+            return (static_cast<Trigram>(static_cast<unsigned char>(str[offset    ])) << 16) |
+                   (static_cast<Trigram>(static_cast<unsigned char>(str[offset + 1])) <<  8) |
+                   (static_cast<Trigram>(static_cast<unsigned char>(str[offset + 2])));
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_TextureNameIndex
+#define TrenchBroom_TextureNameIndex
+
+#include "StringUtils.h"
+#include "Assets/AssetTypes.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        /**
+         * Finds the textures whose names contain a given string, ignoring case.
+         *
+         * The index maps every sequence of three consecutive characters (trigram) of the lower case texture names to
+         * the textures whose names contain it. A query only checks the textures that contain the least common
+         * trigram of the query string. Query strings with fewer than three characters are matched against all
+         * names, which is still cheaper than a plain scan because the lower case names are precomputed.
+         */
+        class TextureNameIndex {
+        private:
+            using Trigram = uint32_t;
+            using IndexList = std::vector<size_t>;
+
+            TextureList m_textures;
+            StringList m_names;
+            std::unordered_map<Trigram, IndexList> m_trigrams;
+        public:
+            TextureNameIndex();
+            explicit TextureNameIndex(const TextureList& textures);
+
+            /**
+             * Returns the textures whose names contain the given string, ignoring case, in the order in which they
+             * were given to the constructor. If the given string is empty, all textures are returned.
+             */
+            TextureList find(const String& pattern) const;
+        private:
+            static Trigram trigram(const String& str, size_t offset);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_TextureNameIndex) */
@@ -46,6 +46,10 @@ namespace TrenchBroom {
             return m_expression->clone();
         }
 
+        const ExpressionBase* Expression::root() const {
+            return m_expression.get();
+        }
+
         size_t Expression::line() const {
             return m_expression->m_line;
         }
@@ -92,6 +96,30 @@ namespace TrenchBroom {
             return doEvaluate(context);
         }
         
+        const Value* ExpressionBase::literalValue() const {
+            return doGetLiteralValue();
+        }
+
+        const String* ExpressionBase::variableName() const {
+            return doGetVariableName();
+        }
+
+        const ExpressionBase::Map* ExpressionBase::mapElements() const {
+            return doGetMapElements();
+        }
+
+        const ExpressionBase::List* ExpressionBase::switchCases() const {
+            return doGetSwitchCases();
+        }
+
+        bool ExpressionBase::caseOperands(const ExpressionBase*& premise, const ExpressionBase*& conclusion) const {
+            return doGetCaseOperands(premise, conclusion);
+        }
+
+        bool ExpressionBase::equalityOperands(const ExpressionBase*& leftOperand, const ExpressionBase*& rightOperand) const {
+            return doGetEqualityOperands(leftOperand, rightOperand);
+        }
+
         String ExpressionBase::asString() const {
             StringStream result;
             appendToStream(result);
@@ -114,6 +142,30 @@ namespace TrenchBroom {
         ExpressionBase* ExpressionBase::doReorderByPrecedence(BinaryOperator* parent) {
             return parent;
         }
+
+        const Value* ExpressionBase::doGetLiteralValue() const {
+            return nullptr;
+        }
+
+        const String* ExpressionBase::doGetVariableName() const {
+            return nullptr;
+        }
+
+        const ExpressionBase::Map* ExpressionBase::doGetMapElements() const {
+            return nullptr;
+        }
+
+        const ExpressionBase::List* ExpressionBase::doGetSwitchCases() const {
+            return nullptr;
+        }
+
+        bool ExpressionBase::doGetCaseOperands(const ExpressionBase*& /* premise */, const ExpressionBase*& /* conclusion */) const {
+            return false;
+        }
+
+        bool ExpressionBase::doGetEqualityOperands(const ExpressionBase*& /* leftOperand */, const ExpressionBase*& /* rightOperand */) const {
+            return false;
+        }
         
         LiteralExpression::LiteralExpression(const Value& value, const size_t line, const size_t column) :
         ExpressionBase(line, column),
@@ -139,6 +191,10 @@ namespace TrenchBroom {
             m_value.appendToStream(str, false);
         }
 
+        const Value* LiteralExpression::doGetLiteralValue() const {
+            return &m_value;
+        }
+
         VariableExpression::VariableExpression(const String& variableName, const size_t line, const size_t column) :
         ExpressionBase(line, column),
         m_variableName(variableName) {}
@@ -163,6 +219,10 @@ namespace TrenchBroom {
             str << m_variableName;
         }
 
+        const String* VariableExpression::doGetVariableName() const {
+            return &m_variableName;
+        }
+
         ArrayExpression::ArrayExpression(const ExpressionBase::List& elements, const size_t line, const size_t column) :
         ExpressionBase(line, column),
         m_elements(elements) {}
@@ -295,6 +355,10 @@ namespace TrenchBroom {
             str << " }";
         }
 
+        const ExpressionBase::Map* MapExpression::doGetMapElements() const {
+            return &m_elements;
+        }
+
         UnaryOperator::UnaryOperator(ExpressionBase* operand, const size_t line, const size_t column) :
         ExpressionBase(line, column),
         m_operand(operand) {
@@ -926,6 +990,15 @@ namespace TrenchBroom {
                     switchDefault()
             }
         }
+
+        bool ComparisonOperator::doGetEqualityOperands(const ExpressionBase*& leftOperand, const ExpressionBase*& rightOperand) const {
+            if (m_op != Op_Equal) {
+                return false;
+            }
+            leftOperand = m_leftOperand;
+            rightOperand = m_rightOperand;
+            return true;
+        }
         
         RangeOperator::RangeOperator(ExpressionBase* leftOperand, ExpressionBase* rightOperand, const size_t line, const size_t column) :
         BinaryOperator(leftOperand, rightOperand, line, column) {}
@@ -1006,6 +1079,12 @@ namespace TrenchBroom {
             return Traits(0, false, false);
         }
 
+        bool CaseOperator::doGetCaseOperands(const ExpressionBase*& premise, const ExpressionBase*& conclusion) const {
+            premise = m_leftOperand;
+            conclusion = m_rightOperand;
+            return true;
+        }
+
         SwitchOperator::SwitchOperator(const ExpressionBase::List& cases, size_t line, size_t column) :
         ExpressionBase(line, column),
         m_cases(cases) {}
@@ -1062,5 +1141,9 @@ namespace TrenchBroom {
             }
             str << " }}";
         }
+
+        const ExpressionBase::List* SwitchOperator::doGetSwitchCases() const {
+            return &m_cases;
+        }
     }
 }
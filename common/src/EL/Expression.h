@@ -42,6 +42,7 @@ namespace TrenchBroom {
             bool optimize();
             Value evaluate(const EvaluationContext& context) const;
             ExpressionBase* clone() const;
+            const ExpressionBase* root() const;
             
             size_t line() const;
             size_t column() const;
@@ -73,6 +74,17 @@ namespace TrenchBroom {
             ExpressionBase* clone() const;
             ExpressionBase* optimize();
             Value evaluate(const EvaluationContext& context) const;
+
+            /*
+             * The following functions allow clients to recognize common shapes of expressions and to translate them
+             * into specialized representations. Each returns null or false if this expression is of a different kind.
+             */
+            const Value* literalValue() const;
+            const String* variableName() const;
+            const Map* mapElements() const;
+            const List* switchCases() const;
+            bool caseOperands(const ExpressionBase*& premise, const ExpressionBase*& conclusion) const;
+            bool equalityOperands(const ExpressionBase*& leftOperand, const ExpressionBase*& rightOperand) const;
             
             String asString() const;
             void appendToStream(std::ostream& str) const;
@@ -84,6 +96,13 @@ namespace TrenchBroom {
             virtual ExpressionBase* doOptimize() = 0;
             virtual Value doEvaluate(const EvaluationContext& context) const = 0;
             virtual void doAppendToStream(std::ostream& str) const = 0;
+
+            virtual const Value* doGetLiteralValue() const;
+            virtual const String* doGetVariableName() const;
+            virtual const Map* doGetMapElements() const;
+            virtual const List* doGetSwitchCases() const;
+            virtual bool doGetCaseOperands(const ExpressionBase*& premise, const ExpressionBase*& conclusion) const;
+            virtual bool doGetEqualityOperands(const ExpressionBase*& leftOperand, const ExpressionBase*& rightOperand) const;
             
             deleteCopyAndMove(ExpressionBase)
         };
@@ -100,6 +119,7 @@ namespace TrenchBroom {
             ExpressionBase* doOptimize() override;
             Value doEvaluate(const EvaluationContext& context) const override;
             void doAppendToStream(std::ostream& str) const override;
+            const Value* doGetLiteralValue() const override;
             
             deleteCopyAndMove(LiteralExpression)
         };
@@ -116,6 +136,7 @@ namespace TrenchBroom {
             ExpressionBase* doOptimize() override;
             Value doEvaluate(const EvaluationContext& context) const override;
             void doAppendToStream(std::ostream& str) const override;
+            const String* doGetVariableName() const override;
             
             deleteCopyAndMove(VariableExpression)
         };
@@ -150,6 +171,7 @@ namespace TrenchBroom {
             ExpressionBase* doOptimize() override;
             Value doEvaluate(const EvaluationContext& context) const override;
             void doAppendToStream(std::ostream& str) const override;
+            const Map* doGetMapElements() const override;
             
             deleteCopyAndMove(MapExpression)
         };
@@ -472,6 +494,7 @@ namespace TrenchBroom {
             Value doEvaluate(const EvaluationContext& context) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
+            bool doGetEqualityOperands(const ExpressionBase*& leftOperand, const ExpressionBase*& rightOperand) const override;
             
             deleteCopyAndMove(ComparisonOperator)
         };
@@ -504,6 +527,7 @@ namespace TrenchBroom {
             Value doEvaluate(const EvaluationContext& context) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
+            bool doGetCaseOperands(const ExpressionBase*& premise, const ExpressionBase*& conclusion) const override;
             
             deleteCopyAndMove(CaseOperator)
         };
@@ -522,6 +546,7 @@ namespace TrenchBroom {
             ExpressionBase* doOptimize() override;
             void doAppendToStream(std::ostream& str) const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            const List* doGetSwitchCases() const override;
             
             deleteCopyAndMove(SwitchOperator)
         };
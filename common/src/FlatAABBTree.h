@@ -0,0 +1,573 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_FLATAABBTREE_H
+#define TRENCHBROOM_FLATAABBTREE_H
+
+#include "NodeTree.h"
+#include "Exceptions.h"
+#include "SurfaceAreaHeuristic.h"
+#include <vecmath/scalar.h>
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/intersection.h>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <vector>
+
+/**
+ * An AABB tree that stores its nodes in arrays instead of allocating each node separately. Nodes refer to their
+ * parent and children by index, and the bounds of all nodes are stored contiguously so that queries touch as little
+ * memory as possible. Queries traverse the tree iteratively using an explicit stack.
+ *
+ * The tree has the same structure as AABBTree, i.e., inserting the same objects in the same order into both trees
+ * yields identical trees.
+ */
+template <typename T, size_t S, typename U, typename Cmp = std::less<U>>
+class FlatAABBTree : public NodeTree<T,S,U,Cmp> {
+public:
+    using List = typename NodeTree<T,S,U,Cmp>::List;
+    using Array = typename NodeTree<T,S,U,Cmp>::Array;
+    using Box = typename NodeTree<T,S,U,Cmp>::Box;
+    using DataType = typename NodeTree<T,S,U,Cmp>::DataType;
+    using FloatType = typename NodeTree<T,S,U,Cmp>::FloatType;
+    using GetBounds = typename NodeTree<T,S,U,Cmp>::GetBounds;
+private:
+    static constexpr size_t NoIndex = std::numeric_limits<size_t>::max();
+
+    /**
+     * The structure of a node. A node is a leaf if it has no children, and leafs carry data. The height of a leaf is
+     * 1, and the height of an inner node is the maximum of the heights of its children plus one.
+     */
+    struct Node {
+        size_t parent;
+        size_t left;
+        size_t right;
+        size_t height;
+
+        bool leaf() const {
+            return left == NoIndex;
+        }
+    };
+
+    /**
+     * A leaf to build a subtree from, together with the center of its bounds.
+     */
+    struct BuildEntry {
+        Box bounds;
+        vm::vec<T,S> center;
+        U data;
+    };
+
+    using BuildIterator = typename std::vector<BuildEntry>::iterator;
+
+    // all of these are indexed by node index
+    std::vector<Box> m_bounds;
+    std::vector<Node> m_nodes;
+    std::vector<U> m_data;
+
+    // indices of nodes that were removed and can be reused
+    std::vector<size_t> m_freeNodes;
+    size_t m_root;
+public:
+    FlatAABBTree() : m_root(NoIndex) {}
+
+    bool contains(const Box& bounds, const U& data) const override {
+        check(bounds, data);
+        return find(bounds, data, true) != NoIndex;
+    }
+
+    void clearAndBuild(const List& objects, const GetBounds& getBounds) override {
+        build(std::begin(objects), std::end(objects), getBounds);
+    }
+
+    void clearAndBuild(const Array& objects, const GetBounds& getBounds) override {
+        build(std::begin(objects), std::end(objects), getBounds);
+    }
+
+    void insert(const Box& bounds, const U& data) override {
+        check(bounds, data);
+
+        const auto leaf = createNode(bounds, NoIndex, NoIndex, data);
+        if (empty()) {
+            m_root = leaf;
+            return;
+        }
+
+        // descend into the subtree which is increased the least by inserting a node with the given bounds
+        auto sibling = m_root;
+        while (!m_nodes[sibling].leaf()) {
+            sibling = selectLeastIncreaser(m_nodes[sibling].left, m_nodes[sibling].right, bounds);
+        }
+
+        // replace the leaf we found by a new inner node that has the found leaf as its left child and the new leaf as
+        // its right child
+        const auto parent = m_nodes[sibling].parent;
+        const auto inner = createNode(merge(m_bounds[sibling], bounds), sibling, leaf, U());
+        replaceChild(parent, sibling, inner);
+        m_nodes[inner].parent = parent;
+        m_nodes[sibling].parent = inner;
+        m_nodes[leaf].parent = inner;
+
+        refit(parent);
+    }
+
+    bool remove(const Box& bounds, const U& data) override {
+        check(bounds, data);
+
+        const auto leaf = find(bounds, data, false);
+        if (leaf == NoIndex) {
+            return false;
+        }
+
+        const auto parent = m_nodes[leaf].parent;
+        destroyNode(leaf);
+
+        if (parent == NoIndex) {
+            m_root = NoIndex;
+        } else {
+            // replace the parent by the sibling of the removed leaf
+            const auto sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+            const auto grandParent = m_nodes[parent].parent;
+            replaceChild(grandParent, parent, sibling);
+            m_nodes[sibling].parent = grandParent;
+            destroyNode(parent);
+
+            refit(grandParent);
+        }
+        return true;
+    }
+
+    void update(const Box& oldBounds, const Box& newBounds, const U& data) override {
+        check(oldBounds, data);
+        check(newBounds, data);
+
+        if (!remove(oldBounds, data)) {
+            NodeTreeException ex;
+            ex << "AABB node not found with oldBounds [ ( " << oldBounds.min << " ) ( " << oldBounds.max << " ) ]: " << data;
+            throw ex;
+        }
+        insert(newBounds, data);
+    }
+
+    void clear() override {
+        m_bounds.clear();
+        m_nodes.clear();
+        m_data.clear();
+        m_freeNodes.clear();
+        m_root = NoIndex;
+    }
+
+    bool empty() const override {
+        return m_root == NoIndex;
+    }
+
+    const Box& bounds() const override {
+        static const auto EmptyBox = Box(vm::vec<T,S>::NaN, vm::vec<T,S>::NaN);
+
+        assert(!empty());
+        if (empty()) {
+            return EmptyBox;
+        } else {
+            return m_bounds[m_root];
+        }
+    }
+
+    size_t height() const override {
+        return empty() ? 0 : m_nodes[m_root].height;
+    }
+
+    List findIntersectors(const vm::ray<T,S>& ray) const override {
+        List result;
+        findIntersectors(ray, std::back_inserter(result));
+        return result;
+    }
+
+    /**
+     * Finds every data item in this tree whose bounding box intersects with the given ray and appends it to the given
+     * output iterator.
+     *
+     * @tparam O the output iterator type
+     * @param ray the ray to test
+     * @param out the output iterator to append to
+     */
+    template <typename O>
+    void findIntersectors(const vm::ray<T,S>& ray, O out) const {
+        traverse([&](const Box& bounds) {
+            return bounds.contains(ray.origin) || !vm::isnan(intersect(ray, bounds));
+        }, out);
+    }
+
+    /**
+     * Visits every data item in this tree whose bounding box intersects with the given ray, ordered by the distance at
+     * which the ray enters the bounding box. The visitor is called with the data item and that distance, which is 0 if
+     * the box contains the ray origin. It returns true to continue and false to stop the traversal, e.g. because no
+     * item at a greater distance can affect the result anymore.
+     *
+     * @tparam V the visitor type
+     * @param ray the ray to test
+     * @param visitor the visitor to call
+     */
+    template <typename V>
+    void findIntersectorsNearestFirst(const vm::ray<T,S>& ray, const V& visitor) const {
+        if (empty()) {
+            return;
+        }
+
+        // a min heap of nodes ordered by entry distance
+        using Entry = std::pair<T, size_t>;
+        const auto compare = [](const Entry& lhs, const Entry& rhs) { return lhs.first > rhs.first; };
+
+        std::vector<Entry> heap;
+        heap.reserve(2 * height());
+
+        const auto pushNode = [&](const size_t index) {
+            const auto distance = entryDistance(ray, m_bounds[index]);
+            if (!vm::isnan(distance)) {
+                heap.emplace_back(distance, index);
+                std::push_heap(std::begin(heap), std::end(heap), compare);
+            }
+        };
+
+        pushNode(m_root);
+        while (!heap.empty()) {
+            std::pop_heap(std::begin(heap), std::end(heap), compare);
+            const auto [distance, index] = heap.back();
+            heap.pop_back();
+
+            const auto& node = m_nodes[index];
+            if (node.leaf()) {
+                if (!visitor(m_data[index], distance)) {
+                    return;
+                }
+            } else {
+                pushNode(node.left);
+                pushNode(node.right);
+            }
+        }
+    }
+
+    List findIntersectors(const Box& bounds) const override {
+        List result;
+        findIntersectors(bounds, std::back_inserter(result));
+        return result;
+    }
+
+    /**
+     * Finds every data item in this tree whose bounding box intersects with the given box and appends it to the given
+     * output iterator.
+     *
+     * @tparam O the output iterator type
+     * @param bounds the box to test
+     * @param out the output iterator to append to
+     */
+    template <typename O>
+    void findIntersectors(const Box& bounds, O out) const {
+        traverse([&](const Box& nodeBounds) {
+            return nodeBounds.intersects(bounds);
+        }, out);
+    }
+
+    List findContainers(const vm::vec<T,S>& point) const override {
+        List result;
+        findContainers(point, std::back_inserter(result));
+        return result;
+    }
+
+    /**
+     * Finds every data item in this tree whose bounding box contains the given point and appends it to the given
+     * output iterator.
+     *
+     * @tparam O the output iterator type
+     * @param point the point to test
+     * @param out the output iterator to append to
+     */
+    template <typename O>
+    void findContainers(const vm::vec<T,S>& point, O out) const {
+        traverse([&](const Box& bounds) {
+            return bounds.contains(point);
+        }, out);
+    }
+
+    /**
+     * Prints a textual representation of this tree to the given output stream. The format is the same as that of
+     * AABBTree::print.
+     *
+     * @param str the output stream to print to
+     */
+    void print(std::ostream& str = std::cout) const {
+        if (empty()) {
+            return;
+        }
+
+        std::vector<std::pair<size_t, size_t>> stack;
+        stack.emplace_back(m_root, 0);
+        while (!stack.empty()) {
+            const auto [index, level] = stack.back();
+            stack.pop_back();
+
+            for (size_t i = 0; i < level; ++i) {
+                str << "  ";
+            }
+
+            const auto& bounds = m_bounds[index];
+            const auto& node = m_nodes[index];
+            if (node.leaf()) {
+                str << "L [ ( " << bounds.min << " ) ( " << bounds.max  << " ) ]: " << m_data[index] << std::endl;
+            } else {
+                str << "O [ ( " << bounds.min << " ) ( " << bounds.max  << " ) ]" << std::endl;
+                stack.emplace_back(node.right, level + 1);
+                stack.emplace_back(node.left, level + 1);
+            }
+        }
+    }
+private:
+    void check(const Box& bounds, const U& data) const {
+        if (vm::isNaN(bounds.min) || vm::isNaN(bounds.max)) {
+            NodeTreeException ex;
+            ex << "Cannot add node to AABB with invalid bounds [ ( " << bounds.min << " ) ( " << bounds.max << " ) ]: " << data;
+            throw ex;
+        }
+    }
+
+    /**
+     * Returns the distance at which the given ray enters the given bounds, 0 if the bounds contain the ray origin, or
+     * NaN if the ray misses the bounds.
+     */
+    static T entryDistance(const vm::ray<T,S>& ray, const Box& bounds) {
+        if (bounds.contains(ray.origin)) {
+            return static_cast<T>(0.0);
+        } else {
+            return intersect(ray, bounds);
+        }
+    }
+
+    /**
+     * Visits every node whose bounds pass the given test, and appends the data of every such leaf to the given output
+     * iterator. The children of an inner node are only visited if its bounds pass the test.
+     */
+    template <typename P, typename O>
+    void traverse(const P& test, O out) const {
+        if (empty()) {
+            return;
+        }
+
+        std::vector<size_t> stack;
+        stack.reserve(height());
+        stack.push_back(m_root);
+
+        while (!stack.empty()) {
+            const auto index = stack.back();
+            stack.pop_back();
+
+            if (test(m_bounds[index])) {
+                const auto& node = m_nodes[index];
+                if (node.leaf()) {
+                    out = m_data[index];
+                    ++out;
+                } else {
+                    stack.push_back(node.right);
+                    stack.push_back(node.left);
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns the index of the leaf with the given data, or NoIndex if no such leaf exists. Only subtrees whose bounds
+     * contain the given bounds are searched. If matchBounds is true, the leaf must also have the given bounds.
+     */
+    size_t find(const Box& bounds, const U& data, const bool matchBounds) const {
+        if (empty()) {
+            return NoIndex;
+        }
+
+        std::vector<size_t> stack;
+        stack.reserve(height());
+        stack.push_back(m_root);
+
+        while (!stack.empty()) {
+            const auto index = stack.back();
+            stack.pop_back();
+
+            const auto& node = m_nodes[index];
+            if (node.leaf()) {
+                if ((!matchBounds || m_bounds[index] == bounds) && hasData(index, data)) {
+                    return index;
+                }
+            } else if (m_bounds[index].contains(bounds)) {
+                stack.push_back(node.right);
+                stack.push_back(node.left);
+            }
+        }
+        return NoIndex;
+    }
+
+    /**
+     * Checks whether the data of the given leaf equals the given data. The data are considered equal if and only if
+     * !(data < leafData) && !(leafData < data) where < is implemented by the comparison operator Cmp.
+     */
+    bool hasData(const size_t index, const U& data) const {
+        static const Cmp cmp;
+        return !cmp(data, m_data[index]) && !cmp(m_data[index], data);
+    }
+
+    /**
+     * Selects one of the two given nodes such that it increases the given bounds the least. Ties are resolved in the
+     * same way as in AABBTree.
+     */
+    size_t selectLeastIncreaser(const size_t node1, const size_t node2, const Box& bounds) const {
+        const auto& bounds1 = m_bounds[node1];
+        const auto& bounds2 = m_bounds[node2];
+        const auto vol1 = bounds1.volume();
+        const auto vol2 = bounds2.volume();
+        const auto diff1 = merge(bounds1, bounds).volume() - vol1;
+        const auto diff2 = merge(bounds2, bounds).volume() - vol2;
+        const auto height1 = m_nodes[node1].height;
+        const auto height2 = m_nodes[node2].height;
+
+        if (diff1 < diff2) {
+            return node1;
+        } else if (diff2 < diff1) {
+            return node2;
+        } else if (height1 < height2) {
+            return node1;
+        } else if (height2 < height1) {
+            return node2;
+        } else if (vol1 < vol2) {
+            return node1;
+        } else if (vol2 < vol1) {
+            return node2;
+        } else {
+            return node1;
+        }
+    }
+
+    /**
+     * Updates the bounds and heights of the given node and all of its ancestors.
+     */
+    void refit(size_t index) {
+        while (index != NoIndex) {
+            auto& node = m_nodes[index];
+            m_bounds[index] = merge(m_bounds[node.left], m_bounds[node.right]);
+            node.height = std::max(m_nodes[node.left].height, m_nodes[node.right].height) + 1;
+            index = node.parent;
+        }
+    }
+
+    /**
+     * Replaces the given child of the given parent, or the root if the parent is NoIndex.
+     */
+    void replaceChild(const size_t parent, const size_t oldChild, const size_t newChild) {
+        if (parent == NoIndex) {
+            assert(m_root == oldChild);
+            m_root = newChild;
+        } else if (m_nodes[parent].left == oldChild) {
+            m_nodes[parent].left = newChild;
+        } else {
+            assert(m_nodes[parent].right == oldChild);
+            m_nodes[parent].right = newChild;
+        }
+    }
+
+    /**
+     * Creates a new node and returns its index. If both children are given, the new node is an inner node whose
+     * height is computed from its children, otherwise it is a leaf.
+     */
+    size_t createNode(const Box& bounds, const size_t left, const size_t right, const U& data) {
+        const auto height = left == NoIndex ? size_t(1) : std::max(m_nodes[left].height, m_nodes[right].height) + 1;
+        const auto node = Node{ NoIndex, left, right, height };
+
+        if (!m_freeNodes.empty()) {
+            const auto index = m_freeNodes.back();
+            m_freeNodes.pop_back();
+            m_bounds[index] = bounds;
+            m_nodes[index] = node;
+            m_data[index] = data;
+            return index;
+        } else {
+            m_bounds.push_back(bounds);
+            m_nodes.push_back(node);
+            m_data.push_back(data);
+            return m_nodes.size() - 1;
+        }
+    }
+
+    void destroyNode(const size_t index) {
+        m_data[index] = U();
+        m_freeNodes.push_back(index);
+    }
+
+    template <typename I>
+    void build(I cur, I end, const GetBounds& getBounds) {
+        clear();
+
+        std::vector<BuildEntry> entries;
+        entries.reserve(static_cast<size_t>(std::distance(cur, end)));
+        while (cur != end) {
+            const auto bounds = getBounds(*cur);
+            check(bounds, *cur);
+            entries.push_back(BuildEntry{ bounds, bounds.center(), *cur });
+            ++cur;
+        }
+
+        if (!entries.empty()) {
+            m_bounds.reserve(2 * entries.size() - 1);
+            m_nodes.reserve(2 * entries.size() - 1);
+            m_data.reserve(2 * entries.size() - 1);
+            m_root = build(std::begin(entries), std::end(entries));
+        }
+    }
+
+    /**
+     * Builds a subtree from the given leafs using the surface area heuristic and returns the index of its root. The
+     * nodes are laid out in depth first order so that a parent is close to its left child in memory.
+     */
+    size_t build(const BuildIterator begin, const BuildIterator end) {
+        assert(begin != end);
+        if (std::next(begin) == end) {
+            return createNode(begin->bounds, NoIndex, NoIndex, begin->data);
+        }
+
+        const auto middle = SurfaceAreaHeuristic::partition<T,S>(begin, end,
+            [](const BuildEntry& entry) -> const Box& { return entry.bounds; },
+            [](const BuildEntry& entry) -> const vm::vec<T,S>& { return entry.center; });
+
+        // reserve the parent's slot before building the children
+        const auto index = createNode(Box(), NoIndex, NoIndex, U());
+        const auto left = build(begin, middle);
+        const auto right = build(middle, end);
+
+        m_nodes[index].left = left;
+        m_nodes[index].right = right;
+        m_nodes[left].parent = index;
+        m_nodes[right].parent = index;
+        m_bounds[index] = merge(m_bounds[left], m_bounds[right]);
+        m_nodes[index].height = std::max(m_nodes[left].height, m_nodes[right].height) + 1;
+        return index;
+    }
+};
+
+#endif //TRENCHBROOM_FLATAABBTREE_H
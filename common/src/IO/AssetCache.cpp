@@ -0,0 +1,216 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AssetCache.h"
+
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        static const uint64_t FnvOffsetBasis = 14695981039346656037ULL;
+        static const uint64_t FnvPrime = 1099511628211ULL;
+
+        static uint64_t fnv1a(uint64_t hash, const char* begin, const char* end) {
+            for (const char* cur = begin; cur != end; ++cur) {
+                hash ^= static_cast<unsigned char>(*cur);
+                hash *= FnvPrime;
+            }
+            return hash;
+        }
+
+        static String toHex(const uint64_t value) {
+            char buffer[17];
+            std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+            return buffer;
+        }
+
+        static std::time_t modificationTime(const MappedFile& file) {
+            if (!file.path().isAbsolute()) {
+                return -1;
+            }
+
+            try {
+                return Disk::fileModificationTime(file.path());
+            } catch (const FileSystemException&) {
+                return -1;
+            }
+        }
+
+        const size_t AssetCache::DefaultMaxSize = 512u * 1024u * 1024u;
+
+        AssetCache::AssetCache(const Path& directory, const size_t maxSize) :
+        m_directory(directory),
+        m_maxSize(maxSize) {}
+
+        bool AssetCache::enabled() const {
+            return !m_directory.isEmpty();
+        }
+
+        const Path& AssetCache::directory() const {
+            return m_directory;
+        }
+
+        uint64_t AssetCache::key(const MappedFile& file, const String& salt) {
+            // a file in an archive is a view of the archive file, which is the one that has a modification time
+            const MappedFile* source = &file;
+            while (const auto* view = dynamic_cast<const MappedFileView*>(source)) {
+                source = &view->container();
+            }
+
+            const auto path = file.path().asString('/');
+            const auto size = toHex(static_cast<uint64_t>(file.size()));
+
+            auto hash = FnvOffsetBasis;
+            hash = fnv1a(hash, salt.data(), salt.data() + salt.size() + 1);
+            hash = fnv1a(hash, path.data(), path.data() + path.size() + 1);
+            hash = fnv1a(hash, size.data(), size.data() + size.size() + 1);
+
+            const auto sourceModificationTime = modificationTime(*source);
+            if (sourceModificationTime != -1) {
+                const auto sourcePath = source->path().asString('/');
+                const auto offset = toHex(static_cast<uint64_t>(file.begin() - source->begin()));
+                const auto time = toHex(static_cast<uint64_t>(sourceModificationTime));
+
+                hash = fnv1a(hash, sourcePath.data(), sourcePath.data() + sourcePath.size() + 1);
+                hash = fnv1a(hash, offset.data(), offset.data() + offset.size() + 1);
+                hash = fnv1a(hash, time.data(), time.data() + time.size());
+            } else {
+                hash = fnv1a(hash, file.begin(), file.end());
+            }
+            return hash;
+        }
+
+        MappedFile::Ptr AssetCache::read(const String& kind, const uint64_t key) const {
+            if (!enabled()) {
+                return nullptr;
+            }
+
+            const auto path = entryPath(kind, key);
+            if (!Disk::fileExists(path)) {
+                return nullptr;
+            }
+
+            try {
+                return Disk::openFile(path);
+            } catch (const FileSystemException&) {
+                return nullptr;
+            }
+        }
+
+        void AssetCache::write(const String& kind, const uint64_t key, const String& data) const {
+            if (!enabled()) {
+                return;
+            }
+
+            const auto path = entryPath(kind, key);
+
+            // write to a temporary file first so that other threads and instances never see a partial entry
+            const auto threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+            const auto tempPath = path.replaceExtension("tmp" + toHex(static_cast<uint64_t>(threadId)));
+
+            try {
+                Disk::ensureDirectoryExists(path.deleteLastComponent());
+                {
+                    std::ofstream stream(tempPath.asString().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+                    if (!stream.is_open()) {
+                        return;
+                    }
+                    stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+                }
+                Disk::moveFile(tempPath, path, true);
+            } catch (const FileSystemException&) {
+                if (Disk::fileExists(tempPath)) {
+                    try {
+                        Disk::deleteFile(tempPath);
+                    } catch (const FileSystemException&) {}
+                }
+            }
+        }
+
+        void AssetCache::prune() const {
+            if (!enabled() || !Disk::directoryExists(m_directory)) {
+                return;
+            }
+
+            struct Entry {
+                Path path;
+                std::time_t modificationTime;
+                size_t size;
+            };
+
+            std::vector<Entry> entries;
+            size_t totalSize = 0;
+
+            try {
+                for (const auto& kind : Disk::getDirectoryContents(m_directory)) {
+                    const auto kindPath = m_directory + kind;
+                    if (!Disk::directoryExists(kindPath)) {
+                        continue;
+                    }
+
+                    // temporary files are skipped because they may still be written to
+                    for (const auto& name : Disk::getDirectoryContents(kindPath)) {
+                        if (name.extension() == "bin") {
+                            const auto path = kindPath + name;
+                            const auto size = Disk::fileSize(path);
+                            entries.push_back({ path, Disk::fileModificationTime(path), size });
+                            totalSize += size;
+                        }
+                    }
+                }
+            } catch (const FileSystemException&) {
+                return;
+            }
+
+            if (totalSize <= m_maxSize) {
+                return;
+            }
+
+            std::sort(std::begin(entries), std::end(entries), [](const Entry& lhs, const Entry& rhs) {
+                return lhs.modificationTime < rhs.modificationTime;
+            });
+
+            for (const auto& entry : entries) {
+                if (totalSize <= m_maxSize) {
+                    break;
+                }
+
+                try {
+                    Disk::deleteFile(entry.path);
+                    totalSize -= entry.size;
+                } catch (const FileSystemException&) {
+                    // the entry may be in use, e.g. it is mapped by another instance on Windows
+                }
+            }
+        }
+
+        Path AssetCache::entryPath(const String& kind, const uint64_t key) const {
+            return m_directory + Path(kind) + Path(toHex(key) + ".bin");
+        }
+    }
+}
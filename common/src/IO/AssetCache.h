@@ -0,0 +1,82 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_AssetCache_h
+#define TrenchBroom_AssetCache_h
+
+#include "StringUtils.h"
+#include "IO/MappedFile.h"
+#include "IO/Path.h"
+
+#include <cstdint>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Stores decoded assets in a directory on disk so that they can be memory mapped instead of being decoded
+         * again the next time they are loaded.
+         *
+         * Entries are grouped by kind (e.g. "textures") and identified by a key that is computed from the source file
+         * and a salt that describes how the asset was decoded, e.g. the palette. The cache is disabled if its directory
+         * path is empty. All functions are safe to call from multiple threads.
+         *
+         * Only textures are cached. Entity definition files are small text files that are parsed once per game, and
+         * decoded entity models are object graphs rather than flat buffers, so neither can simply be memory mapped.
+         */
+        class AssetCache {
+        public:
+            static const size_t DefaultMaxSize;
+        private:
+            Path m_directory;
+            size_t m_maxSize;
+        public:
+            explicit AssetCache(const Path& directory = Path(), size_t maxSize = DefaultMaxSize);
+
+            bool enabled() const;
+            const Path& directory() const;
+
+            /**
+             * Computes the key of the given file from its path, size and modification time, so that the file need not
+             * be read. Files within an archive are identified by the path and modification time of the archive and
+             * their offset in it. Only the contents of files that have no modification time, e.g. because they were
+             * extracted from a compressed archive, are hashed.
+             */
+            static uint64_t key(const MappedFile& file, const String& salt);
+
+            /**
+             * Returns the entry of the given kind with the given key, or nullptr if there is no such entry.
+             */
+            MappedFile::Ptr read(const String& kind, uint64_t key) const;
+            /**
+             * Stores an entry of the given kind with the given key. Errors are ignored because the cache is only an
+             * optimization; the entry will just be written again next time.
+             */
+            void write(const String& kind, uint64_t key, const String& data) const;
+            /**
+             * Deletes the least recently written entries until the total size of all entries does not exceed the
+             * maximum size of this cache.
+             */
+            void prune() const;
+        private:
+            Path entryPath(const String& kind, uint64_t key) const;
+        };
+    }
+}
+
+#endif /* TrenchBroom_AssetCache_h */
@@ -0,0 +1,156 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CachingTextureReader.h"
+
+#include "Color.h"
+#include "Ensure.h"
+#include "Assets/Texture.h"
+#include "IO/CharArrayReader.h"
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace TextureCacheLayout {
+            static const String Kind     = "textures";
+            static const String Magic    = "TBTX";
+            static const uint32_t Version = 1;
+        }
+
+        CachingTextureReader::CachingTextureReader(std::unique_ptr<TextureReader> reader, const AssetCache& cache, const String& salt) :
+        TextureReader(TextureNameStrategy()),
+        m_reader(std::move(reader)),
+        m_cache(cache),
+        m_salt(salt) {
+            ensure(m_reader != nullptr, "reader is null");
+        }
+
+        Assets::Texture* CachingTextureReader::doReadTexture(MappedFile::Ptr file) const {
+            const auto key = AssetCache::key(*file, m_salt);
+            if (const auto entry = m_cache.read(TextureCacheLayout::Kind, key)) {
+                if (auto* texture = deserializeTexture(*entry)) {
+                    return texture;
+                }
+            }
+
+            auto* texture = m_reader->readTexture(file);
+            // placeholders for textures that could not be read are not cached
+            if (texture != nullptr && !texture->buffersIfUnprepared().empty()) {
+                m_cache.write(TextureCacheLayout::Kind, key, serializeTexture(*texture));
+            }
+            return texture;
+        }
+
+        Assets::Texture* CachingTextureReader::doReadTextureHeader(MappedFile::Ptr file) const {
+            return m_reader->readTextureHeader(file);
+        }
+
+        template <typename T>
+        static void append(String& str, const T value) {
+            str.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        /**
+         * Layout: magic, version, width, height, format, type, average color (4 floats), name length, mip count, the
+         * size of each mip level, the name, and the pixel data of each mip level.
+         */
+        String CachingTextureReader::serializeTexture(const Assets::Texture& texture) {
+            const auto& buffers = texture.buffersIfUnprepared();
+            const auto& color = texture.averageColor();
+
+            String result;
+            result.append(TextureCacheLayout::Magic);
+            append<uint32_t>(result, TextureCacheLayout::Version);
+            append<uint32_t>(result, static_cast<uint32_t>(texture.width()));
+            append<uint32_t>(result, static_cast<uint32_t>(texture.height()));
+            append<uint32_t>(result, static_cast<uint32_t>(texture.format()));
+            append<uint32_t>(result, static_cast<uint32_t>(texture.type()));
+            for (size_t i = 0; i < 4; ++i) {
+                append<float>(result, color[i]);
+            }
+            append<uint32_t>(result, static_cast<uint32_t>(texture.name().size()));
+            append<uint32_t>(result, static_cast<uint32_t>(buffers.size()));
+            for (const auto& buffer : buffers) {
+                append<uint64_t>(result, static_cast<uint64_t>(buffer.size()));
+            }
+            result.append(texture.name());
+            for (const auto& buffer : buffers) {
+                result.append(reinterpret_cast<const char*>(buffer.ptr()), buffer.size());
+            }
+            return result;
+        }
+
+        Assets::Texture* CachingTextureReader::deserializeTexture(const MappedFile& file) {
+            try {
+                CharArrayReader reader(file.begin(), file.end());
+                String magic(TextureCacheLayout::Magic.size(), 0);
+                reader.read(&magic[0], magic.size());
+                if (magic != TextureCacheLayout::Magic || reader.readSize<uint32_t>() != TextureCacheLayout::Version) {
+                    return nullptr;
+                }
+
+                const auto width = reader.readSize<uint32_t>();
+                const auto height = reader.readSize<uint32_t>();
+                const auto format = static_cast<GLenum>(reader.readSize<uint32_t>());
+                const auto type = static_cast<Assets::TextureType>(reader.readSize<uint32_t>());
+
+                Color averageColor;
+                for (size_t i = 0; i < 4; ++i) {
+                    averageColor[i] = reader.readFloat<float>();
+                }
+
+                const auto nameLength = reader.readSize<uint32_t>();
+                const auto mipCount = reader.readSize<uint32_t>();
+                if (width == 0 || height == 0 || mipCount == 0 || !reader.canRead(mipCount * sizeof(uint64_t))) {
+                    return nullptr;
+                }
+
+                // the sizes are not trusted, so we check them against the remaining data before allocating anything
+                auto remaining = reader.size() - reader.currentOffset() - mipCount * sizeof(uint64_t);
+                if (nameLength > remaining) {
+                    return nullptr;
+                }
+                remaining -= nameLength;
+
+                std::vector<size_t> mipSizes;
+                for (size_t i = 0; i < mipCount; ++i) {
+                    const auto mipSize = reader.readSize<uint64_t>();
+                    if (mipSize > remaining) {
+                        return nullptr;
+                    }
+                    remaining -= mipSize;
+                    mipSizes.push_back(mipSize);
+                }
+
+                String name(nameLength, 0);
+                reader.read(&name[0], nameLength);
+
+                Assets::TextureBuffer::List buffers;
+                for (const auto mipSize : mipSizes) {
+                    Assets::TextureBuffer buffer(mipSize);
+                    reader.read(buffer.ptr(), mipSize);
+                    buffers.push_back(buffer);
+                }
+
+                return new Assets::Texture(name, width, height, averageColor, buffers, format, type);
+            } catch (const CharArrayReaderException&) {
+                return nullptr;
+            }
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_CachingTextureReader_h
+#define TrenchBroom_CachingTextureReader_h
+
+#include "IO/AssetCache.h"
+#include "IO/TextureReader.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Reads textures with another reader and stores the decoded pixel data in an asset cache. If a texture is
+         * found in the cache, it is read from there instead of being decoded again.
+         */
+        class CachingTextureReader : public TextureReader {
+        private:
+            std::unique_ptr<TextureReader> m_reader;
+            AssetCache m_cache;
+            String m_salt;
+        public:
+            /**
+             * Creates a new reader.
+             *
+             * @param reader the reader that decodes the textures that are not in the cache
+             * @param cache the cache
+             * @param salt describes the configuration of the given reader, e.g. the texture format and the palette
+             */
+            CachingTextureReader(std::unique_ptr<TextureReader> reader, const AssetCache& cache, const String& salt);
+        private:
+            Assets::Texture* doReadTexture(MappedFile::Ptr file) const override;
+            Assets::Texture* doReadTextureHeader(MappedFile::Ptr file) const override;
+        public:
+            static String serializeTexture(const Assets::Texture& texture);
+            static Assets::Texture* deserializeTexture(const MappedFile& file);
+        };
+    }
+}
+
+#endif /* TrenchBroom_CachingTextureReader_h */
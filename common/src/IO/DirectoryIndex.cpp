@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DirectoryIndex.h"
+
+#include <wx/dir.h>
+#include <wx/filefn.h>
+
+namespace TrenchBroom {
+    namespace IO {
+        static std::time_t directoryModificationTime(const String& directory) {
+            // wxWidgets logs an error if the directory does not exist
+            return ::wxDirExists(directory) ? ::wxFileModificationTime(directory) : -1;
+        }
+
+        DirectoryIndex::Directory::Directory() :
+        modificationTime(-1),
+        listingTime(-1) {}
+
+        DirectoryIndex::DirectoryIndex() :
+        m_listingCount(0) {}
+
+        String DirectoryIndex::findEntry(const Path& directory, const String& name) {
+            const auto directoryStr = directory.asString();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_directories.find(directoryStr);
+            if (it != std::end(m_directories)) {
+                const auto* result = findName(it->second, name);
+                if (result != nullptr) {
+                    return *result;
+                }
+
+                // The name may have been added since the directory was listed. A listing taken in the same second
+                // as the last modification may be incomplete even if the modification time did not change.
+                const auto& cached = it->second;
+                if (directoryModificationTime(directoryStr) == cached.modificationTime && cached.modificationTime < cached.listingTime) {
+                    return "";
+                }
+            }
+
+            const auto* result = findName(listDirectory(directoryStr, directoryModificationTime(directoryStr)), name);
+            return result != nullptr ? *result : "";
+        }
+
+        void DirectoryIndex::invalidate(const Path& directory) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_directories.erase(directory.asString());
+        }
+
+        void DirectoryIndex::clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_directories.clear();
+        }
+
+        size_t DirectoryIndex::directoryCount() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_directories.size();
+        }
+
+        size_t DirectoryIndex::listingCount() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_listingCount;
+        }
+
+        DirectoryIndex::Directory& DirectoryIndex::listDirectory(const String& directory, const std::time_t modificationTime) {
+            Directory result;
+            result.modificationTime = modificationTime;
+            result.listingTime = std::time(nullptr);
+
+            if (::wxDirExists(directory)) {
+                wxDir dir(directory);
+                if (dir.IsOpened()) {
+                    wxString filename;
+                    for (auto more = dir.GetFirst(&filename); more; more = dir.GetNext(&filename)) {
+                        const auto name = filename.ToStdString();
+                        result.entries[StringUtils::toLower(name)].push_back(name);
+                    }
+                }
+            }
+
+            ++m_listingCount;
+            auto& entry = m_directories[directory];
+            entry = std::move(result);
+            return entry;
+        }
+
+        const String* DirectoryIndex::findName(const Directory& directory, const String& name) {
+            const auto it = directory.entries.find(StringUtils::toLower(name));
+            if (it == std::end(directory.entries)) {
+                return nullptr;
+            }
+
+            const auto& names = it->second;
+            for (const auto& candidate : names) {
+                if (candidate == name) {
+                    return &candidate;
+                }
+            }
+            return &names.front();
+        }
+    }
+}
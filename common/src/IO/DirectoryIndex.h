@@ -0,0 +1,84 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_DirectoryIndex_h
+#define TrenchBroom_DirectoryIndex_h
+
+#include "Macros.h"
+#include "StringUtils.h"
+#include "IO/Path.h"
+
+#include <ctime>
+#include <mutex>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * Caches the contents of directories by their case folded names so that the case of a path can be fixed
+         * without listing every directory along the path again.
+         *
+         * Directories are listed lazily on first access. A cached listing is trusted as long as the names found in it,
+         * but it is listed again when a name is missing and the directory's modification time has changed since it was
+         * listed, so files that were added by other programs are found. Functions that modify a directory should call
+         * invalidate to drop the cached listing. All functions are safe to call from multiple threads.
+         */
+        class DirectoryIndex {
+        private:
+            class Directory {
+            public:
+                // maps case folded names to the actual names of the directory entries
+                std::unordered_map<String, StringList> entries;
+                std::time_t modificationTime;
+                std::time_t listingTime;
+            public:
+                Directory();
+            };
+
+            mutable std::mutex m_mutex;
+            std::unordered_map<String, Directory> m_directories;
+            size_t m_listingCount;
+        public:
+            DirectoryIndex();
+
+            /**
+             * Returns the name of the entry of the given directory that matches the given name, ignoring case. An
+             * entry whose name matches exactly is preferred. Returns an empty string if the directory has no such
+             * entry or if it cannot be opened. The given directory path must not need fixing itself.
+             */
+            String findEntry(const Path& directory, const String& name);
+
+            void invalidate(const Path& directory);
+            void clear();
+
+            size_t directoryCount() const;
+            /**
+             * Returns how many times a directory was listed since the index was created.
+             */
+            size_t listingCount() const;
+        private:
+            Directory& listDirectory(const String& directory, std::time_t modificationTime);
+            static const String* findName(const Directory& directory, const String& name);
+
+            deleteCopyAndMove(DirectoryIndex)
+        };
+    }
+}
+
+#endif /* TrenchBroom_DirectoryIndex_h */
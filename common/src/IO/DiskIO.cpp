@@ -19,6 +19,8 @@
 
 #include "DiskIO.h"
 
+#include "IO/DirectoryIndex.h"
+
 #include <wx/dir.h>
 #include <wx/filefn.h>
 #include <wx/filename.h>
@@ -29,7 +31,6 @@ namespace TrenchBroom {
     namespace IO {
         namespace Disk {
             bool doCheckCaseSensitive();
-            Path findCaseSensitivePath(const Path::List& list, const Path& path);
             Path fixCase(const Path& path);
             
             bool doCheckCaseSensitive() {
@@ -43,14 +44,11 @@ namespace TrenchBroom {
                 return caseSensitive;
             }
             
-            Path findCaseSensitivePath(const Path::List& list, const Path& path) {
-                for (const Path& entry : list) {
-                    if (StringUtils::caseInsensitiveEqual(entry.asString(), path.asString()))
-                        return entry;
-                }
-                return Path("");
+            DirectoryIndex& directoryIndex() {
+                static DirectoryIndex index;
+                return index;
             }
-            
+
             Path fixCase(const Path& path) {
                 try {
                     if (!path.isAbsolute())
@@ -67,18 +65,12 @@ namespace TrenchBroom {
                     if (remainder.isEmpty())
                         return result;
                     
+                    DirectoryIndex& index = directoryIndex();
                     while (!remainder.isEmpty()) {
-                        const String nextPathStr = (result + remainder.firstComponent()).asString();
-                        if (!::wxDirExists(nextPathStr) &&
-                            !::wxFileExists(nextPathStr)) {
-                            const Path::List content = getDirectoryContents(result);
-                            const Path part = findCaseSensitivePath(content, remainder.firstComponent());
-                            if (part.isEmpty())
-                                return path;
-                            result = result + part;
-                        } else {
-                            result = result + remainder.firstComponent();
-                        }
+                        const String part = index.findEntry(result, remainder.firstComponent().asString());
+                        if (part.empty())
+                            return path;
+                        result = result + Path(part);
                         remainder = remainder.deleteFirstComponent();
                     }
                     return result;
@@ -107,6 +99,17 @@ namespace TrenchBroom {
                 return ::wxFileExists(fixedPath.asString());
             }
             
+            std::time_t fileModificationTime(const Path& path) {
+                const Path fixedPath = fixPath(path);
+                return ::wxFileExists(fixedPath.asString()) ? ::wxFileModificationTime(fixedPath.asString()) : -1;
+            }
+
+            size_t fileSize(const Path& path) {
+                const Path fixedPath = fixPath(path);
+                const wxULongLong size = wxFileName::GetSize(fixedPath.asString());
+                return size == wxInvalidSize ? 0 : static_cast<size_t>(size.GetValue());
+            }
+
             String replaceForbiddenChars(const String& name) {
                 static const String forbidden = wxFileName::GetForbiddenChars().ToStdString();
                 return StringUtils::replaceChars(name, forbidden, "_");
@@ -165,6 +168,7 @@ namespace TrenchBroom {
                 const String fixedPathStr = fixedPath.asString();
                 std::ofstream stream(fixedPathStr.c_str());
                 stream  << contents;
+                directoryIndex().invalidate(fixedPath.deleteLastComponent());
             }
 
             bool createDirectoryHelper(const Path& path);
@@ -185,7 +189,9 @@ namespace TrenchBroom {
                 const IO::Path parent = path.deleteLastComponent();
                 if (!::wxDirExists(parent.asString()) && !createDirectoryHelper(parent))
                     return false;
-                return ::wxMkdir(path.asString());
+                const bool result = ::wxMkdir(path.asString());
+                directoryIndex().invalidate(parent);
+                return result;
             }
 
             void ensureDirectoryExists(const Path& path) {
@@ -200,7 +206,9 @@ namespace TrenchBroom {
                 const Path fixedPath = fixPath(path);
                 if (!fileExists(fixedPath))
                     throw FileSystemException("Could not delete file '" + fixedPath.asString() + "': File does not exist.");
-                if (!::wxRemoveFile(fixedPath.asString()))
+                const bool result = ::wxRemoveFile(fixedPath.asString());
+                directoryIndex().invalidate(fixedPath.deleteLastComponent());
+                if (!result)
                     throw FileSystemException("Could not delete file '" + path.asString() + "'");
             }
             
@@ -211,7 +219,9 @@ namespace TrenchBroom {
                     throw FileSystemException("Could not copy file '" + fixedSourcePath.asString() + "' to '" + fixedDestPath.asString() + "': file already exists");
                 if (directoryExists(fixedDestPath))
                     fixedDestPath = fixedDestPath + sourcePath.lastComponent();
-                if (!::wxCopyFile(fixedSourcePath.asString(), fixedDestPath.asString(), overwrite))
+                const bool result = ::wxCopyFile(fixedSourcePath.asString(), fixedDestPath.asString(), overwrite);
+                directoryIndex().invalidate(fixedDestPath.deleteLastComponent());
+                if (!result)
                     throw FileSystemException("Could not copy file '" + fixedSourcePath.asString() + "' to '" + fixedDestPath.asString() + "'");
             }
             
@@ -222,7 +232,10 @@ namespace TrenchBroom {
                     throw FileSystemException("Could not move file '" + fixedSourcePath.asString() + "' to '" + fixedDestPath.asString() + "': file already exists");
                 if (directoryExists(fixedDestPath))
                     fixedDestPath = fixedDestPath + sourcePath.lastComponent();
-                if (!::wxRenameFile(fixedSourcePath.asString(), fixedDestPath.asString(), overwrite))
+                const bool result = ::wxRenameFile(fixedSourcePath.asString(), fixedDestPath.asString(), overwrite);
+                directoryIndex().invalidate(fixedSourcePath.deleteLastComponent());
+                directoryIndex().invalidate(fixedDestPath.deleteLastComponent());
+                if (!result)
                     throw FileSystemException("Could not move file '" + fixedSourcePath.asString() + "' to '" + fixedDestPath.asString() + "'");
             }
             
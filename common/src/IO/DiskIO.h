@@ -25,15 +25,35 @@
 #include "IO/MappedFile.h"
 #include "IO/Path.h"
 
+#include <ctime>
+
 namespace TrenchBroom {
     namespace IO {
+        class DirectoryIndex;
+
         namespace Disk {
             bool isCaseSensitive();
+
+            /**
+             * Returns the index of directory contents that is used to fix the case of paths on case sensitive file
+             * systems. The index is updated by the functions in this namespace; call DirectoryIndex::invalidate or
+             * DirectoryIndex::clear if a directory was changed by other means and a path must be found immediately.
+             */
+            DirectoryIndex& directoryIndex();
             
             Path fixPath(const Path& path);
             
             bool directoryExists(const Path& path);
             bool fileExists(const Path& path);
+
+            /**
+             * Returns the time at which the given file was last modified, or -1 if the file does not exist.
+             */
+            std::time_t fileModificationTime(const Path& path);
+            /**
+             * Returns the size of the given file in bytes, or 0 if the file does not exist.
+             */
+            size_t fileSize(const Path& path);
             
             String replaceForbiddenChars(const String& name);
             
@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileCache.h"
+
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace IO {
+        FileCache& FileCache::instance() {
+            static FileCache instance;
+            return instance;
+        }
+
+        FileCache::FileCache(const size_t capacity) :
+        m_capacity(capacity),
+        m_size(0) {}
+
+        MappedFile::Ptr FileCache::get(const Key key) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const auto it = m_index.find(key);
+            if (it == std::end(m_index)) {
+                return nullptr;
+            }
+
+            m_entries.splice(std::begin(m_entries), m_entries, it->second);
+            return it->second->second;
+        }
+
+        void FileCache::put(const Key key, MappedFile::Ptr file) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const auto fileSize = file->size();
+            if (fileSize == 0 || fileSize > m_capacity) {
+                return;
+            }
+
+            const auto it = m_index.find(key);
+            if (it != std::end(m_index)) {
+                m_size -= it->second->second->size();
+                m_entries.erase(it->second);
+                m_index.erase(it);
+            }
+
+            evict(m_capacity - fileSize);
+
+            m_entries.emplace_front(key, std::move(file));
+            m_index.emplace(key, std::begin(m_entries));
+            m_size += fileSize;
+        }
+
+        void FileCache::remove(const Key key) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            const auto it = m_index.find(key);
+            if (it != std::end(m_index)) {
+                m_size -= it->second->second->size();
+                m_entries.erase(it->second);
+                m_index.erase(it);
+            }
+        }
+
+        void FileCache::clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_entries.clear();
+            m_index.clear();
+            m_size = 0;
+        }
+
+        size_t FileCache::size() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_size;
+        }
+
+        size_t FileCache::count() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+        size_t FileCache::capacity() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_capacity;
+        }
+
+        void FileCache::setCapacity(const size_t capacity) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_capacity = capacity;
+            evict(m_capacity);
+        }
+
+        void FileCache::evict(const size_t capacity) {
+            while (m_size > capacity) {
+                const auto& entry = m_entries.back();
+                m_size -= entry.second->size();
+                m_index.erase(entry.first);
+                m_entries.pop_back();
+            }
+        }
+    }
+}
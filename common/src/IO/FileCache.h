@@ -0,0 +1,84 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_FileCache_h
+#define TrenchBroom_FileCache_h
+
+#include "Macros.h"
+#include "IO/MappedFile.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * A thread safe cache for the contents of decompressed files, e.g. files in zip or pak archives. The cache
+         * holds at most the given number of bytes and evicts the least recently used files when it is full.
+         *
+         * Files are identified by an opaque key, usually the address of the object that decompresses them. Such
+         * objects must remove their entries when they are destroyed. All file systems share a single instance.
+         */
+        class FileCache {
+        public:
+            static const size_t DefaultCapacity = 128 * 1024 * 1024;
+        private:
+            using Key = const void*;
+            using Entry = std::pair<Key, MappedFile::Ptr>;
+            using EntryList = std::list<Entry>;
+            using EntryMap = std::unordered_map<Key, EntryList::iterator>;
+
+            mutable std::mutex m_mutex;
+            size_t m_capacity;
+            size_t m_size;
+            // the most recently used entry is at the front
+            EntryList m_entries;
+            EntryMap m_index;
+        public:
+            static FileCache& instance();
+
+            explicit FileCache(size_t capacity = DefaultCapacity);
+
+            /**
+             * Returns the file with the given key, or nullptr if it is not in the cache.
+             */
+            MappedFile::Ptr get(Key key);
+            /**
+             * Adds the given file to the cache, evicting other files if necessary. Empty files and files that are
+             * larger than the capacity of the cache are not cached.
+             */
+            void put(Key key, MappedFile::Ptr file);
+            void remove(Key key);
+            void clear();
+
+            size_t size() const;
+            size_t count() const;
+            size_t capacity() const;
+            void setCapacity(size_t capacity);
+        private:
+            void evict(size_t capacity);
+
+            deleteCopyAndMove(FileCache)
+        };
+    }
+}
+
+#endif /* TrenchBroom_FileCache_h */
@@ -107,5 +107,37 @@ namespace TrenchBroom {
             const auto textureType = Assets::Texture::selectTextureType(masked);
             return new Assets::Texture(textureName(imageName, path), imageWidth, imageHeight, Color(), buffers, format, textureType);
         }
+
+        Assets::Texture* FreeImageTextureReader::doReadTextureHeader(MappedFile::Ptr file) const {
+            const auto* begin           = file->begin();
+            const auto* end             = file->end();
+            const auto  path            = file->path();
+            const auto  imageSize       = static_cast<size_t>(end - begin);
+                  auto* imageBegin      = reinterpret_cast<BYTE*>(const_cast<char*>(begin));
+                  auto* imageMemory     = FreeImage_OpenMemory(imageBegin, static_cast<DWORD>(imageSize));
+            const auto  imageFormat     = FreeImage_GetFileTypeFromMemory(imageMemory);
+
+            // plugins that cannot load the header only load the entire image instead
+                  auto* image           = FreeImage_LoadFromMemory(imageFormat, imageMemory, FIF_LOAD_NOPIXELS);
+            const auto  imageName       = path.filename();
+
+            if (image == nullptr) {
+                FreeImage_CloseMemory(imageMemory);
+                return nullptr;
+            }
+
+            const auto imageWidth      = static_cast<size_t>(FreeImage_GetWidth(image));
+            const auto imageHeight     = static_cast<size_t>(FreeImage_GetHeight(image));
+
+            FreeImage_Unload(image);
+            FreeImage_CloseMemory(imageMemory);
+
+            if (imageWidth == 0 || imageHeight == 0) {
+                return nullptr;
+            }
+
+            constexpr auto format = freeImage32BPPFormatToGLFormat();
+            return new Assets::Texture(textureName(imageName, path), imageWidth, imageHeight, format, Assets::TextureType::Opaque);
+        }
     }
 }
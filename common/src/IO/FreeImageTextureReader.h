@@ -33,6 +33,7 @@ namespace TrenchBroom {
             FreeImageTextureReader(const NameStrategy& nameStrategy);
         private:
             Assets::Texture* doReadTexture(MappedFile::Ptr file) const override;
+            Assets::Texture* doReadTextureHeader(MappedFile::Ptr file) const override;
         };
     }
 }
@@ -21,6 +21,7 @@
 
 #include "CollectionUtils.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/FileCache.h"
 #include "IO/IOUtils.h"
 
 #include <cassert>
@@ -45,9 +46,20 @@ namespace TrenchBroom {
         m_file(file),
         m_uncompressedSize(uncompressedSize) {}
 
+        ImageFileSystemBase::CompressedFile::~CompressedFile() {
+            FileCache::instance().remove(this);
+        }
+
         MappedFile::Ptr ImageFileSystemBase::CompressedFile::doOpen() const {
+            auto& cache = FileCache::instance();
+            if (auto cached = cache.get(this)) {
+                return cached;
+            }
+
             auto data = decompress(m_file, m_uncompressedSize);
-            return MappedFile::Ptr(new MappedFileBuffer(m_file->path(), std::move(data), m_uncompressedSize));
+            auto result = MappedFile::Ptr(new MappedFileBuffer(m_file->path(), std::move(data), m_uncompressedSize));
+            cache.put(this, result);
+            return result;
         }
 
         ImageFileSystemBase::Directory::Directory(const Path& path) :
@@ -55,7 +55,7 @@ namespace TrenchBroom {
                 const size_t m_uncompressedSize;
             public:
                 CompressedFile(MappedFile::Ptr file, size_t uncompressedSize);
-                virtual ~CompressedFile() override = default;
+                virtual ~CompressedFile() override;
             private:
                 MappedFile::Ptr doOpen() const override;
                 virtual std::unique_ptr<char[]> decompress(MappedFile::Ptr file, size_t uncompressedSize) const = 0;
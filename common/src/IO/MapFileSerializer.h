@@ -26,22 +26,34 @@
 #include "Model/Node.h"
 
 #include <cstdio>
+#include <memory>
 
 namespace TrenchBroom {
     namespace IO {
+        class MapSnapshot;
         class Path;
-        
+
+        /**
+         * Records the serialized nodes in a snapshot and sets their file positions to the lines they occupy once the
+         * snapshot is written. If the serializer was created with a stream, the snapshot is written to the stream at
+         * the end of the file.
+         */
         class MapFileSerializer : public NodeSerializer {
         private:
             using LineStack = std::vector<size_t>;
             LineStack m_startLineStack;
             size_t m_line;
+            std::unique_ptr<MapSnapshot> m_ownSnapshot;
+            MapSnapshot& m_snapshot;
             FILE* m_stream;
         public:
             static Ptr create(Model::MapFormat format, FILE* stream);
-        protected:
-            MapFileSerializer(FILE* file);
+
+            explicit MapFileSerializer(MapSnapshot& snapshot);
+            ~MapFileSerializer() override;
         private:
+            MapFileSerializer(Model::MapFormat format, FILE* stream);
+
             void doBeginFile() override;
             void doEndFile() override;
             
@@ -54,8 +66,6 @@ namespace TrenchBroom {
         private:
             void setFilePosition(Model::Node* node);
             size_t startLine();
-        private:
-            virtual size_t doWriteBrushFace(FILE* stream, Model::BrushFace* face) = 0;
         };
     }
 }
@@ -21,6 +21,7 @@
 
 #include "CollectionUtils.h"
 #include "Logger.h"
+#include "ParallelUtils.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/Entity.h"
@@ -31,6 +32,9 @@
 
 namespace TrenchBroom {
     namespace IO {
+        // brush geometry is only built on worker threads if each thread gets at least this many brushes
+        static const size_t MinBrushesPerThread = 64;
+
         MapReader::ParentInfo MapReader::ParentInfo::layer(const Model::IdType layerId) {
             return ParentInfo(Type_Layer, layerId);
         }
@@ -55,6 +59,22 @@ namespace TrenchBroom {
             return m_id;
         }
 
+        MapReader::PendingNode::PendingNode(Model::Node* i_parent, Model::Node* i_node) :
+        parent(i_parent),
+        node(i_node),
+        brush(false),
+        startLine(0),
+        lineCount(0) {}
+
+        MapReader::PendingNode::PendingNode(Model::Node* i_parent, const Model::BrushFaceList& i_faces, const size_t i_startLine, const size_t i_lineCount, const ExtraAttributes& i_extraAttributes) :
+        parent(i_parent),
+        node(nullptr),
+        brush(true),
+        faces(i_faces),
+        startLine(i_startLine),
+        lineCount(i_lineCount),
+        extraAttributes(i_extraAttributes) {}
+
         MapReader::MapReader(const char* begin, const char* end) :
         StandardMapParser(begin, end),
         m_factory(nullptr),
@@ -68,18 +88,27 @@ namespace TrenchBroom {
         m_currentNode(nullptr) {}
         
         MapReader::~MapReader() {
+            clearPendingNodes();
             VectorUtils::clearAndDelete(m_faces);
         }
 
         void MapReader::readEntities(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
+            clearPendingNodes();
+            VectorUtils::clearAndDelete(m_faces);
+
             m_worldBounds = worldBounds;
-            parseEntities(format, status);
+            parseEntitiesInChunks(format, status);
+            addPendingNodes(status);
             resolveNodes(status);
         }
         
         void MapReader::readBrushes(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
+            clearPendingNodes();
+            VectorUtils::clearAndDelete(m_faces);
+
             m_worldBounds = worldBounds;
             parseBrushes(format, status);
+            addPendingNodes(status);
         }
         
         void MapReader::readBrushFaces(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
@@ -223,23 +252,62 @@ namespace TrenchBroom {
         }
 
         void MapReader::createBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) {
+            // the brush geometry is built later, see addPendingNodes
+            m_pendingNodes.push_back(PendingNode(m_brushParent, m_faces, startLine, lineCount, extraAttributes));
+            m_faces.clear();
+        }
+
+        void MapReader::addNode(Model::Node* parent, Model::Node* node) {
+            m_pendingNodes.push_back(PendingNode(parent, node));
+        }
+
+        /**
+         * Builds the geometry of all pending brushes on a pool of worker threads and then adds all pending nodes to
+         * their parents in the order in which they were read from the file.
+         */
+        void MapReader::addPendingNodes(ParserStatus& status) {
+            ParallelUtils::parallelFor(m_pendingNodes.size(), [this](const size_t index) {
+                auto& pendingNode = m_pendingNodes[index];
+                if (pendingNode.brush) {
+                    buildBrush(pendingNode);
+                }
+            }, MinBrushesPerThread);
+
+            for (auto& pendingNode : m_pendingNodes) {
+                if (!pendingNode.brush) {
+                    onNode(pendingNode.parent, pendingNode.node, status);
+                } else if (pendingNode.node != nullptr) {
+                    auto* brush = static_cast<Model::Brush*>(pendingNode.node);
+                    setFilePosition(brush, pendingNode.startLine, pendingNode.lineCount);
+                    setExtraAttributes(brush, pendingNode.extraAttributes);
+                    onBrush(pendingNode.parent, brush, status);
+                } else {
+                    StringStream msg;
+                    msg << "Skipping brush: " << pendingNode.error;
+                    status.error(pendingNode.startLine, msg.str());
+                }
+                pendingNode.node = nullptr;
+            }
+            m_pendingNodes.clear();
+        }
+
+        void MapReader::buildBrush(PendingNode& pendingNode) const {
             try {
                 // sort the faces by the weight of their plane normals like QBSP does
-                Model::BrushFace::sortFaces(m_faces);
-                
-                Model::Brush* brush = m_factory->createBrush(m_worldBounds, m_faces);
-                setFilePosition(brush, startLine, lineCount);
-                setExtraAttributes(brush, extraAttributes);
-                
-                onBrush(m_brushParent, brush, status);
-                m_faces.clear();
+                Model::BrushFace::sortFaces(pendingNode.faces);
+                pendingNode.node = m_factory->createBrush(m_worldBounds, pendingNode.faces);
             } catch (GeometryException& e) {
-                StringStream msg;
-                msg << "Skipping brush: " << e.what();
-                status.error(startLine, msg.str());
-                m_faces.clear(); // the faces will have been deleted by the brush's constructor
+                pendingNode.error = e.what();
             }
+            pendingNode.faces.clear(); // the faces are owned by the brush or have been deleted by the brush's constructor
+        }
 
+        void MapReader::clearPendingNodes() {
+            for (auto& pendingNode : m_pendingNodes) {
+                delete pendingNode.node;
+                VectorUtils::clearAndDelete(pendingNode.faces);
+            }
+            m_pendingNodes.clear();
         }
 
         MapReader::ParentInfo::Type MapReader::storeNode(Model::Node* node, const Model::EntityAttribute::List& attributes, ParserStatus& status) {
@@ -250,7 +318,7 @@ namespace TrenchBroom {
                     const Model::IdType layerId = static_cast<Model::IdType>(rawId);
                     Model::Layer* layer = MapUtils::find(m_layers, layerId, static_cast<Model::Layer*>(nullptr));
                     if (layer != nullptr)
-                        onNode(layer, node, status);
+                        addNode(layer, node);
                     else
                         m_unresolvedNodes.push_back(std::make_pair(node, ParentInfo::layer(layerId)));
                     return ParentInfo::Type_Layer;
@@ -267,7 +335,7 @@ namespace TrenchBroom {
                         const Model::IdType groupId = static_cast<Model::IdType>(rawId);
                         Model::Group* group = MapUtils::find(m_groups, groupId, static_cast<Model::Group*>(nullptr));
                         if (group != nullptr)
-                            onNode(group, node, status);
+                            addNode(group, node);
                         else
                             m_unresolvedNodes.push_back(std::make_pair(node, ParentInfo::group(groupId)));
                         return ParentInfo::Type_Group;
@@ -279,7 +347,7 @@ namespace TrenchBroom {
                 }
             }
             
-            onNode(nullptr, node, status);
+            addNode(nullptr, node);
             return ParentInfo::Type_None;
         }
 
@@ -70,6 +70,27 @@ namespace TrenchBroom {
             
             using NodeParentPair = std::pair<Model::Node*, ParentInfo>;
             using NodeParentList = std::vector<NodeParentPair>;
+
+            /**
+             * A node that has been read, but that has not been added to its parent yet. Brushes are stored as a list
+             * of faces until their geometry has been built.
+             */
+            class PendingNode {
+            public:
+                Model::Node* parent;
+                Model::Node* node;
+                bool brush;
+                Model::BrushFaceList faces;
+                size_t startLine;
+                size_t lineCount;
+                ExtraAttributes extraAttributes;
+                String error;
+            public:
+                PendingNode(Model::Node* i_parent, Model::Node* i_node);
+                PendingNode(Model::Node* i_parent, const Model::BrushFaceList& i_faces, size_t i_startLine, size_t i_lineCount, const ExtraAttributes& i_extraAttributes);
+            };
+
+            using PendingNodeList = std::vector<PendingNode>;
             
             vm::bbox3 m_worldBounds;
             Model::ModelFactory* m_factory;
@@ -81,6 +102,7 @@ namespace TrenchBroom {
             LayerMap m_layers;
             GroupMap m_groups;
             NodeParentList m_unresolvedNodes;
+            PendingNodeList m_pendingNodes;
         protected:
             MapReader(const char* begin, const char* end);
             explicit MapReader(const String& str);
@@ -103,6 +125,11 @@ namespace TrenchBroom {
             void createEntity(size_t line, const Model::EntityAttribute::List& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status);
             void createBrush(size_t startLine, size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status);
 
+            void addNode(Model::Node* parent, Model::Node* node);
+            void addPendingNodes(ParserStatus& status);
+            void buildBrush(PendingNode& pendingNode) const;
+            void clearPendingNodes();
+
             ParentInfo::Type storeNode(Model::Node* node, const Model::EntityAttribute::List& attributes, ParserStatus& status);
             void stripParentAttributes(Model::AttributableNode* attributable, ParentInfo::Type parentType);
             
@@ -0,0 +1,114 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "MapSaveQueue.h"
+
+#include "IO/MapSnapshot.h"
+
+#include <exception>
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace IO {
+        MapSaveQueue::Result::Result(const Path& i_path, const bool i_success, const String& i_error) :
+        path(i_path),
+        success(i_success),
+        error(i_error) {}
+
+        MapSaveQueue::MapSaveQueue() :
+        m_pendingCount(0),
+        m_stop(false) {}
+
+        MapSaveQueue::~MapSaveQueue() {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                // the snapshots may contain changes that are not saved anywhere else
+                m_condition.wait(lock, [this]() { return m_pendingCount == 0; });
+                m_stop = true;
+            }
+            m_condition.notify_all();
+
+            if (m_worker.joinable()) {
+                m_worker.join();
+            }
+        }
+
+        void MapSaveQueue::enqueue(std::unique_ptr<const MapSnapshot> snapshot, const Path& path) {
+            ensure(snapshot != nullptr, "snapshot is null");
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_worker.joinable()) {
+                    m_worker = std::thread([this]() { work(); });
+                }
+                m_jobs.push_back(Job{ std::move(snapshot), path });
+                ++m_pendingCount;
+            }
+            m_condition.notify_all();
+        }
+
+        bool MapSaveQueue::hasPendingSaves() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_pendingCount > 0;
+        }
+
+        void MapSaveQueue::waitForPendingSaves() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_pendingCount == 0; });
+        }
+
+        MapSaveQueue::ResultList MapSaveQueue::takeResults() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ResultList results;
+            std::swap(results, m_results);
+            return results;
+        }
+
+        void MapSaveQueue::work() {
+            while (true) {
+                Job job;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+                    if (m_jobs.empty()) {
+                        return;
+                    }
+                    job = std::move(m_jobs.front());
+                    m_jobs.erase(std::begin(m_jobs));
+                }
+
+                auto result = Result(job.path, true, "");
+                try {
+                    job.snapshot->save(job.path);
+                } catch (const std::exception& e) {
+                    result = Result(job.path, false, e.what());
+                }
+
+                // free the snapshot before reporting, it may be large
+                job.snapshot.reset();
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_results.push_back(result);
+                    --m_pendingCount;
+                }
+                m_condition.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_MapSaveQueue
+#define TrenchBroom_MapSaveQueue
+
+#include "Macros.h"
+#include "StringUtils.h"
+#include "IO/Path.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        class MapSnapshot;
+
+        /**
+         * Saves map snapshots on a worker thread, one after another in the order in which they were enqueued. The
+         * outcome of each save is kept until the main thread takes it to report it.
+         */
+        class MapSaveQueue {
+        public:
+            class Result {
+            public:
+                Path path;
+                bool success;
+                // the reason why the save failed, if it failed
+                String error;
+            public:
+                Result(const Path& i_path, bool i_success, const String& i_error);
+            };
+
+            using ResultList = std::vector<Result>;
+        private:
+            struct Job {
+                std::unique_ptr<const MapSnapshot> snapshot;
+                Path path;
+            };
+
+            mutable std::mutex m_mutex;
+            std::condition_variable m_condition;
+            std::vector<Job> m_jobs;
+            ResultList m_results;
+            // the number of jobs that were enqueued but have not finished yet
+            size_t m_pendingCount;
+            std::thread m_worker;
+            bool m_stop;
+        public:
+            MapSaveQueue();
+
+            /**
+             * Waits until all enqueued snapshots are saved.
+             */
+            ~MapSaveQueue();
+
+            void enqueue(std::unique_ptr<const MapSnapshot> snapshot, const Path& path);
+
+            bool hasPendingSaves() const;
+            void waitForPendingSaves();
+
+            /**
+             * Returns the results of all saves that finished since the last call, in the order in which they were
+             * enqueued.
+             */
+            ResultList takeResults();
+        private:
+            void work();
+
+            deleteCopyAndMove(MapSaveQueue)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MapSaveQueue) */
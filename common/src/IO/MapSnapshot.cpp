@@ -0,0 +1,318 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "MapSnapshot.h"
+
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/IOUtils.h"
+#include "IO/MapFileSerializer.h"
+#include "IO/NodeSerializer.h"
+#include "IO/NodeWriter.h"
+#include "IO/Path.h"
+#include "Model/BrushFace.h"
+#include "Model/World.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        class FaceWriter {
+        public:
+            static std::unique_ptr<FaceWriter> create(Model::MapFormat format);
+
+            virtual ~FaceWriter() {}
+
+            virtual void writeFace(FILE* stream, const MapSnapshot::Face& face) const = 0;
+        };
+
+        class QuakeFaceWriter : public FaceWriter {
+        private:
+            String FacePointFormat;
+        public:
+            QuakeFaceWriter() {
+                // the same precision as the stream serializer, so that both save paths write identical files
+                const auto precision = NodeSerializer::FloatPrecision;
+
+                StringStream str;
+                str <<
+                "( %." << precision << "g " <<
+                "%." << precision << "g " <<
+                "%." << precision << "g ) " <<
+                "( %." << precision << "g " <<
+                "%." << precision << "g " <<
+                "%." << precision << "g ) " <<
+                "( %." << precision << "g " <<
+                "%." << precision << "g " <<
+                "%." << precision << "g )";
+
+                FacePointFormat = str.str();
+            }
+
+            void writeFace(FILE* stream, const MapSnapshot::Face& face) const override {
+                writeFacePoints(stream, face);
+                writeTextureInfo(stream, face);
+                std::fprintf(stream, "\n");
+            }
+        protected:
+            void writeFacePoints(FILE* stream, const MapSnapshot::Face& face) const {
+                const auto& points = face.points;
+                std::fprintf(stream, FacePointFormat.c_str(),
+                             points[0].x(),
+                             points[0].y(),
+                             points[0].z(),
+                             points[1].x(),
+                             points[1].y(),
+                             points[1].z(),
+                             points[2].x(),
+                             points[2].y(),
+                             points[2].z());
+            }
+
+            void writeTextureInfo(FILE* stream, const MapSnapshot::Face& face) const {
+                std::fprintf(stream, " %s %.6g %.6g %.6g %.6g %.6g",
+                             face.textureName().c_str(),
+                             face.attribs.xOffset(),
+                             face.attribs.yOffset(),
+                             face.attribs.rotation(),
+                             face.attribs.xScale(),
+                             face.attribs.yScale());
+            }
+        };
+
+        class Quake2FaceWriter : public QuakeFaceWriter {
+        public:
+            void writeFace(FILE* stream, const MapSnapshot::Face& face) const override {
+                writeFacePoints(stream, face);
+                writeTextureInfo(stream, face);
+
+                if (face.hasSurfaceAttributes()) {
+                    writeSurfaceAttributes(stream, face);
+                }
+
+                std::fprintf(stream, "\n");
+            }
+        protected:
+            void writeSurfaceAttributes(FILE* stream, const MapSnapshot::Face& face) const {
+                std::fprintf(stream, " %d %d %.6g",
+                             face.attribs.surfaceContents(),
+                             face.attribs.surfaceFlags(),
+                             face.attribs.surfaceValue());
+            }
+        };
+
+        class DaikatanaFaceWriter : public Quake2FaceWriter {
+        public:
+            void writeFace(FILE* stream, const MapSnapshot::Face& face) const override {
+                writeFacePoints(stream, face);
+                writeTextureInfo(stream, face);
+
+                if (face.hasSurfaceAttributes() || face.hasColor()) {
+                    writeSurfaceAttributes(stream, face);
+                }
+                if (face.hasColor()) {
+                    writeSurfaceColor(stream, face);
+                }
+
+                std::fprintf(stream, "\n");
+            }
+        private:
+            void writeSurfaceColor(FILE* stream, const MapSnapshot::Face& face) const {
+                std::fprintf(stream, " %d %d %d",
+                             static_cast<int>(face.attribs.color().r()),
+                             static_cast<int>(face.attribs.color().g()),
+                             static_cast<int>(face.attribs.color().b()));
+            }
+        };
+
+        class Hexen2FaceWriter : public QuakeFaceWriter {
+        public:
+            void writeFace(FILE* stream, const MapSnapshot::Face& face) const override {
+                writeFacePoints(stream, face);
+                writeTextureInfo(stream, face);
+                std::fprintf(stream, " 0\n"); // extra value written here
+            }
+        };
+
+        class ValveFaceWriter : public QuakeFaceWriter {
+        public:
+            void writeFace(FILE* stream, const MapSnapshot::Face& face) const override {
+                writeFacePoints(stream, face);
+                writeValveTextureInfo(stream, face);
+                std::fprintf(stream, "\n");
+            }
+        private:
+            void writeValveTextureInfo(FILE* stream, const MapSnapshot::Face& face) const {
+                const auto& xAxis = face.textureXAxis;
+                const auto& yAxis = face.textureYAxis;
+
+                std::fprintf(stream, " %s [ %.6g %.6g %.6g %.6g ] [ %.6g %.6g %.6g %.6g ] %.6g %.6g %.6g",
+                             face.textureName().c_str(),
+
+                             xAxis.x(),
+                             xAxis.y(),
+                             xAxis.z(),
+                             face.attribs.xOffset(),
+
+                             yAxis.x(),
+                             yAxis.y(),
+                             yAxis.z(),
+                             face.attribs.yOffset(),
+
+                             face.attribs.rotation(),
+                             face.attribs.xScale(),
+                             face.attribs.yScale());
+            }
+        };
+
+        std::unique_ptr<FaceWriter> FaceWriter::create(const Model::MapFormat format) {
+            switch (format) {
+                case Model::MapFormat::Standard:
+                    return std::make_unique<QuakeFaceWriter>();
+                case Model::MapFormat::Quake2:
+                    // TODO 2427: Implement Quake3 serializers and use them
+                case Model::MapFormat::Quake3:
+                case Model::MapFormat::Quake3_Legacy:
+                    return std::make_unique<Quake2FaceWriter>();
+                case Model::MapFormat::Daikatana:
+                    return std::make_unique<DaikatanaFaceWriter>();
+                case Model::MapFormat::Valve:
+                    return std::make_unique<ValveFaceWriter>();
+                case Model::MapFormat::Hexen2:
+                    return std::make_unique<Hexen2FaceWriter>();
+                case Model::MapFormat::Unknown:
+                    throw FileFormatException("Unknown map file format");
+                switchDefault()
+            }
+        }
+
+        MapSnapshot::Face::Face(const Model::BrushFace* face) :
+        attribs(face->attribs().takeSnapshot()),
+        textureXAxis(face->textureXAxis()),
+        textureYAxis(face->textureYAxis()) {
+            const auto& facePoints = face->points();
+            for (size_t i = 0; i < 3; ++i) {
+                points[i] = facePoints[i];
+            }
+        }
+
+        const String& MapSnapshot::Face::textureName() const {
+            const auto& name = attribs.textureName();
+            return name.empty() ? Model::BrushFace::NoTextureName : name;
+        }
+
+        bool MapSnapshot::Face::hasSurfaceAttributes() const {
+            return attribs.surfaceContents() != 0 || attribs.surfaceFlags() != 0 || attribs.surfaceValue() != 0.0f;
+        }
+
+        bool MapSnapshot::Face::hasColor() const {
+            return attribs.color().a() > 0.0f;
+        }
+
+        MapSnapshot::MapSnapshot(const Model::MapFormat format, const String& gameName) :
+        m_format(format),
+        m_gameName(gameName) {}
+
+        MapSnapshot::MapSnapshot(Model::World& world, const String& gameName) :
+        m_format(world.format()),
+        m_gameName(gameName) {
+            NodeWriter writer(world, new MapFileSerializer(*this));
+            writer.writeMap();
+        }
+
+        Model::MapFormat MapSnapshot::format() const {
+            return m_format;
+        }
+
+        size_t MapSnapshot::faceCount() const {
+            return m_faces.size();
+        }
+
+        void MapSnapshot::beginEntity() {
+            m_entities.push_back(Entity{ 0, 0 });
+        }
+
+        void MapSnapshot::addAttribute(const String& name, const String& value) {
+            assert(!m_entities.empty());
+            m_attributes.push_back(Attribute{ name, value });
+            ++m_entities.back().attributeCount;
+        }
+
+        void MapSnapshot::beginBrush() {
+            assert(!m_entities.empty());
+            m_brushes.push_back(0);
+            ++m_entities.back().brushCount;
+        }
+
+        void MapSnapshot::addFace(const Model::BrushFace* face) {
+            assert(!m_brushes.empty());
+            m_faces.emplace_back(face);
+            ++m_brushes.back();
+        }
+
+        void MapSnapshot::write(FILE* stream) const {
+            const auto faceWriter = FaceWriter::create(m_format);
+
+            auto attribute = std::begin(m_attributes);
+            auto brush = std::begin(m_brushes);
+            auto face = std::begin(m_faces);
+
+            for (size_t entityNo = 0; entityNo < m_entities.size(); ++entityNo) {
+                const auto& entity = m_entities[entityNo];
+                std::fprintf(stream, "// entity %zu\n", entityNo);
+                std::fprintf(stream, "{\n");
+
+                for (size_t i = 0; i < entity.attributeCount; ++i, ++attribute) {
+                    std::fprintf(stream, "\"%s\" \"%s\"\n", attribute->name.c_str(), attribute->value.c_str());
+                }
+
+                for (size_t brushNo = 0; brushNo < entity.brushCount; ++brushNo, ++brush) {
+                    std::fprintf(stream, "// brush %zu\n", brushNo);
+                    std::fprintf(stream, "{\n");
+                    for (size_t i = 0; i < *brush; ++i, ++face) {
+                        faceWriter->writeFace(stream, *face);
+                    }
+                    std::fprintf(stream, "}\n");
+                }
+
+                std::fprintf(stream, "}\n");
+            }
+        }
+
+        void MapSnapshot::save(const Path& path) const {
+            const Path tempPath(path.asString() + ".tmp");
+            try {
+                {
+                    OpenFile open(tempPath, true);
+                    writeGameComment(open.file, m_gameName, Model::formatName(m_format));
+                    write(open.file);
+
+                    if (std::fflush(open.file) != 0 || std::ferror(open.file) != 0) {
+                        throw FileSystemException("Cannot write file: " + tempPath.asString());
+                    }
+                }
+                Disk::moveFile(tempPath, path, true);
+            } catch (const FileSystemException&) {
+                std::remove(tempPath.asString().c_str());
+                throw;
+            }
+        }
+    }
+}
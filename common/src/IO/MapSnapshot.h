@@ -0,0 +1,120 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_MapSnapshot
+#define TrenchBroom_MapSnapshot
+
+#include "Macros.h"
+#include "StringUtils.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/MapFormat.h"
+#include "Model/ModelTypes.h"
+
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        class Path;
+
+        /**
+         * A copy of everything that is written to a map file, in the order in which it is written. Taking a snapshot
+         * only copies values, which is much cheaper than formatting them, so a snapshot can be taken on the main thread
+         * and written on a worker thread while the map is being edited.
+         */
+        class MapSnapshot {
+        public:
+            class Face {
+            public:
+                vm::vec3 points[3];
+                Model::BrushFaceAttributes attribs;
+                vm::vec3 textureXAxis;
+                vm::vec3 textureYAxis;
+            public:
+                explicit Face(const Model::BrushFace* face);
+
+                /**
+                 * Returns the texture name to write, which is never empty.
+                 */
+                const String& textureName() const;
+                bool hasSurfaceAttributes() const;
+                bool hasColor() const;
+            };
+        private:
+            struct Attribute {
+                String name;
+                String value;
+            };
+
+            struct Entity {
+                size_t attributeCount;
+                size_t brushCount;
+            };
+
+            Model::MapFormat m_format;
+            String m_gameName;
+
+            std::vector<Entity> m_entities;
+            std::vector<Attribute> m_attributes;
+            // the number of faces of each brush
+            std::vector<size_t> m_brushes;
+            std::vector<Face> m_faces;
+        public:
+            /**
+             * Creates an empty snapshot that is filled by a MapFileSerializer.
+             */
+            MapSnapshot(Model::MapFormat format, const String& gameName);
+
+            /**
+             * Takes a snapshot of the given world. This also updates the file positions of the world's nodes, so it
+             * must be called on the main thread.
+             */
+            MapSnapshot(Model::World& world, const String& gameName);
+
+            Model::MapFormat format() const;
+            size_t faceCount() const;
+
+            void beginEntity();
+            void addAttribute(const String& name, const String& value);
+            void beginBrush();
+            void addFace(const Model::BrushFace* face);
+
+            /**
+             * Writes the entities of this snapshot to the given stream.
+             */
+            void write(FILE* stream) const;
+
+            /**
+             * Writes this snapshot to a map file with a game comment. The file is written to a temporary file next to
+             * the given path first, which then replaces the file at the given path, so that the file at the given path
+             * is never left half written. May be called on any thread.
+             *
+             * @throws FileSystemException if the file cannot be written
+             */
+            void save(const Path& path) const;
+
+            deleteCopyAndMove(MapSnapshot)
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MapSnapshot) */
@@ -86,6 +86,10 @@ namespace TrenchBroom {
         MappedFileBufferView(path, begin, size),
         m_container(std::move(container)) {}
 
+        const MappedFile& MappedFileView::container() const {
+            return *m_container;
+        }
+
         MappedFileBuffer::MappedFileBuffer(const Path& path, std::unique_ptr<char[]> buffer, const size_t size) :
         MappedFileBufferView(path, buffer.get(), buffer.get() + size),
         m_buffer(std::move(buffer)) {}
@@ -137,6 +137,13 @@ namespace TrenchBroom {
              @param size the size of the subrange
              */
             MappedFileView(MappedFile::Ptr container, const Path& path, const char* begin, size_t size);
+
+            /**
+             Returns the container file that contains this file.
+
+             @return the container file
+             */
+            const MappedFile& container() const;
         };
 
         /**
@@ -222,6 +222,41 @@ namespace TrenchBroom {
         vertexCount(static_cast<size_t>(i_vertexCount < 0 ? -i_vertexCount : i_vertexCount)),
         vertices(vertexCount) {}
 
+        Md2Parser::Md2FrameLoader::Md2FrameLoader(Md2FrameList frames, Md2MeshList meshes) :
+        m_frames(std::move(frames)),
+        m_meshes(std::move(meshes)) {}
+
+        Assets::EntityModel::MeshList Md2Parser::Md2FrameLoader::doLoadFrame(const size_t frameIndex) const {
+            assert(frameIndex < m_frames.size());
+            const auto& frame = m_frames[frameIndex];
+
+            size_t vertexCount = 0;
+            Renderer::IndexRangeMap::Size size;
+            for (const auto& md2Mesh : m_meshes) {
+                vertexCount += md2Mesh.vertices.size();
+                if (md2Mesh.type == Md2Mesh::Fan)
+                    size.inc(GL_TRIANGLE_FAN);
+                else
+                    size.inc(GL_TRIANGLE_STRIP);
+            }
+
+            Renderer::IndexRangeMapBuilder<Assets::EntityModel::Vertex::Spec> builder(vertexCount, size);
+            for (const auto& md2Mesh : m_meshes) {
+                if (!md2Mesh.vertices.empty()) {
+                    const auto vertices = getVertices(frame, md2Mesh.vertices);
+                    if (md2Mesh.type == Md2Mesh::Fan) {
+                        builder.addTriangleFan(vertices);
+                    } else {
+                        builder.addTriangleStrip(vertices);
+                    }
+                }
+            }
+
+            Assets::EntityModel::MeshList result;
+            result.push_back(std::make_unique<Assets::EntityModel::IndexedMesh>(builder.vertices(), builder.indices()));
+            return result;
+        }
+
         Md2Parser::Md2Parser(const String& name, const char* begin, const char* end, const Assets::Palette& palette, const FileSystem& fs) :
         m_name(name),
         m_begin(begin),
@@ -258,10 +293,10 @@ namespace TrenchBroom {
             const size_t commandOffset = readSize<int32_t>(cursor);
 
             const Md2SkinList skins = parseSkins(m_begin + skinOffset, skinCount);
-            const Md2FrameList frames = parseFrames(m_begin + frameOffset, frameCount, frameVertexCount);
-            const Md2MeshList meshes = parseMeshes(m_begin + commandOffset, commandCount);
+            Md2FrameList frames = parseFrames(m_begin + frameOffset, frameCount, frameVertexCount);
+            Md2MeshList meshes = parseMeshes(m_begin + commandOffset, commandCount);
             
-            return buildModel(skins, frames, meshes);
+            return buildModel(skins, std::move(frames), std::move(meshes));
         }
 
         Md2Parser::Md2SkinList Md2Parser::parseSkins(const char* begin, const size_t skinCount) {
@@ -304,12 +339,13 @@ namespace TrenchBroom {
             return meshes;
         }
 
-        Assets::EntityModel* Md2Parser::buildModel(const Md2SkinList& skins, const Md2FrameList& frames, const Md2MeshList& meshes) {
+        Assets::EntityModel* Md2Parser::buildModel(const Md2SkinList& skins, Md2FrameList frames, Md2MeshList meshes) {
             auto model = std::make_unique<Assets::EntityModel>(m_name);
             auto& surface = model->addSurface(m_name);
 
             loadSkins(surface, skins);
-            buildFrames(*model, surface, frames, meshes);
+            addFrames(*model, frames, meshes);
+            model->setFrameLoader(std::make_unique<Md2FrameLoader>(std::move(frames), std::move(meshes)));
 
             return model.release();
         }
@@ -321,48 +357,29 @@ namespace TrenchBroom {
             }
         }
 
-        void Md2Parser::buildFrames(Assets::EntityModel& model, Assets::EntityModel::Surface& surface, const Md2Parser::Md2FrameList& frames, const Md2Parser::Md2MeshList& meshes) {
+        void Md2Parser::addFrames(Assets::EntityModel& model, const Md2Parser::Md2FrameList& frames, const Md2Parser::Md2MeshList& meshes) {
+            // only the bounds are computed up front, the meshes are built by the frame loader when they are needed
             for (const auto& frame: frames) {
-                size_t vertexCount = 0;
-                Renderer::IndexRangeMap::Size size;
-                for (const auto& md2Mesh : meshes) {
-                    vertexCount += md2Mesh.vertices.size();
-                    if (md2Mesh.type == Md2Mesh::Fan)
-                        size.inc(GL_TRIANGLE_FAN);
-                    else
-                        size.inc(GL_TRIANGLE_STRIP);
-                }
-
                 bool boundsInitialized = false;
                 vm::bbox3f bounds;
 
-                Renderer::IndexRangeMapBuilder<Assets::EntityModel::Vertex::Spec> builder(vertexCount, size);
                 for (const auto& md2Mesh : meshes) {
-                    if (!md2Mesh.vertices.empty()) {
-                        vertexCount += md2Mesh.vertices.size();
-                        const auto vertices = getVertices(frame, md2Mesh.vertices);
-
+                    for (const auto& md2MeshVertex : md2Mesh.vertices) {
+                        const auto position = frame.vertex(md2MeshVertex.vertexIndex);
                         if (!boundsInitialized) {
-                            bounds = vm::bbox3f::mergeAll(std::begin(vertices), std::end(vertices), Renderer::GetVertexComponent1());
+                            bounds.min = bounds.max = position;
                             boundsInitialized = true;
                         } else {
-                            bounds = vm::merge(bounds, vm::bbox3f::mergeAll(std::begin(vertices), std::end(vertices), Renderer::GetVertexComponent1()));
-                        }
-
-                        if (md2Mesh.type == Md2Mesh::Fan) {
-                            builder.addTriangleFan(vertices);
-                        } else {
-                            builder.addTriangleStrip(vertices);
+                            bounds = vm::merge(bounds, position);
                         }
                     }
                 }
 
                 model.addFrame(frame.name, bounds);
-                surface.addIndexedMesh(builder.vertices(), builder.indices());
             }
         }
 
-        Assets::EntityModel::VertexList Md2Parser::getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const {
+        Assets::EntityModel::VertexList Md2Parser::getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) {
             using Vertex = Assets::EntityModel::Vertex;
 
             Vertex::List result(0);
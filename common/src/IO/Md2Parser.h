@@ -93,6 +93,19 @@ namespace TrenchBroom {
                 explicit Md2Mesh(int i_vertexCount);
             };
             using Md2MeshList =  std::vector<Md2Mesh>;
+
+            /**
+             Keeps the packed vertices of every frame and builds the mesh of a frame when it is requested.
+             */
+            class Md2FrameLoader : public Assets::EntityModel::FrameLoader {
+            private:
+                Md2FrameList m_frames;
+                Md2MeshList m_meshes;
+            public:
+                Md2FrameLoader(Md2FrameList frames, Md2MeshList meshes);
+            private:
+                Assets::EntityModel::MeshList doLoadFrame(size_t frameIndex) const override;
+            };
             
             
             String m_name;
@@ -108,11 +121,11 @@ namespace TrenchBroom {
             Md2FrameList parseFrames(const char* begin, size_t frameCount, size_t frameVertexCount);
             Md2MeshList parseMeshes(const char* begin, size_t commandCount);
 
-            Assets::EntityModel* buildModel(const Md2SkinList& skins, const Md2FrameList& frames, const Md2MeshList& meshes);
+            Assets::EntityModel* buildModel(const Md2SkinList& skins, Md2FrameList frames, Md2MeshList meshes);
             void loadSkins(Assets::EntityModel::Surface& surface, const Md2SkinList& skins);
-            void buildFrames(Assets::EntityModel& model, Assets::EntityModel::Surface& surface, const Md2FrameList& frames, const Md2MeshList& meshes);
+            void addFrames(Assets::EntityModel& model, const Md2FrameList& frames, const Md2MeshList& meshes);
 
-            Assets::EntityModel::VertexList getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices) const;
+            static Assets::EntityModel::VertexList getVertices(const Md2Frame& frame, const Md2MeshVertexList& meshVertices);
         };
     }
 }
@@ -45,6 +45,47 @@ namespace TrenchBroom {
             static const float VertexScale = 1.0f / 64.0f;
         }
 
+        void Md3Parser::Md3FrameLoader::addSurface(Md3Surface surface) {
+            m_surfaces.push_back(std::move(surface));
+        }
+
+        Assets::EntityModel::MeshList Md3Parser::Md3FrameLoader::doLoadFrame(const size_t frameIndex) const {
+            using Vertex = Assets::EntityModel::Vertex;
+
+            Assets::EntityModel::MeshList result;
+            result.reserve(m_surfaces.size());
+
+            for (const auto& surface : m_surfaces) {
+                if (frameIndex >= surface.frameCount) {
+                    result.push_back(nullptr);
+                    continue;
+                }
+
+                const auto& triangles = surface.triangles;
+                const auto frameOffset = frameIndex * surface.vertexCount;
+                const auto rangeMap = Renderer::IndexRangeMap(GL_TRIANGLES, 0, 3 * triangles.size());
+
+                std::vector<Vertex> frameVertices;
+                frameVertices.reserve(3 * triangles.size());
+
+                for (const auto& triangle : triangles) {
+                    if (triangle.i1 >= surface.vertexCount ||
+                        triangle.i2 >= surface.vertexCount ||
+                        triangle.i3 >= surface.vertexCount) {
+                        continue;
+                    }
+
+                    frameVertices.emplace_back(surface.positions[triangle.i1 + frameOffset], surface.texCoords[triangle.i1]);
+                    frameVertices.emplace_back(surface.positions[triangle.i2 + frameOffset], surface.texCoords[triangle.i2]);
+                    frameVertices.emplace_back(surface.positions[triangle.i3 + frameOffset], surface.texCoords[triangle.i3]);
+                }
+
+                result.push_back(std::make_unique<Assets::EntityModel::IndexedMesh>(frameVertices, rangeMap));
+            }
+
+            return result;
+        }
+
         Md3Parser::Md3Parser(const String& name, const char* begin, const char* end, const FileSystem& fs) :
         m_name(name),
         m_begin(begin),
@@ -81,10 +122,12 @@ namespace TrenchBroom {
             const auto surfaceOffset = reader.readSize<int32_t>();
 
             auto model = std::make_unique<Assets::EntityModel>(m_name);
+            auto loader = std::make_unique<Md3FrameLoader>();
 
             parseFrames(reader.subReaderFromBegin(frameOffset, frameCount * Md3Layout::FrameLength), frameCount, *model);
             // parseTags(reader.subReaderFromBegin(tagOffset, tagCount * Md3Layout::TagLength), tagCount);
-            parseSurfaces(reader.subReaderFromBegin(surfaceOffset), surfaceCount, *model, logger);
+            parseSurfaces(reader.subReaderFromBegin(surfaceOffset), surfaceCount, *model, *loader, logger);
+            model->setFrameLoader(std::move(loader));
 
             return model.release();
         }
@@ -113,7 +156,7 @@ namespace TrenchBroom {
         }
          */
 
-        void Md3Parser::parseSurfaces(CharArrayReader reader, const size_t surfaceCount, Assets::EntityModel& model, Logger& logger) {
+        void Md3Parser::parseSurfaces(CharArrayReader reader, const size_t surfaceCount, Assets::EntityModel& model, Md3FrameLoader& loader, Logger& logger) {
             auto surfaceReader = reader;
             for (size_t i = 0; i < surfaceCount; ++i) {
                 const auto ident = surfaceReader.readInt<int32_t>();
@@ -137,16 +180,18 @@ namespace TrenchBroom {
                 const auto vertexOffset = surfaceReader.readSize<int32_t>(); // all vertices for all frames are stored there!
                 const auto endOffset = surfaceReader.readSize<int32_t>();
 
-                const auto vertexPositions = parseVertexPositions(surfaceReader.subReaderFromBegin(vertexOffset, totalVertexCount * Md3Layout::VertexLength), frameCount, vertexCount);
-                const auto texCoords = parseTexCoords(surfaceReader.subReaderFromBegin(texCoordOffset, vertexCount * Md3Layout::TexCoordLength), vertexCount);
-                const auto vertices = buildVertices(vertexPositions, texCoords, frameCount, vertexCount);
+                Md3Surface md3Surface;
+                md3Surface.positions = parseVertexPositions(surfaceReader.subReaderFromBegin(vertexOffset, totalVertexCount * Md3Layout::VertexLength), frameCount, vertexCount);
+                md3Surface.texCoords = parseTexCoords(surfaceReader.subReaderFromBegin(texCoordOffset, vertexCount * Md3Layout::TexCoordLength), vertexCount);
+                md3Surface.triangles = parseTriangles(surfaceReader.subReaderFromBegin(triangleOffset, triangleCount * Md3Layout::TriangleLength), triangleCount);
+                md3Surface.frameCount = frameCount;
+                md3Surface.vertexCount = vertexCount;
 
-                const auto triangles = parseTriangles(surfaceReader.subReaderFromBegin(triangleOffset, triangleCount * Md3Layout::TriangleLength), triangleCount);
                 const auto shaders = parseShaders(surfaceReader.subReaderFromBegin(shaderOffset, shaderCount * Md3Layout::ShaderLength), shaderCount);
 
                 auto& surface = model.addSurface(surfaceName);
                 loadSurfaceSkins(surface, shaders, logger);
-                buildSurfaceFrames(surface, triangles, vertices, i, frameCount, vertexCount);
+                loader.addSurface(std::move(md3Surface));
 
                 surfaceReader = surfaceReader.subReaderFromBegin(endOffset);
             }
@@ -177,7 +222,7 @@ namespace TrenchBroom {
 
         std::vector<vm::vec3f> Md3Parser::parseVertexPositions(CharArrayReader reader, const size_t frameCount, const size_t vertexCount) {
             std::vector<vm::vec3f> result;
-            result.reserve(vertexCount);
+            result.reserve(frameCount * vertexCount);
             for (size_t i = 0; i < frameCount * vertexCount; ++i) {
                 const auto x = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
                 const auto y = static_cast<float>(reader.readInt<int16_t>()) * Md3Layout::VertexScale;
@@ -199,23 +244,6 @@ namespace TrenchBroom {
             return result;
         }
 
-        std::vector<Assets::EntityModel::Vertex> Md3Parser::buildVertices(const std::vector<vm::vec3f>& positions, const std::vector<vm::vec2f>& texCoords, const size_t frameCount, const size_t vertexCount) {
-            assert(positions.size() == frameCount * vertexCount);
-            assert(texCoords.size() == vertexCount);
-
-            using Vertex = Assets::EntityModel::Vertex;
-            std::vector<Vertex> result;
-            result.reserve(frameCount * vertexCount);
-
-            for (size_t i = 0; i < frameCount; ++i) {
-                for (size_t j = 0; j < vertexCount; ++j) {
-                    result.emplace_back(positions[i * vertexCount + j], texCoords[j]);
-                }
-            }
-
-            return result;
-        }
-
         void Md3Parser::loadSurfaceSkins(Assets::EntityModel::Surface& surface, const std::vector<Path>& shaders, Logger& logger) {
             TextureReader::PathSuffixNameStrategy nameStrategy(2, true);
             Quake3ShaderTextureReader shaderReader(nameStrategy, m_fs);
@@ -230,35 +258,5 @@ namespace TrenchBroom {
                 }
             }
         }
-
-        void Md3Parser::buildSurfaceFrames(Assets::EntityModel::Surface& surface, const std::vector<Md3Parser::Md3Triangle>& triangles, const std::vector<Assets::EntityModel::Vertex>& vertices, const size_t sufaceIndex, const size_t frameCount, const size_t vertexCountPerFrame) {
-            using Vertex = Assets::EntityModel::Vertex;
-
-            const auto rangeMap = Renderer::IndexRangeMap(GL_TRIANGLES, 0, 3 * triangles.size());
-            for (size_t i = 0; i < frameCount; ++i) {
-                const auto frameOffset = i * vertexCountPerFrame;
-
-                std::vector<Vertex> frameVertices;
-                frameVertices.reserve(3 * triangles.size());
-
-                for (const auto& triangle : triangles) {
-                    if (triangle.i1 + frameOffset >= vertices.size() ||
-                        triangle.i2 + frameOffset >= vertices.size() ||
-                        triangle.i3 + frameOffset >= vertices.size()) {
-                        continue;
-                    }
-
-                    const auto& v1 = vertices[triangle.i1 + frameOffset];
-                    const auto& v2 = vertices[triangle.i2 + frameOffset];
-                    const auto& v3 = vertices[triangle.i3 + frameOffset];
-
-                    frameVertices.push_back(v1);
-                    frameVertices.push_back(v2);
-                    frameVertices.push_back(v3);
-                }
-
-                surface.addIndexedMesh(frameVertices, rangeMap);
-            }
-        }
     }
 }
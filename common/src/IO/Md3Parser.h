@@ -48,6 +48,26 @@ namespace TrenchBroom {
             struct Md3Triangle {
                 size_t i1, i2, i3;
             };
+
+            struct Md3Surface {
+                std::vector<Md3Triangle> triangles;
+                std::vector<vm::vec3f> positions; // the vertex positions of all frames
+                std::vector<vm::vec2f> texCoords;
+                size_t frameCount;
+                size_t vertexCount; // the number of vertices per frame
+            };
+
+            /**
+             Keeps the vertex positions of every frame and builds the meshes of a frame when it is requested.
+             */
+            class Md3FrameLoader : public Assets::EntityModel::FrameLoader {
+            private:
+                std::vector<Md3Surface> m_surfaces;
+            public:
+                void addSurface(Md3Surface surface);
+            private:
+                Assets::EntityModel::MeshList doLoadFrame(size_t frameIndex) const override;
+            };
         public:
             Md3Parser(const String& name, const char* begin, const char* end, const FileSystem& fs);
         private:
@@ -55,16 +75,14 @@ namespace TrenchBroom {
 
             void parseFrames(CharArrayReader reader, size_t frameCount, Assets::EntityModel& model);
             // void parseTags(CharArrayReader reader, size_t tagCount);
-            void parseSurfaces(CharArrayReader surfaceReader, size_t surfaceCount, Assets::EntityModel& model, Logger& logger);
+            void parseSurfaces(CharArrayReader surfaceReader, size_t surfaceCount, Assets::EntityModel& model, Md3FrameLoader& loader, Logger& logger);
 
             std::vector<Md3Triangle> parseTriangles(CharArrayReader reader, size_t triangleCount);
             std::vector<Path> parseShaders(CharArrayReader reader, size_t shaderCount);
             std::vector<vm::vec3f> parseVertexPositions(CharArrayReader reader, size_t frameCount, size_t vertexCount);
             std::vector<vm::vec2f> parseTexCoords(CharArrayReader reader, size_t vertexCount);
-            std::vector<Assets::EntityModel::Vertex> buildVertices(const std::vector<vm::vec3f>& positions, const std::vector<vm::vec2f>& texCoords, size_t frameCount, size_t vertexCount);
 
             void loadSurfaceSkins(Assets::EntityModel::Surface& surface, const std::vector<Path>& shaders, Logger& logger);
-            void buildSurfaceFrames(Assets::EntityModel::Surface& surface, const std::vector<Md3Triangle>& triangles, const std::vector<Assets::EntityModel::Vertex>& vertices, size_t sufaceIndex, size_t frameCount, size_t vertexCountPerFrame);
         };
     }
 }
@@ -204,6 +204,73 @@ namespace TrenchBroom {
         };
 
         static const int MF_HOLEY = (1 << 14);
+
+        MdlParser::MdlFrameLoader::MdlFrameLoader(const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const vm::vec3f& origin, const vm::vec3f& scale) :
+        m_skinTriangles(skinTriangles),
+        m_skinVertices(skinVertices),
+        m_skinWidth(skinWidth),
+        m_skinHeight(skinHeight),
+        m_origin(origin),
+        m_scale(scale) {}
+
+        const MdlParser::MdlSkinTriangleList& MdlParser::MdlFrameLoader::skinTriangles() const {
+            return m_skinTriangles;
+        }
+
+        const MdlParser::MdlSkinVertexList& MdlParser::MdlFrameLoader::skinVertices() const {
+            return m_skinVertices;
+        }
+
+        const vm::vec3f& MdlParser::MdlFrameLoader::origin() const {
+            return m_origin;
+        }
+
+        const vm::vec3f& MdlParser::MdlFrameLoader::scale() const {
+            return m_scale;
+        }
+
+        void MdlParser::MdlFrameLoader::addFrame(PackedFrameVertexList vertices) {
+            m_frames.push_back(std::move(vertices));
+        }
+
+        Assets::EntityModel::MeshList MdlParser::MdlFrameLoader::doLoadFrame(const size_t frameIndex) const {
+            using Vertex = Assets::EntityModel::Vertex;
+            using VertexList = Vertex::List;
+
+            assert(frameIndex < m_frames.size());
+            const auto& packedVertices = m_frames[frameIndex];
+
+            std::vector<vm::vec3f> positions(m_skinVertices.size());
+            for (size_t i = 0; i < m_skinVertices.size(); ++i) {
+                positions[i] = unpackFrameVertex(packedVertices[i], m_origin, m_scale);
+            }
+
+            VertexList frameTriangles;
+            frameTriangles.reserve(m_skinTriangles.size() * 3);
+            for (const auto& triangle : m_skinTriangles) {
+                for (size_t j = 0; j < 3; ++j) {
+                    const auto vertexIndex = triangle.vertices[j];
+                    const auto& skinVertex = m_skinVertices[vertexIndex];
+
+                    auto texCoords = vm::vec2f(float(skinVertex.s) / float(m_skinWidth), float(skinVertex.t) / float(m_skinHeight));
+                    if (skinVertex.onseam && !triangle.front) {
+                        texCoords[0] += 0.5f;
+                    }
+
+                    frameTriangles.push_back(Vertex(positions[vertexIndex], texCoords));
+                }
+            }
+
+            Renderer::IndexRangeMap::Size size;
+            size.inc(GL_TRIANGLES, frameTriangles.size());
+
+            Renderer::IndexRangeMapBuilder<Assets::EntityModel::Vertex::Spec> builder(frameTriangles.size() * 3, size);
+            builder.addTriangles(frameTriangles);
+
+            Assets::EntityModel::MeshList result;
+            result.push_back(std::make_unique<Assets::EntityModel::IndexedMesh>(builder.vertices(), builder.indices()));
+            return result;
+        }
         
         MdlParser::MdlParser(const String& name, const char* begin, const char* end, const Assets::Palette& palette) :
         m_name(name),
@@ -248,7 +315,9 @@ namespace TrenchBroom {
             const auto skinVertices = parseSkinVertices(cursor, skinVertexCount);
             const auto skinTriangles = parseSkinTriangles(cursor, skinTriangleCount);
 
-            parseFrames(cursor, *model, surface, frameCount, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale);
+            auto loader = std::make_unique<MdlFrameLoader>(skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale);
+            parseFrames(cursor, *model, *loader, frameCount);
+            model->setFrameLoader(std::move(loader));
 
             return model.release();
         }
@@ -312,28 +381,29 @@ namespace TrenchBroom {
             return triangles;
         }
 
-        void MdlParser::parseFrames(const char*& cursor, Assets::EntityModel& model, Assets::EntityModel::Surface& surface, const size_t count, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const vm::vec3f& origin, const vm::vec3f& scale) {
+        void MdlParser::parseFrames(const char*& cursor, Assets::EntityModel& model, MdlFrameLoader& loader, const size_t count) {
+            const auto vertexCount = loader.skinVertices().size();
             for (size_t i = 0; i < count; ++i) {
                 const auto type = readInt<int32_t>(cursor);
                 if (type == 0) { // single frame
-                    parseFrame(cursor, model, surface, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale);
+                    parseFrame(cursor, model, loader);
                 } else { // frame group, but we only read the first frame
                     const auto* base = cursor;
                     const auto groupFrameCount = readSize<int32_t>(cursor);
 
                     const auto* frameCursor = base + MdlLayout::MultiFrameTimes + groupFrameCount * sizeof(float);
-                    parseFrame(frameCursor, model, surface, skinTriangles, skinVertices, skinWidth, skinHeight, origin, scale);
+                    parseFrame(frameCursor, model, loader);
 
                     // forward to after the last group frame as if we had read them all
-                    const auto offset = (groupFrameCount - 1) * (MdlLayout::SimpleFrameName + MdlLayout::SimpleFrameLength + skinVertices.size() * 4);
+                    const auto offset = (groupFrameCount - 1) * (MdlLayout::SimpleFrameName + MdlLayout::SimpleFrameLength + vertexCount * 4);
                     cursor = frameCursor + offset;
                 }
             }
         }
 
-        void MdlParser::parseFrame(const char*& cursor, Assets::EntityModel& model, Assets::EntityModel::Surface& surface, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, const size_t skinWidth, const size_t skinHeight, const vm::vec3f& origin, const vm::vec3f& scale) {
-            using Vertex = Assets::EntityModel::Vertex;
-            using VertexList = Vertex::List;
+        void MdlParser::parseFrame(const char*& cursor, Assets::EntityModel& model, MdlFrameLoader& loader) {
+            const auto& skinVertices = loader.skinVertices();
+            const auto& skinTriangles = loader.skinTriangles();
 
             char name[MdlLayout::SimpleFrameLength + 1];
             name[MdlLayout::SimpleFrameLength] = 0;
@@ -347,48 +417,24 @@ namespace TrenchBroom {
                 }
             }
 
-            std::vector<vm::vec3f> positions(skinVertices.size());
-            for (size_t i = 0; i < skinVertices.size(); ++i) {
-                positions[i] = unpackFrameVertex(packedVertices[i], origin, scale);
-            }
-
+            // only the bounds are computed up front, the mesh is built by the frame loader when it is needed
             vm::bbox3f bounds;
-
-            VertexList frameTriangles;
-            frameTriangles.reserve(skinTriangles.size());
             for (size_t i = 0; i < skinTriangles.size(); ++i) {
-                const auto& triangle = skinTriangles[i];
                 for (size_t j = 0; j < 3; ++j) {
-                    const auto vertexIndex = triangle.vertices[j];
-                    const auto& skinVertex = skinVertices[vertexIndex];
-
-                    auto texCoords = vm::vec2f(float(skinVertex.s) / float(skinWidth), float(skinVertex.t) / float(skinHeight));
-                    if (skinVertex.onseam && !triangle.front) {
-                        texCoords[0] += 0.5f;
-                    }
-
-                    const auto& position = positions[vertexIndex];
+                    const auto position = unpackFrameVertex(packedVertices[skinTriangles[i].vertices[j]], loader.origin(), loader.scale());
                     if (i == 0 && j == 0) {
                         bounds.min = bounds.max = position;
                     } else {
                         bounds = vm::merge(bounds, position);
                     }
-
-                    frameTriangles.push_back(Vertex(position, texCoords));
                 }
             }
 
-            Renderer::IndexRangeMap::Size size;
-            size.inc(GL_TRIANGLES, frameTriangles.size());
-
-            Renderer::IndexRangeMapBuilder<Assets::EntityModel::Vertex::Spec> builder(frameTriangles.size() * 3, size);
-            builder.addTriangles(frameTriangles);
-
             model.addFrame(String(name), bounds);
-            surface.addIndexedMesh(builder.vertices(), builder.indices());
+            loader.addFrame(std::move(packedVertices));
         }
 
-        vm::vec3f MdlParser::unpackFrameVertex(const PackedFrameVertex& vertex, const vm::vec3f& origin, const vm::vec3f& scale) const {
+        vm::vec3f MdlParser::unpackFrameVertex(const PackedFrameVertex& vertex, const vm::vec3f& origin, const vm::vec3f& scale) {
             vm::vec3f result;
             for (size_t i = 0; i < 3; ++i) {
                 result[i] = origin[i] + scale[i]*static_cast<float>(vertex[i]);
@@ -56,6 +56,31 @@ namespace TrenchBroom {
             using MdlSkinTriangleList = std::vector<MdlSkinTriangle>;
             using PackedFrameVertex = vm::vec<unsigned char, 4>;
             using PackedFrameVertexList = std::vector<PackedFrameVertex>;
+
+            /**
+             Keeps the packed vertices of every frame and builds the mesh of a frame when it is requested.
+             */
+            class MdlFrameLoader : public Assets::EntityModel::FrameLoader {
+            private:
+                MdlSkinTriangleList m_skinTriangles;
+                MdlSkinVertexList m_skinVertices;
+                size_t m_skinWidth;
+                size_t m_skinHeight;
+                vm::vec3f m_origin;
+                vm::vec3f m_scale;
+                std::vector<PackedFrameVertexList> m_frames;
+            public:
+                MdlFrameLoader(const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, size_t skinWidth, size_t skinHeight, const vm::vec3f& origin, const vm::vec3f& scale);
+
+                const MdlSkinTriangleList& skinTriangles() const;
+                const MdlSkinVertexList& skinVertices() const;
+                const vm::vec3f& origin() const;
+                const vm::vec3f& scale() const;
+
+                void addFrame(PackedFrameVertexList vertices);
+            private:
+                Assets::EntityModel::MeshList doLoadFrame(size_t frameIndex) const override;
+            };
             
             String m_name;
             const char* m_begin;
@@ -69,9 +94,9 @@ namespace TrenchBroom {
             void parseSkins(const char*& cursor, Assets::EntityModel::Surface& surface, size_t count, size_t width, size_t height, int flags);
             MdlSkinVertexList parseSkinVertices(const char*& cursor, size_t count);
             MdlSkinTriangleList parseSkinTriangles(const char*& cursor, size_t count);
-            void parseFrames(const char*& cursor, Assets::EntityModel& model, Assets::EntityModel::Surface& surface, size_t count, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, size_t skinWidth, size_t skinHeight, const vm::vec3f& origin, const vm::vec3f& scale);
-            void parseFrame(const char*& cursor, Assets::EntityModel& model, Assets::EntityModel::Surface& surface, const MdlSkinTriangleList& skinTriangles, const MdlSkinVertexList& skinVertices, size_t skinWidth, size_t skinHeight, const vm::vec3f& origin, const vm::vec3f& scale);
-            vm::vec3f unpackFrameVertex(const PackedFrameVertex& vertex, const vm::vec3f& origin, const vm::vec3f& scale) const;
+            void parseFrames(const char*& cursor, Assets::EntityModel& model, MdlFrameLoader& loader, size_t count);
+            void parseFrame(const char*& cursor, Assets::EntityModel& model, MdlFrameLoader& loader);
+            static vm::vec3f unpackFrameVertex(const PackedFrameVertex& vertex, const vm::vec3f& origin, const vm::vec3f& scale);
         };
     }
 }
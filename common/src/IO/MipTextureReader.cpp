@@ -97,5 +97,22 @@ namespace TrenchBroom {
                 return new Assets::Texture(textureName(path), 16, 16);
             }
         }
+
+        Assets::Texture* MipTextureReader::doReadTextureHeader(MappedFile::Ptr file) const {
+            try {
+                CharArrayReader reader(file->begin(), file->end());
+                const auto name = reader.readString(MipLayout::TextureNameLength);
+                const auto width = reader.readSize<int32_t>();
+                const auto height = reader.readSize<int32_t>();
+                if (width == 0 || height == 0 || width * height > file->size()) {
+                    return nullptr;
+                }
+
+                const auto masked = name.size() > 0 && name.at(0) == '{';
+                return new Assets::Texture(textureName(name, file->path()), width, height, GL_RGBA, Assets::Texture::selectTextureType(masked));
+            } catch (const CharArrayReaderException&) {
+                return nullptr;
+            }
+        }
     }
 }
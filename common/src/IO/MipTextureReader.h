@@ -37,6 +37,7 @@ namespace TrenchBroom {
             static size_t mipFileSize(size_t width, size_t height, size_t mipLevels);
         protected:
             Assets::Texture* doReadTexture(MappedFile::Ptr file) const override;
+            Assets::Texture* doReadTextureHeader(MappedFile::Ptr file) const override;
             virtual Assets::Palette doGetPalette(CharArrayReader& reader, const size_t offset[], size_t width, size_t height) const = 0;
         };
     }
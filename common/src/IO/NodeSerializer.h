@@ -33,8 +33,9 @@ namespace TrenchBroom {
         class NodeSerializer {
         private:
             class BrushSerializer;
-        protected:
+        public:
             static const int FloatPrecision = 17;
+        protected:
             using ObjectNo = unsigned int;
         private:
             template <typename T>
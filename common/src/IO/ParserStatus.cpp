@@ -96,6 +96,15 @@ namespace TrenchBroom {
             throw ParserException(buildMessage(str));
         }
 
+        void ParserStatus::forward(const Logger::LogLevel level, const String& str) {
+            StringStream msg;
+            if (!m_prefix.empty()) {
+                msg << m_prefix << ": ";
+            }
+            msg << str;
+            doLog(level, msg.str());
+        }
+
         void ParserStatus::log(const Logger::LogLevel level, const size_t line, const size_t column, const String& str) {
             doLog(level, buildMessage(line, column, str));
         }
@@ -53,6 +53,12 @@ namespace TrenchBroom {
             void warn(const String& str);
             void error(const String& str);
             void errorAndThrow(const String& str);
+
+            /**
+             * Logs a message that has already been formatted by another parser status without a prefix, e.g. one that
+             * collected the messages of a worker thread. The prefix of this parser status is prepended to the message.
+             */
+            void forward(Logger::LogLevel level, const String& str);
         private:
             void log(Logger::LogLevel level, size_t line, size_t column, const String& str);
             String buildMessage(size_t line, size_t column, const String& str) const;
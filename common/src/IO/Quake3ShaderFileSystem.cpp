@@ -20,11 +20,14 @@
 #include "Quake3ShaderFileSystem.h"
 
 #include "CollectionUtils.h"
+#include "ParallelUtils.h"
 #include "Assets/Quake3Shader.h"
 #include "IO/Quake3ShaderParser.h"
 #include "IO/SimpleParserStatus.h"
 
 #include <memory>
+#include <unordered_map>
+#include <utility>
 
 namespace TrenchBroom {
     namespace IO {
@@ -42,20 +45,73 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * A shader script that is parsed on a worker thread. The messages of the parser are collected and logged on the
+         * calling thread afterwards.
+         */
+        class Quake3ShaderFileSystem::ShaderFile {
+        private:
+            class Status : public ParserStatus {
+            public:
+                using Message = std::pair<Logger::LogLevel, String>;
+                std::vector<Message> messages;
+            public:
+                Status() :
+                ParserStatus(nullLogger(), "") {}
+            private:
+                static Logger& nullLogger() {
+                    static NullLogger logger;
+                    return logger;
+                }
+
+                void doProgress(const double progress) override {}
+
+                void doLog(const Logger::LogLevel level, const String& str) override {
+                    messages.push_back(std::make_pair(level, str));
+                }
+            };
+
+            MappedFile::Ptr m_file;
+            Status m_status;
+            std::vector<Assets::Quake3Shader> m_shaders;
+        public:
+            explicit ShaderFile(MappedFile::Ptr file) :
+            m_file(std::move(file)) {}
+
+            void parse() {
+                Quake3ShaderParser parser(m_file->begin(), m_file->end());
+                m_shaders = parser.parse(m_status);
+            }
+
+            void replay(Logger& logger, std::vector<Assets::Quake3Shader>& shaders) {
+                SimpleParserStatus status(logger, m_file->path().asString());
+                for (const auto& message : m_status.messages) {
+                    status.forward(message.first, message.second);
+                }
+                VectorUtils::append(shaders, m_shaders);
+            }
+        };
+
         std::vector<Assets::Quake3Shader> Quake3ShaderFileSystem::loadShaders() const {
             auto result = std::vector<Assets::Quake3Shader>();
 
             const auto scriptsPath = Path("scripts");
             if (next().directoryExists(scriptsPath)) {
                 const auto paths = next().findItems(scriptsPath, FileExtensionMatcher("shader"));
+
+                // the files are opened on this thread because not every file system can be accessed concurrently
+                std::vector<ShaderFile> files;
+                files.reserve(paths.size());
                 for (const auto& path : paths) {
-                    // m_logger.debug() << "Loading shader " << path.asString();
+                    files.emplace_back(next().openFile(path));
+                }
 
-                    const auto file = next().openFile(path);
+                ParallelUtils::parallelFor(files.size(), [&files](const size_t i) {
+                    files[i].parse();
+                });
 
-                    Quake3ShaderParser parser(file->begin(), file->end());
-                    SimpleParserStatus status(m_logger, file->path().asString());
-                    VectorUtils::append(result, parser.parse(status));
+                for (auto& file : files) {
+                    file.replay(m_logger, result);
                 }
             }
 
@@ -78,26 +134,35 @@ namespace TrenchBroom {
             linkStandaloneShaders(shaders);
         }
 
+        static String shaderKey(const Path& shaderPath) {
+            return StringUtils::toLower(shaderPath.asString('/'));
+        }
+
         void Quake3ShaderFileSystem::linkTextures(const Path::List& textures, std::vector<Assets::Quake3Shader>& shaders) {
             m_logger.debug() << "Linking textures...";
+
+            // Shaders are matched case insensitively, like all paths in this file system. If several shaders have the
+            // same path, the first one is linked to a texture.
+            std::unordered_map<String, size_t> shaderIndices;
+            shaderIndices.reserve(shaders.size());
+            for (size_t i = 0; i < shaders.size(); ++i) {
+                shaderIndices.emplace(shaderKey(shaders[i].shaderPath), i);
+            }
+
+            std::vector<bool> linked(shaders.size(), false);
             for (const auto& texture : textures) {
                 const auto shaderPath = texture.deleteExtension();
 
                 // Only link a shader if it has not been linked yet.
                 if (!fileExists(shaderPath)) {
-                    const auto shaderIt = std::find_if(std::begin(shaders), std::end(shaders), [&shaderPath](const auto& shader){
-                        return shaderPath == shader.shaderPath;
-                    });
-
-                    if (shaderIt != std::end(shaders)) {
+                    const auto indexIt = shaderIndices.find(shaderKey(shaderPath));
+                    if (indexIt != std::end(shaderIndices)) {
                         // Found a matching shader.
-                        auto& shader = *shaderIt;
+                        const auto index = indexIt->second;
+                        linked[index] = true;
 
-                        auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(shader, shaderPath);
+                        auto shaderFile = std::make_shared<ObjectFile<Assets::Quake3Shader>>(std::move(shaders[index]), shaderPath);
                         m_root.addFile(shaderPath, std::make_unique<SimpleFile>(std::move(shaderFile)));
-
-                        // Remove the shader so that we don't revisit it when linking standalone shaders.
-                        shaders.erase(shaderIt);
                     } else {
                         // No matching shader found, generate one.
                         auto shader = Assets::Quake3Shader();
@@ -111,6 +176,18 @@ namespace TrenchBroom {
                     }
                 }
             }
+
+            // Remove the linked shaders so that we don't revisit them when linking standalone shaders.
+            size_t count = 0;
+            for (size_t i = 0; i < shaders.size(); ++i) {
+                if (!linked[i]) {
+                    if (count != i) {
+                        shaders[count] = std::move(shaders[i]);
+                    }
+                    ++count;
+                }
+            }
+            shaders.erase(std::next(std::begin(shaders), static_cast<std::ptrdiff_t>(count)), std::end(shaders));
         }
 
         void Quake3ShaderFileSystem::linkStandaloneShaders(std::vector<Assets::Quake3Shader>& shaders) {
@@ -41,6 +41,8 @@ namespace TrenchBroom {
          */
         class Quake3ShaderFileSystem : public ImageFileSystemBase {
         private:
+            class ShaderFile;
+
             Path::List m_searchPaths;
             Logger& m_logger;
         public:
@@ -20,12 +20,17 @@
 #include "StandardMapParser.h"
 
 #include "Logger.h"
+#include "ParallelUtils.h"
 #include "TemporarilySetAny.h"
+#include "IO/ParserStatus.h"
 #include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
 
 #include <vecmath/plane.h>
 #include <vecmath/vec.h>
 
+#include <memory>
+
 namespace TrenchBroom {
     namespace IO {
         const String& QuakeMapTokenizer::NumberDelim() {
@@ -37,6 +42,10 @@ namespace TrenchBroom {
         Tokenizer(begin, end, "\"", '\\'),
         m_skipEol(true) {}
         
+        QuakeMapTokenizer::QuakeMapTokenizer(const char* begin, const char* end, const size_t line, const size_t column) :
+        Tokenizer(begin, end, "\"", '\\', line, column),
+        m_skipEol(true) {}
+
         QuakeMapTokenizer::QuakeMapTokenizer(const String& str) :
         Tokenizer(str, "\"", '\\'),
         m_skipEol(true) {}
@@ -126,19 +135,271 @@ namespace TrenchBroom {
             return Token(QuakeMapToken::Eof, nullptr, nullptr, length(), line(), column());
         }
 
+        /**
+         * A part of the input that can be parsed independently of the other parts. A chunk contains either a
+         * sequence of complete entities, the opening brace and the attributes of a large entity, or a sequence of
+         * brushes of a large entity. The end of a large entity is represented by a footer chunk that contains no
+         * input at all.
+         */
+        class StandardMapParser::Chunk {
+        public:
+            typedef enum {
+                Type_Entities,
+                Type_EntityHeader,
+                Type_Brushes,
+                Type_EntityFooter
+            } Type;
+
+            Type type;
+            const char* begin;
+            const char* end;
+            size_t line;
+            size_t column;
+            size_t lineCount;
+        public:
+            Chunk(const Type i_type, const char* i_begin, const char* i_end, const size_t i_line, const size_t i_column, const size_t i_lineCount = 0) :
+            type(i_type),
+            begin(i_begin),
+            end(i_end),
+            line(i_line),
+            column(i_column),
+            lineCount(i_lineCount) {}
+        };
+
+        /**
+         * Parses a single chunk and records the resulting callbacks and log messages so that they can be replayed
+         * later on another parser.
+         */
+        class StandardMapParser::ChunkParser : public StandardMapParser {
+        private:
+            typedef enum {
+                Event_BeginEntity,
+                Event_EndEntity,
+                Event_BeginBrush,
+                Event_EndBrush,
+                Event_BrushFace,
+                Event_Log
+            } EventType;
+
+            using Event = std::pair<EventType, size_t>;
+            using EventList = std::vector<Event>;
+
+            class Status : public ParserStatus {
+            public:
+                using Message = std::pair<Logger::LogLevel, String>;
+            private:
+                EventList& m_events;
+                std::vector<Message> m_messages;
+            public:
+                explicit Status(EventList& events) :
+                ParserStatus(nullLogger(), ""),
+                m_events(events) {}
+
+                const Message& message(const size_t index) const {
+                    return m_messages[index];
+                }
+            private:
+                static Logger& nullLogger() {
+                    static NullLogger logger;
+                    return logger;
+                }
+
+                void doProgress(const double progress) override {}
+
+                void doLog(const Logger::LogLevel level, const String& str) override {
+                    m_events.push_back(std::make_pair(Event_Log, m_messages.size()));
+                    m_messages.push_back(std::make_pair(level, str));
+                }
+            };
+
+            class BeginEntity {
+            public:
+                size_t line;
+                Model::EntityAttribute::List attributes;
+                ExtraAttributes extraAttributes;
+
+                BeginEntity(const size_t i_line, const Model::EntityAttribute::List& i_attributes, const ExtraAttributes& i_extraAttributes) :
+                line(i_line),
+                attributes(i_attributes),
+                extraAttributes(i_extraAttributes) {}
+            };
+
+            class EndBrush {
+            public:
+                size_t startLine;
+                size_t lineCount;
+                ExtraAttributes extraAttributes;
+
+                EndBrush(const size_t i_startLine, const size_t i_lineCount, const ExtraAttributes& i_extraAttributes) :
+                startLine(i_startLine),
+                lineCount(i_lineCount),
+                extraAttributes(i_extraAttributes) {}
+            };
+
+            class Face {
+            public:
+                size_t line;
+                vm::vec3 point1;
+                vm::vec3 point2;
+                vm::vec3 point3;
+                Model::BrushFaceAttributes attribs;
+                vm::vec3 texAxisX;
+                vm::vec3 texAxisY;
+
+                Face(const size_t i_line, const vm::vec3& i_point1, const vm::vec3& i_point2, const vm::vec3& i_point3, const Model::BrushFaceAttributes& i_attribs, const vm::vec3& i_texAxisX, const vm::vec3& i_texAxisY) :
+                line(i_line),
+                point1(i_point1),
+                point2(i_point2),
+                point3(i_point3),
+                attribs(i_attribs),
+                texAxisX(i_texAxisX),
+                texAxisY(i_texAxisY) {}
+            };
+
+            const Chunk& m_chunk;
+            EventList m_events;
+            Status m_status;
+
+            std::vector<BeginEntity> m_beginEntities;
+            std::vector<std::pair<size_t, size_t>> m_endEntities;
+            std::vector<size_t> m_beginBrushes;
+            std::vector<EndBrush> m_endBrushes;
+            std::vector<Face> m_faces;
+        public:
+            explicit ChunkParser(const Chunk& chunk) :
+            StandardMapParser(chunk.begin, chunk.end, chunk.line, chunk.column),
+            m_chunk(chunk),
+            m_status(m_events) {}
+
+            /**
+             * Parses the chunk. Throws a ParserException if the chunk cannot be parsed.
+             */
+            void parse(const Model::MapFormat format) {
+                switch (m_chunk.type) {
+                    case Chunk::Type_Entities:
+                        parseEntities(format, m_status);
+                        break;
+                    case Chunk::Type_EntityHeader:
+                        setFormat(format);
+                        parseEntityHeader(m_status);
+                        break;
+                    case Chunk::Type_Brushes:
+                        parseBrushes(format, m_status);
+                        break;
+                    case Chunk::Type_EntityFooter:
+                        endEntity(m_chunk.line, m_chunk.lineCount, m_status);
+                        break;
+                    switchDefault()
+                }
+
+            }
+
+            /**
+             * Passes the recorded callbacks and log messages on to the given parser and status.
+             */
+            void replay(StandardMapParser& target, ParserStatus& status) const {
+                for (const auto& event : m_events) {
+                    const auto index = event.second;
+                    switch (event.first) {
+                        case Event_BeginEntity: {
+                            const auto& e = m_beginEntities[index];
+                            target.beginEntity(e.line, e.attributes, e.extraAttributes, status);
+                            break;
+                        }
+                        case Event_EndEntity: {
+                            const auto& e = m_endEntities[index];
+                            target.endEntity(e.first, e.second, status);
+                            break;
+                        }
+                        case Event_BeginBrush:
+                            target.beginBrush(m_beginBrushes[index], status);
+                            break;
+                        case Event_EndBrush: {
+                            const auto& e = m_endBrushes[index];
+                            target.endBrush(e.startLine, e.lineCount, e.extraAttributes, status);
+                            break;
+                        }
+                        case Event_BrushFace: {
+                            const auto& f = m_faces[index];
+                            target.brushFace(f.line, f.point1, f.point2, f.point3, f.attribs, f.texAxisX, f.texAxisY, status);
+                            break;
+                        }
+                        case Event_Log: {
+                            const auto& m = m_status.message(index);
+                            status.forward(m.first, m.second);
+                            break;
+                        }
+                        switchDefault()
+                    }
+                }
+            }
+        private:
+            void onFormatSet(const Model::MapFormat format) override {}
+
+            void onBeginEntity(const size_t line, const Model::EntityAttribute::List& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status) override {
+                m_events.push_back(std::make_pair(Event_BeginEntity, m_beginEntities.size()));
+                m_beginEntities.push_back(BeginEntity(line, attributes, extraAttributes));
+            }
+
+            void onEndEntity(const size_t startLine, const size_t lineCount, ParserStatus& status) override {
+                m_events.push_back(std::make_pair(Event_EndEntity, m_endEntities.size()));
+                m_endEntities.push_back(std::make_pair(startLine, lineCount));
+            }
+
+            void onBeginBrush(const size_t line, ParserStatus& status) override {
+                m_events.push_back(std::make_pair(Event_BeginBrush, m_beginBrushes.size()));
+                m_beginBrushes.push_back(line);
+            }
+
+            void onEndBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) override {
+                m_events.push_back(std::make_pair(Event_EndBrush, m_endBrushes.size()));
+                m_endBrushes.push_back(EndBrush(startLine, lineCount, extraAttributes));
+            }
+
+            void onBrushFace(const size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY, ParserStatus& status) override {
+                m_events.push_back(std::make_pair(Event_BrushFace, m_faces.size()));
+                m_faces.push_back(Face(line, point1, point2, point3, attribs, texAxisX, texAxisY));
+            }
+        };
+
         const String StandardMapParser::BrushPrimitiveId = "brushDef";
         const String StandardMapParser::PatchId = "patchDef2";
+        const size_t StandardMapParser::ChunkSize = 256 * 1024;
 
         StandardMapParser::StandardMapParser(const char* begin, const char* end) :
+        m_begin(begin),
+        m_end(end),
         m_tokenizer(QuakeMapTokenizer(begin, end)),
-        m_format(Model::MapFormat::Unknown) {}
+        m_format(Model::MapFormat::Unknown),
+        m_threadCount(0),
+        m_parsedChunkCount(0) {}
         
         StandardMapParser::StandardMapParser(const String& str) :
+        m_begin(str.c_str()),
+        m_end(str.c_str() + str.size()),
         m_tokenizer(QuakeMapTokenizer(str)),
-        m_format(Model::MapFormat::Unknown) {}
+        m_format(Model::MapFormat::Unknown),
+        m_threadCount(0),
+        m_parsedChunkCount(0) {}
         
         StandardMapParser::~StandardMapParser() {}
 
+        void StandardMapParser::setThreadCount(const size_t threadCount) {
+            m_threadCount = threadCount;
+        }
+
+        size_t StandardMapParser::parsedChunkCount() const {
+            return m_parsedChunkCount;
+        }
+
+        StandardMapParser::StandardMapParser(const char* begin, const char* end, const size_t line, const size_t column) :
+        m_begin(begin),
+        m_end(end),
+        m_tokenizer(QuakeMapTokenizer(begin, end, line, column)),
+        m_format(Model::MapFormat::Unknown),
+        m_threadCount(0),
+        m_parsedChunkCount(0) {}
+
         Model::MapFormat StandardMapParser::detectFormat() {
             auto format = Model::MapFormat::Unknown;
             
@@ -203,6 +464,44 @@ namespace TrenchBroom {
             }
         }
         
+        void StandardMapParser::parseEntitiesInChunks(const Model::MapFormat format, ParserStatus& status) {
+            m_parsedChunkCount = 0;
+
+            auto chunks = ChunkList();
+            const auto threadCount = m_threadCount > 0 ? m_threadCount : ParallelUtils::threadCount(2);
+            if (static_cast<size_t>(m_end - m_begin) < 2 * ChunkSize ||
+                threadCount < 2 ||
+                !findChunks(chunks) ||
+                chunks.size() < 2) {
+                parseEntities(format, status);
+                return;
+            }
+
+            std::vector<std::unique_ptr<ChunkParser>> parsers;
+            parsers.reserve(chunks.size());
+            for (const auto& chunk : chunks) {
+                parsers.push_back(std::make_unique<ChunkParser>(chunk));
+            }
+
+            try {
+                ParallelUtils::parallelFor(parsers.size(), [&](const size_t i) {
+                    parsers[i]->parse(format);
+                });
+            } catch (const ParserException&) {
+                // parse everything again so that the error is reported with the usual context
+                parsers.clear();
+                parseEntities(format, status);
+                return;
+            }
+
+            setFormat(format);
+            for (auto& parser : parsers) {
+                parser->replay(*this, status);
+                parser.reset();
+            }
+            m_parsedChunkCount = chunks.size();
+        }
+
         void StandardMapParser::parseBrushes(const Model::MapFormat format, ParserStatus& status) {
             setFormat(format);
 
@@ -236,6 +535,275 @@ namespace TrenchBroom {
             formatSet(format);
         }
 
+        namespace {
+            /**
+             * Moves over the input like the tokenizer does, keeping track of the line and column numbers and of
+             * escaped characters, but without creating any tokens.
+             */
+            class MapScanner {
+            private:
+                const char* m_cur;
+                const char* m_end;
+                size_t m_line;
+                size_t m_column;
+                bool m_escaped;
+            public:
+                MapScanner(const char* begin, const char* end) :
+                m_cur(begin),
+                m_end(end),
+                m_line(1),
+                m_column(1),
+                m_escaped(false) {}
+
+                bool eof() const {
+                    return m_cur >= m_end;
+                }
+
+                const char* curPos() const {
+                    return m_cur;
+                }
+
+                char curChar() const {
+                    return eof() ? 0 : *m_cur;
+                }
+
+                char lookAhead(const size_t offset = 1) const {
+                    return m_cur + offset >= m_end ? 0 : *(m_cur + offset);
+                }
+
+                size_t line() const {
+                    return m_line;
+                }
+
+                size_t column() const {
+                    return m_column;
+                }
+
+                bool isWhitespace(const char c) const {
+                    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+                }
+
+                bool isDelimiter(const char c) const {
+                    return c == 0 || isWhitespace(c);
+                }
+
+                void advance() {
+                    switch (*m_cur) {
+                        case '\r':
+                            if (lookAhead() == '\n') {
+                                ++m_column;
+                                break;
+                            }
+                            switchFallthrough();
+                        case '\n':
+                            ++m_line;
+                            m_column = 1;
+                            m_escaped = false;
+                            break;
+                        default:
+                            ++m_column;
+                            m_escaped = (*m_cur == '\\') && !m_escaped;
+                            break;
+                    }
+                    ++m_cur;
+                }
+
+                void advanceUntilWhitespace() {
+                    while (!eof() && !isWhitespace(*m_cur)) {
+                        advance();
+                    }
+                }
+
+                void advanceUntilEol() {
+                    while (!eof() && *m_cur != '\n' && *m_cur != '\r') {
+                        advance();
+                    }
+                }
+
+                /**
+                 * Moves past a quoted string, assuming that the current character is the opening quotation mark.
+                 * Returns false if the string is not terminated.
+                 */
+                bool skipQuotedString() {
+                    advance();
+                    while (!eof()) {
+                        if (*m_cur == '"') {
+                            if (!m_escaped) {
+                                break;
+                            }
+                            // same hack as in the tokenizer: an escaped quotation mark at the end of a line or before
+                            // a closing brace terminates the string
+                            const auto next = lookAhead();
+                            if (next == '\n' || next == '}') {
+                                m_escaped = false;
+                                break;
+                            }
+                        }
+                        advance();
+                    }
+                    if (eof()) {
+                        return false;
+                    }
+                    advance();
+                    return true;
+                }
+            };
+        }
+
+        bool StandardMapParser::findChunks(ChunkList& chunks) const {
+            class Position {
+            public:
+                const char* pos;
+                size_t line;
+                size_t column;
+            public:
+                Position(const MapScanner& scanner) :
+                pos(scanner.curPos()),
+                line(scanner.line()),
+                column(scanner.column()) {}
+            };
+
+            auto scanner = MapScanner(m_begin, m_end);
+
+            // the start of the chunk that contains the entities found so far
+            auto groupStart = Position(scanner);
+            auto groupEntityCount = size_t(0);
+
+            // the entity that is currently being scanned
+            auto entityStart = Position(scanner);
+            auto brushStarts = std::vector<Position>();
+            auto splittable = true;
+
+            auto depth = size_t(0);
+            while (!scanner.eof()) {
+                const auto c = scanner.curChar();
+                auto token = false;
+                switch (c) {
+                    case ' ':
+                    case '\t':
+                    case '\n':
+                    case '\r':
+                        scanner.advance();
+                        break;
+                    case '/':
+                        scanner.advance();
+                        if (scanner.curChar() == '/') {
+                            scanner.advance();
+                            if (scanner.curChar() == '/' && scanner.lookAhead() == ' ') {
+                                scanner.advance();
+                                token = true;
+                            } else {
+                                scanner.advanceUntilEol();
+                            }
+                        }
+                        break;
+                    case '"':
+                        if (!scanner.skipQuotedString()) {
+                            return false;
+                        }
+                        token = true;
+                        break;
+                    case '(':
+                    case ')':
+                    case '[':
+                    case ']':
+                        scanner.advance();
+                        token = true;
+                        break;
+                    case '{':
+                    case '}':
+                        if (!scanner.isDelimiter(scanner.lookAhead()) && scanner.lookAhead() != '{' && scanner.lookAhead() != '}') {
+                            // texture names may start with a brace
+                            if (depth < 2) {
+                                return false;
+                            }
+                            scanner.advanceUntilWhitespace();
+                            break;
+                        }
+
+                        if (c == '{') {
+                            if (depth == 0) {
+                                entityStart = Position(scanner);
+                                brushStarts.clear();
+                                splittable = true;
+                            } else if (depth == 1) {
+                                brushStarts.push_back(Position(scanner));
+                            }
+                            ++depth;
+                            scanner.advance();
+                        } else {
+                            if (depth == 0) {
+                                return false;
+                            }
+                            --depth;
+
+                            if (depth > 0) {
+                                scanner.advance();
+                                break;
+                            }
+
+                            const auto entityEnd = Position(scanner);
+                            scanner.advance();
+
+                            const auto entitySize = static_cast<size_t>(scanner.curPos() - entityStart.pos);
+                            if (splittable && !brushStarts.empty() && entitySize > ChunkSize) {
+                                // split the entity into a header chunk, several brush chunks and a footer chunk
+                                const auto& headerStart = groupEntityCount > 0 ? entityStart : groupStart;
+                                if (groupEntityCount > 0) {
+                                    chunks.push_back(Chunk(Chunk::Type_Entities, groupStart.pos, entityStart.pos, groupStart.line, groupStart.column));
+                                }
+                                chunks.push_back(Chunk(Chunk::Type_EntityHeader, headerStart.pos, brushStarts.front().pos, headerStart.line, headerStart.column));
+
+                                size_t first = 0;
+                                for (size_t i = 1; i <= brushStarts.size(); ++i) {
+                                    const auto* end = i < brushStarts.size() ? brushStarts[i].pos : entityEnd.pos;
+                                    if (i == brushStarts.size() || static_cast<size_t>(end - brushStarts[first].pos) >= ChunkSize) {
+                                        const auto& start = brushStarts[first];
+                                        chunks.push_back(Chunk(Chunk::Type_Brushes, start.pos, end, start.line, start.column));
+                                        first = i;
+                                    }
+                                }
+
+                                chunks.push_back(Chunk(Chunk::Type_EntityFooter, entityEnd.pos, entityEnd.pos, entityStart.line, entityStart.column, entityEnd.line - entityStart.line));
+
+                                groupStart = Position(scanner);
+                                groupEntityCount = 0;
+                            } else {
+                                ++groupEntityCount;
+                                if (static_cast<size_t>(scanner.curPos() - groupStart.pos) >= ChunkSize) {
+                                    chunks.push_back(Chunk(Chunk::Type_Entities, groupStart.pos, scanner.curPos(), groupStart.line, groupStart.column));
+                                    groupStart = Position(scanner);
+                                    groupEntityCount = 0;
+                                }
+                            }
+                        }
+                        break;
+                    default:
+                        scanner.advanceUntilWhitespace();
+                        token = true;
+                        break;
+                }
+
+                if (token) {
+                    if (depth == 0) {
+                        return false;
+                    } else if (depth == 1 && !brushStarts.empty()) {
+                        // the parser would add anything that follows the first brush to the entity, so we cannot split it
+                        splittable = false;
+                    }
+                }
+            }
+
+            if (depth > 0) {
+                return false;
+            }
+
+            if (groupStart.pos < m_end) {
+                chunks.push_back(Chunk(Chunk::Type_Entities, groupStart.pos, m_end, groupStart.line, groupStart.column));
+            }
+            return true;
+        }
+
         void StandardMapParser::parseEntity(ParserStatus& status) {
             Token token = m_tokenizer.nextToken();
             if (token.type() == QuakeMapToken::Eof) {
@@ -284,6 +852,35 @@ namespace TrenchBroom {
             }
         }
         
+        void StandardMapParser::parseEntityHeader(ParserStatus& status) {
+            auto token = expect(QuakeMapToken::OBrace, m_tokenizer.nextToken());
+
+            auto attributes = Model::EntityAttribute::List();
+            auto attributeNames = AttributeNames();
+
+            auto extraAttributes = ExtraAttributes();
+            const auto startLine = token.line();
+
+            token = m_tokenizer.peekToken();
+            while (token.type() != QuakeMapToken::Eof) {
+                switch (token.type()) {
+                    case QuakeMapToken::Comment:
+                        m_tokenizer.nextToken();
+                        parseExtraAttributes(extraAttributes, status);
+                        break;
+                    case QuakeMapToken::String:
+                        parseEntityAttribute(attributes, attributeNames, status);
+                        break;
+                    default:
+                        expect(QuakeMapToken::Comment | QuakeMapToken::String, token);
+                }
+
+                token = m_tokenizer.peekToken();
+            }
+
+            beginEntity(startLine, attributes, extraAttributes, status);
+        }
+
         void StandardMapParser::parseEntityAttribute(Model::EntityAttribute::List& attributes, AttributeNames& names, ParserStatus& status) {
             auto token = m_tokenizer.nextToken();
             assert(token.type() == QuakeMapToken::String);
@@ -630,12 +1227,12 @@ namespace TrenchBroom {
             return std::make_tuple(p1, p2, p3);
         }
 
-        String StandardMapParser::parseTextureName(ParserStatus& status) {
-            auto textureName = m_tokenizer.readAnyString(QuakeMapTokenizer::Whitespace());
+        Assets::TextureName StandardMapParser::parseTextureName(ParserStatus& status) {
+            const auto textureName = m_tokenizer.readAnyString(QuakeMapTokenizer::Whitespace());
             if (textureName == Model::BrushFace::NoTextureName) {
-                textureName = "";
+                return Assets::TextureName();
             }
-            return textureName;
+            return Assets::TextureName(textureName);
         }
 
         std::tuple<vm::vec3, float, vm::vec3, float> StandardMapParser::parseValveTextureAxes(ParserStatus& status) {
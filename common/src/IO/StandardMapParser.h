@@ -21,6 +21,7 @@
 #define TrenchBroom_StandardMapParser
 
 #include "TrenchBroom.h"
+#include "Assets/TextureName.h"
 #include "IO/MapParser.h"
 #include "IO/Parser.h"
 #include "IO/Token.h"
@@ -30,6 +31,7 @@
 #include <vecmath/forward.h>
 
 #include <tuple>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -56,6 +58,7 @@ namespace TrenchBroom {
             bool m_skipEol;
         public:
             QuakeMapTokenizer(const char* begin, const char* end);
+            QuakeMapTokenizer(const char* begin, const char* end, size_t line, size_t column);
             QuakeMapTokenizer(const String& str);
             
             void setSkipEol(bool skipEol);
@@ -72,18 +75,52 @@ namespace TrenchBroom {
 
             static const String BrushPrimitiveId;
             static const String PatchId;
+            static const size_t ChunkSize;
 
+            class Chunk;
+            using ChunkList = std::vector<Chunk>;
+            class ChunkParser;
+
+            const char* m_begin;
+            const char* m_end;
             QuakeMapTokenizer m_tokenizer;
             Model::MapFormat m_format;
+            size_t m_threadCount;
+            size_t m_parsedChunkCount;
         public:
             StandardMapParser(const char* begin, const char* end);
             StandardMapParser(const String& str);
             
             virtual ~StandardMapParser() override;
+
+            /**
+             * Sets the number of threads that parseEntitiesInChunks assumes to be available. With fewer than two, the
+             * input is parsed sequentially. The default of 0 uses the number of hardware threads.
+             */
+            void setThreadCount(size_t threadCount);
+
+            /**
+             * Returns the number of chunks that the last call to parseEntitiesInChunks parsed separately, or 0 if it
+             * parsed the entire input with parseEntities.
+             */
+            size_t parsedChunkCount() const;
+        private:
+            StandardMapParser(const char* begin, const char* end, size_t line, size_t column);
         protected:
             Model::MapFormat detectFormat();
             
             void parseEntities(Model::MapFormat format, ParserStatus& status);
+
+            /**
+             * Parses the entities like parseEntities, but first scans the input for the boundaries of the entities
+             * and of the brushes of large entities such as a big worldspawn. The input is split into chunks at these
+             * boundaries, and the chunks are tokenized and parsed on worker threads. The results are then passed to
+             * the callbacks in file order on the calling thread.
+             *
+             * Small inputs and inputs that cannot be split reliably are parsed by parseEntities. If any chunk fails to
+             * parse, the entire input is parsed again by parseEntities so that errors are reported as usual.
+             */
+            void parseEntitiesInChunks(Model::MapFormat format, ParserStatus& status);
             void parseBrushes(Model::MapFormat format, ParserStatus& status);
             void parseBrushFaces(Model::MapFormat format, ParserStatus& status);
             
@@ -91,7 +128,10 @@ namespace TrenchBroom {
         private:
             void setFormat(Model::MapFormat format);
             
+            bool findChunks(ChunkList& chunks) const;
+
             void parseEntity(ParserStatus& status);
+            void parseEntityHeader(ParserStatus& status);
             void parseEntityAttribute(Model::EntityAttribute::List& attributes, AttributeNames& names, ParserStatus& status);
 
             void parseBrushOrBrushPrimitiveOrPatch(ParserStatus& status);
@@ -110,7 +150,7 @@ namespace TrenchBroom {
             void parsePatch(ParserStatus& status, size_t startLine);
 
             std::tuple<vm::vec3, vm::vec3, vm::vec3> parseFacePoints(ParserStatus& status);
-            String parseTextureName(ParserStatus& status);
+            Assets::TextureName parseTextureName(ParserStatus& status);
             std::tuple<vm::vec3, float, vm::vec3, float> parseValveTextureAxes(ParserStatus& status);
             std::tuple<vm::vec3, vm::vec3> parsePrimitiveTextureAxes(ParserStatus& status);
 
@@ -21,7 +21,9 @@
 
 #include "Logger.h"
 #include "Assets/AssetTypes.h"
+#include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
+#include "Assets/TextureDecodeQueue.h"
 #include "Assets/TextureManager.h"
 #include "IO/DiskIO.h"
 #include "IO/FileMatcher.h"
@@ -39,11 +41,18 @@ namespace TrenchBroom {
 
         TextureCollectionLoader::~TextureCollectionLoader() = default;
 
-        std::unique_ptr<Assets::TextureCollection> TextureCollectionLoader::loadTextureCollection(const Path& path, const StringList& textureExtensions, const TextureReader& textureReader) {
+        std::unique_ptr<Assets::TextureCollection> TextureCollectionLoader::loadTextureCollection(const Path& path, const StringList& textureExtensions, std::shared_ptr<const TextureReader> textureReader) {
             auto collection = std::make_unique<Assets::TextureCollection>(path);
 
             for (auto file : doFindTextures(path, textureExtensions)) {
-                auto* texture = textureReader.readTexture(file);
+                auto* texture = textureReader->readTextureHeader(file);
+                if (texture != nullptr) {
+                    texture->setDecodeJob(std::make_shared<Assets::TextureDecodeJob>([textureReader, file]() {
+                        return textureReader->readTexture(file);
+                    }));
+                } else {
+                    texture = textureReader->readTexture(file);
+                }
                 collection->addTexture(texture);
             }
             
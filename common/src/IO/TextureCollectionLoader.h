@@ -48,7 +48,11 @@ namespace TrenchBroom {
         public:
             virtual ~TextureCollectionLoader();
         public:
-            std::unique_ptr<Assets::TextureCollection> loadTextureCollection(const Path& path, const StringList& textureExtensions, const TextureReader& textureReader);
+            /**
+             * Loads the textures of the collection at the given path. Textures whose headers can be read without
+             * decoding them are created without pixel data and are given a job that decodes them later.
+             */
+            std::unique_ptr<Assets::TextureCollection> loadTextureCollection(const Path& path, const StringList& textureExtensions, std::shared_ptr<const TextureReader> textureReader);
         private:
             virtual MappedFile::List doFindTextures(const Path& path, const StringList& extensions) = 0;
         };
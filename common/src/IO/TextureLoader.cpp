@@ -23,6 +23,7 @@
 #include "Assets/TextureCollection.h"
 #include "Assets/TextureManager.h"
 #include "EL/Interpolator.h"
+#include "IO/CachingTextureReader.h"
 #include "IO/FileSystem.h"
 #include "IO/FreeImageTextureReader.h"
 #include "IO/HlMipTextureReader.h"
@@ -35,9 +36,9 @@
 
 namespace TrenchBroom {
     namespace IO {
-        TextureLoader::TextureLoader(const FileSystem& gameFS, const IO::Path::List& fileSearchPaths, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger) :
+        TextureLoader::TextureLoader(const FileSystem& gameFS, const IO::Path::List& fileSearchPaths, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger, const AssetCache& cache) :
         m_textureExtensions(getTextureExtensions(textureConfig)),
-        m_textureReader(createTextureReader(gameFS, textureConfig, logger)),
+        m_textureReader(createTextureReader(gameFS, textureConfig, cache, logger)),
         m_textureCollectionLoader(createTextureCollectionLoader(gameFS, fileSearchPaths, textureConfig, logger)) {
             ensure(m_textureReader != nullptr, "textureReader is null");
             ensure(m_textureCollectionLoader != nullptr, "textureCollectionLoader is null");
@@ -47,7 +48,16 @@ namespace TrenchBroom {
             return textureConfig.format.extensions;
         }
 
-        std::unique_ptr<TextureReader> TextureLoader::createTextureReader(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger) {
+        std::unique_ptr<TextureReader> TextureLoader::createTextureReader(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig, const AssetCache& cache, Logger& logger) {
+            auto reader = createDecodingTextureReader(gameFS, textureConfig, logger);
+            // shaders only refer to other images, so there is nothing to cache for them
+            if (!cache.enabled() || textureConfig.format.format == "q3shader") {
+                return reader;
+            }
+            return std::make_unique<CachingTextureReader>(std::move(reader), cache, cacheSalt(gameFS, textureConfig));
+        }
+
+        std::unique_ptr<TextureReader> TextureLoader::createDecodingTextureReader(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger) {
             if (textureConfig.format.format == "idmip") {
                 TextureReader::PathSuffixNameStrategy nameStrategy(1, true);
                 return std::make_unique<IdMipTextureReader>(nameStrategy, loadPalette(gameFS, textureConfig, logger));
@@ -68,6 +78,22 @@ namespace TrenchBroom {
             }
         }
         
+        String TextureLoader::cacheSalt(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig) {
+            StringStream salt;
+            salt << textureConfig.format.format;
+
+            // the decoded textures depend on the contents of the palette
+            if (!textureConfig.palette.isEmpty()) {
+                try {
+                    const auto file = gameFS.openFile(textureConfig.palette);
+                    salt << ":" << std::hex << AssetCache::key(*file, "palette");
+                } catch (const Exception&) {
+                    salt << ":nopalette";
+                }
+            }
+            return salt.str();
+        }
+
         Assets::Palette TextureLoader::loadPalette(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger) {
             if (textureConfig.palette.isEmpty()) {
                 return Assets::Palette();
@@ -97,7 +123,7 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<Assets::TextureCollection> TextureLoader::loadTextureCollection(const Path& path) {
-            return m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, *m_textureReader);
+            return m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, m_textureReader);
         }
 
         void TextureLoader::loadTextures(const Path::List& paths, Assets::TextureManager& textureManager) {
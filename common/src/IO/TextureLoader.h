@@ -24,6 +24,7 @@
 #include "EL.h"
 #include "StringUtils.h"
 #include "Assets/AssetTypes.h"
+#include "IO/AssetCache.h"
 #include "IO/Path.h"
 #include "IO/TextureCollectionLoader.h"
 #include "IO/TextureReader.h"
@@ -47,13 +48,15 @@ namespace TrenchBroom {
         class TextureLoader {
         private:
             StringList m_textureExtensions;
-            std::unique_ptr<TextureReader> m_textureReader;
+            std::shared_ptr<TextureReader> m_textureReader;
             std::unique_ptr<TextureCollectionLoader> m_textureCollectionLoader;
         public:
-            TextureLoader(const FileSystem& gameFS, const IO::Path::List& fileSearchPaths, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger);
+            TextureLoader(const FileSystem& gameFS, const IO::Path::List& fileSearchPaths, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger, const AssetCache& cache = AssetCache());
         private:
             static StringList getTextureExtensions(const Model::GameConfig::TextureConfig& textureConfig);
-            static std::unique_ptr<TextureReader> createTextureReader(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger);
+            static std::unique_ptr<TextureReader> createTextureReader(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig, const AssetCache& cache, Logger& logger);
+            static std::unique_ptr<TextureReader> createDecodingTextureReader(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger);
+            static String cacheSalt(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig);
             static Assets::Palette loadPalette(const FileSystem& gameFS, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger);
             static std::unique_ptr<TextureCollectionLoader> createTextureCollectionLoader(const FileSystem& gameFS, const IO::Path::List& fileSearchPaths, const Model::GameConfig::TextureConfig& textureConfig, Logger& logger);
         public:
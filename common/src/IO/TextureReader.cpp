@@ -85,6 +85,10 @@ namespace TrenchBroom {
             return doReadTexture(file);
         }
 
+        Assets::Texture* TextureReader::readTextureHeader(MappedFile::Ptr file) const {
+            return doReadTextureHeader(file);
+        }
+
         String TextureReader::textureName(const String& textureName, const Path& path) const {
             return m_nameStrategy->textureName(textureName, path);
         }
@@ -93,6 +97,10 @@ namespace TrenchBroom {
             return m_nameStrategy->textureName(path.lastComponent().asString(), path);
         }
 
+        Assets::Texture* TextureReader::doReadTextureHeader(MappedFile::Ptr file) const {
+            return nullptr;
+        }
+
         size_t TextureReader::mipSize(const size_t width, const size_t height, const size_t mipLevel) {
             const auto size = Assets::sizeAtMipLevel(width, height, mipLevel);
             return size.x() * size.y();
@@ -88,6 +88,15 @@ namespace TrenchBroom {
             virtual ~TextureReader();
             
             Assets::Texture* readTexture(MappedFile::Ptr file) const;
+            /**
+             * Reads only the name and dimensions of a texture and returns an Assets::Texture object without pixel data
+             * allocated with new, or nullptr if this reader does not support this or if the header is invalid. Use
+             * readTexture to obtain the pixel data in that case.
+             *
+             * @param file the file that contains the texture image
+             * @return an Assets::Texture object allocated with new or nullptr
+             */
+            Assets::Texture* readTextureHeader(MappedFile::Ptr file) const;
         protected:
             String textureName(const String& textureName, const Path& path) const;
             String textureName(const Path& path) const;
@@ -101,6 +110,7 @@ namespace TrenchBroom {
              * @return an Assets::Texture object allocated with new
              */
             virtual Assets::Texture* doReadTexture(MappedFile::Ptr file) const = 0;
+            virtual Assets::Texture* doReadTextureHeader(MappedFile::Ptr file) const;
         public:
             static size_t mipSize(size_t width, size_t height, size_t mipLevel);
             
@@ -20,11 +20,10 @@
 #ifndef TrenchBroom_Token
 #define TrenchBroom_Token
 
+#include "NumberParser.h"
 #include "StringUtils.h"
 
 #include <cassert>
-#include <cstdlib>
-#include <cstring>
 
 namespace TrenchBroom {
     namespace IO {
@@ -94,25 +93,12 @@ namespace TrenchBroom {
             
             template <typename T>
             T toFloat() const {
-                static const size_t BufferSize = 256;
-                static char buffer[BufferSize];
-                assert(length() < BufferSize);
-                
-                memcpy(buffer, m_begin, length());
-                buffer[length()] = 0;
-                const T f = static_cast<T>(std::atof(buffer));
-                return f;
+                return NumberParser::toFloat<T>(m_begin, m_end);
             }
             
             template <typename T>
             T toInteger() const {
-                static char buffer[64];
-                assert(length() < 64);
-                
-                memcpy(buffer, m_begin, length());
-                buffer[length()] = 0;
-                const T i = static_cast<T>(std::atoi(buffer));
-                return i;
+                return NumberParser::toInteger<T>(m_begin, m_end);
             }
         };
     }
@@ -21,14 +21,16 @@
 
 namespace TrenchBroom {
     namespace IO {
-        TokenizerState::TokenizerState(const char* begin, const char* end, const String& escapableChars, const char escapeChar) :
+        TokenizerState::TokenizerState(const char* begin, const char* end, const String& escapableChars, const char escapeChar, const size_t line, const size_t column) :
         m_begin(begin),
         m_cur(m_begin),
         m_end(end),
         m_escapableChars(escapableChars),
         m_escapeChar(escapeChar),
-        m_line(1),
-        m_column(1),
+        m_firstLine(line),
+        m_firstColumn(column),
+        m_line(m_firstLine),
+        m_column(m_firstColumn),
         m_escaped(false) {}
 
         TokenizerState* TokenizerState::clone(const char* begin, const char* end) const {
@@ -133,8 +135,8 @@ namespace TrenchBroom {
         
         void TokenizerState::reset() {
             m_cur = m_begin;
-            m_line = 1;
-            m_column = 1;
+            m_line = m_firstLine;
+            m_column = m_firstColumn;
             m_escaped = false;
         }
         
@@ -36,11 +36,13 @@ namespace TrenchBroom {
             const char* m_end;
             String m_escapableChars;
             char m_escapeChar;
+            size_t m_firstLine;
+            size_t m_firstColumn;
             size_t m_line;
             size_t m_column;
             bool m_escaped;
         public:
-            TokenizerState(const char* begin, const char* end, const String& escapableChars, char escapeChar);
+            TokenizerState(const char* begin, const char* end, const String& escapableChars, char escapeChar, size_t line = 1, size_t column = 1);
 
             TokenizerState* clone(const char* begin, const char* end) const;
 
@@ -110,6 +112,13 @@ namespace TrenchBroom {
             Tokenizer(const char* begin, const char* end, const String& escapableChars, const char escapeChar) :
             m_state(std::make_shared<TokenizerState>(begin, end, escapableChars, escapeChar)) {}
 
+            /**
+             * Creates a tokenizer for a part of a larger buffer. The given line and column are the position of the
+             * given begin pointer within the larger buffer, and the tokens will report their positions accordingly.
+             */
+            Tokenizer(const char* begin, const char* end, const String& escapableChars, const char escapeChar, const size_t line, const size_t column) :
+            m_state(std::make_shared<TokenizerState>(begin, end, escapableChars, escapeChar, line, column)) {}
+
             Tokenizer(const String& str, const String& escapableChars, const char escapeChar) :
             m_state(std::make_shared<TokenizerState>(str.c_str(), str.c_str() + str.size(), escapableChars, escapeChar)) {}
 
@@ -54,11 +54,37 @@ namespace TrenchBroom {
             }
         }
 
+        Assets::Texture* WalTextureReader::doReadTextureHeader(MappedFile::Ptr file) const {
+            try {
+                CharArrayReader reader(file->begin(), file->end());
+                const char version = reader.readChar<char>();
+                if (version != 3) {
+                    reader.seekFromBegin(0);
+                }
+
+                const auto name = reader.readString(WalLayout::TextureNameLength);
+                if (version == 3) {
+                    reader.seekForward(3); // garbage
+                }
+
+                const auto width = reader.readSize<uint32_t>();
+                const auto height = reader.readSize<uint32_t>();
+                if (width == 0 || height == 0 || width * height > file->size()) {
+                    return nullptr;
+                }
+
+                // Daikatana textures may turn out to be masked once their pixel data is decoded
+                return new Assets::Texture(textureName(name, file->path()), width, height, GL_RGBA, Assets::TextureType::Opaque);
+            } catch (const CharArrayReaderException&) {
+                return nullptr;
+            }
+        }
+
         Assets::Texture* WalTextureReader::readQ2Wal(CharArrayReader& reader, const Path& path) const {
             static const size_t MaxMipLevels = 4;
-            static Color tempColor, averageColor;
-            static Assets::TextureBuffer::List buffers(MaxMipLevels);
-            static size_t offsets[MaxMipLevels];
+            Color averageColor;
+            Assets::TextureBuffer::List buffers(MaxMipLevels);
+            size_t offsets[MaxMipLevels];
 
             const String name = reader.readString(WalLayout::TextureNameLength);
             const size_t width = reader.readSize<uint32_t>();
@@ -76,9 +102,9 @@ namespace TrenchBroom {
 
         Assets::Texture* WalTextureReader::readDkWal(CharArrayReader& reader, const Path& path) const {
             static const size_t MaxMipLevels = 9;
-            static Color tempColor, averageColor;
-            static Assets::TextureBuffer::List buffers(MaxMipLevels);
-            static size_t offsets[MaxMipLevels];
+            Color averageColor;
+            Assets::TextureBuffer::List buffers(MaxMipLevels);
+            size_t offsets[MaxMipLevels];
 
             const char version = reader.readChar<char>();
             ensure(version == 3, "Unknown WAL texture version");
@@ -117,7 +143,7 @@ namespace TrenchBroom {
         }
 
         bool WalTextureReader::readMips(const Assets::Palette& palette, const size_t mipLevels, const size_t offsets[], const size_t width, const size_t height, CharArrayReader& reader, Assets::TextureBuffer::List& buffers, Color& averageColor, const Assets::PaletteTransparency transparency) {
-            static Color tempColor;
+            Color tempColor;
 
             auto hasTransparency = false;
             for (size_t i = 0; i < mipLevels; ++i) {
@@ -22,10 +22,12 @@
 #include "CollectionUtils.h"
 #include "IO/CharArrayReader.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/FileCache.h"
 #include "IO/IOUtils.h"
 
 #include <cassert>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -33,27 +35,94 @@ namespace TrenchBroom {
     namespace IO {
         // ZipFileSystem::ZipCompressedFile
 
-        ZipFileSystem::ZipCompressedFile::ZipCompressedFile(ZipFileSystem* owner, const mz_uint fileIndex) :
-        m_owner(owner),
-        m_fileIndex(fileIndex) {}
+        namespace ZipLayout {
+            static const size_t LocalHeaderSize        = 30;
+            static const size_t LocalHeaderNameLength  = 26;
+            static const mz_uint32 LocalHeaderSignature = 0x04034b50;
+            static const mz_uint16 MethodStored        = 0;
+            static const mz_uint16 MethodDeflated      = 8;
+            static const mz_uint16 FlagEncrypted       = 1;
+        }
+
+        ZipFileSystem::ZipCompressedFile::ZipCompressedFile(MappedFile::Ptr archiveFile, const Path& path, const mz_zip_archive_file_stat& stat) :
+        m_archiveFile(std::move(archiveFile)),
+        m_path(path),
+        m_localHeaderOffset(stat.m_local_header_ofs),
+        m_compressedSize(stat.m_comp_size),
+        m_uncompressedSize(stat.m_uncomp_size),
+        m_method(stat.m_method),
+        m_crc32(stat.m_crc32) {
+            if ((stat.m_bit_flag & ZipLayout::FlagEncrypted) != 0) {
+                // encrypted entries are rejected when they are opened
+                m_method = std::numeric_limits<mz_uint16>::max();
+            }
+        }
+
+        ZipFileSystem::ZipCompressedFile::~ZipCompressedFile() {
+            FileCache::instance().remove(this);
+        }
 
         MappedFile::Ptr ZipFileSystem::ZipCompressedFile::doOpen() const {
-            const auto path = Path(m_owner->filename(m_fileIndex));
+            const auto* data = findData();
+            if (m_method == ZipLayout::MethodStored) {
+                // no need to copy or cache anything, the file is just a view of the archive
+                return std::make_shared<MappedFileView>(m_archiveFile, m_path, data, data + m_uncompressedSize);
+            }
+
+            auto& cache = FileCache::instance();
+            if (auto cached = cache.get(this)) {
+                return cached;
+            }
+
+            auto result = inflate(data);
+            cache.put(this, result);
+            return result;
+        }
 
-            mz_zip_archive_file_stat stat;
-            if (!mz_zip_reader_file_stat(&m_owner->m_archive, m_fileIndex, &stat)) {
-                throw FileSystemException("mz_zip_reader_file_stat failed for " + path.asString());
+        /**
+         * Returns a pointer to the (compressed) data of this file within the archive. Only reads from the archive's
+         * memory, which is never modified, so this is safe to call from any thread.
+         */
+        const char* ZipFileSystem::ZipCompressedFile::findData() const {
+            if (m_method != ZipLayout::MethodStored && m_method != ZipLayout::MethodDeflated) {
+                throw FileSystemException("Unsupported compression method or encrypted file: " + m_path.asString());
+            }
+
+            try {
+                CharArrayReader reader(m_archiveFile->begin(), m_archiveFile->end());
+                reader.seekFromBegin(static_cast<size_t>(m_localHeaderOffset));
+                if (reader.readUnsignedInt<mz_uint32>() != ZipLayout::LocalHeaderSignature) {
+                    throw FileSystemException("Invalid local file header for " + m_path.asString());
+                }
+
+                reader.seekFromBegin(static_cast<size_t>(m_localHeaderOffset) + ZipLayout::LocalHeaderNameLength);
+                const auto nameLength = reader.readSize<mz_uint16>();
+                const auto extraLength = reader.readSize<mz_uint16>();
+                reader.seekFromBegin(static_cast<size_t>(m_localHeaderOffset) + ZipLayout::LocalHeaderSize + nameLength + extraLength);
+
+                const auto dataSize = m_method == ZipLayout::MethodStored ? m_uncompressedSize : m_compressedSize;
+                reader.ensureCanRead(static_cast<size_t>(dataSize));
+                return reader.cur<char>();
+            } catch (const CharArrayReaderException&) {
+                throw FileSystemException("Truncated zip archive entry: " + m_path.asString());
             }
+        }
+
+        MappedFile::Ptr ZipFileSystem::ZipCompressedFile::inflate(const char* data) const {
+            const auto uncompressedSize = static_cast<size_t>(m_uncompressedSize);
+            auto buffer = std::make_unique<char[]>(uncompressedSize);
 
-            const size_t uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-            auto data = std::make_unique<char[]>(uncompressedSize);
-            auto* begin = data.get();
+            const auto size = tinfl_decompress_mem_to_mem(buffer.get(), uncompressedSize, data, static_cast<size_t>(m_compressedSize), 0);
+            if (size != uncompressedSize) {
+                throw FileSystemException("Error decompressing " + m_path.asString());
+            }
 
-            if (!mz_zip_reader_extract_to_mem(&m_owner->m_archive, m_fileIndex, begin, uncompressedSize, 0)) {
-                throw FileSystemException("mz_zip_reader_extract_to_mem failed for " + path.asString());
+            const auto checksum = mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const unsigned char*>(buffer.get()), uncompressedSize);
+            if (checksum != m_crc32) {
+                throw FileSystemException("CRC mismatch when decompressing " + m_path.asString());
             }
 
-            return std::make_shared<MappedFileBuffer>(path, std::move(data), uncompressedSize);
+            return std::make_shared<MappedFileBuffer>(m_path, std::move(buffer), uncompressedSize);
         }
 
         // ZipFileSystem
@@ -81,7 +150,13 @@ namespace TrenchBroom {
             for (mz_uint i = 0; i < numFiles; ++i) {
                 if (!mz_zip_reader_is_file_a_directory(&m_archive, i)) {
                     const auto path = Path(filename(i));
-                    m_root.addFile(path, std::make_unique<ZipCompressedFile>(this, i));
+
+                    mz_zip_archive_file_stat stat;
+                    if (!mz_zip_reader_file_stat(&m_archive, i, &stat)) {
+                        throw FileSystemException("mz_zip_reader_file_stat failed for " + path.asString());
+                    }
+
+                    m_root.addFile(path, std::make_unique<ZipCompressedFile>(m_file, path, stat));
                 }
             }
 
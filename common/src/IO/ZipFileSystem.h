@@ -30,20 +30,32 @@
 
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * A file system backed by a zip archive. The archive is only used to read the central directory; the entries
+         * are extracted straight from the archive's memory, so files can be opened concurrently from several threads.
+         * Decompressed files are kept in the shared FileCache.
+         */
         class ZipFileSystem : public ImageFileSystem {
         private:
             mz_zip_archive m_archive;
         private:
             class ZipCompressedFile : public File {
             private:
-                ZipFileSystem* m_owner;
-                mz_uint m_fileIndex;
+                MappedFile::Ptr m_archiveFile;
+                Path m_path;
+                mz_uint64 m_localHeaderOffset;
+                mz_uint64 m_compressedSize;
+                mz_uint64 m_uncompressedSize;
+                mz_uint16 m_method;
+                mz_uint32 m_crc32;
             public:
-                ZipCompressedFile(ZipFileSystem* owner, mz_uint fileIndex);
+                ZipCompressedFile(MappedFile::Ptr archiveFile, const Path& path, const mz_zip_archive_file_stat& stat);
+                ~ZipCompressedFile() override;
             private:
                 MappedFile::Ptr doOpen() const override;
+                const char* findData() const;
+                MappedFile::Ptr inflate(const char* data) const;
             };
-            friend class ZipCompressedFile;
         public:
             ZipFileSystem(const Path& path, MappedFile::Ptr file);
             ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path, MappedFile::Ptr file);
@@ -41,9 +41,11 @@
 #include <vecmath/mat_ext.h>
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
+#include <vecmath/scalar.h>
 #include <vecmath/util.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 
 namespace TrenchBroom {
@@ -138,6 +140,52 @@ namespace TrenchBroom {
             }
         };
 
+        class Brush::BuildGeometryFromPlanes {
+        private:
+            // Intersecting all triples of planes grows with the fourth power of the number of faces, so clipping is
+            // faster for brushes with more faces than this (see BrushBuildBenchmark).
+            static const size_t MaxFaceCount = 24;
+
+            bool m_built;
+            bool m_brushValid;
+        public:
+            BuildGeometryFromPlanes(BrushGeometry& geometry, const BrushFaceList& faces, const vm::bbox3& worldBounds) :
+            m_built(false),
+            m_brushValid(true) {
+                if (faces.size() > MaxFaceCount) {
+                    return;
+                }
+
+                std::vector<vm::plane3> planes;
+                planes.reserve(faces.size());
+                for (const auto* brushFace : faces) {
+                    planes.push_back(brushFace->boundary());
+                }
+
+                const auto faceGeometries = geometry.buildFromPlanes(planes, worldBounds);
+                if (!faceGeometries.empty()) {
+                    assert(faceGeometries.size() == faces.size());
+                    for (size_t i = 0; i < faces.size(); ++i) {
+                        faces[i]->setGeometry(faceGeometries[i]);
+                    }
+
+                    geometry.correctVertexPositions();
+
+                    HealEdgesCallback healCallback;
+                    m_brushValid = geometry.healEdges(healCallback);
+                    m_built = true;
+                }
+            }
+
+            bool built() const {
+                return m_built;
+            }
+
+            bool brushValid() const {
+                return m_brushValid;
+            }
+        };
+
         class Brush::MoveVerticesCallback : public BrushGeometry::Callback {
         private:
             using IncidenceMap = std::map<vm::vec3, BrushFaceList>;
@@ -1160,24 +1208,91 @@ namespace TrenchBroom {
             return VertexSet(std::begin(vertices), std::end(vertices));
         }
 
-        BrushList Brush::subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const String& defaultTextureName, const BrushList& subtrahends) const {
-            auto result = std::list<BrushGeometry>{*m_geometry};
+        BrushList Brush::subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const String& defaultTextureName, const BrushList& subtrahends, const bool mergeFragments) const {
+            return createBrushes(factory, worldBounds, defaultTextureName, subtractGeometry(subtrahends, mergeFragments), subtrahends);
+        }
+
+        /**
+         * Checks whether the given fragments have a pair of faces that lie in the same plane with opposite normals.
+         */
+        static bool shareFacePlane(const BrushGeometry& lhs, const BrushGeometry& rhs) {
+            const BrushGeometry::Callback callback;
+            for (const auto* lhsFace : lhs.faces()) {
+                const auto lhsPlane = callback.getPlane(lhsFace).flip();
+                for (const auto* rhsFace : rhs.faces()) {
+                    const auto rhsPlane = callback.getPlane(rhsFace);
+                    if (vm::isEqual(lhsPlane.normal, rhsPlane.normal, vm::C::almostZero()) &&
+                        vm::isEqual(lhsPlane.distance, rhsPlane.distance, vm::C::almostZero())) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Repeatedly replaces two fragments that share a face plane by their convex hull if the hull does not cover
+         * more space than the two fragments, i.e. if their union is convex.
+         */
+        static void mergeConvexFragments(BrushGeometry::List& fragments) {
+            auto merged = true;
+            while (merged) {
+                merged = false;
+                for (auto first = std::begin(fragments); first != std::end(fragments); ++first) {
+                    auto second = std::next(first);
+                    while (second != std::end(fragments)) {
+                        if (first->bounds().intersects(second->bounds()) && shareFacePlane(*first, *second)) {
+                            auto hull = *first;
+                            hull.merge(*second);
+                            if (vm::isEqual(hull.volume(), first->volume() + second->volume(), vm::C::almostZero())) {
+                                *first = std::move(hull);
+                                second = fragments.erase(second);
+                                merged = true;
+                                continue;
+                            }
+                        }
+                        ++second;
+                    }
+                }
+            }
+        }
 
-            for (auto* subtrahend : subtrahends) {
-                auto nextResults = std::list<BrushGeometry>();
+        BrushGeometry::List Brush::subtractGeometry(const BrushList& subtrahends, const bool mergeFragments) const {
+            auto result = BrushGeometry::List{*m_geometry};
 
-                for (const BrushGeometry& fragment : result) {
-                    const auto subFragments = fragment.subtract(*subtrahend->m_geometry);
-                    ListUtils::append(nextResults, subFragments);
+            for (const auto* subtrahend : subtrahends) {
+                const auto& subtrahendBounds = subtrahend->bounds();
+                if (!bounds().intersects(subtrahendBounds)) {
+                    continue;
                 }
 
-                result = nextResults;
+                auto nextResults = BrushGeometry::List();
+                for (auto it = std::begin(result); it != std::end(result); ) {
+                    auto next = std::next(it);
+                    if (it->bounds().intersects(subtrahendBounds)) {
+                        nextResults.splice(std::end(nextResults), it->subtract(*subtrahend->m_geometry));
+                    } else {
+                        // the fragment cannot be affected by this subtrahend, so keep it without copying it
+                        nextResults.splice(std::end(nextResults), result, it);
+                    }
+                    it = next;
+                }
+
+                result = std::move(nextResults);
+            }
+
+            if (mergeFragments) {
+                mergeConvexFragments(result);
             }
 
+            return result;
+        }
+
+        BrushList Brush::createBrushes(const ModelFactory& factory, const vm::bbox3& worldBounds, const String& defaultTextureName, const BrushGeometry::List& fragments, const BrushList& subtrahends) const {
             BrushList brushes;
-            brushes.reserve(result.size());
+            brushes.reserve(fragments.size());
 
-            for (const auto& geometry : result) {
+            for (const auto& geometry : fragments) {
                 auto* brush = createBrush(factory, worldBounds, defaultTextureName, geometry, subtrahends);
                 brushes.push_back(brush);
             }
@@ -1198,6 +1313,10 @@ namespace TrenchBroom {
         }
 
         bool Brush::canTransform(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const {
+            if (canTransformGeometry(transformation, worldBounds)) {
+                return true;
+            }
+
             auto* testBrush = clone(worldBounds);
             bool result = true;
 
@@ -1231,7 +1350,9 @@ namespace TrenchBroom {
             auto* brush = factory.createBrush(worldBounds, faces);
             brush->cloneFaceAttributesFrom(this);
             for (const auto* subtrahend : subtrahends) {
-                brush->cloneInvertedFaceAttributesFrom(subtrahend);
+                if (subtrahend->bounds().intersects(brush->bounds())) {
+                    brush->cloneInvertedFaceAttributesFrom(subtrahend);
+                }
             }
             return brush;
         }
@@ -1274,20 +1395,93 @@ namespace TrenchBroom {
         void Brush::buildGeometry(const vm::bbox3& worldBounds) {
             assert(m_geometry == nullptr);
 
-            m_geometry = new BrushGeometry(worldBounds.expand(1.0));
+            m_geometry = new BrushGeometry();
+
+            BuildGeometryFromPlanes buildGeometryFromPlanes(*m_geometry, m_faces, worldBounds);
+            if (buildGeometryFromPlanes.built()) {
+                updateFacesFromGeometry(worldBounds, *m_geometry);
+
+                if (!buildGeometryFromPlanes.brushValid()) {
+                    throw GeometryException("Brush is invalid");
+                }
+            } else {
+                // The brush has many faces, the faces are redundant or degenerate, or the brush exceeds the world
+                // bounds. Clipping a cube that is larger than the world bounds handles all of these cases.
+                *m_geometry = BrushGeometry(worldBounds.expand(1.0));
 
-            AddFacesToGeometry addFacesToGeometry(*m_geometry, m_faces);
-            updateFacesFromGeometry(worldBounds, *m_geometry);
+                AddFacesToGeometry addFacesToGeometry(*m_geometry, m_faces);
+                updateFacesFromGeometry(worldBounds, *m_geometry);
 
-            if (addFacesToGeometry.brushEmpty()) {
-                throw GeometryException("Brush is empty");
-            } else  if (!addFacesToGeometry.brushValid()) {
-                throw GeometryException("Brush is invalid");
-            } else if (!fullySpecified()) {
+                if (addFacesToGeometry.brushEmpty()) {
+                    throw GeometryException("Brush is empty");
+                } else  if (!addFacesToGeometry.brushValid()) {
+                    throw GeometryException("Brush is invalid");
+                }
+            }
+
+            if (!fullySpecified()) {
                 throw GeometryException("Brush is not fully specified");
             }
         }
 
+        /**
+         * Returns whether the given transformation only moves the vertices of a brush without changing its topology or
+         * moving any two vertices closer together. This holds for combinations of translations, rotations by multiples
+         * of 90 degrees, flips and uniform scales by a factor of at least 1.
+         */
+        static bool preservesBrushGeometry(const vm::mat4x4& transformation) {
+            if (transformation[0][3] != 0.0 || transformation[1][3] != 0.0 || transformation[2][3] != 0.0 || transformation[3][3] != 1.0) {
+                return false;
+            }
+
+            // the linear part must have exactly one non zero entry per row and column, and all of them must have the
+            // same absolute value
+            auto scale = 0.0;
+            bool rowUsed[3] = { false, false, false };
+            for (size_t c = 0; c < 3; ++c) {
+                size_t nonZeroCount = 0;
+                for (size_t r = 0; r < 3; ++r) {
+                    const auto value = std::abs(transformation[c][r]);
+                    if (value > vm::C::almostZero()) {
+                        if (rowUsed[r]) {
+                            return false;
+                        }
+                        if (scale == 0.0) {
+                            scale = value;
+                        } else if (!vm::isEqual(value, scale, vm::C::almostZero())) {
+                            return false;
+                        }
+                        rowUsed[r] = true;
+                        ++nonZeroCount;
+                    }
+                }
+                if (nonZeroCount != 1) {
+                    return false;
+                }
+            }
+
+            return scale >= 1.0 - vm::C::almostZero();
+        }
+
+        bool Brush::canTransformGeometry(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const {
+            return preservesBrushGeometry(transformation) && worldBounds.contains(bounds().transform(transformation));
+        }
+
+        void Brush::transformGeometry(const vm::mat4x4& transformation) {
+            ensure(m_geometry != nullptr, "geometry is null");
+
+            const vm::bbox3 oldBounds = bounds();
+            m_geometry->transform(transformation);
+            m_geometry->correctVertexPositions();
+
+            for (auto* face : m_faces) {
+                face->resetTexCoordSystemCache();
+            }
+
+            invalidateVertexCache();
+            nodeBoundsDidChange(oldBounds);
+        }
+
         void Brush::deleteGeometry() {
             assert(m_geometry != nullptr);
 
@@ -1494,7 +1688,11 @@ namespace TrenchBroom {
                 face->transform(transformation, lockTextures);
             }
 
-            rebuildGeometry(worldBounds);
+            if (canTransformGeometry(transformation, worldBounds)) {
+                transformGeometry(transformation);
+            } else {
+                rebuildGeometry(worldBounds);
+            }
         }
 
         class Brush::Contains : public ConstNodeVisitor, public NodeQuery<bool> {
@@ -68,6 +68,7 @@ namespace TrenchBroom {
             class AddFaceToGeometryCallback;
             class HealEdgesCallback;
             class AddFacesToGeometry;
+            class BuildGeometryFromPlanes;
             class MoveVerticesCallback;
             using RemoveVertexCallback = MoveVerticesCallback;
             class QueryCallback;
@@ -251,10 +252,29 @@ namespace TrenchBroom {
              * Subtracts the given subtrahends from `this`, returning the result but without modifying `this`.
              *
              * @param subtrahends brushes to subtract from `this`. The passed-in brushes are not modified.
+             * @param mergeFragments whether fragments whose union is convex should be merged into a single brush
              * @return the subtraction result
              */
-            BrushList subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const String& defaultTextureName, const BrushList& subtrahends) const;
+            BrushList subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const String& defaultTextureName, const BrushList& subtrahends, bool mergeFragments = false) const;
             BrushList subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const String& defaultTextureName, Brush* subtrahend) const;
+
+            /**
+             * First step of CSG subtraction; computes the geometry that remains when the given subtrahends are
+             * subtracted from `this`. Subtrahends whose bounds do not intersect a fragment are skipped for that
+             * fragment. Since this only reads `this` and the subtrahends, it may be called for several brushes
+             * concurrently.
+             *
+             * @param subtrahends brushes to subtract from `this`
+             * @param mergeFragments whether fragments whose union is convex should be merged
+             * @return the geometry of the remaining fragments
+             */
+            BrushGeometry::List subtractGeometry(const BrushList& subtrahends, bool mergeFragments) const;
+
+            /**
+             * Second step of CSG subtraction; creates a brush for each of the given fragments, see createBrush. This
+             * assigns textures and must therefore be called on the main thread.
+             */
+            BrushList createBrushes(const ModelFactory& factory, const vm::bbox3& worldBounds, const String& defaultTextureName, const BrushGeometry::List& fragments, const BrushList& subtrahends) const;
             void intersect(const vm::bbox3& worldBounds, const Brush* brush);
 
             // transformation
@@ -280,6 +300,8 @@ namespace TrenchBroom {
             void rebuildGeometry(const vm::bbox3& worldBounds);
         private:
             void buildGeometry(const vm::bbox3& worldBounds);
+            bool canTransformGeometry(const vm::mat4x4& transformation, const vm::bbox3& worldBounds) const;
+            void transformGeometry(const vm::mat4x4& transformation);
             void deleteGeometry();
             bool checkGeometry() const;
         public:
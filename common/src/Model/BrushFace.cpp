@@ -269,6 +269,10 @@ namespace TrenchBroom {
             invalidateVertexCache();
         }
 
+        const TexCoordSystem& BrushFace::texCoordSystem() const {
+            return *m_texCoordSystem;
+        }
+
         void BrushFace::resetTexCoordSystemCache() {
             if (m_texCoordSystem != nullptr) {
                 m_texCoordSystem->resetCache(m_points[0], m_points[1], m_points[2], m_attribs);
@@ -348,7 +352,7 @@ namespace TrenchBroom {
         }
 
         void BrushFace::updateTexture(Assets::TextureManager& textureManager) {
-            Assets::Texture* texture = textureManager.texture(textureName());
+            Assets::Texture* texture = textureManager.texture(m_attribs.internedTextureName());
             setTexture(texture);
         }
 
@@ -640,6 +644,10 @@ namespace TrenchBroom {
             return m_lineNumber;
         }
 
+        size_t BrushFace::lineCount() const {
+            return m_lineCount;
+        }
+
         void BrushFace::setFilePosition(const size_t lineNumber, const size_t lineCount) {
             m_lineNumber = lineNumber;
             m_lineCount = lineCount;
@@ -123,6 +123,7 @@ namespace TrenchBroom {
             const BrushFaceAttributes& attribs() const;
             void setAttribs(const BrushFaceAttributes& attribs);
 
+            const TexCoordSystem& texCoordSystem() const;
             void resetTexCoordSystemCache();
             
             const String& textureName() const;
@@ -196,6 +197,7 @@ namespace TrenchBroom {
             void invalidate();
             
             size_t lineNumber() const;
+            size_t lineCount() const;
             void setFilePosition(size_t lineNumber, size_t lineCount);
             
             bool selected() const;
@@ -26,6 +26,9 @@
 namespace TrenchBroom {
     namespace Model {
         BrushFaceAttributes::BrushFaceAttributes(const String& textureName) :
+        BrushFaceAttributes(Assets::TextureName(textureName)) {}
+
+        BrushFaceAttributes::BrushFaceAttributes(const Assets::TextureName& textureName) :
         m_textureName(textureName),
         m_texture(nullptr),
         m_offset(vm::vec2f::zero),
@@ -75,6 +78,22 @@ namespace TrenchBroom {
             swap(lhs.m_color, rhs.m_color);
         }
 
+        bool BrushFaceAttributes::operator==(const BrushFaceAttributes& other) const {
+            return (m_textureName == other.m_textureName &&
+                    m_texture == other.m_texture &&
+                    m_offset == other.m_offset &&
+                    m_scale == other.m_scale &&
+                    m_rotation == other.m_rotation &&
+                    m_surfaceContents == other.m_surfaceContents &&
+                    m_surfaceFlags == other.m_surfaceFlags &&
+                    m_surfaceValue == other.m_surfaceValue &&
+                    m_color == other.m_color);
+        }
+
+        bool BrushFaceAttributes::operator!=(const BrushFaceAttributes& other) const {
+            return !(*this == other);
+        }
+
         BrushFaceAttributes BrushFaceAttributes::takeSnapshot() const {
             BrushFaceAttributes result(m_textureName);
             result.m_offset = m_offset;
@@ -88,6 +107,10 @@ namespace TrenchBroom {
         }
 
         const String& BrushFaceAttributes::textureName() const {
+            return m_textureName.asString();
+        }
+
+        const Assets::TextureName& BrushFaceAttributes::internedTextureName() const {
             return m_textureName;
         }
         
@@ -155,7 +178,7 @@ namespace TrenchBroom {
             m_texture = texture;
             if (m_texture != nullptr) {
                 m_texture->incUsageCount();
-                m_textureName = m_texture->name();
+                m_textureName = m_texture->internedName();
             }
         }
         
@@ -164,7 +187,8 @@ namespace TrenchBroom {
                 m_texture->decUsageCount();
             }
             m_texture = nullptr;
-            m_textureName = BrushFace::NoTextureName;
+            static const Assets::TextureName noTextureName(BrushFace::NoTextureName);
+            m_textureName = noTextureName;
         }
 
         bool BrushFaceAttributes::valid() const {
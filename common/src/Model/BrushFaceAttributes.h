@@ -23,6 +23,7 @@
 #include "TrenchBroom.h"
 #include "StringUtils.h"
 #include "Color.h"
+#include "Assets/TextureName.h"
 
 #include <vecmath/forward.h>
 
@@ -34,7 +35,7 @@ namespace TrenchBroom {
     namespace Model {
         class BrushFaceAttributes {
         private:
-            String m_textureName;
+            Assets::TextureName m_textureName;
             Assets::Texture* m_texture;
             
             vm::vec2f m_offset;
@@ -48,14 +49,19 @@ namespace TrenchBroom {
             Color m_color;
         public:
             BrushFaceAttributes(const String& textureName);
+            BrushFaceAttributes(const Assets::TextureName& textureName);
             BrushFaceAttributes(const BrushFaceAttributes& other);
             ~BrushFaceAttributes();
             BrushFaceAttributes& operator=(BrushFaceAttributes other);
             friend void swap(BrushFaceAttributes& lhs, BrushFaceAttributes& rhs);
+
+            bool operator==(const BrushFaceAttributes& other) const;
+            bool operator!=(const BrushFaceAttributes& other) const;
             
             BrushFaceAttributes takeSnapshot() const;
             
             const String& textureName() const;
+            const Assets::TextureName& internedTextureName() const;
             Assets::Texture* texture() const;
             vm::vec2f textureSize() const;
             
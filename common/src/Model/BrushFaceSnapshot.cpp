@@ -35,5 +35,10 @@ namespace TrenchBroom {
                 face->restoreTexCoordSystemSnapshot(*m_coordSystemSnapshot);
             }
         }
+
+        size_t BrushFaceSnapshot::memorySize() const {
+            // the coordinate system snapshot stores at most two axes
+            return sizeof(BrushFaceSnapshot) + (m_coordSystemSnapshot != nullptr ? 2 * sizeof(vm::vec3) : 0);
+        }
     }
 }
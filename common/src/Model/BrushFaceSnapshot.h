@@ -35,6 +35,11 @@ namespace TrenchBroom {
         public:
             BrushFaceSnapshot(BrushFace* face, TexCoordSystem& coordSystemSnapshot);
             void restore();
+
+            /**
+             * Returns an estimate of the number of bytes held by this snapshot.
+             */
+            size_t memorySize() const;
         };
     }
 }
@@ -19,32 +19,146 @@
 
 #include "BrushSnapshot.h"
 
-#include "CollectionUtils.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
 
 namespace TrenchBroom {
     namespace Model {
+        /**
+         * Hands out shared immutable copies of face attributes. Only weak references are kept here, so a record is freed
+         * as soon as the last snapshot that uses it is deleted.
+         */
+        class SharedAttributePool {
+        private:
+            using Entry = std::weak_ptr<const BrushFaceAttributes>;
+            std::mutex m_mutex;
+            std::unordered_multimap<size_t, Entry> m_entries;
+            size_t m_sweepThreshold;
+        public:
+            SharedAttributePool() :
+            m_sweepThreshold(1024) {}
+
+            std::shared_ptr<const BrushFaceAttributes> get(const BrushFaceAttributes& attribs) {
+                // the texture is not part of the snapshot, it is set again when the face is restored
+                const auto snapshot = attribs.takeSnapshot();
+                const auto key = hash(snapshot);
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                const auto range = m_entries.equal_range(key);
+                for (auto it = range.first; it != range.second; ++it) {
+                    auto existing = it->second.lock();
+                    if (existing != nullptr && *existing == snapshot) {
+                        return existing;
+                    }
+                }
+
+                auto result = std::make_shared<const BrushFaceAttributes>(snapshot);
+                m_entries.emplace(key, result);
+                if (m_entries.size() >= m_sweepThreshold) {
+                    sweep();
+                }
+                return result;
+            }
+
+            size_t size() {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                sweep();
+                return m_entries.size();
+            }
+        private:
+            void sweep() {
+                for (auto it = std::begin(m_entries); it != std::end(m_entries); ) {
+                    if (it->second.expired()) {
+                        it = m_entries.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+                m_sweepThreshold = std::max(size_t(1024), 2 * m_entries.size());
+            }
+
+            static size_t hash(const BrushFaceAttributes& attribs) {
+                size_t result = std::hash<size_t>()(attribs.internedTextureName().id());
+                const auto combine = [&result](const float f) {
+                    result ^= std::hash<float>()(f) + 0x9e3779b9 + (result << 6) + (result >> 2);
+                };
+                combine(attribs.xOffset());
+                combine(attribs.yOffset());
+                combine(attribs.xScale());
+                combine(attribs.yScale());
+                combine(attribs.rotation());
+                combine(static_cast<float>(attribs.surfaceContents()));
+                combine(static_cast<float>(attribs.surfaceFlags()));
+                combine(attribs.surfaceValue());
+                return result;
+            }
+        };
+
+        static SharedAttributePool& sharedAttributePool() {
+            static SharedAttributePool pool;
+            return pool;
+        }
+
         BrushSnapshot::BrushSnapshot(Brush* brush) :
         m_brush(brush) {
             takeSnapshot(brush);
         }
 
-        BrushSnapshot::~BrushSnapshot() {
-            VectorUtils::clearAndDelete(m_faces);
+        size_t BrushSnapshot::sharedAttributeCount() {
+            return sharedAttributePool().size();
         }
 
         void BrushSnapshot::takeSnapshot(Brush* brush) {
-            for (BrushFace* face : brush->faces()) {
-                BrushFace *faceClone = face->clone();
-                faceClone->setTexture(nullptr);
-                m_faces.push_back(faceClone);
+            auto& pool = sharedAttributePool();
+            
+            const BrushFaceList& faces = brush->faces();
+            m_faces.resize(faces.size());
+            for (size_t i = 0; i < faces.size(); ++i) {
+                const BrushFace* face = faces[i];
+                FaceRecord& record = m_faces[i];
+                
+                const auto& points = face->points();
+                std::copy(std::begin(points), std::end(points), std::begin(record.points));
+                record.attribs = pool.get(face->attribs());
+                record.texCoordSystem = face->texCoordSystem().clone();
+                record.lineNumber = face->lineNumber();
+                record.lineCount = face->lineCount();
+                record.selected = face->selected();
             }
         }
         
         void BrushSnapshot::doRestore(const vm::bbox3& worldBounds) {
-            m_brush->setFaces(worldBounds, m_faces);
+            BrushFaceList faces;
+            faces.reserve(m_faces.size());
+            
+            for (FaceRecord& record : m_faces) {
+                auto* face = new BrushFace(record.points[0], record.points[1], record.points[2], *record.attribs, std::move(record.texCoordSystem));
+                face->setFilePosition(record.lineNumber, record.lineCount);
+                if (record.selected)
+                    face->select();
+                faces.push_back(face);
+            }
             m_faces.clear();
+
+            m_brush->setFaces(worldBounds, faces);
+        }
+
+        size_t BrushSnapshot::doGetMemorySize() const {
+            static const size_t TexCoordSystemSize = std::max(sizeof(ParallelTexCoordSystem), sizeof(ParaxialTexCoordSystem));
+            
+            size_t result = sizeof(BrushSnapshot) + m_faces.capacity() * (sizeof(FaceRecord) + TexCoordSystemSize);
+            for (const FaceRecord& record : m_faces) {
+                // shared records are attributed to their users in equal parts
+                result += sizeof(BrushFaceAttributes) / static_cast<size_t>(std::max(1l, record.attribs.use_count()));
+            }
+            return result;
         }
     }
 }
@@ -20,26 +20,49 @@
 #ifndef TrenchBroom_BrushSnapshot
 #define TrenchBroom_BrushSnapshot
 
+#include "Model/BrushFaceAttributes.h"
 #include "Model/ModelTypes.h"
 #include "Model/NodeSnapshot.h"
+#include "Model/TexCoordSystem.h"
 
+#include <vecmath/vec.h>
+
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Model {
         class Brush;
-        class BrushFaceSnapshot;
         
+        /**
+         * Stores the faces of a brush as compact records instead of cloning them. The face attributes are immutable and
+         * shared with all other snapshots of faces that have equal attributes, so that snapshots of large selections that
+         * use a small number of textures remain small.
+         */
         class BrushSnapshot : public NodeSnapshot {
         private:
+            struct FaceRecord {
+                vm::vec3 points[3];
+                std::shared_ptr<const BrushFaceAttributes> attribs;
+                std::unique_ptr<TexCoordSystem> texCoordSystem;
+                size_t lineNumber;
+                size_t lineCount;
+                bool selected;
+            };
+
             Brush* m_brush;
-            BrushFaceList m_faces;
+            std::vector<FaceRecord> m_faces;
         public:
             BrushSnapshot(Brush* brush);
-            ~BrushSnapshot() override;
+
+            /**
+             * Returns the number of distinct attribute records that are currently shared by brush snapshots.
+             */
+            static size_t sharedAttributeCount();
         private:
             void takeSnapshot(Brush* brush);
             void doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemorySize() const override;
         };
     }
 }
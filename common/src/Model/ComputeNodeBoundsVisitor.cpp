@@ -57,6 +57,52 @@ namespace TrenchBroom {
             }
         }
 
+        ComputeTransformedNodeBoundsVisitor::ComputeTransformedNodeBoundsVisitor(const vm::mat4x4& transformation, const vm::bbox3& defaultBounds) :
+        m_transformation(transformation),
+        m_initialized(false),
+        m_bounds(defaultBounds) {}
+
+        const vm::bbox3& ComputeTransformedNodeBoundsVisitor::bounds() const {
+            return m_bounds;
+        }
+
+        void ComputeTransformedNodeBoundsVisitor::doVisit(const World* world) {}
+        void ComputeTransformedNodeBoundsVisitor::doVisit(const Layer* layer) {}
+
+        void ComputeTransformedNodeBoundsVisitor::doVisit(const Group* group) {
+            // the bounds of a transformed group are computed from its transformed children
+            group->iterate(*this);
+        }
+
+        void ComputeTransformedNodeBoundsVisitor::doVisit(const Entity* entity) {
+            if (entity->hasChildren()) {
+                entity->iterate(*this);
+            } else {
+                // a point entity only moves its origin, which is rounded, see Entity::doTransform
+                const auto& bounds = entity->bounds();
+                const auto center = bounds.center();
+                const auto offset = center - entity->origin();
+                const auto origin = vm::round(m_transformation * center - offset);
+                mergeWith(bounds.translate(origin - entity->origin()));
+            }
+        }
+
+        void ComputeTransformedNodeBoundsVisitor::doVisit(const Brush* brush) {
+            const auto positions = brush->vertexPositions();
+            mergeWith(vm::bbox3::mergeAll(std::begin(positions), std::end(positions), [this](const vm::vec3& position) {
+                return m_transformation * position;
+            }));
+        }
+
+        void ComputeTransformedNodeBoundsVisitor::mergeWith(const vm::bbox3& bounds) {
+            if (!m_initialized) {
+                m_bounds = bounds;
+                m_initialized = true;
+            } else {
+                m_bounds = merge(m_bounds, bounds);
+            }
+        }
+
         vm::bbox3 computeBounds(const Model::NodeList& nodes) {
             return computeBounds(std::begin(nodes), std::end(nodes));
         }
@@ -25,6 +25,7 @@
 #include "Model/Node.h"
 
 #include <vecmath/bbox.h>
+#include <vecmath/mat.h>
 
 namespace TrenchBroom {
     namespace Model {
@@ -44,6 +45,28 @@ namespace TrenchBroom {
             void mergeWith(const vm::bbox3& bounds);
         };
         
+        /**
+         * Computes the bounds of the visited nodes as if they were transformed by the given transformation. The result
+         * matches the bounds after the transformation is applied: brushes contribute their transformed vertices, point
+         * entities their translated bounds, and groups and brush entities the bounds of their transformed children.
+         */
+        class ComputeTransformedNodeBoundsVisitor : public ConstNodeVisitor {
+        private:
+            vm::mat4x4 m_transformation;
+            bool m_initialized;
+            vm::bbox3 m_bounds;
+        public:
+            ComputeTransformedNodeBoundsVisitor(const vm::mat4x4& transformation, const vm::bbox3& defaultBounds = vm::bbox3());
+            const vm::bbox3& bounds() const;
+        private:
+            void doVisit(const World* world) override;
+            void doVisit(const Layer* layer) override;
+            void doVisit(const Group* group) override;
+            void doVisit(const Entity* entity) override;
+            void doVisit(const Brush* brush) override;
+            void mergeWith(const vm::bbox3& bounds);
+        };
+
         vm::bbox3 computeBounds(const Model::NodeList& nodes);
         
         template <typename I>
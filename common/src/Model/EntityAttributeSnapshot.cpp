@@ -39,5 +39,21 @@ namespace TrenchBroom {
             else
                 node->addOrUpdateAttribute(m_name, m_value);
         }
+
+        size_t EntityAttributeSnapshot::memorySize() const {
+            return sizeof(EntityAttributeSnapshot) + m_name.capacity() + m_value.capacity();
+        }
+
+        size_t EntityAttributeSnapshot::memorySize(const Map& snapshots) {
+            size_t result = sizeof(Map);
+            for (const auto& entry : snapshots) {
+                result += sizeof(Map::value_type);
+                for (const auto& snapshot : entry.second) {
+                    // each list element also stores two pointers to its neighbours
+                    result += 2 * sizeof(void*) + snapshot.memorySize();
+                }
+            }
+            return result;
+        }
     }
 }
@@ -39,6 +39,9 @@ namespace TrenchBroom {
             EntityAttributeSnapshot(const AttributeName& name);
 
             void restore(AttributableNode* node) const;
+
+            size_t memorySize() const;
+            static size_t memorySize(const Map& snapshots);
         };
     }
 }
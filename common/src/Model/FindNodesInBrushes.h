@@ -0,0 +1,108 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_FindNodesInBrushes
+#define TrenchBroom_FindNodesInBrushes
+
+#include "TrenchBroom.h"
+#include "CollectionUtils.h"
+#include "Model/Brush.h"
+#include "Model/EditorContext.h"
+#include "Model/ModelTypes.h"
+#include "Model/World.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/constants.h>
+
+#include <iterator>
+#include <set>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Finds the selectable nodes for which the given predicate holds with at least one of the given brushes. Only the
+         * nodes whose bounds intersect with the bounds of a brush are tested, and these are found using the node tree of
+         * the given world. Like CollectMatchingNodesVisitor with StopRecursionIfMatched, the descendants of a matching
+         * node are not included in the result.
+         *
+         * @param world the world to search
+         * @param begin the first brush
+         * @param end the end of the range of brushes
+         * @param editorContext the editor context that determines which nodes are selectable
+         * @param match a predicate that is called with a brush and a candidate node
+         * @return the matching nodes
+         */
+        template <typename I, typename M>
+        NodeList findNodesMatchingBrushes(const World& world, I begin, I end, const EditorContext& editorContext, const M& match) {
+            std::set<const Node*> matched;
+            NodeList result;
+            NodeList candidates;
+
+            for (I cur = begin; cur != end; ++cur) {
+                const Brush* brush = *cur;
+
+                // expand the query a little because the exact tests allow for some imprecision
+                candidates.clear();
+                world.findNodesIntersecting(brush->bounds().expand(vm::C::almostZero()), std::back_inserter(candidates));
+
+                for (Node* node : candidates) {
+                    if (matched.count(node) == 0 && editorContext.selectable(node) && match(brush, node)) {
+                        matched.insert(node);
+                        result.push_back(node);
+                    }
+                }
+            }
+
+            VectorUtils::eraseIf(result, [&matched](const Node* node) {
+                for (const Node* parent = node->parent(); parent != nullptr; parent = parent->parent()) {
+                    if (matched.count(parent) > 0) {
+                        return true;
+                    }
+                }
+                return false;
+            });
+            return result;
+        }
+
+        /**
+         * Finds the same nodes as CollectTouchingNodesVisitor: every selectable node that intersects with one of the given
+         * brushes, except for the brushes themselves.
+         */
+        template <typename I>
+        NodeList findNodesTouchingBrushes(const World& world, I begin, I end, const EditorContext& editorContext) {
+            const std::set<const Node*> queryNodes(begin, end);
+            return findNodesMatchingBrushes(world, begin, end, editorContext, [&queryNodes](const Brush* brush, const Node* node) {
+                return queryNodes.count(node) == 0 && brush->intersects(node);
+            });
+        }
+
+        /**
+         * Finds the same nodes as CollectContainedNodesVisitor: every selectable node that is contained in one of the
+         * given brushes other than itself.
+         */
+        template <typename I>
+        NodeList findNodesContainedInBrushes(const World& world, I begin, I end, const EditorContext& editorContext) {
+            return findNodesMatchingBrushes(world, begin, end, editorContext, [](const Brush* brush, const Node* node) {
+                return brush != node && brush->contains(node);
+            });
+        }
+    }
+}
+
+#endif /* defined(TrenchBroom_FindNodesInBrushes) */
@@ -63,7 +63,7 @@ namespace TrenchBroom {
         }
 
         GameSPtr GameFactory::createGame(const String& gameName, Logger& logger) {
-            return GameSPtr(new GameImpl(gameConfig(gameName), gamePath(gameName), logger));
+            return GameSPtr(new GameImpl(gameConfig(gameName), gamePath(gameName), logger, pref(Preferences::AssetCacheDirectory)));
         }
         
         StringList GameFactory::fileFormats(const String& gameName) const {
@@ -32,6 +32,7 @@
 #include "IO/FileSystem.h"
 #include "IO/IOUtils.h"
 #include "IO/MapParser.h"
+#include "IO/MapSnapshot.h"
 #include "IO/MdlParser.h"
 #include "IO/Md2Parser.h"
 #include "IO/Md3Parser.h"
@@ -58,10 +59,18 @@
 
 namespace TrenchBroom {
     namespace Model {
-        GameImpl::GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger) :
+        GameImpl::GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger, const IO::Path& assetCacheDirectory) :
         m_config(config),
-        m_gamePath(gamePath) {
+        m_gamePath(gamePath),
+        m_assetCacheDirectory(assetCacheDirectory) {
             initializeFileSystem(logger);
+
+            // the cache only needs to be pruned once per session, and doing so lists all of its entries
+            if (!m_assetCacheDirectory.isEmpty()) {
+                m_assetCachePruned = std::async(std::launch::async, [assetCacheDirectory]() {
+                    IO::AssetCache(assetCacheDirectory).prune();
+                });
+            }
         }
 
         void GameImpl::initializeFileSystem(Logger& logger) {
@@ -136,13 +145,8 @@ namespace TrenchBroom {
         }
 
         void GameImpl::doWriteMap(World& world, const IO::Path& path) const {
-            const auto mapFormatName = formatName(world.format());
-
-            IO::OpenFile open(path, true);
-            IO::writeGameComment(open.file, gameName(), mapFormatName);
-
-            IO::NodeWriter writer(world, open.file);
-            writer.writeMap();
+            const IO::MapSnapshot snapshot(world, gameName());
+            snapshot.save(path);
         }
 
         void GameImpl::doExportMap(World& world, const Model::ExportFormat format, const IO::Path& path) const {
@@ -194,7 +198,8 @@ namespace TrenchBroom {
             const auto paths = extractTextureCollections(node);
 
             const auto fileSearchPaths = textureCollectionSearchPaths(documentPath);
-            IO::TextureLoader textureLoader(m_fs, fileSearchPaths, m_config.textureConfig(), logger);
+            const IO::AssetCache cache(m_assetCacheDirectory);
+            IO::TextureLoader textureLoader(m_fs, fileSearchPaths, m_config.textureConfig(), logger, cache);
             textureLoader.loadTextures(paths, textureManager);
         }
 
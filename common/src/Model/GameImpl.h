@@ -28,6 +28,7 @@
 #include "Model/GameFileSystem.h"
 #include "Model/ModelTypes.h"
 
+#include <future>
 #include <memory>
 
 namespace TrenchBroom {
@@ -40,8 +41,10 @@ namespace TrenchBroom {
             GameFileSystem m_fs;
             IO::Path m_gamePath;
             IO::Path::List m_additionalSearchPaths;
+            IO::Path m_assetCacheDirectory;
+            std::future<void> m_assetCachePruned;
         public:
-            GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger);
+            GameImpl(GameConfig& config, const IO::Path& gamePath, Logger& logger, const IO::Path& assetCacheDirectory = IO::Path());
         private:
             void initializeFileSystem(Logger& logger);
         private:
@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "IssueValidationQueue.h"
+
+#include "ParallelUtils.h"
+#include "Model/CollectNodesVisitor.h"
+#include "Model/Node.h"
+#include "Model/World.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace TrenchBroom {
+    namespace Model {
+        IssueValidationQueue::IssueValidationQueue() :
+        m_next(0) {}
+
+        void IssueValidationQueue::reset(World* world) {
+            clear();
+            if (world != nullptr) {
+                CollectNodesVisitor visitor;
+                world->acceptAndRecurse(visitor);
+                m_nodes = visitor.nodes();
+            }
+        }
+
+        void IssueValidationQueue::clear() {
+            m_nodes.clear();
+            m_next = 0;
+        }
+
+        bool IssueValidationQueue::done() const {
+            return m_next == m_nodes.size();
+        }
+
+        size_t IssueValidationQueue::remaining() const {
+            return m_nodes.size() - m_next;
+        }
+
+        NodeList IssueValidationQueue::validateNext(const IssueGeneratorList& issueGenerators, const size_t count) {
+            const auto first = std::next(std::begin(m_nodes), static_cast<NodeList::difference_type>(m_next));
+            const auto last = std::next(first, static_cast<NodeList::difference_type>(std::min(count, remaining())));
+            m_next += static_cast<size_t>(std::distance(first, last));
+
+            // most nodes are usually still valid, so only hand the others to the worker threads
+            NodeList invalidNodes;
+            std::copy_if(first, last, std::back_inserter(invalidNodes), [](const Node* node) { return !node->issuesValid(); });
+            ParallelUtils::parallelFor(invalidNodes.size(), [&](const size_t i) {
+                invalidNodes[i]->issues(issueGenerators);
+            }, 32);
+
+            return NodeList(first, last);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TrenchBroom_IssueValidationQueue
+#define TrenchBroom_IssueValidationQueue
+
+#include "Model/ModelTypes.h"
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Validates the issues of the nodes of a map in batches, so that a caller can spread the work over several
+         * idle events instead of blocking until every node has been checked.
+         *
+         * Nodes keep track of whether their issues are still valid, so only nodes that were changed since their
+         * issues were last generated cost anything. Within a batch, the issue generators are run for different
+         * nodes in parallel. The caller must ensure that the map is not modified while a batch is being validated,
+         * and it must reset the queue whenever nodes are removed from the map.
+         */
+        class IssueValidationQueue {
+        private:
+            NodeList m_nodes;
+            size_t m_next;
+        public:
+            IssueValidationQueue();
+
+            /**
+             * Enqueues all nodes of the given world in the order in which they appear in the map.
+             */
+            void reset(World* world);
+            void clear();
+
+            bool done() const;
+            size_t remaining() const;
+
+            /**
+             * Validates the issues of the next count nodes in the queue and returns these nodes.
+             */
+            NodeList validateNext(const IssueGeneratorList& issueGenerators, size_t count);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_IssueValidationQueue) */
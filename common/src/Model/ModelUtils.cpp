@@ -19,6 +19,19 @@
 
 #include "ModelUtils.h"
 
+#include "Model/Brush.h"
+#include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
+#include "Model/Entity.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/NodeVisitor.h"
+#include "Model/ParallelTexCoordSystem.h"
+#include "Model/ParaxialTexCoordSystem.h"
+#include "Model/World.h"
+
+#include <algorithm>
+
 namespace TrenchBroom {
     namespace Model {
         NodeList collectParents(const NodeList& nodes) {
@@ -54,5 +67,64 @@ namespace TrenchBroom {
             
             return result;
         }
+
+        class ComputeNodeMemorySizeVisitor : public ConstNodeVisitor {
+        private:
+            size_t m_memorySize;
+        public:
+            ComputeNodeMemorySizeVisitor() :
+            m_memorySize(0) {}
+
+            size_t memorySize() const {
+                return m_memorySize;
+            }
+        private:
+            void doVisit(const World* world) override {
+                m_memorySize += sizeof(World) + attributesMemorySize(world);
+            }
+
+            void doVisit(const Layer* layer) override {
+                m_memorySize += sizeof(Layer);
+            }
+
+            void doVisit(const Group* group) override {
+                m_memorySize += sizeof(Group);
+            }
+
+            void doVisit(const Entity* entity) override {
+                m_memorySize += sizeof(Entity) + attributesMemorySize(entity);
+            }
+
+            void doVisit(const Brush* brush) override {
+                static const size_t TexCoordSystemSize = std::max(sizeof(ParallelTexCoordSystem), sizeof(ParaxialTexCoordSystem));
+
+                m_memorySize += (sizeof(Brush) +
+                                 brush->faceCount() * (sizeof(BrushFace*) + sizeof(BrushFace) + TexCoordSystemSize + sizeof(BrushFaceGeometry)) +
+                                 brush->vertexCount() * sizeof(BrushVertex) +
+                                 brush->edgeCount() * (sizeof(BrushEdge) + 2 * sizeof(BrushHalfEdge)));
+            }
+
+            static size_t attributesMemorySize(const AttributableNode* node) {
+                size_t result = 0;
+                for (const auto& attribute : node->attributes()) {
+                    result += sizeof(EntityAttribute) + attribute.name().capacity() + attribute.value().capacity();
+                }
+                return result;
+            }
+        };
+
+        size_t nodeMemorySize(const NodeList& nodes) {
+            ComputeNodeMemorySizeVisitor visitor;
+            Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
+            return visitor.memorySize();
+        }
+
+        size_t mapMemorySize(const ParentChildrenMap& nodes) {
+            size_t result = sizeof(ParentChildrenMap);
+            for (const auto& entry : nodes) {
+                result += sizeof(ParentChildrenMap::value_type) + entry.second.capacity() * sizeof(Node*);
+            }
+            return result;
+        }
     }
 }
@@ -38,6 +38,16 @@ namespace TrenchBroom {
 
         NodeList collectChildren(const ParentChildrenMap& nodes);
         ParentChildrenMap parentChildrenMap(const NodeList& nodes);
+
+        /**
+         * Estimates the memory used by the given nodes, including their descendants.
+         */
+        size_t nodeMemorySize(const NodeList& nodes);
+
+        /**
+         * Estimates the memory used by the given map itself, not counting the nodes it refers to.
+         */
+        size_t mapMemorySize(const ParentChildrenMap& nodes);
     }
 }
 
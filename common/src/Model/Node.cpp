@@ -585,6 +585,10 @@ namespace TrenchBroom {
             validateIssues(issueGenerators);
             return m_issues;
         }
+
+        bool Node::issuesValid() const {
+            return m_issuesValid;
+        }
         
         bool Node::issueHidden(const IssueType type) const {
             return (type & m_hiddenIssues) != 0;
@@ -32,8 +32,14 @@ namespace TrenchBroom {
         public:
             virtual ~NodeSnapshot();
             void restore(const vm::bbox3& worldBounds);
+
+            /**
+             * Returns an estimate of the number of bytes held by this snapshot.
+             */
+            size_t memorySize() const;
         private:
             virtual void doRestore(const vm::bbox3& worldBounds) = 0;
+            virtual size_t doGetMemorySize() const = 0;
         };
     }
 }
@@ -20,9 +20,13 @@
 #include "PickResult.h"
 
 #include "Model/CompareHits.h"
+#include "Model/EditorContext.h"
+#include "Model/HitAdapter.h"
 
 #include <vecmath/util.h>
 
+#include <limits>
+
 namespace TrenchBroom {
     namespace Model {
         class PickResult::CompareWrapper {
@@ -33,9 +37,17 @@ namespace TrenchBroom {
             bool operator()(const Hit& lhs, const Hit& rhs) const { return m_compare->compare(lhs, rhs) < 0; }
         };
         
+        PickResult::PickResult(const EditorContext& editorContext, CompareHits* compare, const Hit::HitType closestHitType) :
+        m_editorContext(&editorContext),
+        m_compare(compare),
+        m_closestHitType(closestHitType),
+        m_closestPickableHitDistance(std::numeric_limits<FloatType>::max()) {}
+
         PickResult::PickResult() :
         m_editorContext(nullptr),
-        m_compare(new CompareHitsByDistance()) {}
+        m_compare(new CompareHitsByDistance()),
+        m_closestHitType(Hit::NoType),
+        m_closestPickableHitDistance(std::numeric_limits<FloatType>::max()) {}
 
         PickResult PickResult::byDistance(const EditorContext& editorContext) {
             CompareHits* compare = new CombineCompareHits(new CompareHitsByDistance(),
@@ -43,6 +55,12 @@ namespace TrenchBroom {
             return PickResult(editorContext, compare);
         }
 
+        PickResult PickResult::closestByDistance(const EditorContext& editorContext, const Hit::HitType type) {
+            CompareHits* compare = new CombineCompareHits(new CompareHitsByDistance(),
+                                                          new CompareHitsByType());
+            return PickResult(editorContext, compare, type);
+        }
+
         PickResult PickResult::bySize(const EditorContext& editorContext, const vm::axis::type axis) {
             return PickResult(editorContext, new CompareHitsBySize(axis));
         }
@@ -55,8 +73,24 @@ namespace TrenchBroom {
             return m_hits.size();
         }
         
+        bool PickResult::needsAllHits() const {
+            return m_closestHitType == Hit::NoType;
+        }
+
+        bool PickResult::needsHitsAt(const FloatType distance) const {
+            // hits at almost the same distance as the closest hit are considered by HitQuery::first, too
+            return needsAllHits() || distance <= m_closestPickableHitDistance + vm::C::almostZero();
+        }
+
         void PickResult::addHit(const Hit& hit) {
             ensure(m_compare.get() != nullptr, "compare is null");
+            if (hit.hasType(m_closestHitType) && hit.distance() < m_closestPickableHitDistance) {
+                const auto* node = hitToNode(hit);
+                if (m_editorContext == nullptr || node == nullptr || m_editorContext->pickable(node)) {
+                    m_closestPickableHitDistance = hit.distance();
+                }
+            }
+
             Hit::List::iterator pos = std::upper_bound(std::begin(m_hits), std::end(m_hits), hit, CompareWrapper(m_compare.get()));
             m_hits.insert(pos, hit);
         }
@@ -73,6 +107,7 @@ namespace TrenchBroom {
 
         void PickResult::clear() {
             m_hits.clear();
+            m_closestPickableHitDistance = std::numeric_limits<FloatType>::max();
         }
     }
 }
@@ -39,20 +39,37 @@ namespace TrenchBroom {
             const EditorContext* m_editorContext;
             Hit::List m_hits;
             ComparePtr m_compare;
+            // if not NoType, only the closest pickable hit of this type is of interest
+            Hit::HitType m_closestHitType;
+            FloatType m_closestPickableHitDistance;
             class CompareWrapper;
         public:
-            PickResult(const EditorContext& editorContext, CompareHits* compare) :
-            m_editorContext(&editorContext),
-            m_compare(compare) {}
+            PickResult(const EditorContext& editorContext, CompareHits* compare, Hit::HitType closestHitType = Hit::NoType);
 
             PickResult();
 
             static PickResult byDistance(const EditorContext& editorContext);
+            /**
+             * Returns a pick result that only needs the closest pickable hit of the given type, which allows picking to
+             * stop early. Hits of other types in front of it are still collected. Only use it if the result is queried
+             * with first() and no filters that let a pickable hit of the given type pass through, such as selected() or
+             * minDistance().
+             */
+            static PickResult closestByDistance(const EditorContext& editorContext, Hit::HitType type = Hit::AnyType);
             static PickResult bySize(const EditorContext& editorContext, vm::axis::type axis);
 
             bool empty() const;
             size_t size() const;
 
+            /**
+             * Indicates whether this pick result needs every hit along the pick ray, in which case the order in which
+             * the hits are added does not matter.
+             */
+            bool needsAllHits() const;
+            /**
+             * Indicates whether hits at the given distance or beyond may still affect this pick result.
+             */
+            bool needsHitsAt(FloatType distance) const;
             void addHit(const Hit& hit);
 
             const Hit::List& all() const;
@@ -19,6 +19,7 @@
 
 #include "PortalFile.h"
 
+#include "NumberParser.h"
 #include "IO/Path.h"
 
 #include <vecmath/forward.h>
@@ -29,6 +30,20 @@
 
 namespace TrenchBroom {
     namespace Model {
+        /**
+         * Unlike NumberParser::toFloat, fails if the given string is not a number.
+         */
+        static float parseCoordinate(const String& str) {
+            const auto* begin = str.data();
+            const auto* end = str.data() + str.size();
+
+            double result = 0.0;
+            if (begin == end || NumberParser::parseDouble(begin, end, result) != end) {
+                throw FileFormatException("Error reading portal: '" + str + "' is not a number");
+            }
+            return static_cast<float>(result);
+        }
+
         PortalFile::PortalFile() {}
 
         PortalFile::PortalFile(const IO::Path& path) {
@@ -96,9 +111,9 @@ namespace TrenchBroom {
                         throw FileFormatException("Error reading portal");
                     }
                     
-                    const vm::vec3f vert(std::stof(components.at(ptr)),
-                                     std::stof(components.at(ptr+1)),
-                                     std::stof(components.at(ptr+2)));
+                    const vm::vec3f vert(parseCoordinate(components.at(ptr)),
+                                         parseCoordinate(components.at(ptr+1)),
+                                         parseCoordinate(components.at(ptr+2)));
                     verts.push_back(vert);
                     ptr += 3;
                 }
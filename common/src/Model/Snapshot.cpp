@@ -41,16 +41,24 @@ namespace TrenchBroom {
                 snapshot->restore();
         }
 
+        size_t Snapshot::memorySize() const {
+            return m_memorySize;
+        }
+
         void Snapshot::takeSnapshot(Node* node) {
             NodeSnapshot* snapshot = node->takeSnapshot();
-            if (snapshot != nullptr)
+            if (snapshot != nullptr) {
                 m_nodeSnapshots.push_back(snapshot);
+                m_memorySize += sizeof(NodeSnapshot*) + snapshot->memorySize();
+            }
         }
 
         void Snapshot::takeSnapshot(BrushFace* face) {
             BrushFaceSnapshot* snapshot = face->takeSnapshot();
-            if (snapshot != nullptr)
+            if (snapshot != nullptr) {
                 m_brushFaceSnapshots.push_back(snapshot);
+                m_memorySize += sizeof(BrushFaceSnapshot*) + snapshot->memorySize();
+            }
         }
     }
 }
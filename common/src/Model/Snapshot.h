@@ -33,9 +33,11 @@ namespace TrenchBroom {
         private:
             NodeSnapshotList m_nodeSnapshots;
             BrushFaceSnapshotList m_brushFaceSnapshots;
+            size_t m_memorySize;
         public:
             template <typename I>
-            Snapshot(I cur, I end) {
+            Snapshot(I cur, I end) :
+            m_memorySize(sizeof(Snapshot)) {
                 while (cur != end) {
                     takeSnapshot(*cur);
                     ++cur;
@@ -46,6 +48,11 @@ namespace TrenchBroom {
             
             void restoreNodes(const vm::bbox3& worldBounds);
             void restoreBrushFaces();
+
+            /**
+             * Returns an estimate of the number of bytes held by this snapshot, computed when the snapshot was taken.
+             */
+            size_t memorySize() const;
         private:
             void takeSnapshot(Node* node);
             void takeSnapshot(BrushFace* face);
@@ -24,6 +24,7 @@
 #include "Model/BrushFace.h"
 #include "Model/CollectNodesWithDescendantSelectionCountVisitor.h"
 #include "Model/IssueGenerator.h"
+#include "Model/PickResult.h"
 
 namespace TrenchBroom {
     namespace Model {
@@ -271,9 +272,22 @@ namespace TrenchBroom {
         }
 
         void World::doPick(const vm::ray3& ray, PickResult& pickResult) const {
-            for (const auto* node : m_nodeTree.findIntersectors(ray)) {
-                node->pick(ray, pickResult);
+            if (pickResult.needsAllHits()) {
+                for (const auto* node : m_nodeTree.findIntersectors(ray)) {
+                    node->pick(ray, pickResult);
+                }
+                return;
             }
+
+            // visit the nodes in the order in which the ray enters their bounds, which allows to stop once the pick
+            // result cannot change anymore
+            m_nodeTree.findIntersectorsNearestFirst(ray, [&](const Node* node, const FloatType distance) {
+                if (!pickResult.needsHitsAt(distance)) {
+                    return false;
+                }
+                node->pick(ray, pickResult);
+                return true;
+            });
         }
         
         void World::doFindNodesContaining(const vm::vec3& point, NodeList& result) {
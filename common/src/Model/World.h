@@ -21,7 +21,7 @@
 #define TrenchBroom_World
 
 #include "TrenchBroom.h"
-#include "AABBTree.h"
+#include "FlatAABBTree.h"
 #include "Model/AttributableNode.h"
 #include "Model/AttributableNodeIndex.h"
 #include "Model/IssueGeneratorRegistry.h"
@@ -42,7 +42,7 @@ namespace TrenchBroom {
             AttributableNodeIndex m_attributableIndex;
             IssueGeneratorRegistry m_issueGeneratorRegistry;
 
-            using NodeTree = AABBTree<FloatType, 3, Node*>;
+            using NodeTree = FlatAABBTree<FloatType, 3, Node*>;
             NodeTree m_nodeTree;
             bool m_updateNodeTree;
         public:
@@ -55,6 +55,15 @@ namespace TrenchBroom {
             void createDefaultLayer(const vm::bbox3& worldBounds);
         public: // index
             const AttributableNodeIndex& attributableNodeIndex() const;
+        public: // spatial queries
+            /**
+             * Appends every group, entity and brush whose bounds intersect with the given bounds to the given output
+             * iterator, using the node tree.
+             */
+            template <typename O>
+            void findNodesIntersecting(const vm::bbox3& bounds, O out) const {
+                m_nodeTree.findIntersectors(bounds, out);
+            }
         public: // selection
             // issue generator registration
             const IssueGeneratorList& registeredIssueGenerators() const;
@@ -137,6 +137,15 @@ public:
      */
     virtual List findIntersectors(const vm::ray<T,S>& ray) const = 0;
 
+    /**
+     * Finds every data item in this tree whose bounding box intersects with the given box and returns a list of those
+     * items. Boxes that only touch each other are considered to intersect.
+     *
+     * @param bounds the box to test
+     * @return a list containing all found data items
+     */
+    virtual List findIntersectors(const Box& bounds) const = 0;
+
     /**
      * Finds every data item in this tree whose bounding box contains the given point and returns a list of those items.
      *
@@ -0,0 +1,192 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NumberParser.h"
+
+#include <cstdint>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace NumberParser {
+    static bool isDigit(const char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    /**
+     * Slow path for numbers that cannot be converted exactly with double arithmetic, e.g. numbers with more than
+     * 15 significant digits or very large exponents. The given range must not contain a sign. Returns false if the
+     * number is out of the range of double.
+     */
+    static bool parseDoubleExact(const char* begin, const char* end, double& result) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        return std::from_chars(begin, end, result).ec == std::errc();
+#else
+        std::istringstream stream(String(begin, end));
+        stream.imbue(std::locale::classic());
+        stream >> result;
+        return !stream.fail();
+#endif
+    }
+
+    const char* parseDouble(const char* begin, const char* end, double& result) {
+        // powers of ten that are exactly representable as doubles
+        static const double PowersOfTen[] = {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        static const int MaxExactPower = 22;
+        static const uint64_t MaxExactMantissa = uint64_t(1) << 53;
+        static const int MaxMantissaDigits = 19;
+
+        const char* cur = begin;
+        auto negative = false;
+        if (cur < end && (*cur == '+' || *cur == '-')) {
+            negative = *cur == '-';
+            ++cur;
+        }
+        const char* unsignedBegin = cur;
+
+        uint64_t mantissa = 0;
+        int mantissaDigits = 0;
+        int exponent = 0;
+        auto truncated = false;
+        auto hasDigits = false;
+
+        while (cur < end && isDigit(*cur)) {
+            hasDigits = true;
+            const auto digit = static_cast<uint64_t>(*cur - '0');
+            if (mantissaDigits < MaxMantissaDigits) {
+                mantissa = mantissa * 10 + digit;
+                if (mantissa > 0) {
+                    ++mantissaDigits;
+                }
+            } else {
+                truncated = true;
+                ++exponent;
+            }
+            ++cur;
+        }
+
+        if (cur < end && *cur == '.') {
+            ++cur;
+            while (cur < end && isDigit(*cur)) {
+                hasDigits = true;
+                const auto digit = static_cast<uint64_t>(*cur - '0');
+                if (mantissaDigits < MaxMantissaDigits) {
+                    mantissa = mantissa * 10 + digit;
+                    if (mantissa > 0) {
+                        ++mantissaDigits;
+                    }
+                    --exponent;
+                } else {
+                    truncated = true;
+                }
+                ++cur;
+            }
+        }
+
+        if (!hasDigits) {
+            return begin;
+        }
+
+        const char* numberEnd = cur;
+        if (cur < end && (*cur == 'e' || *cur == 'E')) {
+            ++cur;
+            auto negativeExponent = false;
+            if (cur < end && (*cur == '+' || *cur == '-')) {
+                negativeExponent = *cur == '-';
+                ++cur;
+            }
+
+            if (cur < end && isDigit(*cur)) {
+                int explicitExponent = 0;
+                while (cur < end && isDigit(*cur)) {
+                    if (explicitExponent < 100000) {
+                        explicitExponent = explicitExponent * 10 + (*cur - '0');
+                    }
+                    ++cur;
+                }
+                exponent += negativeExponent ? -explicitExponent : explicitExponent;
+                numberEnd = cur;
+            }
+        }
+
+        if (mantissa == 0) {
+            result = negative ? -0.0 : 0.0;
+        } else if (!truncated && mantissa <= MaxExactMantissa && exponent >= -MaxExactPower && exponent <= MaxExactPower) {
+            // both the mantissa and the power of ten are exact, so a single multiplication or division yields a
+            // correctly rounded result
+            auto value = static_cast<double>(mantissa);
+            if (exponent < 0) {
+                value /= PowersOfTen[-exponent];
+            } else {
+                value *= PowersOfTen[exponent];
+            }
+            result = negative ? -value : value;
+        } else {
+            auto value = 0.0;
+            if (!parseDoubleExact(unsignedBegin, numberEnd, value)) {
+                value = exponent + mantissaDigits > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+            }
+            result = negative ? -value : value;
+        }
+
+        return numberEnd;
+    }
+
+    const char* parseLongLong(const char* begin, const char* end, long long& result) {
+        const char* cur = begin;
+        auto negative = false;
+        if (cur < end && (*cur == '+' || *cur == '-')) {
+            negative = *cur == '-';
+            ++cur;
+        }
+
+        if (cur == end || !isDigit(*cur)) {
+            return begin;
+        }
+
+        // accumulate the magnitude, which may be one larger than the maximum positive value for negative numbers
+        const auto limit = static_cast<unsigned long long>(std::numeric_limits<long long>::max()) + (negative ? 1u : 0u);
+        unsigned long long magnitude = 0;
+        while (cur < end && isDigit(*cur)) {
+            const auto digit = static_cast<unsigned long long>(*cur - '0');
+            if (magnitude > (limit - digit) / 10) {
+                magnitude = limit;
+            } else {
+                magnitude = magnitude * 10 + digit;
+            }
+            ++cur;
+        }
+
+        if (negative) {
+            result = magnitude == limit ? std::numeric_limits<long long>::min() : -static_cast<long long>(magnitude);
+        } else {
+            result = static_cast<long long>(magnitude);
+        }
+        return cur;
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_NumberParser_h
+#define TrenchBroom_NumberParser_h
+
+#include "StringUtils.h"
+
+/**
+ * Converts numbers from their textual representation without copying the text and independently of the current
+ * locale, i.e., the decimal separator is always a period. Only decimal notation is accepted:
+ *
+ * INTEGER ::= [ "+" | "-" ] DIGIT { DIGIT }
+ * FLOAT   ::= [ "+" | "-" ] ( DIGIT { DIGIT } [ "." { DIGIT } ] | "." DIGIT { DIGIT } ) [ ( "e" | "E" ) [ "+" | "-" ] DIGIT { DIGIT } ]
+ */
+namespace NumberParser {
+    /**
+     * Parses a floating point number at the start of the given range. The result is correctly rounded.
+     *
+     * @param begin the start of the range
+     * @param end the end of the range
+     * @param result the parsed value, unchanged if the range doesn't start with a number
+     * @return a pointer to the first character after the number, or begin if the range doesn't start with a number
+     */
+    const char* parseDouble(const char* begin, const char* end, double& result);
+
+    /**
+     * Parses an integer at the start of the given range. Values that exceed the range of long long are clamped.
+     *
+     * @param begin the start of the range
+     * @param end the end of the range
+     * @param result the parsed value, unchanged if the range doesn't start with an integer
+     * @return a pointer to the first character after the integer, or begin if the range doesn't start with an integer
+     */
+    const char* parseLongLong(const char* begin, const char* end, long long& result);
+
+    /**
+     * Converts the number at the start of the given range, ignoring any characters that follow it. Like std::atof,
+     * returns 0 if the range doesn't start with a number.
+     */
+    template <typename T>
+    T toFloat(const char* begin, const char* end) {
+        double result = 0.0;
+        parseDouble(begin, end, result);
+        return static_cast<T>(result);
+    }
+
+    template <typename T>
+    T toFloat(const String& str) {
+        return toFloat<T>(str.data(), str.data() + str.size());
+    }
+
+    /**
+     * Converts the integer at the start of the given range, ignoring any characters that follow it. Like std::atoi,
+     * returns 0 if the range doesn't start with an integer.
+     */
+    template <typename T>
+    T toInteger(const char* begin, const char* end) {
+        long long result = 0;
+        parseLongLong(begin, end, result);
+        return static_cast<T>(result);
+    }
+
+    template <typename T>
+    T toInteger(const String& str) {
+        return toInteger<T>(str.data(), str.data() + str.size());
+    }
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ParallelUtils_h
+#define TrenchBroom_ParallelUtils_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ParallelUtils {
+    /**
+     * Returns the number of worker threads to use for the given number of tasks, given that each thread should
+     * process at least the given number of tasks. The result is at least 1 and at most the number of hardware threads.
+     */
+    inline size_t threadCount(const size_t taskCount, const size_t minTasksPerThread = 1) {
+        const size_t hardwareThreads = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+        const size_t maxThreads = taskCount / std::max(minTasksPerThread, static_cast<size_t>(1));
+        return std::max(std::min(hardwareThreads, maxThreads), static_cast<size_t>(1));
+    }
+
+    /**
+     * Calls the given function once for every index in [0, count), distributing the indices over a number of worker
+     * threads. The calling thread participates in the work and the function returns once all indices have been
+     * processed. If fewer than minTasksPerThread * 2 indices are given, everything is processed on the calling thread.
+     *
+     * The function must be safe to call concurrently for different indices. If it throws, no further indices are
+     * handed out and the first exception is rethrown on the calling thread once all workers have finished.
+     */
+    template <typename F>
+    void parallelFor(const size_t count, F&& func, const size_t minTasksPerThread = 1) {
+        const size_t numThreads = threadCount(count, minTasksPerThread);
+        if (numThreads <= 1) {
+            for (size_t i = 0; i < count; ++i) {
+                func(i);
+            }
+            return;
+        }
+
+        std::atomic<size_t> next(0);
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        const auto work = [&]() {
+            try {
+                for (size_t i = next++; i < count; i = next++) {
+                    func(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+                next = count;
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(numThreads - 1);
+        for (size_t i = 0; i < numThreads - 1; ++i) {
+            workers.emplace_back(work);
+        }
+
+        work();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif
@@ -367,6 +367,11 @@ public: // Accessors
 
     const vm::bbox<T,3>& bounds() const;
 
+    /**
+     * Returns the volume enclosed by this polyhedron, or 0 if this is not a polyhedron.
+     */
+    T volume() const;
+
     bool empty() const;
     bool point() const;
     bool edge() const;
@@ -376,6 +381,18 @@ public: // Accessors
 
     void clear();
 
+    /**
+     * Returns the combined memory statistics of the allocators for vertices, edges, half edges and faces of this
+     * polyhedron type.
+     */
+    static AllocatorStatistics allocatorStatistics();
+
+    /**
+     * Returns memory that is no longer used by any vertex, edge, half edge or face of this polyhedron type to the
+     * system.
+     */
+    static void releaseUnusedMemory();
+
     struct FaceHit {
         Face* face;
         T distance;
@@ -421,6 +438,13 @@ public: // Vertex correction and edge healing
     void correctVertexPositions(const size_t decimals = 0, const T epsilon = vm::constants<T>::correctEpsilon());
     bool healEdges(const T minLength = MinEdgeLength);
     bool healEdges(Callback& callback, const T minLength = MinEdgeLength);
+
+    /**
+     * Applies the given affine transformation to the vertices of this polyhedron without changing its topology. The
+     * transformation must not be singular. If it mirrors this polyhedron, the face boundaries are reversed so that they
+     * remain counter clockwise.
+     */
+    void transform(const vm::mat<T,4,4>& transformation);
 private:
     Edge* removeEdge(Edge* edge, Callback& callback);
     void removeDegenerateFace(Face* face, Callback& callback);
@@ -522,6 +546,19 @@ public: // Subtraction
     SubtractResult subtract(const Polyhedron& subtrahend, const Callback& callback) const;
 private:
     class Subtract;
+public: // Construction from planes
+    /**
+     * Builds the convex polyhedron bounded by the given planes directly from the intersection points of all triples
+     * of planes instead of clipping a larger polyhedron with every plane. The planes point outward, and this
+     * polyhedron must be empty. No callbacks are invoked.
+     *
+     * Returns the face that was created for each plane, in the order of the given planes. If the planes do not bound
+     * a polyhedron within the given bounds, or if a plane does not contribute a face of its own, then this polyhedron
+     * remains empty and an empty vector is returned, and the caller should fall back to clipping.
+     */
+    std::vector<Face*> buildFromPlanes(const std::vector<vm::plane<T,3>>& planes, const vm::bbox<T,3>& bounds);
+private:
+    class BuildFromPlanes;
 public: // geometrical queries
     bool contains(const V& point, const Callback& callback = Callback()) const;
     bool contains(const Polyhedron& other, const Callback& callback = Callback()) const;
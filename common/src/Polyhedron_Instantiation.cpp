@@ -27,6 +27,7 @@
 #include "Polyhedron_ConvexHull.h"
 #include "Polyhedron_Clip.h"
 #include "Polyhedron_Subtract.h"
+#include "Polyhedron_Planes.h"
 #include "Polyhedron_Intersect.h"
 #include "Polyhedron_Queries.h"
 #include "Polyhedron_BrushGeometryPayload.h"
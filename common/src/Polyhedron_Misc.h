@@ -587,6 +587,29 @@ const vm::bbox<T,3>& Polyhedron<T,FP,VP>::bounds() const {
     return m_bounds;
 }
 
+template <typename T, typename FP, typename VP>
+T Polyhedron<T,FP,VP>::volume() const {
+    if (!polyhedron()) {
+        return static_cast<T>(0.0);
+    }
+
+    // sum up the signed volumes of the tetrahedra spanned by a reference point and the triangles of each face; the
+    // reference point is a vertex to keep the numbers small
+    const auto& origin = m_vertices.front()->position();
+    auto result = static_cast<T>(0.0);
+    for (const auto* face : m_faces) {
+        const auto& boundary = face->boundary();
+        const auto* first = boundary.front();
+        const auto p0 = first->origin()->position() - origin;
+        for (const auto* current = first->next(); current->next() != first; current = current->next()) {
+            const auto p1 = current->origin()->position() - origin;
+            const auto p2 = current->next()->origin()->position() - origin;
+            result += dot(p0, cross(p1, p2));
+        }
+    }
+    return vm::abs(result) / static_cast<T>(6.0);
+}
+
 template <typename T, typename FP, typename VP>
 bool Polyhedron<T,FP,VP>::empty() const {
     return vertexCount() == 0;
@@ -624,6 +647,24 @@ void Polyhedron<T,FP,VP>::clear() {
     m_vertices.clear();
 }
 
+template <typename T, typename FP, typename VP>
+AllocatorStatistics Polyhedron<T,FP,VP>::allocatorStatistics() {
+    AllocatorStatistics result;
+    result += Vertex::statistics();
+    result += Edge::statistics();
+    result += HalfEdge::statistics();
+    result += Face::statistics();
+    return result;
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron<T,FP,VP>::releaseUnusedMemory() {
+    Vertex::releaseUnusedMemory();
+    Edge::releaseUnusedMemory();
+    HalfEdge::releaseUnusedMemory();
+    Face::releaseUnusedMemory();
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron<T,FP,VP>::FaceHit::FaceHit(Face* i_face, const T i_distance) : face(i_face), distance(i_distance) {}
 
@@ -1118,6 +1159,49 @@ void Polyhedron<T,FP,VP>::correctVertexPositions(const size_t decimals, const T
     updateBounds();
 }
 
+template <typename T, typename FP, typename VP>
+void Polyhedron<T,FP,VP>::transform(const vm::mat<T,4,4>& transformation) {
+    if (m_vertices.empty()) {
+        return;
+    }
+
+    Vertex* firstVertex = m_vertices.front();
+    Vertex* currentVertex = firstVertex;
+    do {
+        currentVertex->setPosition(transformation * currentVertex->position());
+        currentVertex = currentVertex->next();
+    } while (currentVertex != firstVertex);
+
+    if (!m_faces.empty() && vm::computeDeterminant(vm::stripTranslation(transformation)) < static_cast<T>(0.0)) {
+        // Every half edge now runs from its former destination to its former origin. The new origins must be determined
+        // before any of them is changed.
+        std::vector<std::pair<HalfEdge*, Vertex*>> newOrigins;
+        Face* firstFace = m_faces.front();
+        Face* currentFace = firstFace;
+        do {
+            HalfEdge* firstEdge = currentFace->boundary().front();
+            HalfEdge* currentEdge = firstEdge;
+            do {
+                newOrigins.push_back(std::make_pair(currentEdge, currentEdge->destination()));
+                currentEdge = currentEdge->next();
+            } while (currentEdge != firstEdge);
+            currentFace = currentFace->next();
+        } while (currentFace != firstFace);
+
+        for (const auto& entry : newOrigins) {
+            entry.first->setOrigin(entry.second);
+        }
+
+        currentFace = firstFace;
+        do {
+            currentFace->flip();
+            currentFace = currentFace->next();
+        } while (currentFace != firstFace);
+    }
+
+    updateBounds();
+}
+
 template <typename T, typename FP, typename VP>
 bool Polyhedron<T,FP,VP>::healEdges(const T minLength) {
     Callback callback;
@@ -0,0 +1,231 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef Polyhedron_Planes_h
+#define Polyhedron_Planes_h
+
+#include <vecmath/plane.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+template <typename T, typename FP, typename VP>
+std::vector<typename Polyhedron<T,FP,VP>::Face*> Polyhedron<T,FP,VP>::buildFromPlanes(const std::vector<vm::plane<T,3>>& planes, const vm::bbox<T,3>& bounds) {
+    assert(empty());
+    BuildFromPlanes build(planes, bounds, *this);
+    assert(checkInvariant());
+    return build.result();
+}
+
+template <typename T, typename FP, typename VP>
+class Polyhedron<T,FP,VP>::BuildFromPlanes {
+private:
+    using Plane = vm::plane<T,3>;
+    using IndexList = std::vector<size_t>;
+    using HalfEdgeMap = std::map<std::pair<size_t, size_t>, HalfEdge*>;
+
+    const std::vector<Plane>& m_planes;
+    const vm::bbox<T,3>& m_bounds;
+    const T m_epsilon;
+
+    std::vector<V> m_positions;
+    // for each plane, the indices of the positions that lie on it in counter clockwise order
+    std::vector<IndexList> m_planeVertices;
+
+    VertexList m_vertices;
+    EdgeList m_edges;
+    FaceList m_faces;
+    std::vector<Face*> m_planeFaces;
+    Polyhedron& m_destination;
+public:
+    BuildFromPlanes(const std::vector<Plane>& planes, const vm::bbox<T,3>& bounds, Polyhedron& destination) :
+    m_planes(planes),
+    m_bounds(bounds),
+    m_epsilon(vm::constants<T>::pointStatusEpsilon()),
+    m_destination(destination) {
+        if (findVertices() && sortVertices() && buildTopology()) {
+            swapContents();
+        } else {
+            m_planeFaces.clear();
+        }
+    }
+
+    std::vector<Face*> result() {
+        return std::move(m_planeFaces);
+    }
+private:
+    /**
+     * Collects the intersection points of all triples of planes that are on or behind every plane. Fails if such a
+     * point is not contained in the bounds.
+     */
+    bool findVertices() {
+        const auto count = m_planes.size();
+        if (count < 4) {
+            return false;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t j = i + 1; j < count; ++j) {
+                for (size_t k = j + 1; k < count; ++k) {
+                    V position;
+                    if (intersect(m_planes[i], m_planes[j], m_planes[k], position) && inside(position)) {
+                        if (!m_bounds.contains(position)) {
+                            return false;
+                        }
+                        addPosition(position);
+                    }
+                }
+            }
+        }
+        return m_positions.size() >= 4;
+    }
+
+    static bool intersect(const Plane& p1, const Plane& p2, const Plane& p3, V& position) {
+        const auto n23 = cross(p2.normal, p3.normal);
+        const auto det = dot(p1.normal, n23);
+        if (std::abs(det) < vm::constants<T>::colinearEpsilon()) {
+            return false;
+        }
+
+        const auto n31 = cross(p3.normal, p1.normal);
+        const auto n12 = cross(p1.normal, p2.normal);
+        position = (p1.distance * n23 + p2.distance * n31 + p3.distance * n12) / det;
+        return true;
+    }
+
+    bool inside(const V& position) const {
+        for (const auto& plane : m_planes) {
+            if (plane.pointDistance(position) > m_epsilon) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void addPosition(const V& position) {
+        // more than three planes may meet in a vertex
+        for (const auto& existing : m_positions) {
+            if (vm::squaredDistance(existing, position) <= m_epsilon * m_epsilon) {
+                return;
+            }
+        }
+        m_positions.push_back(position);
+    }
+
+    /**
+     * Collects the vertices of every plane and sorts them counter clockwise when viewed from outside. Fails if a plane
+     * touches the polyhedron only in a vertex or an edge or not at all.
+     */
+    bool sortVertices() {
+        m_planeVertices.resize(m_planes.size());
+        for (size_t i = 0; i < m_planes.size(); ++i) {
+            const auto& plane = m_planes[i];
+            auto& indices = m_planeVertices[i];
+
+            V center = V::zero;
+            for (size_t j = 0; j < m_positions.size(); ++j) {
+                if (std::abs(plane.pointDistance(m_positions[j])) <= m_epsilon) {
+                    indices.push_back(j);
+                    center = center + m_positions[j];
+                }
+            }
+
+            if (indices.size() < 3) {
+                return false;
+            }
+
+            center = center / static_cast<T>(indices.size());
+            const auto u = normalize(m_positions[indices.front()] - center);
+            const auto w = cross(plane.normal, u);
+
+            std::vector<std::pair<T, size_t>> angles;
+            angles.reserve(indices.size());
+            for (const auto index : indices) {
+                const auto offset = m_positions[index] - center;
+                angles.emplace_back(std::atan2(dot(offset, w), dot(offset, u)), index);
+            }
+            std::sort(std::begin(angles), std::end(angles));
+
+            for (size_t j = 0; j < angles.size(); ++j) {
+                indices[j] = angles[j].second;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Creates the vertices, faces and edges. Fails if the boundaries do not form a closed polyhedron, e.g. because two
+     * planes yield the same face.
+     */
+    bool buildTopology() {
+        std::vector<Vertex*> vertices;
+        vertices.reserve(m_positions.size());
+        for (const auto& position : m_positions) {
+            Vertex* vertex = new Vertex(position);
+            m_vertices.append(vertex, 1);
+            vertices.push_back(vertex);
+        }
+
+        HalfEdgeMap halfEdges;
+        m_planeFaces.reserve(m_planes.size());
+        for (const auto& indices : m_planeVertices) {
+            HalfEdgeList boundary;
+            for (size_t i = 0; i < indices.size(); ++i) {
+                const auto origin = indices[i];
+                const auto destination = indices[(i + 1) % indices.size()];
+
+                HalfEdge* halfEdge = new HalfEdge(vertices[origin]);
+                boundary.append(halfEdge, 1);
+                if (!halfEdges.insert(std::make_pair(std::make_pair(origin, destination), halfEdge)).second) {
+                    return false;
+                }
+            }
+
+            Face* face = new Face(boundary);
+            m_faces.append(face, 1);
+            m_planeFaces.push_back(face);
+        }
+
+        for (const auto& entry : halfEdges) {
+            const auto& key = entry.first;
+            const auto twin = halfEdges.find(std::make_pair(key.second, key.first));
+            if (twin == std::end(halfEdges)) {
+                return false;
+            }
+            if (key.first < key.second) {
+                m_edges.append(new Edge(entry.second, twin->second), 1);
+            }
+        }
+
+        // See https://en.m.wikipedia.org/wiki/Euler_characteristic
+        return m_vertices.size() + m_faces.size() - m_edges.size() == 2;
+    }
+
+    void swapContents() {
+        using std::swap;
+        swap(m_vertices, m_destination.m_vertices);
+        swap(m_edges, m_destination.m_edges);
+        swap(m_faces, m_destination.m_faces);
+        m_destination.updateBounds();
+    }
+};
+
+#endif
@@ -55,8 +55,8 @@ public:
         }
     }
     
-    const List result() {
-        return m_fragments;
+    List result() {
+        return std::move(m_fragments);
     }
 private:
     /**
@@ -221,13 +221,13 @@ private:
             const auto frontClipResult = fragmentInFront.clip(curPlaneInv);
             
             if (!frontClipResult.empty()) // Polyhedron::clip() keeps the part behind the plane.
-                m_fragments.push_back(fragmentInFront);
+                m_fragments.push_back(std::move(fragmentInFront));
             
             // back fragments need to be clipped by the rest of the subtrahend planes
             Polyhedron<T,FP,VP> fragmentBehind = fragment;
             const auto backClipResult = fragmentBehind.clip(curPlane);
             if (!backClipResult.empty())
-                backFragments.push_back(fragmentBehind);
+                backFragments.push_back(std::move(fragmentBehind));
         }
         
         // recursively process the back fragments.
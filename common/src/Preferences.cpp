@@ -120,9 +120,12 @@ namespace TrenchBroom {
 
         Preference<int> TextureMinFilter(IO::Path("Renderer/Texture mode min filter"), 0x2700);
         Preference<int> TextureMagFilter(IO::Path("Renderer/Texture mode mag filter"), 0x2600);
+        Preference<IO::Path> AssetCacheDirectory(IO::Path("Renderer/Asset cache directory"), IO::Path());
 
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
         Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
+        Preference<int> UndoMemoryBudget(IO::Path("Editor/Undo memory budget"), 512);
+        Preference<bool> CSGSubtractMergeFragments(IO::Path("Editor/CSG subtract merges fragments"), true);
 
         Preference<IO::Path>& RendererFontPath() {
             static Preference<IO::Path> fontPath(IO::Path("Renderer/Font name"), IO::Path("fonts/SourceSansPro-Regular.otf"));
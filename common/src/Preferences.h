@@ -117,9 +117,15 @@ namespace TrenchBroom {
         
         extern Preference<int> TextureMinFilter;
         extern Preference<int> TextureMagFilter;
+        // the directory where decoded textures are cached, or an empty path to disable the cache
+        extern Preference<IO::Path> AssetCacheDirectory;
         
         extern Preference<bool> TextureLock;
         extern Preference<bool> UVLock;
+        // the memory that the undo history may use in MiB, or 0 for no limit
+        extern Preference<int> UndoMemoryBudget;
+        // whether CSG subtraction merges fragments whose union is convex
+        extern Preference<bool> CSGSubtractMergeFragments;
         
         Preference<IO::Path>& RendererFontPath();
         extern Preference<int> RendererFontSize;
@@ -35,6 +35,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -114,6 +115,21 @@ namespace TrenchBroom {
                                    EdgeRenderPolicy::RenderAll);
         }
 
+        // Region
+
+        BrushRenderer::Region::Region() :
+        brushCount(0),
+        vertexArray(std::make_shared<BrushVertexArray>()),
+        edgeIndices(std::make_shared<BrushIndexArray>()),
+        transparentFaces(std::make_shared<TextureToBrushIndicesMap>()),
+        opaqueFaces(std::make_shared<TextureToBrushIndicesMap>()) {}
+
+        void BrushRenderer::Region::updateRenderers(const Color& faceColor) {
+            opaqueFaceRenderer = FaceRenderer(vertexArray, opaqueFaces, faceColor);
+            transparentFaceRenderer = FaceRenderer(vertexArray, transparentFaces, faceColor);
+            edgeRenderer = IndexedEdgeRenderer(vertexArray, edgeIndices);
+        }
+
         // BrushRenderer
 
         BrushRenderer::BrushRenderer(const bool transparent) :
@@ -169,8 +185,11 @@ namespace TrenchBroom {
             m_invalidBrushes = m_allBrushes;
 
             assert(m_brushInfo.empty());
-            assert(m_transparentFaces->empty());
-            assert(m_opaqueFaces->empty());
+            for ([[maybe_unused]] const auto& entry : m_regions) {
+                assert(entry.second->brushCount == 0);
+                assert(entry.second->transparentFaces->empty());
+                assert(entry.second->opaqueFaces->empty());
+            }
         }
 
         void BrushRenderer::invalidateBrushes(const Model::BrushList& brushes) {
@@ -197,15 +216,7 @@ namespace TrenchBroom {
             m_brushInfo.clear();
             m_allBrushes.clear();
             m_invalidBrushes.clear();
-
-            m_vertexArray = std::make_shared<BrushVertexArray>();
-            m_edgeIndices = std::make_shared<BrushIndexArray>();
-            m_transparentFaces = std::make_shared<TextureToBrushIndicesMap>();
-            m_opaqueFaces = std::make_shared<TextureToBrushIndicesMap>();
-
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
-            m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            m_regions.clear();
         }
 
         void BrushRenderer::setFaceColor(const Color& faceColor) {
@@ -262,10 +273,10 @@ namespace TrenchBroom {
                     validate();
                 }
                 if (renderContext.showFaces()) {
-                    renderOpaqueFaces(renderBatch);
+                    renderOpaqueFaces(renderContext, renderBatch);
                 }
                 if (renderContext.showEdges() || m_showEdges) {
-                    renderEdges(renderBatch);
+                    renderEdges(renderContext, renderBatch);
                 }
             }
         }
@@ -276,31 +287,50 @@ namespace TrenchBroom {
                     validate();
                 }
                 if (renderContext.showFaces()) {
-                    renderTransparentFaces(renderBatch);
+                    renderTransparentFaces(renderContext, renderBatch);
                 }
             }
         }
 
-        void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch) {
-            m_opaqueFaceRenderer.setGrayscale(m_grayscale);
-            m_opaqueFaceRenderer.setTint(m_tint);
-            m_opaqueFaceRenderer.setTintColor(m_tintColor);
-            m_opaqueFaceRenderer.render(renderBatch);
+        void BrushRenderer::renderOpaqueFaces(RenderContext& renderContext, RenderBatch& renderBatch) {
+            for (auto& entry : m_regions) {
+                auto& region = *entry.second;
+                if (visible(renderContext, region)) {
+                    region.opaqueFaceRenderer.setGrayscale(m_grayscale);
+                    region.opaqueFaceRenderer.setTint(m_tint);
+                    region.opaqueFaceRenderer.setTintColor(m_tintColor);
+                    region.opaqueFaceRenderer.render(renderBatch);
+                }
+            }
         }
         
-        void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch) {
-            m_transparentFaceRenderer.setGrayscale(m_grayscale);
-            m_transparentFaceRenderer.setTint(m_tint);
-            m_transparentFaceRenderer.setTintColor(m_tintColor);
-            m_transparentFaceRenderer.setAlpha(m_transparencyAlpha);
-            m_transparentFaceRenderer.render(renderBatch);
+        void BrushRenderer::renderTransparentFaces(RenderContext& renderContext, RenderBatch& renderBatch) {
+            for (auto& entry : m_regions) {
+                auto& region = *entry.second;
+                if (visible(renderContext, region)) {
+                    region.transparentFaceRenderer.setGrayscale(m_grayscale);
+                    region.transparentFaceRenderer.setTint(m_tint);
+                    region.transparentFaceRenderer.setTintColor(m_tintColor);
+                    region.transparentFaceRenderer.setAlpha(m_transparencyAlpha);
+                    region.transparentFaceRenderer.render(renderBatch);
+                }
+            }
         }
         
-        void BrushRenderer::renderEdges(RenderBatch& renderBatch) {
-            if (m_showOccludedEdges) {
-                m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+        void BrushRenderer::renderEdges(RenderContext& renderContext, RenderBatch& renderBatch) {
+            for (auto& entry : m_regions) {
+                auto& region = *entry.second;
+                if (visible(renderContext, region)) {
+                    if (m_showOccludedEdges) {
+                        region.edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+                    }
+                    region.edgeRenderer.render(renderBatch, m_edgeColor);
+                }
             }
-            m_edgeRenderer.render(renderBatch, m_edgeColor);
+        }
+
+        bool BrushRenderer::visible(const RenderContext& renderContext, const Region& region) {
+            return region.brushCount > 0 && renderContext.viewVolume().intersects(region.bounds);
         }
 
         class BrushRenderer::FilterWrapper : public BrushRenderer::Filter {
@@ -336,9 +366,9 @@ namespace TrenchBroom {
             m_invalidBrushes.clear();
             assert(valid());
 
-            m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
-            m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
-            m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            for (auto& entry : m_regions) {
+                entry.second->updateRenderers(m_faceColor);
+            }
         }
 
         static size_t triIndicesCountForPolygon(const size_t vertexCount) {
@@ -408,6 +438,27 @@ namespace TrenchBroom {
             }
         }
 
+        BrushRenderer::Region& BrushRenderer::addToRegion(const Model::Brush* brush) {
+            const auto bounds = vm::bbox3f(brush->bounds());
+            const auto center = bounds.center();
+            const auto key = vm::vec3i(static_cast<int>(std::floor(center.x() / RegionSize)),
+                                       static_cast<int>(std::floor(center.y() / RegionSize)),
+                                       static_cast<int>(std::floor(center.z() / RegionSize)));
+
+            auto& region = m_regions[key];
+            if (region == nullptr) {
+                region = std::make_unique<Region>();
+            }
+
+            if (region->brushCount == 0) {
+                region->bounds = bounds;
+            } else {
+                region->bounds = merge(region->bounds, bounds);
+            }
+            ++region->brushCount;
+            return *region;
+        }
+
         void BrushRenderer::validateBrush(const Model::Brush* brush) {
             assert(m_allBrushes.find(brush) != m_allBrushes.end());
             assert(m_invalidBrushes.find(brush) != m_invalidBrushes.end());
@@ -426,6 +477,8 @@ namespace TrenchBroom {
             }
 
             BrushInfo& info = m_brushInfo[brush];
+            Region& region = addToRegion(brush);
+            info.region = &region;
 
             // collect vertices
             auto& brushCache = brush->brushRendererBrushCache();
@@ -433,8 +486,8 @@ namespace TrenchBroom {
             const auto& cachedVertices = brushCache.cachedVertices();
             ensure(!cachedVertices.empty(), "Brush must have cached vertices");
 
-            assert(m_vertexArray != nullptr);
-            auto [vertBlock, dest] = m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
+            assert(region.vertexArray != nullptr);
+            auto [vertBlock, dest] = region.vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
             std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
             info.vertexHolderKey = vertBlock;
 
@@ -444,7 +497,7 @@ namespace TrenchBroom {
             {
                 const size_t edgeIndexCount = countMarkedEdgeIndices(brush, edgePolicy);
                 if (edgeIndexCount > 0) {
-                    auto[key, dest] = m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
+                    auto[key, dest] = region.edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
                     info.edgeIndicesKey = key;
                     getMarkedEdgeIndices(brush, edgePolicy, brushVerticesStartIndex, dest);
                 } else {
@@ -461,7 +514,7 @@ namespace TrenchBroom {
             const size_t facesSortedByTexSize = facesSortedByTex.size();
 
             std::shared_ptr<TextureToBrushIndicesMap> faceVboPtr = \
-                (renderType == Filter::RenderOpacity::Opaque) ? m_opaqueFaces : m_transparentFaces;
+                (renderType == Filter::RenderOpacity::Opaque) ? region.opaqueFaces : region.transparentFaces;
 
             size_t nextI;
             for (size_t i = 0; i < facesSortedByTexSize; i = nextI) {
@@ -564,32 +617,36 @@ namespace TrenchBroom {
             }
 
             const BrushInfo& info = it->second;
+            Region& region = *info.region;
 
             // update Vbo's
-            m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
+            region.vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
             if (info.edgeIndicesKey != nullptr) {
-                m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
+                region.edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
             }
 
             for (const auto& [texture, opaqueKey] : info.opaqueFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_opaqueFaces->at(texture);
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = region.opaqueFaces->at(texture);
                 faceIndexHolder->zeroElementsWithKey(opaqueKey);
 
                 if (!faceIndexHolder->hasValidIndices()) {
                     // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_opaqueFaces->erase(texture);
+                    region.opaqueFaces->erase(texture);
                 }
             }
             for (const auto& [texture, transparentKey] : info.transparentFaceIndicesKeys) {
-                std::shared_ptr<BrushIndexArray> faceIndexHolder = m_transparentFaces->at(texture);
+                std::shared_ptr<BrushIndexArray> faceIndexHolder = region.transparentFaces->at(texture);
                 faceIndexHolder->zeroElementsWithKey(transparentKey);
 
                 if (!faceIndexHolder->hasValidIndices()) {
                     // There are no indices left to render for this texture, so delete the <Texture, BrushIndexArray> entry from the map
-                    m_transparentFaces->erase(texture);
+                    region.transparentFaces->erase(texture);
                 }
             }
 
+            assert(region.brushCount > 0);
+            --region.brushCount;
+
             m_brushInfo.erase(it);
         }
     }
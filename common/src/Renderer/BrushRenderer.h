@@ -27,8 +27,13 @@
 #include "Model/Brush.h"
 #include "Renderer/AllocationTracker.h"
 
+#include <vecmath/forward.h>
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
 #include <tuple>
 #include <map>
+#include <memory>
 #include <unordered_map>
 
 namespace TrenchBroom {
@@ -128,7 +133,39 @@ namespace TrenchBroom {
         private:
             Filter* m_filter;
 
+            /**
+             * Brushes are batched by the cell of a coarse grid that contains their center. Every region has its own
+             * vertex and index arrays, so regions that are outside of the view volume can be skipped without
+             * splitting the draw calls of the visible regions, which still render all faces with the same texture at
+             * once.
+             */
+            struct Region {
+                // contains the bounds of every brush that was added since the region was last empty
+                vm::bbox3f bounds;
+                size_t brushCount;
+
+                BrushVertexArrayPtr vertexArray;
+                BrushIndexArrayPtr edgeIndices;
+                std::shared_ptr<TextureToBrushIndicesMap> transparentFaces;
+                std::shared_ptr<TextureToBrushIndicesMap> opaqueFaces;
+
+                FaceRenderer opaqueFaceRenderer;
+                FaceRenderer transparentFaceRenderer;
+                IndexedEdgeRenderer edgeRenderer;
+
+                Region();
+                void updateRenderers(const Color& faceColor);
+            };
+
+            /**
+             * The size of the grid cells that brushes are batched by. Large enough that a typical map has only a few
+             * dozen regions.
+             */
+            static constexpr float RegionSize = 2048.0f;
+            std::map<vm::vec3i, std::unique_ptr<Region>> m_regions;
+
             struct BrushInfo {
+                Region* region;
                 AllocationTracker::Block* vertexHolderKey;
                 AllocationTracker::Block* edgeIndicesKey;
                 std::vector<std::pair<const Assets::Texture*, AllocationTracker::Block*>> opaqueFaceIndicesKeys;
@@ -147,15 +184,6 @@ namespace TrenchBroom {
             std::set<const Model::Brush*> m_allBrushes;
             std::set<const Model::Brush*> m_invalidBrushes;
 
-            BrushVertexArrayPtr m_vertexArray;
-            BrushIndexArrayPtr m_edgeIndices;
-            std::shared_ptr<TextureToBrushIndicesMap> m_transparentFaces;
-            std::shared_ptr<TextureToBrushIndicesMap> m_opaqueFaces;
-
-            FaceRenderer m_opaqueFaceRenderer;
-            FaceRenderer m_transparentFaceRenderer;
-            IndexedEdgeRenderer m_edgeRenderer;
-            
             Color m_faceColor;
             bool m_showEdges;
             Color m_edgeColor;
@@ -201,8 +229,8 @@ namespace TrenchBroom {
              *
              * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the Brush object for modification.
              *
-             * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces, and m_opaqueFaces
-             * maps will be empty, so the BrushRenderer will not have any lingering Texture* pointers.
+             * Additionally, calling `invalidate()` guarantees the m_brushInfo map and the face maps of all regions
+             * will be empty, so the BrushRenderer will not have any lingering Texture* pointers.
              */
             void invalidate();
             void invalidateBrushes(const Model::BrushList& brushes);
@@ -223,9 +251,10 @@ namespace TrenchBroom {
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
-            void renderOpaqueFaces(RenderBatch& renderBatch);
-            void renderTransparentFaces(RenderBatch& renderBatch);
-            void renderEdges(RenderBatch& renderBatch);
+            void renderOpaqueFaces(RenderContext& renderContext, RenderBatch& renderBatch);
+            void renderTransparentFaces(RenderContext& renderContext, RenderBatch& renderBatch);
+            void renderEdges(RenderContext& renderContext, RenderBatch& renderBatch);
+            static bool visible(const RenderContext& renderContext, const Region& region);
 
         public:
             /**
@@ -233,6 +262,7 @@ namespace TrenchBroom {
              */
             void validate();
         private:
+            Region& addToRegion(const Model::Brush* brush);
             void validateBrush(const Model::Brush* brush);
             void addBrush(const Model::Brush* brush);
             void removeBrush(const Model::Brush* brush);
@@ -215,8 +215,9 @@ namespace TrenchBroom {
                 renderService.setForegroundColor(m_overlayTextColor);
                 renderService.setBackgroundColor(m_overlayBackgroundColor);
                 
+                const auto& viewVolume = renderContext.viewVolume();
                 for (const Model::Entity* entity : m_entities) {
-                    if (m_showHiddenEntities || m_editorContext.visible(entity)) {
+                    if ((m_showHiddenEntities || m_editorContext.visible(entity)) && viewVolume.intersects(vm::bbox3f(entity->bounds()))) {
                         if (entity->group() == nullptr || entity->group() == m_editorContext.currentGroup()) {
                             if (m_showOccludedOverlays)
                                 renderService.setShowOccludedObjects();
@@ -241,11 +242,15 @@ namespace TrenchBroom {
             renderService.setShowOccludedObjectsTransparent();
             renderService.setForegroundColor(m_angleColor);
             
+            const auto& viewVolume = renderContext.viewVolume();
             std::vector<vm::vec3f> vertices(3);
             for (const auto* entity : m_entities) {
                 if (!m_showHiddenEntities && !m_editorContext.visible(entity)) {
                     continue;
                 }
+                if (!viewVolume.intersects(vm::bbox3f(entity->bounds()))) {
+                    continue;
+                }
 
                 const auto rotation = vm::mat4x4f(entity->rotation());
                 const auto direction = rotation * vm::vec3f::pos_x;
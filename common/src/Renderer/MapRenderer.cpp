@@ -42,6 +42,7 @@
 #include "Renderer/RenderContext.h"
 #include "Renderer/RenderService.h"
 #include "Renderer/RenderUtils.h"
+#include "Renderer/Transformation.h"
 #include "View/Selection.h"
 #include "View/MapDocument.h"
 
@@ -216,15 +217,52 @@ namespace TrenchBroom {
             m_defaultRenderer->renderTransparent(renderContext, renderBatch);
         }
         
+        class PushModelMatrix : public Renderable {
+        private:
+            vm::mat4x4f m_matrix;
+        public:
+            explicit PushModelMatrix(const vm::mat4x4f& matrix) :
+            m_matrix(matrix) {}
+        private:
+            void doRender(RenderContext& renderContext) override {
+                renderContext.transformation().pushModelMatrix(m_matrix);
+            }
+        };
+
+        class PopModelMatrix : public Renderable {
+        private:
+            void doRender(RenderContext& renderContext) override {
+                renderContext.transformation().popModelMatrix();
+            }
+        };
+
         void MapRenderer::renderSelectionOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!renderContext.hideSelection()) {
+                beginTransformPreview(renderBatch);
                 m_selectionRenderer->renderOpaque(renderContext, renderBatch);
+                endTransformPreview(renderBatch);
             }
         }
         
         void MapRenderer::renderSelectionTransparent(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!renderContext.hideSelection()) {
+                beginTransformPreview(renderBatch);
                 m_selectionRenderer->renderTransparent(renderContext, renderBatch);
+                endTransformPreview(renderBatch);
+            }
+        }
+
+        void MapRenderer::beginTransformPreview(RenderBatch& renderBatch) {
+            View::MapDocumentSPtr document = lock(m_document);
+            if (document->transformPreviewActive()) {
+                renderBatch.addOneShot(new PushModelMatrix(vm::mat4x4f(document->transformPreview())));
+            }
+        }
+
+        void MapRenderer::endTransformPreview(RenderBatch& renderBatch) {
+            View::MapDocumentSPtr document = lock(m_document);
+            if (document->transformPreviewActive()) {
+                renderBatch.addOneShot(new PopModelMatrix());
             }
         }
         
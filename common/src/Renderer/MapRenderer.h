@@ -76,6 +76,8 @@ namespace TrenchBroom {
             void renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderSelectionOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderSelectionTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
+            void beginTransformPreview(RenderBatch& renderBatch);
+            void endTransformPreview(RenderBatch& renderBatch);
             void renderLockedOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderLockedTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderEntityLinks(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -27,6 +27,7 @@ namespace TrenchBroom {
         m_renderMode(renderMode),
         m_camera(camera),
         m_transformation(m_camera.projectionMatrix(), m_camera.viewMatrix()),
+        m_viewVolume(m_camera),
         m_fontManager(fontManager),
         m_shaderManager(shaderManager),
         m_showTextures(true),
@@ -58,6 +59,10 @@ namespace TrenchBroom {
             return m_camera;
         }
 
+        const ViewVolume& RenderContext::viewVolume() const {
+            return m_viewVolume;
+        }
+
         Transformation& RenderContext::transformation() {
             return m_transformation;
         }
@@ -22,6 +22,7 @@
 
 #include "Renderer/Transformation.h"
 #include "Renderer/RenderBatch.h"
+#include "Renderer/ViewVolume.h"
 
 namespace TrenchBroom {
     namespace View {
@@ -52,6 +53,7 @@ namespace TrenchBroom {
             RenderMode m_renderMode;
             const Camera& m_camera;
             Transformation m_transformation;
+            ViewVolume m_viewVolume;
             FontManager& m_fontManager;
             ShaderManager& m_shaderManager;
 
@@ -85,6 +87,10 @@ namespace TrenchBroom {
             bool render3D() const;
             
             const Camera& camera() const;
+            /**
+             * The part of the world that the camera shows, used to skip objects that are not visible.
+             */
+            const ViewVolume& viewVolume() const;
             Transformation& transformation();
             FontManager& fontManager();
             ShaderManager& shaderManager();
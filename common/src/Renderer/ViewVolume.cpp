@@ -0,0 +1,71 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ViewVolume.h"
+
+#include "Renderer/Camera.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        ViewVolume::ViewVolume() {}
+
+        ViewVolume::ViewVolume(const std::vector<vm::plane3f>& planes) :
+        m_planes(planes) {}
+
+        ViewVolume::ViewVolume(const Camera& camera) :
+        m_planes(4) {
+            camera.frustumPlanes(m_planes[0], m_planes[1], m_planes[2], m_planes[3]);
+            if (camera.perspectiveProjection()) {
+                m_planes.emplace_back(camera.position() + camera.farPlane() * camera.direction(), camera.direction());
+            }
+        }
+
+        const std::vector<vm::plane3f>& ViewVolume::planes() const {
+            return m_planes;
+        }
+
+        ViewVolume::Containment ViewVolume::classify(const vm::bbox3f& bounds) const {
+            auto result = Containment::Inside;
+            for (const auto& plane : m_planes) {
+                // the corners of the box that lie farthest along and against the plane normal
+                vm::vec3f positive, negative;
+                for (size_t i = 0; i < 3; ++i) {
+                    if (plane.normal[i] >= 0.0f) {
+                        positive[i] = bounds.max[i];
+                        negative[i] = bounds.min[i];
+                    } else {
+                        positive[i] = bounds.min[i];
+                        negative[i] = bounds.max[i];
+                    }
+                }
+
+                if (plane.pointDistance(negative) > 0.0f) {
+                    return Containment::Outside;
+                } else if (plane.pointDistance(positive) > 0.0f) {
+                    result = Containment::Intersects;
+                }
+            }
+            return result;
+        }
+
+        bool ViewVolume::intersects(const vm::bbox3f& bounds) const {
+            return classify(bounds) != Containment::Outside;
+        }
+    }
+}
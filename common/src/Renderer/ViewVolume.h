@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_ViewVolume
+#define TrenchBroom_ViewVolume
+
+#include <vecmath/forward.h>
+#include <vecmath/bbox.h>
+#include <vecmath/plane.h>
+
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class Camera;
+
+        /**
+         * The part of the world that a camera shows, bounded by planes whose normals point outwards.
+         *
+         * For a perspective camera, this is its view frustum up to the far plane. For an orthographic camera, this is
+         * the box spanned by the viewport rectangle, which is unbounded in viewing direction. A view volume without
+         * any planes contains everything.
+         */
+        class ViewVolume {
+        public:
+            enum class Containment {
+                Outside,
+                Intersects,
+                Inside
+            };
+        private:
+            std::vector<vm::plane3f> m_planes;
+        public:
+            ViewVolume();
+            explicit ViewVolume(const std::vector<vm::plane3f>& planes);
+            explicit ViewVolume(const Camera& camera);
+
+            const std::vector<vm::plane3f>& planes() const;
+
+            /**
+             * Classifies the given box conservatively: a box that is reported to intersect this volume may still be
+             * outside of it if it is near one of its corners, but a box that is reported to be outside is never
+             * visible.
+             */
+            Containment classify(const vm::bbox3f& bounds) const;
+            bool intersects(const vm::bbox3f& bounds) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_ViewVolume) */
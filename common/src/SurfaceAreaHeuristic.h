@@ -0,0 +1,142 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+ 
+ This file is part of TrenchBroom.
+ 
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_SURFACEAREAHEURISTIC_H
+#define TRENCHBROOM_SURFACEAREAHEURISTIC_H
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+/**
+ * Functions to build bounding volume hierarchies top down.
+ */
+namespace SurfaceAreaHeuristic {
+    /**
+     * Returns half of the surface area of the given box, which is sufficient to compare surface areas.
+     */
+    template <typename T, size_t S>
+    T surfaceArea(const vm::bbox<T,S>& bounds) {
+        const auto size = bounds.size();
+        auto result = static_cast<T>(0.0);
+        for (size_t i = 0; i < S; ++i) {
+            for (size_t j = i + 1; j < S; ++j) {
+                result += size[i] * size[j];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Partitions the given range of objects into two non-empty groups that should become the children of a node in
+     * a bounding volume hierarchy. The centers of the objects' bounds are sorted into bins along the axis where they
+     * are spread the most. Then the objects are split at the bin boundary where the sum of the surface areas of both
+     * groups' bounds, weighted by the number of objects in each group, is minimal. Objects whose centers coincide are
+     * split in half.
+     *
+     * @tparam T the component type
+     * @tparam S the number of components
+     * @param begin the first object, the range must contain at least two objects
+     * @param end the end of the range of objects
+     * @param getBounds returns the bounds of an object
+     * @param getCenter returns the center of an object's bounds
+     * @return an iterator to the first object of the second group
+     */
+    template <typename T, size_t S, typename I, typename B, typename C>
+    I partition(const I begin, const I end, const B& getBounds, const C& getCenter) {
+        static const size_t BinCount = 16;
+        using Box = vm::bbox<T,S>;
+
+        const auto count = std::distance(begin, end);
+        assert(count > 1);
+
+        auto centers = Box(getCenter(*begin), getCenter(*begin));
+        for (auto it = begin; it != end; ++it) {
+            centers = merge(centers, getCenter(*it));
+        }
+
+        const auto extent = centers.size();
+        size_t axis = 0;
+        for (size_t i = 1; i < S; ++i) {
+            if (extent[i] > extent[axis]) {
+                axis = i;
+            }
+        }
+
+        if (!(extent[axis] > static_cast<T>(0.0))) {
+            return std::next(begin, count / 2);
+        }
+
+        const auto min = centers.min[axis];
+        const auto scale = static_cast<T>(BinCount) / extent[axis];
+        const auto binIndex = [&](const auto& object) {
+            return std::min(BinCount - 1, static_cast<size_t>((getCenter(object)[axis] - min) * scale));
+        };
+
+        size_t binCounts[BinCount] = {};
+        Box binBounds[BinCount];
+        for (auto it = begin; it != end; ++it) {
+            const auto bin = binIndex(*it);
+            binBounds[bin] = binCounts[bin] == 0 ? Box(getBounds(*it)) : merge(binBounds[bin], getBounds(*it));
+            ++binCounts[bin];
+        }
+
+        // rightAreas[i] is the surface area of the bounds of the bins i to BinCount - 1
+        T rightAreas[BinCount] = {};
+        size_t rightCounts[BinCount] = {};
+        Box rightBounds;
+        size_t rightCount = 0;
+        for (size_t i = BinCount - 1; i > 0; --i) {
+            if (binCounts[i] > 0) {
+                rightBounds = rightCount == 0 ? binBounds[i] : merge(rightBounds, binBounds[i]);
+                rightCount += binCounts[i];
+            }
+            rightAreas[i] = surfaceArea(rightBounds);
+            rightCounts[i] = rightCount;
+        }
+
+        Box leftBounds;
+        size_t leftCount = 0;
+        size_t bestSplit = 1;
+        auto bestCost = std::numeric_limits<T>::max();
+        for (size_t i = 1; i < BinCount; ++i) {
+            if (binCounts[i - 1] > 0) {
+                leftBounds = leftCount == 0 ? binBounds[i - 1] : merge(leftBounds, binBounds[i - 1]);
+                leftCount += binCounts[i - 1];
+            }
+            if (leftCount > 0 && rightCounts[i] > 0) {
+                const auto cost = static_cast<T>(leftCount) * surfaceArea(leftBounds) + static_cast<T>(rightCounts[i]) * rightAreas[i];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestSplit = i;
+                }
+            }
+        }
+
+        // the smallest and the largest center are always in the first and the last bin, so both groups are non-empty
+        return std::partition(begin, end, [&](const auto& object) { return binIndex(object) < bestSplit; });
+    }
+}
+
+#endif //TRENCHBROOM_SURFACEAREAHEURISTIC_H
@@ -295,6 +295,7 @@ namespace TrenchBroom {
 #ifndef NDEBUG
             Menu* debugMenu = m_menuBar->addMenu("Debug");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugPrintVertices, "Print Vertices");
+            debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugPrintUndoMemoryUsage, "Print Undo Memory Usage");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugCreateBrush, "Create Brush...");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugCreateCube, "Create Cube...");
             debugMenu->addUnmodifiableActionItem(CommandIds::Menu::DebugClipWithFace, "Clip Brush...");
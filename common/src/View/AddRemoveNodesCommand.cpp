@@ -21,6 +21,7 @@
 
 #include "CollectionUtils.h"
 #include "Macros.h"
+#include "Model/ModelUtils.h"
 #include "Model/Node.h"
 #include "View/MapDocumentCommandFacade.h"
 
@@ -113,5 +114,11 @@ namespace TrenchBroom {
         bool AddRemoveNodesCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+
+        size_t AddRemoveNodesCommand::doGetMemorySize() const {
+            // the nodes to add are owned by this command, the nodes to remove belong to the document
+            return (Model::mapMemorySize(m_nodesToAdd) + Model::mapMemorySize(m_nodesToRemove) +
+                    Model::nodeMemorySize(Model::collectChildren(m_nodesToAdd)));
+        }
     }
 }
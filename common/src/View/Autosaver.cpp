@@ -88,6 +88,10 @@ namespace TrenchBroom {
             if (currentTime - m_lastSaveTime < m_saveInterval) {
                 return;
             }
+            if (document->hasPendingSaves()) {
+                // a backup may still be written, and it must not be renamed or deleted by thinBackups until it is
+                return;
+            }
 
             const auto documentPath = document->path();
             if (!documentPath.isAbsolute()) {
@@ -121,9 +125,9 @@ namespace TrenchBroom {
 
                 m_lastSaveTime = std::time(nullptr);
                 m_lastModificationCount = document->modificationCount();
-                document->saveDocumentTo(backupFilePath);
-                
-                logger.info() << "Created autosave backup at " << backupFilePath;
+
+                // the document logs when the backup has been written
+                document->saveDocumentToInBackground(backupFilePath);
             } catch (const FileSystemException& e) {
                 logger.error() << "Aborting autosave: " << e.what();
             }
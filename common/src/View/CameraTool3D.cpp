@@ -76,6 +76,11 @@ namespace TrenchBroom {
         Tool* CameraTool3D::doGetTool() {
             return this;
         }
+
+        bool CameraTool3D::doNeedsAllHits(const InputState& inputState) const {
+            // the orbit center may be behind a brush that is too close to the camera, see doStartMouseDrag
+            return inputState.modifierKeysPressed(ModifierKeys::MKAlt);
+        }
         
         void CameraTool3D::doMouseScroll(const InputState& inputState) {
             const auto factor = pref(Preferences::CameraMouseWheelInvert) ? -1.0f : 1.0f;
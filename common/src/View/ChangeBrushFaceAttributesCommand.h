@@ -52,6 +52,8 @@ namespace TrenchBroom {
             UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const override;
             
             bool doCollateWith(UndoableCommand::Ptr command) override;
+
+            size_t doGetMemorySize() const override;
         private:
             ChangeBrushFaceAttributesCommand(const ChangeBrushFaceAttributesCommand& other);
             ChangeBrushFaceAttributesCommand& operator=(const ChangeBrushFaceAttributesCommand& other);
@@ -112,5 +112,10 @@ namespace TrenchBroom {
             m_newValue = other->m_newValue;
             return true;
         }
+
+        size_t ChangeEntityAttributesCommand::doGetMemorySize() const {
+            return (m_oldName.capacity() + m_newName.capacity() + m_newValue.capacity() +
+                    Model::EntityAttributeSnapshot::memorySize(m_snapshots));
+        }
     }
 }
@@ -64,6 +64,8 @@ namespace TrenchBroom {
             bool doIsRepeatable(MapDocumentCommandFacade* document) const override;
             
             bool doCollateWith(UndoableCommand::Ptr command) override;
+
+            size_t doGetMemorySize() const override;
         };
     }
 }
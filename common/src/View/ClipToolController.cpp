@@ -214,6 +214,11 @@ namespace TrenchBroom {
         Tool* ClipToolController::doGetTool() {
             return m_tool;
         }
+
+        bool ClipToolController::doNeedsAllHits(const InputState& inputState) const {
+            // the face to clip along may belong to a selected brush behind other objects
+            return true;
+        }
         
         void ClipToolController::doPick(const InputState& inputState, Model::PickResult& pickResult) {
             m_tool->pick(inputState.pickRay(), inputState.camera(), pickResult);
@@ -111,6 +111,7 @@ namespace TrenchBroom {
             virtual ~ClipToolController() override;
         private:
             Tool* doGetTool() override;
+            bool doNeedsAllHits(const InputState& inputState) const override;
             
             void doPick(const InputState& inputState, Model::PickResult& pickResult) override;
             
@@ -117,6 +117,7 @@ namespace TrenchBroom {
                 const int DebugCrashReportDialog             = Lowest + 146;
                 const int DebugSetWindowSize                 = Lowest + 147;
                 const int DebugThrowExceptionDuringCommand   = Lowest + 148;
+                const int DebugPrintUndoMemoryUsage          = Lowest + 149;
 
                 const int RunCompile                         = Lowest + 150;
                 const int RunLaunch                          = Lowest + 151;
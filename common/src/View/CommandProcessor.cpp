@@ -26,6 +26,7 @@
 #include <wx/time.h>
 
 #include <algorithm>
+#include <iterator>
 
 namespace TrenchBroom {
     namespace View {
@@ -97,6 +98,13 @@ namespace TrenchBroom {
         bool CommandGroup::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+
+        size_t CommandGroup::doGetMemorySize() const {
+            size_t result = 0;
+            for (const auto& command : m_commands)
+                result += command->memorySize();
+            return result;
+        }
         
         const wxLongLong CommandProcessor::CollationInterval(1000);
         
@@ -113,6 +121,7 @@ namespace TrenchBroom {
         m_document(document),
         m_clearRepeatableCommandStack(false),
         m_lastCommandTimestamp(0),
+        m_memoryBudget(0),
         m_groupLevel(0) {
             ensure(m_document != nullptr, "document is null");
         }
@@ -252,6 +261,26 @@ namespace TrenchBroom {
             m_nextCommandStack.clear();
             m_lastCommandTimestamp = 0;
         }
+
+        void CommandProcessor::setMemoryBudget(const size_t memoryBudget) {
+            m_memoryBudget = memoryBudget;
+            if (m_groupLevel == 0) {
+                enforceMemoryBudget();
+            }
+        }
+
+        size_t CommandProcessor::memoryBudget() const {
+            return m_memoryBudget;
+        }
+
+        size_t CommandProcessor::memoryUsage() const {
+            size_t result = 0;
+            for (const auto& command : m_lastCommandStack)
+                result += command->memorySize();
+            for (const auto& command : m_nextCommandStack)
+                result += command->memorySize();
+            return result;
+        }
         
         CommandProcessor::SubmitAndStoreResult CommandProcessor::submitAndStoreCommand(UndoableCommand::Ptr command, const bool collate) {
             SubmitAndStoreResult result;
@@ -352,10 +381,12 @@ namespace TrenchBroom {
             if (collatable(collate, timestamp)) {
                 auto lastCommand = m_lastCommandStack.back();
                 if (lastCommand->collateWith(command)) {
+                    enforceMemoryBudget();
                     return false;
                 }
             }
             m_lastCommandStack.push_back(command);
+            enforceMemoryBudget();
             return true;
         }
         
@@ -363,6 +394,35 @@ namespace TrenchBroom {
             return collate && !m_lastCommandStack.empty() && timestamp - m_lastCommandTimestamp <= CollationInterval;
         }
         
+        void CommandProcessor::enforceMemoryBudget() {
+            assert(m_groupLevel == 0);
+            if (m_memoryBudget == 0) {
+                return;
+            }
+
+            auto usage = memoryUsage();
+            auto count = size_t(0);
+            while (usage > m_memoryBudget && count + 1 < m_lastCommandStack.size()) {
+                usage -= m_lastCommandStack[count]->memorySize();
+                ++count;
+            }
+
+            if (count > 0) {
+                m_lastCommandStack.erase(std::begin(m_lastCommandStack), std::next(std::begin(m_lastCommandStack), static_cast<std::ptrdiff_t>(count)));
+            }
+
+            // if that is not enough, discard the commands that would be redone last, which are at the bottom of the stack
+            count = 0;
+            while (usage > m_memoryBudget && count < m_nextCommandStack.size()) {
+                usage -= m_nextCommandStack[count]->memorySize();
+                ++count;
+            }
+
+            if (count > 0) {
+                m_nextCommandStack.erase(std::begin(m_nextCommandStack), std::next(std::begin(m_nextCommandStack), static_cast<std::ptrdiff_t>(count)));
+            }
+        }
+        
         void CommandProcessor::pushNextCommand(UndoableCommand::Ptr command) {
             assert(m_groupLevel == 0);
             m_nextCommandStack.push_back(command);
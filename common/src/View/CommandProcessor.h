@@ -62,6 +62,8 @@ namespace TrenchBroom {
             UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const override;
 
             bool doCollateWith(UndoableCommand::Ptr command) override;
+
+            size_t doGetMemorySize() const override;
         };
         
         class CommandProcessor {
@@ -76,6 +78,8 @@ namespace TrenchBroom {
             CommandStack m_repeatableCommandStack;
             bool m_clearRepeatableCommandStack;
             wxLongLong m_lastCommandTimestamp;
+            // the number of bytes that the undo stack may use, or 0 if it is unlimited
+            size_t m_memoryBudget;
             
             String m_groupName;
             CommandStack m_groupedCommands;
@@ -111,6 +115,19 @@ namespace TrenchBroom {
             void clearRepeatableCommands();
             
             void clear();
+
+            /**
+             * Limits the memory used by the stored commands to the given number of bytes by discarding the oldest
+             * commands that can be undone, and then the commands that would be redone last. The most recent command
+             * that can be undone is always kept. A budget of 0 means no limit.
+             */
+            void setMemoryBudget(size_t memoryBudget);
+            size_t memoryBudget() const;
+
+            /**
+             * Returns an estimate of the number of bytes used by the commands that can be undone or redone.
+             */
+            size_t memoryUsage() const;
         private:
             SubmitAndStoreResult submitAndStoreCommand(UndoableCommand::Ptr command, bool collate);
             bool doCommand(Command::Ptr command);
@@ -125,6 +142,7 @@ namespace TrenchBroom {
 
             bool pushLastCommand(UndoableCommand::Ptr command, bool collate);
             bool collatable(bool collate, wxLongLong timestamp) const;
+            void enforceMemoryBudget();
             
             void pushNextCommand(UndoableCommand::Ptr command);
             void pushRepeatableCommand(UndoableCommand::Ptr command);
@@ -51,5 +51,9 @@ namespace TrenchBroom {
         bool ConvertEntityColorCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+
+        size_t ConvertEntityColorCommand::doGetMemorySize() const {
+            return m_attributeName.capacity() + Model::EntityAttributeSnapshot::memorySize(m_snapshots);
+        }
     }
 }
@@ -19,7 +19,6 @@
 
 #include "IssueBrowserView.h"
 
-#include "Model/CollectMatchingIssuesVisitor.h"
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
 #include "Model/World.h"
@@ -29,6 +28,8 @@
 #include <wx/menu.h>
 #include <wx/settings.h>
 
+#include <chrono>
+
 namespace TrenchBroom {
     namespace View {
         IssueBrowserView::IssueBrowserView(wxWindow* parent, MapDocumentWPtr document) :
@@ -168,17 +169,31 @@ namespace TrenchBroom {
         }
 
         void IssueBrowserView::updateIssues() {
-            m_issues.clear();
-            
             MapDocumentSPtr document = lock(m_document);
             Model::World* world = document->world();
-            if (world != nullptr) {
-                const Model::IssueGeneratorList& issueGenerators = world->registeredIssueGenerators();
-                Model::CollectMatchingIssuesVisitor<IssueVisible> visitor(issueGenerators, IssueVisible(m_hiddenGenerators, m_showHiddenIssues));
-                world->acceptAndRecurse(visitor);
-                m_issues = visitor.issues();
-                VectorUtils::sort(m_issues, IssueCmp());
+            if (world == nullptr) {
+                m_validationQueue.clear();
+                return;
             }
+
+            // Validate as many batches as fit into a short time slice. The remaining nodes are validated during the
+            // following idle events, so a large map does not block the editor while its issues are generated.
+            const auto maxDuration = std::chrono::milliseconds(50);
+            const auto start = std::chrono::steady_clock::now();
+
+            const Model::IssueGeneratorList& issueGenerators = world->registeredIssueGenerators();
+            const IssueVisible visible(m_hiddenGenerators, m_showHiddenIssues);
+            do {
+                for (Model::Node* node : m_validationQueue.validateNext(issueGenerators, ValidationBatchSize)) {
+                    for (Model::Issue* issue : node->issues(issueGenerators)) {
+                        if (visible(issue)) {
+                            m_issues.push_back(issue);
+                        }
+                    }
+                }
+            } while (!m_validationQueue.done() && std::chrono::steady_clock::now() - start < maxDuration);
+
+            VectorUtils::sort(m_issues, IssueCmp());
         }
 
         void IssueBrowserView::OnApplyQuickFix(wxCommandEvent& event) {
@@ -283,17 +298,27 @@ namespace TrenchBroom {
 
         void IssueBrowserView::OnIdle(wxIdleEvent& event) {
             validate();
+            if (!m_validationQueue.done()) {
+                event.RequestMore();
+            }
         }
         
         void IssueBrowserView::invalidate() {
             m_valid = false;
+            m_issues.clear();
+            m_validationQueue.clear();
             SetItemCount(0);
         }
         
         void IssueBrowserView::validate() {
             if (!m_valid) {
                 m_valid = true;
-                
+
+                MapDocumentSPtr document = lock(m_document);
+                m_validationQueue.reset(document->world());
+            }
+
+            if (!m_validationQueue.done()) {
                 updateIssues();
                 SetItemCount(static_cast<long>(m_issues.size()));
             }
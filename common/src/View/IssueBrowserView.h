@@ -23,6 +23,7 @@
 #include "View/ViewTypes.h"
 
 #include "Model/Issue.h"
+#include "Model/IssueValidationQueue.h"
 #include "Model/ModelTypes.h"
 
 #include <wx/listctrl.h>
@@ -38,11 +39,13 @@ namespace TrenchBroom {
             static const int ShowIssuesCommandId = 1;
             static const int HideIssuesCommandId = 2;
             static const int FixObjectsBaseId = 3;
+            static const size_t ValidationBatchSize = 1024;
             
             using IndexList = std::vector<size_t>;
             
             MapDocumentWPtr m_document;
             Model::IssueList m_issues;
+            Model::IssueValidationQueue m_validationQueue;
             
             Model::IssueType m_hiddenGenerators;
             bool m_showHiddenIssues;
@@ -21,12 +21,15 @@
 
 #include "PreferenceManager.h"
 #include "Preferences.h"
+#include "ParallelUtils.h"
 #include "Polyhedron.h"
 #include "Assets/EntityDefinitionManager.h"
 #include "Assets/EntityModelManager.h"
 #include "Assets/Texture.h"
 #include "Assets/TextureManager.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/MapSaveQueue.h"
+#include "IO/MapSnapshot.h"
 #include "IO/SimpleParserStatus.h"
 #include "IO/SystemPaths.h"
 #include "Model/AttributeNameWithDoubleQuotationMarksIssueGenerator.h"
@@ -35,16 +38,15 @@
 #include "Model/BrushBuilder.h"
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
+#include "Model/BrushSnapshot.h"
 #include "Model/ChangeBrushFaceAttributesRequest.h"
 #include "Model/CollectAttributableNodesVisitor.h"
-#include "Model/CollectContainedNodesVisitor.h"
 #include "Model/CollectMatchingBrushFacesVisitor.h"
 #include "Model/CollectNodesVisitor.h"
 #include "Model/CollectNodesByVisibilityVisitor.h"
 #include "Model/CollectSelectableNodesVisitor.h"
 #include "Model/CollectSelectableNodesWithFilePositionVisitor.h"
 #include "Model/CollectSelectedNodesVisitor.h"
-#include "Model/CollectTouchingNodesVisitor.h"
 #include "Model/CollectUniqueNodesVisitor.h"
 #include "Model/ComputeNodeBoundsVisitor.h"
 #include "Model/EditorContext.h"
@@ -56,6 +58,7 @@
 #include "Model/LinkSourceIssueGenerator.h"
 #include "Model/LinkTargetIssueGenerator.h"
 #include "Model/FindLayerVisitor.h"
+#include "Model/FindNodesInBrushes.h"
 #include "Model/Game.h"
 #include "Model/GameFactory.h"
 #include "Model/Group.h"
@@ -116,6 +119,7 @@
 #include <vecmath/util.h>
 
 #include <cassert>
+#include <limits>
 #include <numeric>
 
 namespace TrenchBroom {
@@ -139,6 +143,7 @@ namespace TrenchBroom {
         m_editorContext(std::make_unique<Model::EditorContext>()),
         m_mapViewConfig(std::make_unique<MapViewConfig>(*m_editorContext)),
         m_grid(std::make_unique<Grid>(4)),
+        m_saveQueue(std::make_unique<IO::MapSaveQueue>()),
         m_path(DefaultDocumentName),
         m_lastSaveModificationCount(0),
         m_modificationCount(0),
@@ -146,6 +151,7 @@ namespace TrenchBroom {
         m_currentTextureName(Model::BrushFace::NoTextureName),
         m_lastSelectionBounds(0.0, 32.0),
         m_selectionBoundsValid(true),
+        m_transformPreviewActive(false),
         m_viewEffectsService(nullptr) {
                 bindObservers();
         }
@@ -282,28 +288,78 @@ namespace TrenchBroom {
             m_game->writeMap(*m_world, path);
         }
         
+        void MapDocument::saveDocumentToInBackground(const IO::Path& path) {
+            enqueueSave(path, std::nullopt);
+        }
+        
         void MapDocument::exportDocumentAs(const Model::ExportFormat format, const IO::Path& path) {
             m_game->exportMap(*m_world, format, path);
         }
 
+        bool MapDocument::hasPendingSaves() const {
+            return m_saveQueue->hasPendingSaves();
+        }
+
+        void MapDocument::waitForPendingSaves() {
+            m_saveQueue->waitForPendingSaves();
+        }
+
+        bool MapDocument::reportFinishedSaves() {
+            auto documentSaved = true;
+            for (const auto& result : m_saveQueue->takeResults()) {
+                assert(!m_pendingSaveModificationCounts.empty());
+                const auto modificationCount = m_pendingSaveModificationCounts.front();
+                m_pendingSaveModificationCounts.pop_front();
+
+                if (result.success) {
+                    info() << "Saved " << result.path;
+                    if (modificationCount.has_value()) {
+                        setLastSaveModificationCount(*modificationCount);
+                    }
+                } else {
+                    error() << "Could not save " << result.path << ": " << result.error;
+                    if (modificationCount.has_value()) {
+                        documentSaved = false;
+                    }
+                }
+            }
+            return documentSaved;
+        }
+
         void MapDocument::doSaveDocument(const IO::Path& path) {
-            saveDocumentTo(path);
-            setLastSaveModificationCount();
+            enqueueSave(path, m_modificationCount);
             setPath(path);
             documentWasSavedNotifier(this);
         }
+
+        void MapDocument::enqueueSave(const IO::Path& path, const std::optional<size_t> modificationCount) {
+            ensure(m_game.get() != nullptr, "game is null");
+            ensure(m_world != nullptr, "world is null");
+            m_saveQueue->enqueue(std::make_unique<IO::MapSnapshot>(*m_world, m_game->gameName()), path);
+            m_pendingSaveModificationCounts.push_back(modificationCount);
+        }
         
         void MapDocument::clearDocument() {
+            // saves of the previous map must not mark the next one as saved
+            waitForPendingSaves();
+            reportFinishedSaves();
+
             if (m_world != nullptr) {
                 documentWillBeClearedNotifier(this);
 
                 m_editorContext->reset();
                 clearSelection();
                 unloadAssets();
+
+                // observers may still refer to the nodes, so the world is only deleted once they have been notified
+                std::unique_ptr<Model::World> world = std::move(m_world);
                 clearWorld();
                 clearModificationCount();
                 
                 documentWasClearedNotifier(this);
+
+                world.reset();
+                Model::BrushGeometry::releaseUnusedMemory();
             }
         }
         
@@ -532,10 +588,7 @@ namespace TrenchBroom {
         void MapDocument::selectTouching(const bool del) {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
             
-            Model::CollectTouchingNodesVisitor<Model::BrushList::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
-            
-            const Model::NodeList nodes = visitor.nodes();
+            const Model::NodeList nodes = Model::findNodesTouchingBrushes(*m_world, std::begin(brushes), std::end(brushes), editorContext());
             
             Transaction transaction(this, "Select Touching");
             if (del)
@@ -548,10 +601,7 @@ namespace TrenchBroom {
         void MapDocument::selectInside(const bool del) {
             const Model::BrushList& brushes = m_selectedNodes.brushes();
 
-            Model::CollectContainedNodesVisitor<Model::BrushList::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
-            
-            const Model::NodeList nodes = visitor.nodes();
+            const Model::NodeList nodes = Model::findNodesContainedInBrushes(*m_world, std::begin(brushes), std::end(brushes), editorContext());
 
             Transaction transaction(this, "Select Inside");
             if (del)
@@ -617,9 +667,15 @@ namespace TrenchBroom {
         }
         
         void MapDocument::validateSelectionBounds() const {
-            Model::ComputeNodeBoundsVisitor visitor;
-            Model::Node::accept(std::begin(m_selectedNodes), std::end(m_selectedNodes), visitor);
-            m_selectionBounds = visitor.bounds();
+            if (m_transformPreview != nullptr) {
+                Model::ComputeTransformedNodeBoundsVisitor visitor(m_transformPreview->transform());
+                Model::Node::accept(std::begin(m_selectedNodes), std::end(m_selectedNodes), visitor);
+                m_selectionBounds = visitor.bounds();
+            } else {
+                Model::ComputeNodeBoundsVisitor visitor;
+                Model::Node::accept(std::begin(m_selectedNodes), std::end(m_selectedNodes), visitor);
+                m_selectionBounds = visitor.bounds();
+            }
             m_selectionBoundsValid = true;
         }
         
@@ -1015,27 +1071,99 @@ namespace TrenchBroom {
         }
         
         bool MapDocument::translateObjects(const vm::vec3& delta) {
-            return submitAndStore(TransformObjectsCommand::translate(delta, pref(Preferences::TextureLock)));
+            return transformObjects(TransformObjectsCommand::translate(delta, pref(Preferences::TextureLock)));
         }
         
         bool MapDocument::rotateObjects(const vm::vec3& center, const vm::vec3& axis, const FloatType angle) {
-            return submitAndStore(TransformObjectsCommand::rotate(center, axis, angle, pref(Preferences::TextureLock)));
+            return transformObjects(TransformObjectsCommand::rotate(center, axis, angle, pref(Preferences::TextureLock)));
         }
         
         bool MapDocument::scaleObjects(const vm::bbox3& oldBBox, const vm::bbox3& newBBox) {
-            return submitAndStore(TransformObjectsCommand::scale(oldBBox, newBBox, pref(Preferences::TextureLock)));
+            return transformObjects(TransformObjectsCommand::scale(oldBBox, newBBox, pref(Preferences::TextureLock)));
         }
         
         bool MapDocument::scaleObjects(const vm::vec3& center, const vm::vec3& scaleFactors) {
-            return submitAndStore(TransformObjectsCommand::scale(center, scaleFactors, pref(Preferences::TextureLock)));
+            return transformObjects(TransformObjectsCommand::scale(center, scaleFactors, pref(Preferences::TextureLock)));
         }
         
         bool MapDocument::shearObjects(const vm::bbox3& box, const vm::vec3& sideToShear, const vm::vec3& delta) {
-            return submitAndStore(TransformObjectsCommand::shearBBox(box, sideToShear, delta,  pref(Preferences::TextureLock)));
+            return transformObjects(TransformObjectsCommand::shearBBox(box, sideToShear, delta,  pref(Preferences::TextureLock)));
         }
         
         bool MapDocument::flipObjects(const vm::vec3& center, const vm::axis::type axis) {
-            return submitAndStore(TransformObjectsCommand::flip(center, axis, pref(Preferences::TextureLock)));
+            return transformObjects(TransformObjectsCommand::flip(center, axis, pref(Preferences::TextureLock)));
+        }
+
+        void MapDocument::beginTransformPreview() {
+            assert(!m_transformPreviewActive);
+            m_transformPreviewActive = true;
+            m_transformPreview = nullptr;
+        }
+
+        bool MapDocument::commitTransformPreview() {
+            assert(m_transformPreviewActive);
+            auto command = m_transformPreview;
+            cancelTransformPreview();
+
+            if (command == nullptr) {
+                return true;
+            }
+            return submitAndStore(command);
+        }
+
+        void MapDocument::resetTransformPreview() {
+            assert(m_transformPreviewActive);
+            if (m_transformPreview != nullptr) {
+                m_transformPreview = nullptr;
+                invalidateSelectionBounds();
+                transformPreviewDidChangeNotifier();
+            }
+        }
+
+        void MapDocument::cancelTransformPreview() {
+            resetTransformPreview();
+            m_transformPreviewActive = false;
+        }
+
+        bool MapDocument::transformPreviewActive() const {
+            return m_transformPreviewActive;
+        }
+
+        vm::mat4x4 MapDocument::transformPreview() const {
+            if (m_transformPreview == nullptr) {
+                return vm::mat4x4::identity;
+            }
+            return m_transformPreview->transform();
+        }
+
+        bool MapDocument::transformObjects(std::shared_ptr<TransformObjectsCommand> command) {
+            if (!m_transformPreviewActive) {
+                return submitAndStore(command);
+            }
+
+            if (!hasSelectedNodes()) {
+                return false;
+            }
+
+            // the objects are only checked against the world bounds here; the brush geometry is validated when the
+            // preview is committed
+            const auto transform = command->transform() * transformPreview();
+            Model::ComputeTransformedNodeBoundsVisitor visitor(transform);
+            Model::Node::accept(std::begin(m_selectedNodes), std::end(m_selectedNodes), visitor);
+            if (!m_worldBounds.contains(visitor.bounds())) {
+                return false;
+            }
+
+            if (m_transformPreview == nullptr) {
+                m_transformPreview = command;
+            } else {
+                m_transformPreview->appendTransform(command->transform());
+            }
+
+            m_selectionBounds = visitor.bounds();
+            m_selectionBoundsValid = true;
+            transformPreviewDidChangeNotifier();
+            return true;
         }
         
         bool MapDocument::createBrush(const std::vector<vm::vec3>& points) {
@@ -1122,8 +1250,17 @@ namespace TrenchBroom {
                 toRemove.push_back(subtrahend);
             }
 
-            for (auto* minuend : minuends) {
-                const Model::BrushList result = minuend->subtract(*m_world, m_worldBounds, currentTextureName(), subtrahends);
+            // the fragments of the minuends are computed concurrently, but the brushes are created on this thread
+            // because assigning textures to their faces is not thread safe
+            const auto mergeFragments = pref(Preferences::CSGSubtractMergeFragments);
+            std::vector<Model::BrushGeometry::List> fragments(minuends.size());
+            ParallelUtils::parallelFor(minuends.size(), [&](const size_t i) {
+                fragments[i] = minuends[i]->subtractGeometry(subtrahends, mergeFragments);
+            });
+
+            for (size_t i = 0; i < minuends.size(); ++i) {
+                auto* minuend = minuends[i];
+                const Model::BrushList result = minuend->createBrushes(*m_world, m_worldBounds, currentTextureName(), fragments[i], subtrahends);
 
                 if (!result.empty()) {
                     VectorUtils::append(toAdd[minuend->parent()], result);
@@ -1416,6 +1553,11 @@ namespace TrenchBroom {
 
         const ThrowExceptionCommand::CommandType ThrowExceptionCommand::Type = Command::freeType();
 
+        void MapDocument::printUndoMemoryUsage() {
+            info("Undo memory usage: %zu KiB, %zu shared face attribute records",
+                 doGetUndoMemoryUsage() / 1024, Model::BrushSnapshot::sharedAttributeCount());
+        }
+
         bool MapDocument::throwExceptionDuringCommand() {
             return submitAndStore(ThrowExceptionCommand::Ptr(new ThrowExceptionCommand()));
         }
@@ -1452,6 +1594,11 @@ namespace TrenchBroom {
             doClearRepeatableCommands();
         }
         
+        void MapDocument::updateUndoMemoryBudget() {
+            const auto budget = static_cast<size_t>(std::max(0, pref(Preferences::UndoMemoryBudget)));
+            doSetUndoMemoryBudget(budget * 1024 * 1024);
+        }
+
         void MapDocument::beginTransaction(const String& name) {
             doBeginTransaction(name);
         }
@@ -1480,6 +1627,10 @@ namespace TrenchBroom {
         void MapDocument::commitPendingAssets() {
             m_textureManager->commitChanges();
         }
+
+        bool MapDocument::hasPendingAssets() const {
+            return m_textureManager->hasDecodedTextures();
+        }
         
         void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
             if (m_world != nullptr)
@@ -1515,7 +1666,7 @@ namespace TrenchBroom {
         }
         
         void MapDocument::clearWorld() {
-            m_world.release();
+            m_world.reset();
             m_currentLayer = nullptr;
         }
         
@@ -1828,8 +1979,8 @@ namespace TrenchBroom {
             return m_modificationCount;
         }
 
-        void MapDocument::setLastSaveModificationCount() {
-            m_lastSaveModificationCount = m_modificationCount;
+        void MapDocument::setLastSaveModificationCount(const size_t modificationCount) {
+            m_lastSaveModificationCount = modificationCount;
             documentModificationStateDidChangeNotifier();
         }
         
@@ -1873,6 +2024,8 @@ namespace TrenchBroom {
                        path == Preferences::TextureMagFilter.path()) {
                 m_entityModelManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
                 m_textureManager->setTextureMode(pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+            } else if (path == Preferences::UndoMemoryBudget.path()) {
+                updateUndoMemoryBudget();
             }
         }
 
@@ -39,7 +39,9 @@
 #include <vecmath/bbox.h>
 #include <vecmath/util.h>
 
+#include <deque>
 #include <memory>
+#include <optional>
 
 class Color;
 namespace TrenchBroom {
@@ -48,6 +50,10 @@ namespace TrenchBroom {
         class EntityModelManager;
         class TextureManager;
     }
+
+    namespace IO {
+        class MapSaveQueue;
+    }
     
     namespace Model {
         class BrushFaceAttributes;
@@ -64,6 +70,7 @@ namespace TrenchBroom {
         class Grid;
         class MapViewConfig;
         class Selection;
+        class TransformObjectsCommand;
         class UndoableCommand;
         class ViewEffectsService;
         
@@ -88,6 +95,11 @@ namespace TrenchBroom {
             std::unique_ptr<Model::EditorContext> m_editorContext;
             std::unique_ptr<MapViewConfig> m_mapViewConfig;
             std::unique_ptr<Grid> m_grid;
+
+            std::unique_ptr<IO::MapSaveQueue> m_saveQueue;
+            // for every save that has not been reported yet, in the order in which they were enqueued, the
+            // modification count to mark as saved once it succeeded, or nothing if the save is a backup
+            std::deque<std::optional<size_t>> m_pendingSaveModificationCounts;
             
             IO::Path m_path;
             size_t m_lastSaveModificationCount;
@@ -102,6 +114,9 @@ namespace TrenchBroom {
             vm::bbox3 m_lastSelectionBounds;
             mutable vm::bbox3 m_selectionBounds;
             mutable bool m_selectionBoundsValid;
+
+            bool m_transformPreviewActive;
+            std::shared_ptr<TransformObjectsCommand> m_transformPreview;
             
             ViewEffectsService* m_viewEffectsService;
 
@@ -142,6 +157,8 @@ namespace TrenchBroom {
             
             Notifier1<const Model::BrushFaceList&> brushFacesDidChangeNotifier;
 
+            Notifier0 transformPreviewDidChangeNotifier;
+
             Notifier0 textureCollectionsWillChangeNotifier;
             Notifier0 textureCollectionsDidChangeNotifier;
 
@@ -188,12 +205,29 @@ namespace TrenchBroom {
         public: // new, load, save document
             void newDocument(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, Model::GameSPtr game);
             void loadDocument(Model::MapFormat mapFormat, const vm::bbox3& worldBounds, Model::GameSPtr game, const IO::Path& path);
+            /**
+             * saveDocument, saveDocumentAs and saveDocumentToInBackground only take a snapshot of the map and write it
+             * on a worker thread, so the document can be edited again right away. Their outcome is logged by
+             * reportFinishedSaves, and the document is only marked as saved once its file was written. saveDocumentTo
+             * writes the file before it returns.
+             */
             void saveDocument();
             void saveDocumentAs(const IO::Path& path);
             void saveDocumentTo(const IO::Path& path);
+            void saveDocumentToInBackground(const IO::Path& path);
             void exportDocumentAs(Model::ExportFormat format, const IO::Path& path);
+
+            bool hasPendingSaves() const;
+            void waitForPendingSaves();
+
+            /**
+             * Logs the outcome of all saves that finished since the last call. Returns false if saving the document
+             * itself failed.
+             */
+            bool reportFinishedSaves();
         private:
             void doSaveDocument(const IO::Path& path);
+            void enqueueSave(const IO::Path& path, std::optional<size_t> modificationCount);
             void clearDocument();
         public: // copy and paste
             String serializeSelectedNodes();
@@ -309,6 +343,41 @@ namespace TrenchBroom {
             bool scaleObjects(const vm::vec3& center, const vm::vec3& scaleFactors) override;
             bool shearObjects(const vm::bbox3& box, const vm::vec3& sideToShear, const vm::vec3& delta) override;
             bool flipObjects(const vm::vec3& center, vm::axis::type axis) override;
+        public: // previewing transformations
+            /**
+             * Starts a transformation preview. While the preview is active, transformations of the selected objects
+             * are collected instead of being applied. The selection is rendered and its bounds are reported as if the
+             * collected transformation had been applied, but the objects remain unchanged until the preview is
+             * committed.
+             */
+            void beginTransformPreview();
+
+            /**
+             * Ends the transformation preview and applies the collected transformation to the selected objects using a
+             * single command.
+             *
+             * @return true if there was nothing to apply or if the transformation was applied successfully
+             */
+            bool commitTransformPreview();
+
+            /**
+             * Discards the collected transformation, but keeps the preview active.
+             */
+            void resetTransformPreview();
+
+            /**
+             * Discards the collected transformation and ends the preview.
+             */
+            void cancelTransformPreview();
+
+            bool transformPreviewActive() const;
+
+            /**
+             * Returns the collected transformation, or the identity if no transformation has been collected.
+             */
+            vm::mat4x4 transformPreview() const;
+        private:
+            bool transformObjects(std::shared_ptr<TransformObjectsCommand> command);
         public:
             bool createBrush(const std::vector<vm::vec3>& points);
             bool csgConvexMerge();
@@ -355,6 +424,7 @@ namespace TrenchBroom {
             virtual void performRebuildBrushGeometry(const Model::BrushList& brushes) = 0;
         public: // debug commands
             void printVertices();
+            void printUndoMemoryUsage();
             bool throwExceptionDuringCommand();
         public: // command processing
             bool canUndoLastCommand() const;
@@ -370,6 +440,8 @@ namespace TrenchBroom {
             void rollbackTransaction();
             void commitTransaction();
             void cancelTransaction();
+        protected:
+            void updateUndoMemoryBudget();
         private:
             bool submit(Command::Ptr command);
             bool submitAndStore(UndoableCommand::Ptr command);
@@ -382,6 +454,8 @@ namespace TrenchBroom {
             virtual void doRedoNextCommand() = 0;
             virtual bool doRepeatLastCommands() = 0;
             virtual void doClearRepeatableCommands() = 0;
+            virtual void doSetUndoMemoryBudget(size_t memoryBudget) = 0;
+            virtual size_t doGetUndoMemoryUsage() const = 0;
             
             virtual void doBeginTransaction(const String& name) = 0;
             virtual void doEndTransaction() = 0;
@@ -391,6 +465,7 @@ namespace TrenchBroom {
             virtual bool doSubmitAndStore(UndoableCommand::Ptr command) = 0;
         public: // asset state management
             void commitPendingAssets();
+            bool hasPendingAssets() const;
         public: // picking
             void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
             Model::NodeList findNodesContaining(const vm::vec3& point) const;
@@ -463,7 +538,7 @@ namespace TrenchBroom {
             bool modified() const;
             size_t modificationCount() const;
         private:
-            void setLastSaveModificationCount();
+            void setLastSaveModificationCount(size_t modificationCount);
             void clearModificationCount();
         private: // observers
             void bindObservers();
@@ -51,6 +51,7 @@ namespace TrenchBroom {
         MapDocumentCommandFacade::MapDocumentCommandFacade() :
         m_commandProcessor(this) {
             bindObservers();
+            updateUndoMemoryBudget();
         }
 
         void MapDocumentCommandFacade::performSelect(const Model::NodeList& nodes) {
@@ -257,10 +258,31 @@ namespace TrenchBroom {
             selectionDidChangeNotifier(selection);
         }
 
+        /**
+         * Indicates whether the node tree should be rebuilt instead of being updated for every added node. Rebuilding
+         * pays off if the added nodes make up a large part of the world, e.g. after pasting or duplicating many objects.
+         */
+        static bool shouldRebuildNodeTree(const Model::World* world, const Model::ParentChildrenMap& nodes) {
+            static const size_t MinAddedNodes = 256;
+
+            size_t addedCount = 0;
+            for (const auto& entry : nodes) {
+                for (const auto* child : entry.second) {
+                    addedCount += child->familySize();
+                }
+            }
+            return addedCount >= MinAddedNodes && addedCount * 4 >= world->descendantCount();
+        }
+
         void MapDocumentCommandFacade::performAddNodes(const Model::ParentChildrenMap& nodes) {
             const Model::NodeList parents = collectParents(nodes);
             Notifier1<const Model::NodeList&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
             
+            const auto rebuildNodeTree = shouldRebuildNodeTree(m_world.get(), nodes);
+            if (rebuildNodeTree) {
+                m_world->disableNodeTreeUpdates();
+            }
+
             Model::NodeList addedNodes;
             for (const auto& entry : nodes) {
                 Model::Node* parent = entry.first;
@@ -268,6 +290,11 @@ namespace TrenchBroom {
                 parent->addChildren(children);
                 VectorUtils::append(addedNodes, children);
             }
+
+            if (rebuildNodeTree) {
+                m_world->rebuildNodeTree();
+                m_world->enableNodeTreeUpdates();
+            }
             
             setEntityDefinitions(addedNodes);
             setTextures(addedNodes);
@@ -970,6 +997,14 @@ namespace TrenchBroom {
             m_commandProcessor.clearRepeatableCommands();
         }
 
+        void MapDocumentCommandFacade::doSetUndoMemoryBudget(const size_t memoryBudget) {
+            m_commandProcessor.setMemoryBudget(memoryBudget);
+        }
+
+        size_t MapDocumentCommandFacade::doGetUndoMemoryUsage() const {
+            return m_commandProcessor.memoryUsage();
+        }
+
         void MapDocumentCommandFacade::doBeginTransaction(const String& name) {
             debug("Starting transaction '" + name + "'");
             m_commandProcessor.beginGroup(name);
@@ -131,6 +131,8 @@ namespace TrenchBroom {
             void doRedoNextCommand() override;
             bool doRepeatLastCommands() override;
             void doClearRepeatableCommands() override;
+            void doSetUndoMemoryBudget(size_t memoryBudget) override;
+            size_t doGetUndoMemoryUsage() const override;
             
             void doBeginTransaction(const String& name) override;
             void doEndTransaction() override;
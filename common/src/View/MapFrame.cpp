@@ -88,6 +88,7 @@ namespace TrenchBroom {
         m_frameManager(nullptr),
         m_autosaver(nullptr),
         m_autosaveTimer(nullptr),
+        m_pendingAssetsTimer(nullptr),
         m_contextManager(nullptr),
         m_mapView(nullptr),
         m_console(nullptr),
@@ -102,6 +103,7 @@ namespace TrenchBroom {
         m_frameManager(nullptr),
         m_autosaver(nullptr),
         m_autosaveTimer(nullptr),
+        m_pendingAssetsTimer(nullptr),
         m_contextManager(nullptr),
         m_mapView(nullptr),
         m_console(nullptr),
@@ -134,6 +136,10 @@ namespace TrenchBroom {
             m_autosaveTimer = new wxTimer(this);
             m_autosaveTimer->Start(1000);
 
+            m_pendingAssetsTimer = new wxTimer();
+            m_pendingAssetsTimer->Bind(wxEVT_TIMER, &MapFrame::OnPendingAssetsTimer, this);
+            m_pendingAssetsTimer->Start(100);
+
             bindObservers();
             bindEvents();
 
@@ -186,6 +192,9 @@ namespace TrenchBroom {
             delete m_autosaveTimer;
             m_autosaveTimer = nullptr;
 
+            delete m_pendingAssetsTimer;
+            m_pendingAssetsTimer = nullptr;
+
             delete m_autosaver;
             m_autosaver = nullptr;
 
@@ -257,7 +266,6 @@ namespace TrenchBroom {
             try {
                 if (m_document->persistent()) {
                     m_document->saveDocument();
-                    logger().info() << "Saved " << m_document->path();
                     return true;
                 }
                 return saveDocumentAs();
@@ -281,7 +289,6 @@ namespace TrenchBroom {
 
                 const IO::Path path(saveDialog.GetPath().ToStdString());
                 m_document->saveDocumentAs(path);
-                logger().info() << "Saved " << m_document->path();
                 return true;
             } catch (const FileSystemException& e) {
                 ::wxMessageBox(e.what(), "", wxOK | wxICON_ERROR, this);
@@ -292,6 +299,20 @@ namespace TrenchBroom {
             }
         }
 
+        bool MapFrame::saveDocumentAndWait() {
+            // the document may be closed or replaced right afterwards, so the file must be written successfully
+            if (!saveDocument()) {
+                return false;
+            }
+
+            m_document->waitForPendingSaves();
+            if (!m_document->reportFinishedSaves()) {
+                ::wxMessageBox("Could not save " + m_document->filename() + ", see the console for details.", "", wxOK | wxICON_ERROR, this);
+                return false;
+            }
+            return true;
+        }
+
         bool MapFrame::exportDocumentAsObj() {
             const IO::Path& originalPath = m_document->path();
             const IO::Path directory = originalPath.deleteLastComponent();
@@ -320,12 +341,16 @@ namespace TrenchBroom {
         }
 
         bool MapFrame::confirmOrDiscardChanges() {
+            // a save that is still being written may fail and leave the document modified
+            m_document->waitForPendingSaves();
+            m_document->reportFinishedSaves();
+
             if (!m_document->modified())
                 return true;
             const int result = ::wxMessageBox(m_document->filename() + " has been modified. Do you want to save the changes?", "TrenchBroom", wxYES_NO | wxCANCEL, this);
             switch (result) {
                 case wxYES:
-                    return saveDocument();
+                    return saveDocumentAndWait();
                 case wxNO:
                     return true;
                 default:
@@ -775,6 +800,7 @@ namespace TrenchBroom {
             Bind(wxEVT_MENU, &MapFrame::OnRunLaunch, this, CommandIds::Menu::RunLaunch);
             
             Bind(wxEVT_MENU, &MapFrame::OnDebugPrintVertices, this, CommandIds::Menu::DebugPrintVertices);
+            Bind(wxEVT_MENU, &MapFrame::OnDebugPrintUndoMemoryUsage, this, CommandIds::Menu::DebugPrintUndoMemoryUsage);
             Bind(wxEVT_MENU, &MapFrame::OnDebugCreateBrush, this, CommandIds::Menu::DebugCreateBrush);
             Bind(wxEVT_MENU, &MapFrame::OnDebugCreateCube, this, CommandIds::Menu::DebugCreateCube);
             Bind(wxEVT_MENU, &MapFrame::OnDebugClipBrush, this, CommandIds::Menu::DebugClipWithFace);
@@ -1450,6 +1476,12 @@ namespace TrenchBroom {
             m_document->printVertices();
         }
 
+        void MapFrame::OnDebugPrintUndoMemoryUsage(wxCommandEvent& event) {
+            if (IsBeingDeleted()) return;
+            
+            m_document->printUndoMemoryUsage();
+        }
+
         void MapFrame::OnDebugCreateBrush(wxCommandEvent& event) {
             if (IsBeingDeleted()) return;
             
@@ -1843,6 +1875,7 @@ namespace TrenchBroom {
                     event.Enable(canLaunch());
                     break;
                 case CommandIds::Menu::DebugPrintVertices:
+                case CommandIds::Menu::DebugPrintUndoMemoryUsage:
                 case CommandIds::Menu::DebugCreateBrush:
                 case CommandIds::Menu::DebugCreateCube:
                 case CommandIds::Menu::DebugCopyJSShortcuts:
@@ -2076,6 +2109,19 @@ namespace TrenchBroom {
 
             m_autosaver->triggerAutosave(logger());
         }
+
+        void MapFrame::OnPendingAssetsTimer(wxTimerEvent& event) {
+            if (IsBeingDeleted()) return;
+
+            // textures are decoded in the background and uploaded when the views are rendered
+            if (m_document->hasPendingAssets()) {
+                m_mapView->Refresh();
+                m_inspector->Refresh();
+            }
+
+            // maps are saved in the background, too
+            m_document->reportFinishedSaves();
+        }
         
         int MapFrame::indexForGridSize(const int gridSize) {
             return gridSize - Grid::MinSize;
@@ -59,6 +59,7 @@ namespace TrenchBroom {
 
             Autosaver* m_autosaver;
             wxTimer* m_autosaveTimer;
+            wxTimer* m_pendingAssetsTimer;
 
             SplitterWindow2* m_hSplitter;
             SplitterWindow2* m_vSplitter;
@@ -96,6 +97,7 @@ namespace TrenchBroom {
         private:
             bool saveDocument();
             bool saveDocumentAs();
+            bool saveDocumentAndWait();
             bool exportDocumentAsObj();
             bool exportDocument(Model::ExportFormat format, const IO::Path& path);
 
@@ -235,6 +237,7 @@ namespace TrenchBroom {
             void OnRunLaunch(wxCommandEvent& event);
 
             void OnDebugPrintVertices(wxCommandEvent& event);
+            void OnDebugPrintUndoMemoryUsage(wxCommandEvent& event);
             void OnDebugCreateBrush(wxCommandEvent& event);
             void OnDebugCreateCube(wxCommandEvent& event);
             void OnDebugClipBrush(wxCommandEvent& event);
@@ -291,6 +294,7 @@ namespace TrenchBroom {
         private: // other event handlers
             void OnClose(wxCloseEvent& event);
             void OnAutosaveTimer(wxTimerEvent& event);
+            void OnPendingAssetsTimer(wxTimerEvent& event);
         private: // grid helpers
             static int indexForGridSize(const int gridSize);
             static int gridSizeForIndex(const int index);
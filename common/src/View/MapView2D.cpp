@@ -23,9 +23,9 @@
 #include "Model/Brush.h"
 #include "Model/BrushBuilder.h"
 #include "Model/BrushFace.h"
-#include "Model/CollectContainedNodesVisitor.h"
 #include "Model/CompareHits.h"
 #include "Model/Entity.h"
+#include "Model/FindNodesInBrushes.h"
 #include "Model/HitAdapter.h"
 #include "Model/HitQuery.h"
 #include "Model/PickResult.h"
@@ -219,9 +219,7 @@ namespace TrenchBroom {
             Transaction transaction(document, "Select Tall");
             document->deleteObjects();
 
-            Model::CollectContainedNodesVisitor<Model::BrushList::const_iterator> visitor(std::begin(tallBrushes), std::end(tallBrushes), document->editorContext());
-            document->world()->acceptAndRecurse(visitor);
-            document->select(visitor.nodes());
+            document->select(Model::findNodesContainedInBrushes(*document->world(), std::begin(tallBrushes), std::end(tallBrushes), document->editorContext()));
 
             VectorUtils::clearAndDelete(tallBrushes);
         }
@@ -26,6 +26,7 @@
 #include "Model/BrushFace.h"
 #include "Model/BrushGeometry.h"
 #include "Model/Entity.h"
+#include "Model/Group.h"
 #include "Model/HitAdapter.h"
 #include "Model/HitQuery.h"
 #include "Model/PickResult.h"
@@ -309,7 +310,10 @@ namespace TrenchBroom {
         Model::PickResult MapView3D::doPick(const vm::ray3& pickRay) const {
             MapDocumentSPtr document = lock(m_document);
             const Model::EditorContext& editorContext = document->editorContext();
-            Model::PickResult pickResult = Model::PickResult::byDistance(editorContext);
+
+            // picking runs on every mouse move, and most tools only look at the closest pickable brush and the hits in
+            // front of it
+            Model::PickResult pickResult = toolsNeedAllHits() ? Model::PickResult::byDistance(editorContext) : Model::PickResult::closestByDistance(editorContext, Model::Brush::BrushHit);
 
             document->pick(pickRay, pickResult);
             return pickResult;
@@ -330,10 +334,11 @@ namespace TrenchBroom {
                 const auto pickRay = vm::ray3(m_camera.pickRay(clientCoords.x, clientCoords.y));
                 
                 const auto& editorContext = document->editorContext();
-                auto pickResult = Model::PickResult::byDistance(editorContext);
+                auto pickResult = Model::PickResult::closestByDistance(editorContext, Model::Brush::BrushHit);
 
+                // entities and closed groups in front of a brush don't prevent pasting onto it
                 document->pick(pickRay, pickResult);
-                const auto& hit = pickResult.query().pickable().type(Model::Brush::BrushHit).first();
+                const auto& hit = pickResult.query().pickable().type(Model::Brush::BrushHit).occluded(Model::Entity::EntityHit | Model::Group::GroupHit).first();
                 
                 if (hit.isMatch()) {
                     const auto* face = Model::hitToFace(hit);
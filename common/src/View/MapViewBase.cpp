@@ -126,6 +126,7 @@ namespace TrenchBroom {
             document->nodesDidChangeNotifier.addObserver(this, &MapViewBase::nodesDidChange);
             document->nodeVisibilityDidChangeNotifier.addObserver(this, &MapViewBase::nodesDidChange);
             document->nodeLockingDidChangeNotifier.addObserver(this, &MapViewBase::nodesDidChange);
+            document->transformPreviewDidChangeNotifier.addObserver(this, &MapViewBase::transformPreviewDidChange);
             document->commandDoneNotifier.addObserver(this, &MapViewBase::commandDone);
             document->commandUndoneNotifier.addObserver(this, &MapViewBase::commandUndone);
             document->selectionDidChangeNotifier.addObserver(this, &MapViewBase::selectionDidChange);
@@ -160,6 +161,7 @@ namespace TrenchBroom {
                 document->nodesDidChangeNotifier.removeObserver(this, &MapViewBase::nodesDidChange);
                 document->nodeVisibilityDidChangeNotifier.removeObserver(this, &MapViewBase::nodesDidChange);
                 document->nodeLockingDidChangeNotifier.removeObserver(this, &MapViewBase::nodesDidChange);
+                document->transformPreviewDidChangeNotifier.removeObserver(this, &MapViewBase::transformPreviewDidChange);
                 document->commandDoneNotifier.removeObserver(this, &MapViewBase::commandDone);
                 document->commandUndoneNotifier.removeObserver(this, &MapViewBase::commandUndone);
                 document->selectionDidChangeNotifier.removeObserver(this, &MapViewBase::selectionDidChange);
@@ -192,6 +194,10 @@ namespace TrenchBroom {
             Refresh();
         }
 
+        void MapViewBase::transformPreviewDidChange() {
+            Refresh();
+        }
+
         void MapViewBase::toolChanged(Tool* tool) {
             updatePickResult();
             updateAcceleratorTable(HasFocus());
@@ -93,6 +93,7 @@ namespace TrenchBroom {
             void unbindObservers();
             
             void nodesDidChange(const Model::NodeList& nodes);
+            void transformPreviewDidChange();
             void toolChanged(Tool* tool);
             void commandDone(Command::Ptr command);
             void commandUndone(UndoableCommand::Ptr command);
@@ -48,9 +48,14 @@ namespace TrenchBroom {
             return lock(m_document)->grid();
         }
 
+        bool MoveObjectsTool::hasSelection() const {
+            return lock(m_document)->hasSelection();
+        }
+
         bool MoveObjectsTool::startMove(const InputState& inputState) {
             auto document = lock(m_document);
             document->beginTransaction(duplicateObjects(inputState) ? "Duplicate Objects" : "Move Objects");
+            document->beginTransformPreview();
             m_duplicateObjects = duplicateObjects(inputState);
             return true;
         }
@@ -79,11 +84,16 @@ namespace TrenchBroom {
         
         void MoveObjectsTool::endMove(const InputState& inputState) {
             auto document = lock(m_document);
-            document->commitTransaction();
+            if (document->commitTransformPreview()) {
+                document->commitTransaction();
+            } else {
+                document->cancelTransaction();
+            }
         }
         
         void MoveObjectsTool::cancelMove() {
             auto document = lock(m_document);
+            document->cancelTransformPreview();
             document->cancelTransaction();
         }
 
@@ -47,6 +47,7 @@ namespace TrenchBroom {
             MoveObjectsTool(MapDocumentWPtr document);
         public:
             const Grid& grid() const;
+            bool hasSelection() const;
             
             bool startMove(const InputState& inputState);
             MoveResult move(const InputState& inputState, const vm::vec3& delta);
@@ -44,6 +44,11 @@ namespace TrenchBroom {
             return m_tool;
         }
 
+        bool MoveObjectsToolController::doNeedsAllHits(const InputState& inputState) const {
+            // the selected object to move may be behind other objects
+            return m_tool->hasSelection();
+        }
+
         MoveObjectsToolController::MoveInfo MoveObjectsToolController::doStartMove(const InputState& inputState) {
             if (!inputState.modifierKeysPressed(ModifierKeys::MKNone) &&
                 !inputState.modifierKeysPressed(ModifierKeys::MKAlt) &&
@@ -57,5 +57,10 @@ namespace TrenchBroom {
         bool ReparentNodesCommand::doCollateWith(UndoableCommand::Ptr command) {
             return false;
         }
+
+        size_t ReparentNodesCommand::doGetMemorySize() const {
+            // the reparented nodes always belong to the document, so only the maps count
+            return Model::mapMemorySize(m_nodesToAdd) + Model::mapMemorySize(m_nodesToRemove);
+        }
     }
 }
@@ -46,6 +46,11 @@ namespace TrenchBroom {
         Tool* ResizeBrushesToolController::doGetTool() {
             return m_tool;
         }
+
+        bool ResizeBrushesToolController::doNeedsAllHits(const InputState& inputState) const {
+            // the tool looks for a selected brush behind other objects
+            return handleInput(inputState);
+        }
         
         void ResizeBrushesToolController::doPick(const InputState& inputState, Model::PickResult& pickResult) {
             if (handleInput(inputState)) {
@@ -90,16 +90,22 @@ namespace TrenchBroom {
         void RotateObjectsTool::beginRotation() {
             MapDocumentSPtr document = lock(m_document);
             document->beginTransaction("Rotate Objects");
+            document->beginTransformPreview();
         }
         
         void RotateObjectsTool::commitRotation() {
             MapDocumentSPtr document = lock(m_document);
-            document->commitTransaction();
-            updateRecentlyUsedCenters(rotationCenter());
+            if (document->commitTransformPreview()) {
+                document->commitTransaction();
+                updateRecentlyUsedCenters(rotationCenter());
+            } else {
+                document->cancelTransaction();
+            }
         }
         
         void RotateObjectsTool::cancelRotation() {
             MapDocumentSPtr document = lock(m_document);
+            document->cancelTransformPreview();
             document->cancelTransaction();
         }
         
@@ -110,7 +116,7 @@ namespace TrenchBroom {
         
         void RotateObjectsTool::applyRotation(const vm::vec3& center, const vm::vec3& axis, const FloatType angle) {
             MapDocumentSPtr document = lock(m_document);
-            document->rollbackTransaction();
+            document->resetTransformPreview();
             document->rotateObjects(center, axis, angle);
         }
         
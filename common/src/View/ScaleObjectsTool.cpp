@@ -887,6 +887,7 @@ namespace TrenchBroom {
 
             MapDocumentSPtr document = lock(m_document);
             document->beginTransaction("Scale Objects");
+            document->beginTransformPreview();
             m_resizing = true;
         }
 
@@ -908,15 +909,19 @@ namespace TrenchBroom {
         void ScaleObjectsTool::commitScale() {
             MapDocumentSPtr document = lock(m_document);
             if (isZero(m_dragCumulativeDelta, vm::C::almostZero())) {
+                document->cancelTransformPreview();
                 document->cancelTransaction();
-            } else {
+            } else if (document->commitTransformPreview()) {
                 document->commitTransaction();
+            } else {
+                document->cancelTransaction();
             }
             m_resizing = false;
         }
 
         void ScaleObjectsTool::cancelScale() {
             MapDocumentSPtr document = lock(m_document);
+            document->cancelTransformPreview();
             document->cancelTransaction();
             m_resizing = false;
         }
@@ -48,6 +48,11 @@ namespace TrenchBroom {
         Tool* SelectionTool::doGetTool() {
             return this;
         }
+
+        bool SelectionTool::doNeedsAllHits(const InputState& inputState) const {
+            // drilling the selection steps through all objects under the mouse, see doMouseScroll
+            return inputState.checkModifierKeys(MK_Yes, MK_No, MK_No);
+        }
         
         bool SelectionTool::doMouseClick(const InputState& inputState) {
             if (!handleClick(inputState)) {
@@ -169,6 +169,7 @@ namespace TrenchBroom {
 
             MapDocumentSPtr document = lock(m_document);
             document->beginTransaction("Shear Objects");
+            document->beginTransformPreview();
             m_resizing = true;
         }
 
@@ -177,9 +178,12 @@ namespace TrenchBroom {
 
             MapDocumentSPtr document = lock(m_document);
             if (isZero(m_dragCumulativeDelta, vm::C::almostZero())) {
+                document->cancelTransformPreview();
                 document->cancelTransaction();
-            } else {
+            } else if (document->commitTransformPreview()) {
                 document->commitTransaction();
+            } else {
+                document->cancelTransaction();
             }
             m_resizing = false;
         }
@@ -188,6 +192,7 @@ namespace TrenchBroom {
             ensure(m_resizing, "must be resizing already");
 
             MapDocumentSPtr document = lock(m_document);
+            document->cancelTransformPreview();
             document->cancelTransaction();
 
             m_resizing = false;
@@ -41,6 +41,8 @@ namespace TrenchBroom {
             void takeSnapshot(MapDocumentCommandFacade* document);
             bool restoreSnapshot(MapDocumentCommandFacade* document);
             void deleteSnapshot();
+
+            size_t doGetMemorySize() const override;
         private:
             virtual Model::Snapshot* doTakeSnapshot(MapDocumentCommandFacade* document) const;
         };
@@ -214,20 +214,22 @@ namespace TrenchBroom {
             reload();
         }
 
+        // Changes to the map only affect the usage counts of the textures, and the view lays itself out again if
+        // its layout depends on them.
         void TextureBrowser::nodesWereAdded(const Model::NodeList& nodes) {
-            reload();
+            refresh();
         }
         
         void TextureBrowser::nodesWereRemoved(const Model::NodeList& nodes) {
-            reload();
+            refresh();
         }
         
         void TextureBrowser::nodesDidChange(const Model::NodeList& nodes) {
-            reload();
+            refresh();
         }
         
         void TextureBrowser::brushFacesDidChange(const Model::BrushFaceList& faces) {
-            reload();
+            refresh();
         }
 
         void TextureBrowser::textureCollectionsDidChange() {
@@ -255,6 +257,13 @@ namespace TrenchBroom {
             }
         }
 
+        void TextureBrowser::refresh() {
+            if (m_view != nullptr) {
+                updateSelectedTexture();
+                m_view->Refresh();
+            }
+        }
+
         void TextureBrowser::updateSelectedTexture() {
             MapDocumentSPtr document = lock(m_document);
             const String& textureName = document->currentTextureName();
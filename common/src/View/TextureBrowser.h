@@ -90,6 +90,7 @@ namespace TrenchBroom {
             void preferenceDidChange(const IO::Path& path);
 
             void reload();
+            void refresh();
             void updateSelectedTexture();
         };
     }
@@ -35,6 +35,8 @@
 #include <vecmath/mat.h>
 #include <vecmath/mat_ext.h>
 
+#include <unordered_set>
+
 namespace TrenchBroom {
     namespace View {
         TextureCellData::TextureCellData(Assets::Texture* i_texture, const Renderer::FontDescriptor& i_fontDescriptor) :
@@ -50,7 +52,9 @@ namespace TrenchBroom {
         m_group(false),
         m_hideUnused(false),
         m_sortOrder(SO_Name),
-        m_selectedTexture(nullptr) {
+        m_selectedTexture(nullptr),
+        m_cellTitleFont(IO::Path(), 0),
+        m_cellTitleMaxWidth(0.0f) {
             m_textureManager.usageCountDidChange.addObserver(this, &TextureBrowserView::usageCountDidChange);
         }
         
@@ -103,7 +107,10 @@ namespace TrenchBroom {
         }
 
         void TextureBrowserView::usageCountDidChange() {
-            invalidate();
+            // otherwise, only the colors of the cell borders change
+            if (layoutDependsOnUsage()) {
+                invalidate();
+            }
             Refresh();
         }
 
@@ -125,23 +132,24 @@ namespace TrenchBroom {
             assert(fontSize > 0);
             
             const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
+            const MatchName matchName(m_filterText, m_textureManager);
             
             if (m_group) {
                 for (const Assets::TextureCollection* collection : getCollections()) {
                     layout.addGroup(collection->name(), fontSize + 2.0f);
-                    for (Assets::Texture* texture : getTextures(collection))
+                    for (Assets::Texture* texture : getTextures(collection, matchName))
                         addTextureToLayout(layout, texture, font);
                 }
             } else {
-                for (Assets::Texture* texture : getTextures())
+                for (Assets::Texture* texture : getTextures(matchName))
                     addTextureToLayout(layout, texture, font);
             }
         }
         
         void TextureBrowserView::addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font) {
-            const float maxCellWidth = layout.maxCellWidth();
-            const Renderer::FontDescriptor actualFont = fontManager().selectFontSize(font, texture->name(), maxCellWidth, 5);
-            const vm::vec2f actualSize = fontManager().font(actualFont).measure(texture->name());
+            const CellTitle& title = cellTitle(texture, font, layout.maxCellWidth());
+            const Renderer::FontDescriptor& actualFont = title.font;
+            const vm::vec2f& actualSize = title.size;
             
             const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
             const size_t scaledTextureWidth = static_cast<size_t>(vm::round(scaleFactor * static_cast<float>(texture->width())));
@@ -154,6 +162,27 @@ namespace TrenchBroom {
                            font.size() + 2.0f);
         }
 
+        const TextureBrowserView::CellTitle& TextureBrowserView::cellTitle(const Assets::Texture* texture, const Renderer::FontDescriptor& font, const float maxCellWidth) {
+            if (font.compare(m_cellTitleFont) != 0 || maxCellWidth != m_cellTitleMaxWidth) {
+                m_cellTitles.clear();
+                m_cellTitleFont = font;
+                m_cellTitleMaxWidth = maxCellWidth;
+            }
+
+            const size_t key = texture->internedName().id();
+            auto it = m_cellTitles.find(key);
+            if (it == std::end(m_cellTitles)) {
+                const Renderer::FontDescriptor actualFont = fontManager().selectFontSize(font, texture->name(), maxCellWidth, 5);
+                const vm::vec2f actualSize = fontManager().font(actualFont).measure(texture->name());
+                it = m_cellTitles.insert(std::make_pair(key, CellTitle{ actualFont, actualSize })).first;
+            }
+            return it->second;
+        }
+
+        bool TextureBrowserView::layoutDependsOnUsage() const {
+            return m_hideUnused || m_sortOrder == SO_Usage;
+        }
+
         struct TextureBrowserView::CompareByUsageCount {
             StringUtils::CaseInsensitiveStringLess m_less;
 
@@ -185,12 +214,19 @@ namespace TrenchBroom {
         };
         
         struct TextureBrowserView::MatchName {
-            String pattern;
-            
-            MatchName(const String& i_pattern) : pattern(i_pattern) {}
-            
+            bool active;
+            std::unordered_set<const Assets::Texture*> matches;
+
+            MatchName(const String& pattern, const Assets::TextureManager& textureManager) :
+            active(!pattern.empty()) {
+                if (active) {
+                    const Assets::TextureList found = textureManager.findTextures(pattern);
+                    matches.insert(std::begin(found), std::end(found));
+                }
+            }
+
             bool operator()(const Assets::Texture* texture) const {
-                return !StringUtils::containsCaseInsensitive(texture->name(), pattern);
+                return active && matches.count(texture) == 0;
             }
         };
 
@@ -203,25 +239,25 @@ namespace TrenchBroom {
             return collections;
         }
         
-        Assets::TextureList TextureBrowserView::getTextures(const Assets::TextureCollection* collection) const {
+        Assets::TextureList TextureBrowserView::getTextures(const Assets::TextureCollection* collection, const MatchName& matchName) const {
             Assets::TextureList textures = collection->textures();
-            filterTextures(textures);
+            filterTextures(textures, matchName);
             sortTextures(textures);
             return textures;
         }
         
-        Assets::TextureList TextureBrowserView::getTextures() const {
+        Assets::TextureList TextureBrowserView::getTextures(const MatchName& matchName) const {
             Assets::TextureList textures = m_textureManager.textures();
-            filterTextures(textures);
+            filterTextures(textures, matchName);
             sortTextures(textures);
             return textures;
         }
 
-        void TextureBrowserView::filterTextures(Assets::TextureList& textures) const {
+        void TextureBrowserView::filterTextures(Assets::TextureList& textures, const MatchName& matchName) const {
+            if (matchName.active)
+                VectorUtils::eraseIf(textures, matchName);
             if (m_hideUnused)
                 VectorUtils::eraseIf(textures, MatchUsageCount());
-            if (!m_filterText.empty())
-                VectorUtils::eraseIf(textures, MatchName(m_filterText));
         }
         
         void TextureBrowserView::sortTextures(Assets::TextureList& textures) const {
@@ -326,7 +362,8 @@ namespace TrenchBroom {
                             for (size_t k = 0; k < row.size(); ++k) {
                                 const Layout::Group::Row::Cell& cell = row[k];
                                 const LayoutBounds& bounds = cell.itemBounds();
-                                const Assets::Texture* texture = cell.item().texture;
+                                Assets::Texture* texture = cell.item().texture;
+                                texture->raiseDecodePriority(Assets::TextureDecodePriority::Visible);
                                 
                                 vertices[0] = TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.top() - y)),    vm::vec2f(0.0f, 0.0f));
                                 vertices[1] = TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.bottom() - y)), vm::vec2f(0.0f, 1.0f));
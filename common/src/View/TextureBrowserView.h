@@ -29,6 +29,7 @@
 #include "View/CellView.h"
 
 #include <map>
+#include <unordered_map>
 
 class wxScrollBar;
 
@@ -60,6 +61,16 @@ namespace TrenchBroom {
             using TextVertex = Renderer::VertexSpecs::P2T2C4::Vertex;
             using StringMap = std::map<Renderer::FontDescriptor, TextVertex::List>;
 
+            /**
+             * The font and size of a texture name as shown below the texture.
+             */
+            struct CellTitle {
+                Renderer::FontDescriptor font;
+                vm::vec2f size;
+            };
+            // indexed by the ID of the interned texture name
+            using CellTitleCache = std::unordered_map<size_t, CellTitle>;
+
             Assets::TextureManager& m_textureManager;
 
             bool m_group;
@@ -68,6 +79,12 @@ namespace TrenchBroom {
             String m_filterText;
             
             Assets::Texture* m_selectedTexture;
+
+            // fitting a title into a cell takes several measurements, so they are kept until the font or the cell
+            // width change
+            CellTitleCache m_cellTitles;
+            Renderer::FontDescriptor m_cellTitleFont;
+            float m_cellTitleMaxWidth;
         public:
             TextureBrowserView(wxWindow* parent,
                                wxScrollBar* scrollBar,
@@ -88,6 +105,8 @@ namespace TrenchBroom {
             void doInitLayout(Layout& layout) override;
             void doReloadLayout(Layout& layout) override;
             void addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font);
+            const CellTitle& cellTitle(const Assets::Texture* texture, const Renderer::FontDescriptor& font, float maxCellWidth);
+            bool layoutDependsOnUsage() const;
             
             struct CompareByUsageCount;
             struct CompareByName;
@@ -95,10 +114,10 @@ namespace TrenchBroom {
             struct MatchName;
             
             Assets::TextureCollectionList getCollections() const;
-            Assets::TextureList getTextures(const Assets::TextureCollection* collection) const;
-            Assets::TextureList getTextures() const;
+            Assets::TextureList getTextures(const Assets::TextureCollection* collection, const MatchName& matchName) const;
+            Assets::TextureList getTextures(const MatchName& matchName) const;
             
-            void filterTextures(Assets::TextureList& textures) const;
+            void filterTextures(Assets::TextureList& textures, const MatchName& matchName) const;
             void sortTextures(Assets::TextureList& textures) const;
             
             void doClear() override;
@@ -64,6 +64,10 @@ namespace TrenchBroom {
             m_toolChain->append(tool);
         }
 
+        bool ToolBoxConnector::toolsNeedAllHits() const {
+            return m_toolChain->needsAllHits(m_inputState);
+        }
+
         bool ToolBoxConnector::dragEnter(const wxCoord x, const wxCoord y, const String& text) {
             ensure(m_toolBox != nullptr, "toolBox is null");
 
@@ -64,6 +64,7 @@ namespace TrenchBroom {
         protected:
             void setToolBox(ToolBox& toolBox);
             void addTool(ToolController* tool);
+            bool toolsNeedAllHits() const;
         public: // drag and drop
             bool dragEnter(wxCoord x, wxCoord y, const String& text);
             bool dragMove(wxCoord x, wxCoord y, const String& text);
@@ -47,6 +47,13 @@ namespace TrenchBroom {
             assert(checkInvariant());
         }
         
+        bool ToolChain::needsAllHits(const InputState& inputState) const {
+            assert(checkInvariant());
+            if (chainEndsHere())
+                return false;
+            return m_tool->needsAllHits(inputState) || m_suffix->needsAllHits(inputState);
+        }
+
         void ToolChain::pick(const InputState& inputState, Model::PickResult& pickResult) {
             assert(checkInvariant());
             if (!chainEndsHere()) {
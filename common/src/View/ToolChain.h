@@ -46,6 +46,7 @@ namespace TrenchBroom {
             
             void append(ToolController* adapter);
             
+            bool needsAllHits(const InputState& inputState) const;
             void pick(const InputState& inputState, Model::PickResult& pickResult);
             
             void modifierKeyChange(const InputState& inputState);
@@ -462,6 +462,8 @@ namespace TrenchBroom {
         ToolController::~ToolController() = default;
         Tool* ToolController::tool() { return doGetTool(); }
         bool ToolController::toolActive() { return tool()->active(); }
+        bool ToolController::needsAllHits(const InputState& inputState) { return toolActive() && doNeedsAllHits(inputState); }
+        bool ToolController::doNeedsAllHits(const InputState& inputState) const { return false; }
         void ToolController::refreshViews() { tool()->refreshViews(); }
 
         ToolControllerGroup::ToolControllerGroup() :
@@ -475,6 +477,10 @@ namespace TrenchBroom {
             m_chain.append(controller);
         }
 
+        bool ToolControllerGroup::doNeedsAllHits(const InputState& inputState) const {
+            return m_chain.needsAllHits(inputState);
+        }
+
         void ToolControllerGroup::doPick(const InputState& inputState, Model::PickResult& pickResult) {
             m_chain.pick(inputState, pickResult);
         }
@@ -365,7 +365,13 @@ namespace TrenchBroom {
             
             Tool* tool();
             bool toolActive();
-            
+
+            /**
+             * Indicates whether this tool may query hits behind the closest pickable brush in the given input state,
+             * e.g. to find a selected object behind others. Otherwise, picking can stop once that brush is found.
+             */
+            bool needsAllHits(const InputState& inputState);
+
             virtual void pick(const InputState& inputState, Model::PickResult& pickResult) = 0;
             
             virtual void modifierKeyChange(const InputState& inputState) = 0;
@@ -397,6 +403,7 @@ namespace TrenchBroom {
             void refreshViews();
         private:
             virtual Tool* doGetTool() = 0;
+            virtual bool doNeedsAllHits(const InputState& inputState) const;
         };
         
         template <class PickingPolicyType, class KeyPolicyType, class MousePolicyType, class MouseDragPolicyType, class RenderPolicyType, class DropPolicyType>
@@ -532,6 +539,7 @@ namespace TrenchBroom {
         protected:
             void addController(ToolController* controller);
         protected:
+            bool doNeedsAllHits(const InputState& inputState) const override;
             void doPick(const InputState& inputState, Model::PickResult& pickResult) override;
             
             void doModifierKeyChange(const InputState& inputState) override;
@@ -61,6 +61,14 @@ namespace TrenchBroom {
             return Ptr(new TransformObjectsCommand(Action_Flip, "Flip Objects", transform, lockTextures));
         }
 
+        const vm::mat4x4& TransformObjectsCommand::transform() const {
+            return m_transform;
+        }
+
+        void TransformObjectsCommand::appendTransform(const vm::mat4x4& transform) {
+            m_transform = transform * m_transform;
+        }
+
         TransformObjectsCommand::TransformObjectsCommand(const Action action, const String& name, const vm::mat4x4& transform, const bool lockTextures) :
         SnapshotCommand(Type, name),
         m_action(action),
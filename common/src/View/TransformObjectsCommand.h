@@ -55,6 +55,13 @@ namespace TrenchBroom {
             static Ptr scale(const vm::vec3& center, const vm::vec3& scaleFactors, bool lockTextures);
             static Ptr shearBBox(const vm::bbox3& box, const vm::vec3& sideToShear, const vm::vec3& delta, bool lockTextures);
             static Ptr flip(const vm::vec3& center, vm::axis::type axis, bool lockTextures);
+
+            const vm::mat4x4& transform() const;
+
+            /**
+             * Applies the given transformation after the transformation of this command.
+             */
+            void appendTransform(const vm::mat4x4& transform);
         private:
             TransformObjectsCommand(Action action, const String& name, const vm::mat4x4& transform, bool lockTextures);
 
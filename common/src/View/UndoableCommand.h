@@ -41,6 +41,11 @@ namespace TrenchBroom {
             UndoableCommand::Ptr repeat(MapDocumentCommandFacade* document) const;
             
             virtual bool collateWith(UndoableCommand::Ptr command);
+
+            /**
+             * Returns an estimate of the number of bytes that this command holds in order to undo it.
+             */
+            size_t memorySize() const;
         private:
             virtual bool doPerformUndo(MapDocumentCommandFacade* document) = 0;
             
@@ -49,6 +54,8 @@ namespace TrenchBroom {
             virtual UndoableCommand::Ptr doRepeat(MapDocumentCommandFacade* document) const;
             
             virtual bool doCollateWith(UndoableCommand::Ptr command) = 0;
+
+            virtual size_t doGetMemorySize() const;
         public: // this method is just a service for DocumentCommand and should never be called from anywhere else
             virtual size_t documentModificationCount() const;
         private:
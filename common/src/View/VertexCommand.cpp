@@ -174,6 +174,10 @@ namespace TrenchBroom {
             m_snapshot = nullptr;
         }
 
+        size_t VertexCommand::doGetMemorySize() const {
+            return m_snapshot != nullptr ? m_snapshot->memorySize() : 0;
+        }
+
         void VertexCommand::removeHandles(VertexHandleManagerBase& manager) {
             manager.removeHandles(std::begin(m_brushes), std::end(m_brushes));
         }
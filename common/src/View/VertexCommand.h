@@ -75,6 +75,8 @@ namespace TrenchBroom {
         private:
             void takeSnapshot();
             void deleteSnapshot();
+
+            size_t doGetMemorySize() const override;
         private:
             virtual bool doCanDoVertexOperation(const MapDocument* document) const = 0;
             virtual bool doVertexOperation(MapDocumentCommandFacade* document) = 0;
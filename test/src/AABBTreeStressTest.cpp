@@ -27,10 +27,17 @@
 #include "IO/WorldReader.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
+#include "Model/CollectMatchingNodesVisitor.h"
 #include "Model/Entity.h"
 #include "Model/NodeVisitor.h"
 #include "Model/World.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
 namespace TrenchBroom {
     namespace Model {
         using AABB = AABBTree<double, 3, Node*>;
@@ -96,6 +103,91 @@ namespace TrenchBroom {
             TreeBuilder builder(tree);
             world->acceptAndRecurse(builder);
         }
+
+        class MatchTreeNodes {
+        public:
+            bool operator()(const Node* node) const { return node->shouldAddToSpacialIndex(); }
+        };
+
+        template <typename L>
+        static double timeLambda(L&& lambda) {
+            const auto start = std::chrono::high_resolution_clock::now();
+            lambda();
+            const auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double>(end - start).count() * 1000.0;
+        }
+
+        TEST(AABBTreeStressTest, compareIncrementalAndBulkBuild) {
+            const auto mapPath = IO::Disk::getCurrentWorkingDir() + IO::Path("data/IO/Map/rtz_q1.map");
+            const auto file = IO::Disk::openFile(mapPath);
+
+            IO::TestParserStatus status;
+            IO::WorldReader reader(file->begin(), file->end(), nullptr);
+
+            const vm::bbox3 worldBounds(8192);
+            auto world = reader.read(Model::MapFormat::Standard, worldBounds, status);
+
+            CollectMatchingNodesVisitor<MatchTreeNodes> collect;
+            world->acceptAndRecurse(collect);
+            const auto& nodes = collect.nodes();
+            const auto getBounds = [](const Node* node) { return node->bounds(); };
+
+            AABB incrementalTree;
+            const auto incrementalBuildTime = timeLambda([&]() {
+                for (auto* node : nodes) {
+                    incrementalTree.insert(node->bounds(), node);
+                }
+            });
+
+            AABB bulkTree;
+            const auto bulkBuildTime = timeLambda([&]() {
+                bulkTree.clearAndBuild(nodes, getBounds);
+            });
+
+            ASSERT_EQ(incrementalTree.bounds(), bulkTree.bounds());
+            for (auto* node : nodes) {
+                ASSERT_TRUE(bulkTree.contains(node->bounds(), node));
+            }
+
+            std::mt19937 random(0);
+            std::uniform_real_distribution<double> coords(-1.0, 1.0);
+
+            const auto& bounds = bulkTree.bounds();
+            std::vector<vm::ray3> rays;
+            for (size_t i = 0; i < 10000; ++i) {
+                const auto origin = bounds.center() + vm::vec3(coords(random), coords(random), coords(random)) * bounds.size() / 2.0;
+                const auto direction = normalize(vm::vec3(coords(random), coords(random), coords(random)));
+                rays.emplace_back(origin, direction);
+            }
+
+            std::vector<AABB::List> incrementalResults;
+            const auto incrementalQueryTime = timeLambda([&]() {
+                for (const auto& ray : rays) {
+                    incrementalResults.push_back(incrementalTree.findIntersectors(ray));
+                }
+            });
+
+            std::vector<AABB::List> bulkResults;
+            const auto bulkQueryTime = timeLambda([&]() {
+                for (const auto& ray : rays) {
+                    bulkResults.push_back(bulkTree.findIntersectors(ray));
+                }
+            });
+
+            for (size_t i = 0; i < rays.size(); ++i) {
+                auto expected = incrementalResults[i];
+                auto actual = bulkResults[i];
+                expected.sort();
+                actual.sort();
+                ASSERT_EQ(expected, actual);
+            }
+
+            printf("Built tree with %zu nodes incrementally in %fms (height %zu), bulk in %fms (height %zu)\n",
+                   nodes.size(), incrementalBuildTime, incrementalTree.height(), bulkBuildTime, bulkTree.height());
+            printf("Average ray query time: %fus incremental, %fus bulk\n",
+                   incrementalQueryTime * 1000.0 / static_cast<double>(rays.size()),
+                   bulkQueryTime * 1000.0 / static_cast<double>(rays.size()));
+        }
     }
 }
 
@@ -468,6 +468,88 @@ TEST(AABBTreeTest, findIntersectorsFromInsideRootBBox) {
     assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x), { 2u });
 }
 
+TEST(AABBTreeTest, findIntersectorsOfBox) {
+    AABB tree;
+    ASSERT_TRUE(tree.findIntersectors(BOX(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0))).empty());
+
+    tree.insert(BOX(VEC(-2.0, -1.0, -1.0), VEC(-1.0, +1.0, +1.0)), 1u);
+    tree.insert(BOX(VEC(+1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0)), 2u);
+
+    ASSERT_TRUE(tree.findIntersectors(BOX(VEC(-0.5, 0.0, 0.0), VEC(0.5, 1.0, 1.0))).empty());
+    ASSERT_EQ(AABB::List({ 1u }), tree.findIntersectors(BOX(VEC(-1.0, 0.0, 0.0), VEC(0.0, 1.0, 1.0))));
+    ASSERT_EQ(AABB::List({ 2u }), tree.findIntersectors(BOX(VEC(1.5, 0.5, 0.5), VEC(3.0, 3.0, 3.0))));
+    ASSERT_EQ(2u, tree.findIntersectors(BOX(VEC(-1.0, 0.0, 0.0), VEC(1.0, 1.0, 1.0))).size());
+}
+
+TEST(AABBTreeTest, clearAndBuildEmptyTree) {
+    AABB tree;
+    tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0)), 1u);
+    tree.clearAndBuild(AABB::Array(), [](const size_t) { return BOX(); });
+
+    ASSERT_TRUE(tree.empty());
+}
+
+TEST(AABBTreeTest, clearAndBuildFourNodes) {
+    const auto getBounds = [](const size_t i) {
+        return makeBounds(2 * i, 2 * i + 1);
+    };
+
+    AABB tree;
+    tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0)), 5u);
+    tree.clearAndBuild(AABB::Array({ 3u, 1u, 0u, 2u }), getBounds);
+
+    assertTree(R"(
+O [ ( 0 -1 -1 ) ( 7 1 1 ) ]
+  O [ ( 0 -1 -1 ) ( 3 1 1 ) ]
+    L [ ( 0 -1 -1 ) ( 1 1 1 ) ]: 0
+    L [ ( 2 -1 -1 ) ( 3 1 1 ) ]: 1
+  O [ ( 4 -1 -1 ) ( 7 1 1 ) ]
+    L [ ( 4 -1 -1 ) ( 5 1 1 ) ]: 2
+    L [ ( 6 -1 -1 ) ( 7 1 1 ) ]: 3
+)" , tree);
+
+    ASSERT_EQ(3u, tree.height());
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(tree.contains(getBounds(i), i));
+    }
+    ASSERT_FALSE(tree.contains(BOX(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0)), 5u));
+
+    assertIntersectors(tree, RAY(VEC(-1.0, 0.0, 0.0), VEC::pos_x), { 0u, 1u, 2u, 3u });
+    assertIntersectors(tree, RAY(VEC(4.5, -2.0, 0.0), VEC::pos_y), { 2u });
+}
+
+TEST(AABBTreeTest, clearAndBuildIdenticalBounds) {
+    AABB::Array objects;
+    for (size_t i = 0; i < 100; ++i) {
+        objects.push_back(i);
+    }
+
+    AABB tree;
+    tree.clearAndBuild(objects, [](const size_t) { return makeBounds(0, 1); });
+
+    // objects whose bounds cannot be separated are split in half
+    ASSERT_EQ(8u, tree.height());
+    for (const auto i : objects) {
+        ASSERT_TRUE(tree.contains(makeBounds(0, 1), i));
+    }
+}
+
+TEST(AABBTreeTest, clearAndBuildThenInsertAndRemove) {
+    AABB::List objects;
+    for (size_t i = 0; i < 10; ++i) {
+        objects.push_back(i);
+    }
+
+    AABB tree;
+    tree.clearAndBuild(objects, [](const size_t i) { return makeBounds(i, i + 1); });
+    tree.insert(makeBounds(3, 4), 10u);
+    ASSERT_TRUE(tree.remove(makeBounds(5, 6), 5u));
+
+    ASSERT_TRUE(tree.contains(makeBounds(3, 4), 10u));
+    ASSERT_FALSE(tree.contains(makeBounds(5, 6), 5u));
+    assertIntersectors(tree, RAY(VEC(3.5, -2.0, 0.0), VEC::pos_y), { 3u, 10u });
+}
+
 void assertTree(const std::string& exp, const AABB& actual) {
     std::stringstream str;
     actual.print(str);
@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Allocator.h"
+
+#include <thread>
+#include <vector>
+
+class AllocatorTestObject : public Allocator<AllocatorTestObject, 16> {
+public:
+    size_t value;
+public:
+    explicit AllocatorTestObject(const size_t i_value) :
+    value(i_value) {}
+};
+
+TEST(AllocatorTest, allocateAndDelete) {
+    const auto before = AllocatorTestObject::statistics();
+
+    std::vector<AllocatorTestObject*> objects;
+    for (size_t i = 0; i < 100; ++i) {
+        objects.push_back(new AllocatorTestObject(i));
+    }
+
+    auto stats = AllocatorTestObject::statistics();
+    ASSERT_EQ(before.liveObjects + 100u, stats.liveObjects);
+    ASSERT_EQ(before.totalAllocations + 100u, stats.totalAllocations);
+    ASSERT_LE(before.chunks + 7u, stats.chunks);
+
+    for (size_t i = 0; i < objects.size(); ++i) {
+        ASSERT_EQ(i, objects[i]->value);
+    }
+
+    // delete in a different order than the objects were allocated in
+    for (size_t i = 0; i < objects.size(); i += 2) {
+        delete objects[i];
+    }
+    for (size_t i = 1; i < objects.size(); i += 2) {
+        delete objects[i];
+    }
+
+    AllocatorTestObject::releaseUnusedMemory();
+
+    stats = AllocatorTestObject::statistics();
+    ASSERT_EQ(before.liveObjects, stats.liveObjects);
+    ASSERT_EQ(0u, stats.chunks);
+    ASSERT_EQ(0u, stats.bytes);
+}
+
+TEST(AllocatorTest, deleteOnOtherThread) {
+    std::vector<AllocatorTestObject*> objects;
+    std::thread allocate([&]() {
+        for (size_t i = 0; i < 1000; ++i) {
+            objects.push_back(new AllocatorTestObject(i));
+        }
+    });
+    allocate.join();
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&objects, t]() {
+            for (size_t i = t; i < objects.size(); i += 4) {
+                ASSERT_EQ(i, objects[i]->value);
+                delete objects[i];
+
+                // reuse the freed memory on this thread
+                delete new AllocatorTestObject(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    AllocatorTestObject::releaseUnusedMemory();
+
+    const auto stats = AllocatorTestObject::statistics();
+    ASSERT_EQ(0u, stats.liveObjects);
+    ASSERT_EQ(0u, stats.chunks);
+}
@@ -0,0 +1,132 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelFrameCache.h"
+#include "Renderer/IndexRangeMap.h"
+
+#include <vecmath/bbox.h>
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace Assets {
+        /**
+         Creates a mesh with the given number of vertices for every frame.
+         */
+        class TestFrameLoader : public EntityModel::FrameLoader {
+        private:
+            size_t m_vertexCount;
+        public:
+            explicit TestFrameLoader(const size_t vertexCount) :
+            m_vertexCount(vertexCount) {}
+        private:
+            EntityModel::MeshList doLoadFrame(const size_t /* frameIndex */) const override {
+                const EntityModel::VertexList vertices(m_vertexCount);
+                EntityModel::MeshList result;
+                result.push_back(std::make_unique<EntityModel::IndexedMesh>(vertices, Renderer::IndexRangeMap(GL_TRIANGLES, 0, m_vertexCount)));
+                return result;
+            }
+        };
+
+        static std::unique_ptr<EntityModel> createModel(const size_t frameCount, const size_t vertexCount) {
+            auto model = std::make_unique<EntityModel>("model");
+            model->addSurface("surface");
+            for (size_t i = 0; i < frameCount; ++i) {
+                model->addFrame("frame" + std::to_string(i), vm::bbox3f(8.0f));
+            }
+            model->setFrameLoader(std::make_unique<TestFrameLoader>(vertexCount));
+            return model;
+        }
+
+        TEST(EntityModelFrameCacheTest, loadFrame) {
+            auto model = createModel(3, 30);
+            const auto frameSize = 30 * sizeof(EntityModel::Vertex);
+
+            EntityModelFrameCache cache(2 * frameSize);
+            cache.loadFrame(*model, 0);
+            ASSERT_TRUE(model->frameLoaded(0));
+            ASSERT_EQ(1u, cache.frameCount());
+            ASSERT_EQ(frameSize, cache.bytes());
+
+            // loading a frame again does not count it twice
+            cache.loadFrame(*model, 0);
+            ASSERT_EQ(1u, cache.frameCount());
+            ASSERT_EQ(frameSize, cache.bytes());
+
+            // out of range frames are ignored
+            cache.loadFrame(*model, 3);
+            ASSERT_EQ(1u, cache.frameCount());
+        }
+
+        TEST(EntityModelFrameCacheTest, evictLeastRecentlyUsedFrame) {
+            auto model1 = createModel(2, 30);
+            auto model2 = createModel(2, 30);
+            const auto frameSize = 30 * sizeof(EntityModel::Vertex);
+
+            EntityModelFrameCache cache(2 * frameSize);
+            cache.loadFrame(*model1, 0);
+            cache.loadFrame(*model2, 0);
+            cache.loadFrame(*model1, 0); // model2 frame 0 is now the least recently used frame
+            cache.loadFrame(*model1, 1);
+
+            ASSERT_EQ(2u, cache.frameCount());
+            ASSERT_EQ(2 * frameSize, cache.bytes());
+            ASSERT_TRUE(model1->frameLoaded(0));
+            ASSERT_TRUE(model1->frameLoaded(1));
+            ASSERT_FALSE(model2->frameLoaded(0));
+
+            // an evicted frame is loaded again on demand
+            cache.loadFrame(*model2, 0);
+            ASSERT_TRUE(model2->frameLoaded(0));
+            ASSERT_FALSE(model1->frameLoaded(0));
+            ASSERT_EQ(2u, cache.frameCount());
+        }
+
+        TEST(EntityModelFrameCacheTest, keepFrameLargerThanBudget) {
+            auto model = createModel(2, 30);
+
+            EntityModelFrameCache cache(16);
+            cache.loadFrame(*model, 0);
+            ASSERT_TRUE(model->frameLoaded(0));
+
+            cache.loadFrame(*model, 1);
+            ASSERT_FALSE(model->frameLoaded(0));
+            ASSERT_TRUE(model->frameLoaded(1));
+            ASSERT_EQ(1u, cache.frameCount());
+        }
+
+        TEST(EntityModelFrameCacheTest, ignoreModelsWithoutFrameLoader) {
+            EntityModel model("model");
+            model.addFrame("frame", vm::bbox3f(8.0f));
+            model.addSurface("surface").addIndexedMesh(EntityModel::VertexList(3), Renderer::IndexRangeMap(GL_TRIANGLES, 0, 3));
+
+            EntityModelFrameCache cache(0);
+            cache.loadFrame(model, 0);
+            ASSERT_TRUE(model.frameLoaded(0));
+            ASSERT_EQ(0u, cache.frameCount());
+
+            model.unloadFrame(0);
+            ASSERT_TRUE(model.frameLoaded(0));
+        }
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "EL.h"
+#include "Assets/ModelDefinition.h"
+#include "IO/ELParser.h"
+#include "Model/EntityAttributes.h"
+
+#include <map>
+
+namespace TrenchBroom {
+    namespace Assets {
+        using AttributeValues = std::map<String, String>;
+
+        static ModelSpecification modelSpecification(const ModelDefinition& definition, const AttributeValues& values) {
+            Model::EntityAttributes attributes;
+            for (const auto& entry : values) {
+                attributes.addOrUpdateAttribute(entry.first, entry.second, nullptr);
+            }
+            return definition.modelSpecification(attributes);
+        }
+
+        static ModelSpecification modelSpecification(const String& expression, const AttributeValues& values) {
+            return modelSpecification(ModelDefinition(IO::ELParser::parseStrict(expression)), values);
+        }
+
+        TEST(ModelDefinitionTest, evaluateLiterals) {
+            ASSERT_EQ(ModelSpecification(IO::Path("maps/b_shell0.bsp")), modelSpecification("\"maps/b_shell0.bsp\"", {}));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/armor.mdl"), 1, 2), modelSpecification("{ \"path\": \"progs/armor.mdl\", \"skin\": 1, \"frame\": 2 }", {}));
+            ASSERT_EQ(ModelSpecification(IO::Path(), 1), modelSpecification("{ \"skin\": 1 }", {}));
+        }
+
+        TEST(ModelDefinitionTest, evaluateAttributeComparisons) {
+            const String expression(
+                "{{"
+                "  spawnflags == 1 -> \"progs/one.mdl\","
+                "  \"2\" == spawnflags -> \"progs/two.mdl\","
+                "  style == \"red\" -> { \"path\": \"progs/style.mdl\", \"skin\": 1 },"
+                "  style == \"blue\" -> null,"
+                "  \"progs/default.mdl\""
+                "}}");
+
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/one.mdl")), modelSpecification(expression, { { "spawnflags", "1" } }));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/one.mdl")), modelSpecification(expression, { { "spawnflags", "1.0" } }));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/two.mdl")), modelSpecification(expression, { { "spawnflags", "2" } }));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/style.mdl"), 1), modelSpecification(expression, { { "style", "red" } }));
+            ASSERT_EQ(ModelSpecification(), modelSpecification(expression, { { "style", "blue" } }));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/default.mdl")), modelSpecification(expression, { { "style", "Red" } }));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/default.mdl")), modelSpecification(expression, {}));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/default.mdl")), modelSpecification(expression, { { "spawnflags", " " } }));
+        }
+
+        TEST(ModelDefinitionTest, evaluateNonNumericAttributeComparedToNumber) {
+            ASSERT_THROW(modelSpecification("{{ spawnflags == 1 -> \"progs/one.mdl\" }}", { { "spawnflags", "abc" } }), EL::ConversionError);
+        }
+
+        TEST(ModelDefinitionTest, evaluateAttributeMaps) {
+            const String expression("{ \"path\": model, \"skin\": skin, \"frame\": frame }");
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/player.mdl"), 2, 3), modelSpecification(expression, { { "model", "progs/player.mdl" }, { "skin", "2" }, { "frame", "3" } }));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/player.mdl")), modelSpecification(expression, { { "model", "progs/player.mdl" } }));
+            ASSERT_EQ(ModelSpecification(), modelSpecification(expression, {}));
+
+            // values that are not plain numbers are converted by EL
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/player.mdl"), 2, 0), modelSpecification(expression, { { "model", "progs/player.mdl" }, { "skin", "2 abc" }, { "frame", "abc" } }));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/player.mdl"), 2, 3), modelSpecification(expression, { { "model", "progs/player.mdl" }, { "skin", " 2" }, { "frame", "3 " } }));
+
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/player.mdl")), modelSpecification("model", { { "model", "progs/player.mdl" } }));
+        }
+
+        TEST(ModelDefinitionTest, evaluateOtherExpressions) {
+            const String expression(
+                "{{"
+                "  (spawnflags & 2) == 2 -> \"progs/two.mdl\","
+                "  { \"path\": \"progs/\" + name + \".mdl\" }"
+                " }}");
+
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/two.mdl")), modelSpecification(expression, { { "spawnflags", "3" } }));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/ogre.mdl")), modelSpecification(expression, { { "spawnflags", "1" }, { "name", "ogre" } }));
+        }
+
+        TEST(ModelDefinitionTest, evaluateAppendedDefinitions) {
+            ModelDefinition definition(IO::ELParser::parseStrict("{{ spawnflags == 1 -> \"progs/one.mdl\" }}"));
+            definition.append(ModelDefinition(IO::ELParser::parseStrict("{{ spawnflags == 2 -> \"progs/two.mdl\" }}")));
+
+            const ModelDefinition copy(definition);
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/one.mdl")), modelSpecification(copy, { { "spawnflags", "1" } }));
+            ASSERT_EQ(ModelSpecification(IO::Path("progs/two.mdl")), modelSpecification(copy, { { "spawnflags", "2" } }));
+            ASSERT_EQ(ModelSpecification(), modelSpecification(copy, { { "spawnflags", "3" } }));
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Assets/Texture.h"
+#include "Assets/TextureDecodeQueue.h"
+#include "ParallelUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST(TextureDecodeQueueTest, decodeAllJobs) {
+            TextureDecodeQueue::JobList jobs;
+            for (size_t i = 0; i < 100; ++i) {
+                jobs.push_back(std::make_shared<TextureDecodeJob>([]() { return new Texture("texture", 16, 16); }));
+            }
+            jobs[50]->cancel();
+            jobs[99]->raisePriority(TextureDecodePriority::Used);
+
+            TextureDecodeQueue queue;
+            queue.enqueue(jobs);
+
+            size_t finished = 0;
+            for (size_t i = 0; i < 1000 && finished < 99; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                finished += queue.takeFinishedCount();
+            }
+            ASSERT_EQ(99u, finished);
+
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                if (i != 50) {
+                    ASSERT_TRUE(jobs[i]->finished());
+                    ASSERT_TRUE(jobs[i]->takeResult() != nullptr);
+                }
+            }
+        }
+
+        TEST(TextureDecodeQueueTest, raisePriorityOfQueuedJob) {
+            std::promise<void> release;
+            std::shared_future<void> released = release.get_future().share();
+
+            std::mutex mutex;
+            std::vector<size_t> started;
+
+            TextureDecodeQueue::JobList jobs;
+            for (size_t i = 0; i < 100; ++i) {
+                jobs.push_back(std::make_shared<TextureDecodeJob>([i, released, &mutex, &started]() {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        started.push_back(i);
+                    }
+                    released.wait();
+                    return new Texture("texture", 16, 16);
+                }));
+            }
+
+            TextureDecodeQueue queue;
+            queue.enqueue(jobs);
+
+            // every worker blocks on the first job it takes, so the raised job must be the next one to be taken
+            jobs[99]->raisePriority(TextureDecodePriority::Used);
+            release.set_value();
+
+            size_t finished = 0;
+            for (size_t i = 0; i < 1000 && finished < 100; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                finished += queue.takeFinishedCount();
+            }
+            ASSERT_EQ(100u, finished);
+
+            const auto workerCount = std::max(ParallelUtils::threadCount(std::numeric_limits<size_t>::max()), size_t(2)) - 1;
+            const auto position = std::distance(std::begin(started), std::find(std::begin(started), std::end(started), 99u));
+            ASSERT_LE(static_cast<size_t>(position), workerCount);
+        }
+
+        TEST(TextureDecodeJobTest, raisePriority) {
+            TextureDecodeJob job([]() { return nullptr; });
+            ASSERT_EQ(TextureDecodePriority::Background, job.priority());
+
+            job.raisePriority(TextureDecodePriority::Used);
+            ASSERT_EQ(TextureDecodePriority::Used, job.priority());
+
+            job.raisePriority(TextureDecodePriority::Visible);
+            ASSERT_EQ(TextureDecodePriority::Used, job.priority());
+
+            job.run();
+            ASSERT_TRUE(job.finished());
+            ASSERT_TRUE(job.takeResult() == nullptr);
+        }
+    }
+}
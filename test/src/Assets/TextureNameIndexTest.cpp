@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "StringUtils.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureNameIndex.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class TextureNameIndexTest : public ::testing::Test {
+        protected:
+            std::vector<std::unique_ptr<Texture>> m_textures;
+
+            TextureList createTextures(const StringList& names) {
+                TextureList result;
+                for (const auto& name : names) {
+                    m_textures.push_back(std::make_unique<Texture>(name, 16, 16));
+                    result.push_back(m_textures.back().get());
+                }
+                return result;
+            }
+
+            static StringList names(const TextureList& textures) {
+                StringList result;
+                for (const auto* texture : textures) {
+                    result.push_back(texture->name());
+                }
+                return result;
+            }
+        };
+
+        TEST_F(TextureNameIndexTest, findTextures) {
+            const auto textures = createTextures({ "base/wall", "base/floor", "Gothic/Wall_Trim", "sky1", "e1u1/wallgrate" });
+            const TextureNameIndex index(textures);
+
+            ASSERT_EQ(names(textures), names(index.find("")));
+            ASSERT_EQ(StringList({ "base/wall", "Gothic/Wall_Trim", "e1u1/wallgrate" }), names(index.find("wall")));
+            ASSERT_EQ(StringList({ "base/wall", "Gothic/Wall_Trim", "e1u1/wallgrate" }), names(index.find("WALL")));
+            ASSERT_EQ(StringList({ "Gothic/Wall_Trim" }), names(index.find("l_t")));
+            ASSERT_EQ(StringList({ "base/wall", "base/floor" }), names(index.find("base/")));
+            ASSERT_EQ(StringList({ "sky1", "e1u1/wallgrate" }), names(index.find("1")));
+            ASSERT_EQ(StringList({ "base/floor" }), names(index.find("fl")));
+            ASSERT_TRUE(index.find("lava").empty());
+            ASSERT_TRUE(index.find("wallx").empty());
+        }
+
+        TEST_F(TextureNameIndexTest, emptyIndex) {
+            const TextureNameIndex index;
+            ASSERT_TRUE(index.find("").empty());
+            ASSERT_TRUE(index.find("wall").empty());
+        }
+
+        TEST_F(TextureNameIndexTest, matchesSubstringSearch) {
+            std::mt19937 random(0);
+            std::uniform_int_distribution<size_t> lengths(1, 16);
+            std::uniform_int_distribution<int> chars(0, 5);
+            const auto randomString = [&](const size_t length) {
+                String result;
+                for (size_t i = 0; i < length; ++i) {
+                    const int c = chars(random);
+                    result.push_back(c == 5 ? '/' : static_cast<char>((random() % 2 == 0 ? 'a' : 'A') + c));
+                }
+                return result;
+            };
+
+            StringList textureNames;
+            for (size_t i = 0; i < 500; ++i) {
+                textureNames.push_back(randomString(lengths(random)));
+            }
+            const auto textures = createTextures(textureNames);
+            const TextureNameIndex index(textures);
+
+            for (size_t i = 0; i < 200; ++i) {
+                const auto pattern = randomString(1 + i % 5);
+
+                StringList expected;
+                for (const auto& name : textureNames) {
+                    if (StringUtils::containsCaseInsensitive(name, pattern)) {
+                        expected.push_back(name);
+                    }
+                }
+                ASSERT_EQ(expected, names(index.find(pattern))) << pattern;
+            }
+        }
+    }
+}
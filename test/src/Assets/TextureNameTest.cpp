@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Assets/Texture.h"
+#include "Assets/TextureName.h"
+#include "Model/BrushFaceAttributes.h"
+
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        TEST(TextureNameTest, internSameSpelling) {
+            const TextureName name1("TextureNameTest/wall");
+            const TextureName name2(String("TextureNameTest/") + "wall");
+            const TextureName name3("TextureNameTest/floor");
+
+            ASSERT_EQ(name1, name2);
+            ASSERT_EQ(name1.id(), name2.id());
+            ASSERT_EQ(&name1.asString(), &name2.asString());
+            ASSERT_EQ("TextureNameTest/wall", name1.asString());
+
+            ASSERT_NE(name1, name3);
+            ASSERT_NE(name1.id(), name3.id());
+            ASSERT_LT(name1.id(), TextureName::count());
+            ASSERT_LT(name3.id(), TextureName::count());
+        }
+
+        TEST(TextureNameTest, caseInsensitiveId) {
+            const TextureName upper("TextureNameTest/SKY");
+            const TextureName mixed("TextureNameTest/Sky");
+            const TextureName lower("texturenametest/sky");
+
+            ASSERT_NE(upper, mixed);
+            ASSERT_NE(upper, lower);
+            ASSERT_EQ(lower.id(), lower.caseInsensitiveId());
+            ASSERT_EQ(lower.id(), upper.caseInsensitiveId());
+            ASSERT_EQ(lower.id(), mixed.caseInsensitiveId());
+        }
+
+        TEST(TextureNameTest, emptyName) {
+            ASSERT_EQ(TextureName(), TextureName(""));
+            ASSERT_EQ("", TextureName().asString());
+        }
+
+        TEST(TextureNameTest, internOnSeveralThreads) {
+            static const size_t NameCount = 500;
+
+            std::vector<std::vector<TextureName>> names(4);
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < names.size(); ++t) {
+                threads.emplace_back([&names, t]() {
+                    for (size_t i = 0; i < NameCount; ++i) {
+                        names[t].emplace_back("TextureNameTest/Thread" + std::to_string(i));
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            for (size_t t = 1; t < names.size(); ++t) {
+                ASSERT_EQ(names[0], names[t]);
+            }
+            for (size_t i = 0; i < NameCount; ++i) {
+                ASSERT_EQ("TextureNameTest/Thread" + std::to_string(i), names[0][i].asString());
+                ASSERT_EQ(TextureName("texturenametest/thread" + std::to_string(i)).id(), names[0][i].caseInsensitiveId());
+            }
+        }
+
+        TEST(TextureNameTest, faceAttributesShareTextureName) {
+            Texture texture("TextureNameTest/Metal", 16, 16);
+
+            Model::BrushFaceAttributes attribs("texturenametest/metal");
+            ASSERT_EQ(TextureName("texturenametest/metal"), attribs.internedTextureName());
+            ASSERT_EQ(texture.internedName().caseInsensitiveId(), attribs.internedTextureName().caseInsensitiveId());
+
+            attribs.setTexture(&texture);
+            ASSERT_EQ(texture.internedName(), attribs.internedTextureName());
+            ASSERT_EQ("TextureNameTest/Metal", attribs.textureName());
+
+            attribs.unsetTexture();
+            ASSERT_EQ(nullptr, attribs.texture());
+        }
+    }
+}
@@ -0,0 +1,273 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vecmath/vec.h>
+#include <vecmath/ray.h>
+#include "AABBTree.h"
+#include "FlatAABBTree.h"
+
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using FLAT = FlatAABBTree<double, 3, size_t>;
+using TREE = AABBTree<double, 3, size_t>;
+using BOX = FLAT::Box;
+using RAY = vm::ray<FLAT::FloatType, FLAT::Components>;
+using VEC = vm::vec<FLAT::FloatType, FLAT::Components>;
+
+template <typename L>
+static std::string printTree(const L& tree) {
+    std::stringstream str;
+    tree.print(str);
+    return str.str();
+}
+
+static std::vector<BOX> makeRandomBounds(const size_t count) {
+    std::mt19937 random(0);
+    std::uniform_real_distribution<double> positions(-1024.0, 1024.0);
+    std::uniform_real_distribution<double> sizes(1.0, 64.0);
+
+    std::vector<BOX> result;
+    for (size_t i = 0; i < count; ++i) {
+        const auto min = VEC(positions(random), positions(random), positions(random));
+        const auto max = min + VEC(sizes(random), sizes(random), sizes(random));
+        result.emplace_back(min, max);
+    }
+    return result;
+}
+
+static std::set<size_t> findIntersectors(const FLAT& tree, const RAY& ray) {
+    std::set<size_t> result;
+    tree.findIntersectors(ray, std::inserter(result, std::end(result)));
+    return result;
+}
+
+TEST(FlatAABBTreeTest, createEmptyTree) {
+    FLAT tree;
+
+    ASSERT_TRUE(tree.empty());
+    ASSERT_EQ(0u, tree.height());
+    ASSERT_TRUE(tree.findIntersectors(RAY(VEC::zero, VEC::pos_x)).empty());
+    ASSERT_TRUE(tree.findContainers(VEC::zero).empty());
+}
+
+TEST(FlatAABBTreeTest, insertAndRemoveSingleNode) {
+    const BOX bounds(VEC(0.0, 0.0, 0.0), VEC(2.0, 1.0, 1.0));
+
+    FLAT tree;
+    tree.insert(bounds, 1u);
+
+    ASSERT_FALSE(tree.empty());
+    ASSERT_EQ(1u, tree.height());
+    ASSERT_EQ(bounds, tree.bounds());
+    ASSERT_TRUE(tree.contains(bounds, 1u));
+    ASSERT_FALSE(tree.contains(bounds, 2u));
+
+    ASSERT_FALSE(tree.remove(bounds, 2u));
+    ASSERT_TRUE(tree.remove(bounds, 1u));
+    ASSERT_TRUE(tree.empty());
+}
+
+TEST(FlatAABBTreeTest, insertTwoNodes) {
+    const BOX bounds1(VEC(0.0, 0.0, 0.0), VEC(2.0, 1.0, 1.0));
+    const BOX bounds2(VEC(-1.0, -1.0, -1.0), VEC(1.0, 1.0, 1.0));
+
+    FLAT tree;
+    tree.insert(bounds1, 1u);
+    tree.insert(bounds2, 2u);
+
+    ASSERT_EQ(R"(O [ ( -1 -1 -1 ) ( 2 1 1 ) ]
+  L [ ( 0 0 0 ) ( 2 1 1 ) ]: 1
+  L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 2
+)", printTree(tree));
+
+    ASSERT_EQ(2u, tree.height());
+    ASSERT_TRUE(tree.contains(bounds1, 1u));
+    ASSERT_TRUE(tree.contains(bounds2, 2u));
+}
+
+TEST(FlatAABBTreeTest, updateNode) {
+    const BOX bounds1(VEC(0.0, 0.0, 0.0), VEC(1.0, 1.0, 1.0));
+    const BOX bounds2(VEC(4.0, 0.0, 0.0), VEC(5.0, 1.0, 1.0));
+    const BOX bounds3(VEC(8.0, 0.0, 0.0), VEC(9.0, 1.0, 1.0));
+
+    FLAT tree;
+    tree.insert(bounds1, 1u);
+    tree.insert(bounds2, 2u);
+    tree.update(bounds2, bounds3, 2u);
+
+    ASSERT_TRUE(tree.contains(bounds3, 2u));
+    ASSERT_FALSE(tree.contains(bounds2, 2u));
+    ASSERT_EQ(merge(bounds1, bounds3), tree.bounds());
+    ASSERT_THROW(tree.update(bounds2, bounds3, 3u), NodeTreeException);
+}
+
+TEST(FlatAABBTreeTest, findContainers) {
+    FLAT tree;
+    tree.insert(BOX(VEC(-2.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), 1u);
+    tree.insert(BOX(VEC(-1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0)), 2u);
+
+    ASSERT_EQ(FLAT::List({ 1u }), tree.findContainers(VEC(-1.5, 0.0, 0.0)));
+    ASSERT_EQ(FLAT::List({ 2u }), tree.findContainers(VEC(+1.5, 0.0, 0.0)));
+    ASSERT_EQ(2u, tree.findContainers(VEC(0.0, 0.0, 0.0)).size());
+    ASSERT_TRUE(tree.findContainers(VEC(3.0, 0.0, 0.0)).empty());
+}
+
+TEST(FlatAABBTreeTest, matchesAABBTree) {
+    const auto bounds = makeRandomBounds(500);
+
+    TREE tree;
+    FLAT flat;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        tree.insert(bounds[i], i);
+        flat.insert(bounds[i], i);
+    }
+    ASSERT_EQ(printTree(tree), printTree(flat));
+    ASSERT_EQ(tree.height(), flat.height());
+
+    // removing nodes must yield the same tree, too, and inserting them again reuses the freed slots
+    for (size_t i = 0; i < bounds.size(); i += 3) {
+        ASSERT_TRUE(tree.remove(bounds[i], i));
+        ASSERT_TRUE(flat.remove(bounds[i], i));
+    }
+    ASSERT_EQ(printTree(tree), printTree(flat));
+
+    for (size_t i = 0; i < bounds.size(); i += 3) {
+        tree.insert(bounds[i], i);
+        flat.insert(bounds[i], i);
+    }
+    ASSERT_EQ(printTree(tree), printTree(flat));
+
+    std::vector<size_t> objects;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        objects.push_back(i);
+    }
+    tree.clearAndBuild(objects, [&](const size_t i) { return bounds[i]; });
+    flat.clearAndBuild(objects, [&](const size_t i) { return bounds[i]; });
+    ASSERT_EQ(printTree(tree), printTree(flat));
+}
+
+TEST(FlatAABBTreeTest, findIntersectors) {
+    const auto bounds = makeRandomBounds(1000);
+
+    std::vector<size_t> objects;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        objects.push_back(i);
+    }
+
+    FLAT tree;
+    tree.clearAndBuild(objects, [&](const size_t i) { return bounds[i]; });
+
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        ASSERT_TRUE(tree.contains(bounds[i], i));
+    }
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> coords(-1.0, 1.0);
+    for (size_t i = 0; i < 100; ++i) {
+        const auto ray = RAY(VEC(coords(random), coords(random), coords(random)) * 1024.0, normalize(VEC(coords(random), coords(random), coords(random))));
+
+        std::set<size_t> expected;
+        for (size_t j = 0; j < bounds.size(); ++j) {
+            if (bounds[j].contains(ray.origin) || !vm::isnan(intersect(ray, bounds[j]))) {
+                expected.insert(j);
+            }
+        }
+        ASSERT_EQ(expected, findIntersectors(tree, ray));
+    }
+}
+
+TEST(FlatAABBTreeTest, findIntersectorsOfBox) {
+    const auto bounds = makeRandomBounds(1000);
+
+    FLAT tree;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        tree.insert(bounds[i], i);
+    }
+
+    const auto queries = makeRandomBounds(100);
+    for (const auto& query : queries) {
+        std::set<size_t> expected;
+        for (size_t j = 0; j < bounds.size(); ++j) {
+            if (bounds[j].intersects(query)) {
+                expected.insert(j);
+            }
+        }
+
+        std::set<size_t> actual;
+        tree.findIntersectors(query, std::inserter(actual, std::end(actual)));
+        ASSERT_EQ(expected, actual);
+    }
+
+    // boxes that only touch each other intersect, too
+    FLAT small;
+    small.insert(BOX(VEC(-2.0, -1.0, -1.0), VEC(-1.0, +1.0, +1.0)), 1u);
+    small.insert(BOX(VEC(+1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0)), 2u);
+    ASSERT_EQ(FLAT::List({ 1u }), small.findIntersectors(BOX(VEC(-1.0, 0.0, 0.0), VEC(0.0, 1.0, 1.0))));
+    ASSERT_EQ(2u, small.findIntersectors(BOX(VEC(-1.0, 0.0, 0.0), VEC(1.0, 1.0, 1.0))).size());
+    ASSERT_TRUE(small.findIntersectors(BOX(VEC(-0.5, 0.0, 0.0), VEC(0.5, 1.0, 1.0))).empty());
+}
+
+TEST(FlatAABBTreeTest, findIntersectorsNearestFirst) {
+    const auto bounds = makeRandomBounds(1000);
+
+    std::vector<size_t> objects;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        objects.push_back(i);
+    }
+
+    FLAT tree;
+    tree.clearAndBuild(objects, [&](const size_t i) { return bounds[i]; });
+
+    std::mt19937 random(2);
+    std::uniform_real_distribution<double> coords(-1.0, 1.0);
+    for (size_t i = 0; i < 100; ++i) {
+        const auto ray = RAY(VEC(coords(random), coords(random), coords(random)) * 1024.0, normalize(VEC(coords(random), coords(random), coords(random))));
+
+        std::set<size_t> visited;
+        auto lastDistance = 0.0;
+        tree.findIntersectorsNearestFirst(ray, [&](const size_t object, const double distance) {
+            EXPECT_LE(lastDistance, distance);
+            EXPECT_DOUBLE_EQ(bounds[object].contains(ray.origin) ? 0.0 : intersect(ray, bounds[object]), distance);
+            lastDistance = distance;
+            visited.insert(object);
+            return true;
+        });
+        ASSERT_EQ(findIntersectors(tree, ray), visited);
+    }
+}
+
+TEST(FlatAABBTreeTest, findIntersectorsNearestFirstStops) {
+    FLAT tree;
+    for (size_t i = 0; i < 10; ++i) {
+        const auto x = static_cast<double>(i) * 2.0;
+        tree.insert(BOX(VEC(x, -1.0, -1.0), VEC(x + 1.0, 1.0, 1.0)), i);
+    }
+
+    std::vector<size_t> visited;
+    tree.findIntersectorsNearestFirst(RAY(VEC(-1.0, 0.0, 0.0), VEC::pos_x), [&](const size_t object, const double distance) {
+        visited.push_back(object);
+        return distance < 4.0;
+    });
+    ASSERT_EQ(std::vector<size_t>({ 0u, 1u, 2u }), visited);
+}
@@ -0,0 +1,205 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Assets/Palette.h"
+#include "Assets/Texture.h"
+#include "IO/AssetCache.h"
+#include "IO/CachingTextureReader.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/DiskIO.h"
+#include "IO/IdMipTextureReader.h"
+#include "IO/MappedFile.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/WadFileSystem.h"
+
+#include <cstring>
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST(AssetCacheTest, disabledWithoutDirectory) {
+            const AssetCache cache;
+            ASSERT_FALSE(cache.enabled());
+            ASSERT_TRUE(cache.read("textures", 1u) == nullptr);
+            cache.write("textures", 1u, "data");
+            ASSERT_TRUE(cache.read("textures", 1u) == nullptr);
+        }
+
+        TEST(AssetCacheTest, writeAndRead) {
+            TestEnvironment env("AssetCacheTest");
+            const AssetCache cache(env.dir() + Path("cache"));
+            ASSERT_TRUE(cache.enabled());
+
+            ASSERT_TRUE(cache.read("textures", 1u) == nullptr);
+            cache.write("textures", 1u, "some data");
+
+            const auto entry = cache.read("textures", 1u);
+            ASSERT_TRUE(entry != nullptr);
+            ASSERT_EQ(String("some data"), String(entry->begin(), entry->end()));
+
+            ASSERT_TRUE(cache.read("textures", 2u) == nullptr);
+            ASSERT_TRUE(cache.read("models", 1u) == nullptr);
+        }
+
+        TEST(AssetCacheTest, keyDependsOnContentsAndSalt) {
+            const Path wadPath = Disk::getCurrentWorkingDir() + Path("data/IO/Wad/cr8_czg.wad");
+            WadFileSystem wadFS(wadPath);
+
+            const auto file1 = wadFS.openFile(Path("cr8_czg_1.D"));
+            const auto file2 = wadFS.openFile(Path("cr8_czg_2.D"));
+
+            ASSERT_EQ(AssetCache::key(*file1, "idmip"), AssetCache::key(*file1, "idmip"));
+            ASSERT_NE(AssetCache::key(*file1, "idmip"), AssetCache::key(*file2, "idmip"));
+            ASSERT_NE(AssetCache::key(*file1, "idmip"), AssetCache::key(*file1, "wal"));
+        }
+
+        TEST(AssetCacheTest, keyDependsOnFileOnDisk) {
+            TestEnvironment env("AssetCacheTest");
+            env.createFile(Path("texture.tga"), "some data");
+            env.setFileModificationTime(Path("texture.tga"), 1000000000);
+
+            const auto key = AssetCache::key(*Disk::openFile(env.dir() + Path("texture.tga")), "image");
+            ASSERT_EQ(key, AssetCache::key(*Disk::openFile(env.dir() + Path("texture.tga")), "image"));
+
+            // only the modification time changes, the size and the contents stay the same
+            env.setFileModificationTime(Path("texture.tga"), 1000000060);
+            ASSERT_NE(key, AssetCache::key(*Disk::openFile(env.dir() + Path("texture.tga")), "image"));
+        }
+
+        TEST(AssetCacheTest, keyDependsOnContentsOfFilesNotOnDisk) {
+            const String data1 = "some data";
+            const String data2 = "more data";
+            const MappedFileBufferView file1(Path("textures/texture.tga"), data1.data(), data1.size());
+            const MappedFileBufferView file2(Path("textures/texture.tga"), data2.data(), data2.size());
+
+            ASSERT_NE(AssetCache::key(file1, "image"), AssetCache::key(file2, "image"));
+        }
+
+        TEST(AssetCacheTest, prune) {
+            TestEnvironment env("AssetCacheTest");
+            const AssetCache cache(env.dir() + Path("cache"), 10u);
+
+            cache.write("textures", 1u, "123456");
+            cache.write("textures", 2u, "123456");
+            cache.write("models", 3u, "123456");
+
+            cache.prune();
+
+            size_t count = 0;
+            for (const auto key : { 1u, 2u }) {
+                if (cache.read("textures", key) != nullptr) {
+                    ++count;
+                }
+            }
+            if (cache.read("models", 3u) != nullptr) {
+                ++count;
+            }
+            ASSERT_EQ(1u, count);
+        }
+
+        TEST(AssetCacheTest, readCachedTexture) {
+            TestEnvironment env("AssetCacheTest");
+            const AssetCache cache(env.dir() + Path("cache"));
+
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+            const auto palette = Assets::Palette::loadFile(fs, Path("data/palette.lmp"));
+
+            TextureReader::TextureNameStrategy nameStrategy;
+            const IdMipTextureReader reader(nameStrategy, palette);
+            const CachingTextureReader cachingReader(std::make_unique<IdMipTextureReader>(nameStrategy, palette), cache, "idmip");
+
+            const Path wadPath = Disk::getCurrentWorkingDir() + Path("data/IO/Wad/cr8_czg.wad");
+            WadFileSystem wadFS(wadPath);
+            const auto file = wadFS.openFile(Path("cr8_czg_3.D"));
+
+            std::unique_ptr<Assets::Texture> expected(reader.readTexture(file));
+            ASSERT_TRUE(cache.read("textures", AssetCache::key(*file, "idmip")) == nullptr);
+
+            // the first read decodes the texture and stores it in the cache, the second one reads it from the cache
+            for (size_t i = 0; i < 2; ++i) {
+                std::unique_ptr<Assets::Texture> texture(cachingReader.readTexture(file));
+                ASSERT_TRUE(cache.read("textures", AssetCache::key(*file, "idmip")) != nullptr);
+
+                ASSERT_EQ(expected->name(), texture->name());
+                ASSERT_EQ(expected->width(), texture->width());
+                ASSERT_EQ(expected->height(), texture->height());
+                ASSERT_EQ(expected->format(), texture->format());
+                ASSERT_EQ(expected->type(), texture->type());
+                ASSERT_EQ(expected->averageColor(), texture->averageColor());
+
+                const auto& expectedBuffers = expected->buffersIfUnprepared();
+                const auto& buffers = texture->buffersIfUnprepared();
+                ASSERT_EQ(expectedBuffers.size(), buffers.size());
+                for (size_t j = 0; j < buffers.size(); ++j) {
+                    ASSERT_EQ(expectedBuffers[j].size(), buffers[j].size());
+                    ASSERT_EQ(0, std::memcmp(expectedBuffers[j].ptr(), buffers[j].ptr(), buffers[j].size()));
+                }
+            }
+        }
+
+        TEST(AssetCacheTest, rejectInvalidTextureEntry) {
+            TestEnvironment env("AssetCacheTest");
+            const AssetCache cache(env.dir() + Path("cache"));
+
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+            const auto palette = Assets::Palette::loadFile(fs, Path("data/palette.lmp"));
+
+            TextureReader::TextureNameStrategy nameStrategy;
+            const IdMipTextureReader reader(nameStrategy, palette);
+            const CachingTextureReader cachingReader(std::make_unique<IdMipTextureReader>(nameStrategy, palette), cache, "idmip");
+
+            const Path wadPath = Disk::getCurrentWorkingDir() + Path("data/IO/Wad/cr8_czg.wad");
+            WadFileSystem wadFS(wadPath);
+            const auto file = wadFS.openFile(Path("cr8_czg_3.D"));
+            const auto key = AssetCache::key(*file, "idmip");
+
+            std::unique_ptr<Assets::Texture> expected(reader.readTexture(file));
+            const auto data = CachingTextureReader::serializeTexture(*expected);
+
+            // the name length and the size of the first mip level follow the header
+            const size_t nameLengthOffset = 40;
+            const size_t mipSizeOffset = 48;
+
+            auto invalidNameLength = data;
+            const uint32_t hugeNameLength = 0xFFFFFFFF;
+            std::memcpy(&invalidNameLength[nameLengthOffset], &hugeNameLength, sizeof(hugeNameLength));
+
+            auto invalidMipSize = data;
+            const uint64_t hugeMipSize = 0xFFFFFFFFFFFF;
+            std::memcpy(&invalidMipSize[mipSizeOffset], &hugeMipSize, sizeof(hugeMipSize));
+
+            const auto truncated = data.substr(0, data.size() - 1);
+
+            for (const auto& invalid : { invalidNameLength, invalidMipSize, truncated }) {
+                cache.write("textures", key, invalid);
+                ASSERT_TRUE(CachingTextureReader::deserializeTexture(*cache.read("textures", key)) == nullptr);
+
+                // an invalid entry is a cache miss, so the texture is decoded and stored again
+                std::unique_ptr<Assets::Texture> texture(cachingReader.readTexture(file));
+                ASSERT_EQ(expected->name(), texture->name());
+
+                const auto entry = cache.read("textures", key);
+                ASSERT_EQ(data, String(entry->begin(), entry->end()));
+            }
+        }
+    }
+}
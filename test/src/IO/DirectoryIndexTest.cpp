@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/DirectoryIndex.h"
+#include "IO/DiskIO.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+
+#include <wx/filefn.h>
+
+namespace TrenchBroom {
+    namespace IO {
+        class DirectoryIndexTestEnvironment : public TestEnvironment {
+        public:
+            explicit DirectoryIndexTestEnvironment(const String& dir) :
+            TestEnvironment(dir) {
+                createTestEnvironment();
+            }
+        private:
+            void doCreateTestEnvironment() override {
+                createDirectory(Path("Textures"));
+                createDirectory(Path("Textures/Base"));
+                createFile(Path("Textures/Base/Wall.tga"), "");
+                createFile(Path("Textures/Base/floor.tga"), "");
+                if (Disk::isCaseSensitive()) {
+                    // would overwrite floor.tga otherwise
+                    createFile(Path("Textures/Base/FLOOR.tga"), "");
+                }
+            }
+        };
+
+        TEST(DirectoryIndexTest, findEntry) {
+            DirectoryIndexTestEnvironment env("DirectoryIndexTest");
+            DirectoryIndex index;
+
+            const auto base = env.dir() + Path("Textures/Base");
+            ASSERT_EQ(String("Textures"), index.findEntry(env.dir(), "textures"));
+            ASSERT_EQ(String("Wall.tga"), index.findEntry(base, "wall.TGA"));
+            ASSERT_EQ(String("Wall.tga"), index.findEntry(base, "Wall.tga"));
+            ASSERT_EQ(String(""), index.findEntry(base, "ceiling.tga"));
+            ASSERT_EQ(String(""), index.findEntry(env.dir() + Path("Models"), "ceiling.tga"));
+
+            ASSERT_EQ(String("floor.tga"), index.findEntry(base, "floor.tga"));
+            if (Disk::isCaseSensitive()) {
+                // exact matches are preferred if several entries only differ in case
+                ASSERT_EQ(String("FLOOR.tga"), index.findEntry(base, "FLOOR.tga"));
+            } else {
+                ASSERT_EQ(String("floor.tga"), index.findEntry(base, "FLOOR.tga"));
+            }
+        }
+
+        TEST(DirectoryIndexTest, findEntryListsDirectoryOnce) {
+            DirectoryIndexTestEnvironment env("DirectoryIndexTest");
+            DirectoryIndex index;
+
+            const auto base = env.dir() + Path("Textures/Base");
+            ASSERT_EQ(String("Wall.tga"), index.findEntry(base, "WALL.TGA"));
+            ASSERT_EQ(1u, index.listingCount());
+            ASSERT_EQ(1u, index.directoryCount());
+
+            for (size_t i = 0; i < 10; ++i) {
+                ASSERT_EQ(String("Wall.tga"), index.findEntry(base, "wall.tga"));
+                ASSERT_EQ(String("floor.tga"), index.findEntry(base, "floor.tga"));
+            }
+            ASSERT_EQ(1u, index.listingCount());
+
+            index.invalidate(base);
+            ASSERT_EQ(0u, index.directoryCount());
+            ASSERT_EQ(String("Wall.tga"), index.findEntry(base, "WALL.TGA"));
+            ASSERT_EQ(2u, index.listingCount());
+        }
+
+        TEST(DirectoryIndexTest, findAddedEntry) {
+            DirectoryIndexTestEnvironment env("DirectoryIndexTest");
+            DirectoryIndex index;
+
+            const auto base = env.dir() + Path("Textures/Base");
+            ASSERT_EQ(String(""), index.findEntry(base, "ceiling.tga"));
+
+            // created without invalidating the index
+            env.createFile(Path("Textures/Base/Ceiling.tga"), "");
+            ASSERT_EQ(String("Ceiling.tga"), index.findEntry(base, "ceiling.tga"));
+        }
+
+        TEST(DirectoryIndexTest, fixPathAfterChanges) {
+            DirectoryIndexTestEnvironment env("DirectoryIndexTest");
+
+            ASSERT_TRUE(::wxFileExists(Disk::fixPath(env.dir() + Path("textures/base/WALL.TGA")).asString()));
+
+            Disk::createFile(env.dir() + Path("Textures/Base/Sky.tga"), "");
+            ASSERT_TRUE(::wxFileExists(Disk::fixPath(env.dir() + Path("TEXTURES/BASE/sky.tga")).asString()));
+
+            Disk::moveFile(env.dir() + Path("Textures/Base/Sky.tga"), env.dir() + Path("Textures/Base/Clouds.tga"), false);
+            ASSERT_TRUE(::wxFileExists(Disk::fixPath(env.dir() + Path("textures/base/CLOUDS.tga")).asString()));
+            ASSERT_FALSE(Disk::fileExists(env.dir() + Path("textures/base/sky.tga")));
+
+            Disk::deleteFile(env.dir() + Path("Textures/Base/Clouds.tga"));
+            ASSERT_FALSE(Disk::fileExists(env.dir() + Path("textures/base/CLOUDS.tga")));
+        }
+    }
+}
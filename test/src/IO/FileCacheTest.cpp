@@ -0,0 +1,84 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "IO/FileCache.h"
+#include "IO/MappedFile.h"
+#include "IO/Path.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        static MappedFile::Ptr makeFile(const size_t size) {
+            return std::make_shared<MappedFileBuffer>(Path("file"), std::make_unique<char[]>(size), size);
+        }
+
+        TEST(FileCacheTest, getAndPut) {
+            FileCache cache(100);
+            const int keys[2] = { 0, 0 };
+
+            ASSERT_TRUE(cache.get(&keys[0]) == nullptr);
+
+            const auto file = makeFile(10);
+            cache.put(&keys[0], file);
+            ASSERT_TRUE(cache.get(&keys[0]) == file);
+            ASSERT_TRUE(cache.get(&keys[1]) == nullptr);
+            ASSERT_EQ(10u, cache.size());
+
+            const auto other = makeFile(20);
+            cache.put(&keys[0], other);
+            ASSERT_TRUE(cache.get(&keys[0]) == other);
+            ASSERT_EQ(20u, cache.size());
+            ASSERT_EQ(1u, cache.count());
+
+            cache.remove(&keys[0]);
+            ASSERT_TRUE(cache.get(&keys[0]) == nullptr);
+            ASSERT_EQ(0u, cache.size());
+        }
+
+        TEST(FileCacheTest, evictLeastRecentlyUsed) {
+            FileCache cache(100);
+            const int keys[4] = { 0, 0, 0, 0 };
+
+            cache.put(&keys[0], makeFile(40));
+            cache.put(&keys[1], makeFile(40));
+
+            // makes keys[1] the least recently used file
+            ASSERT_TRUE(cache.get(&keys[0]) != nullptr);
+
+            cache.put(&keys[2], makeFile(40));
+            ASSERT_TRUE(cache.get(&keys[0]) != nullptr);
+            ASSERT_TRUE(cache.get(&keys[1]) == nullptr);
+            ASSERT_TRUE(cache.get(&keys[2]) != nullptr);
+            ASSERT_EQ(80u, cache.size());
+
+            // too large to be cached
+            cache.put(&keys[3], makeFile(101));
+            ASSERT_TRUE(cache.get(&keys[3]) == nullptr);
+            ASSERT_EQ(80u, cache.size());
+
+            cache.setCapacity(50);
+            ASSERT_TRUE(cache.get(&keys[0]) == nullptr);
+            ASSERT_TRUE(cache.get(&keys[2]) != nullptr);
+            ASSERT_EQ(40u, cache.size());
+        }
+    }
+}
@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/MapSaveQueue.h"
+#include "IO/MapSnapshot.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "Model/BrushBuilder.h"
+#include "Model/Brush.h"
+#include "Model/Layer.h"
+#include "Model/World.h"
+
+#include <vecmath/bbox.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        static String readFile(const Path& path) {
+            std::ifstream stream(path.asString(), std::ios::in | std::ios::binary);
+            return String(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+
+        TEST(MapSnapshotTest, snapshotIsUnaffectedByLaterChanges) {
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::World map(Model::MapFormat::Standard, nullptr, worldBounds);
+            map.addOrUpdateAttribute("classname", "worldspawn");
+
+            Model::BrushBuilder builder(&map, worldBounds);
+            Model::Brush* brush = builder.createCube(64.0, "none");
+            map.defaultLayer()->addChild(brush);
+
+            const MapSnapshot snapshot(map, "Quake");
+            ASSERT_EQ(6u, snapshot.faceCount());
+            ASSERT_EQ(5u, brush->lineNumber());
+
+            map.addOrUpdateAttribute("message", "changed");
+            map.defaultLayer()->removeChild(brush);
+            delete brush;
+
+            TestEnvironment env("MapSnapshotTest");
+            const Path path = env.dir() + Path("test.map");
+            snapshot.save(path);
+
+            ASSERT_EQ(String("// Game: Quake\n"
+                             "// Format: Standard\n"
+                             "// entity 0\n"
+                             "{\n"
+                             "\"classname\" \"worldspawn\"\n"
+                             "// brush 0\n"
+                             "{\n"
+                             "( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1\n"
+                             "( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1\n"
+                             "( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1\n"
+                             "( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1\n"
+                             "( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1\n"
+                             "( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1\n"
+                             "}\n"
+                             "}\n"), readFile(path));
+            ASSERT_FALSE(Disk::fileExists(path.addExtension("tmp")));
+        }
+
+        TEST(MapSnapshotTest, saveReplacesExistingFile) {
+            TestEnvironment env("MapSnapshotTest");
+            env.createFile(Path("test.map"), "old contents");
+
+            const MapSnapshot snapshot(Model::MapFormat::Standard, "Quake");
+            const Path path = env.dir() + Path("test.map");
+            snapshot.save(path);
+
+            ASSERT_EQ(String("// Game: Quake\n// Format: Standard\n"), readFile(path));
+        }
+
+        TEST(MapSnapshotTest, saveToMissingDirectoryThrows) {
+            TestEnvironment env("MapSnapshotTest");
+
+            const MapSnapshot snapshot(Model::MapFormat::Standard, "Quake");
+            ASSERT_THROW(snapshot.save(env.dir() + Path("missing/test.map")), FileSystemException);
+        }
+
+        TEST(MapSaveQueueTest, reportResultsInOrder) {
+            TestEnvironment env("MapSaveQueueTest");
+            const Path path1 = env.dir() + Path("test1.map");
+            const Path path2 = env.dir() + Path("missing/test2.map");
+            const Path path3 = env.dir() + Path("test3.map");
+
+            MapSaveQueue queue;
+            ASSERT_FALSE(queue.hasPendingSaves());
+
+            queue.enqueue(std::make_unique<MapSnapshot>(Model::MapFormat::Standard, "Quake"), path1);
+            queue.enqueue(std::make_unique<MapSnapshot>(Model::MapFormat::Valve, "Quake"), path2);
+            queue.enqueue(std::make_unique<MapSnapshot>(Model::MapFormat::Valve, "Quake"), path3);
+            queue.waitForPendingSaves();
+            ASSERT_FALSE(queue.hasPendingSaves());
+
+            const auto results = queue.takeResults();
+            ASSERT_EQ(3u, results.size());
+            ASSERT_EQ(path1, results[0].path);
+            ASSERT_TRUE(results[0].success);
+            ASSERT_EQ(path2, results[1].path);
+            ASSERT_FALSE(results[1].success);
+            ASSERT_FALSE(results[1].error.empty());
+            ASSERT_EQ(path3, results[2].path);
+            ASSERT_TRUE(results[2].success);
+
+            ASSERT_TRUE(queue.takeResults().empty());
+            ASSERT_EQ(String("// Game: Quake\n// Format: Valve\n"), readFile(path3));
+        }
+    }
+}
@@ -74,6 +74,13 @@ namespace TrenchBroom {
 
             const auto* skin2 = surface2->skin("bfg/LDAbfg_z");
             ASSERT_NE(nullptr, skin2);
+
+            ASSERT_FALSE(model->frameLoaded(0));
+            ASSERT_TRUE(model->loadFrame(0));
+            ASSERT_TRUE(model->frameLoaded(0));
+            ASSERT_EQ(surface1->meshSizeInBytes(0) + surface2->meshSizeInBytes(0), model->frameSizeInBytes(0));
+            ASSERT_LT(0u, surface1->meshSizeInBytes(0));
+            ASSERT_LT(0u, surface2->meshSizeInBytes(0));
         }
     }
 }
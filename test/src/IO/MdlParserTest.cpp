@@ -51,6 +51,20 @@ namespace TrenchBroom {
             EXPECT_EQ(3u, surface.skinCount());
             EXPECT_EQ(1u, surface.frameCount());
 
+            // the frame meshes are only built on demand
+            EXPECT_TRUE(model->hasFrameLoader());
+            EXPECT_FALSE(model->frameLoaded(0));
+            EXPECT_EQ(0u, model->frameSizeInBytes(0));
+
+            EXPECT_TRUE(model->loadFrame(0));
+            EXPECT_TRUE(model->frameLoaded(0));
+            EXPECT_LT(0u, model->frameSizeInBytes(0));
+            EXPECT_FALSE(model->loadFrame(0));
+
+            model->unloadFrame(0);
+            EXPECT_FALSE(model->frameLoaded(0));
+            EXPECT_EQ(0u, model->frameSizeInBytes(0));
+
             delete model;
         }
 
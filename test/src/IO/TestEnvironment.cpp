@@ -21,9 +21,11 @@
 
 #include "Macros.h"
 
+#include <wx/datetime.h>
 #include <wx/dir.h>
 #include <wx/file.h>
 #include <wx/filefn.h>
+#include <wx/filename.h>
 
 namespace TrenchBroom {
     namespace IO {
@@ -56,6 +58,11 @@ namespace TrenchBroom {
             assertResult(file.Write(wxString(contents)));
         }
 
+        void TestEnvironment::setFileModificationTime(const Path& path, const std::time_t modificationTime) {
+            const wxDateTime time(modificationTime);
+            assertResult(wxFileName((m_dir + path).asString()).SetTimes(nullptr, &time, nullptr));
+        }
+
         bool TestEnvironment::deleteDirectory(const Path& path) {
             if (!::wxDirExists(path.asString())) {
                 return true;
@@ -23,6 +23,8 @@
 #include "StringUtils.h"
 #include "IO/Path.h"
 
+#include <ctime>
+
 namespace TrenchBroom {
     namespace IO {
         class TestEnvironment {
@@ -37,6 +39,7 @@ namespace TrenchBroom {
             void createTestEnvironment();
             void createDirectory(const Path& path);
             void createFile(const Path& path, const String& contents);
+            void setFileModificationTime(const Path& path, std::time_t modificationTime);
 
             bool deleteDirectory(const Path& path);
             bool deleteTestEnvironment();
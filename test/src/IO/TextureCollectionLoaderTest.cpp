@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Logger.h"
+#include "Assets/Palette.h"
+#include "Assets/Texture.h"
+#include "Assets/TextureCollection.h"
+#include "Assets/TextureDecodeQueue.h"
+#include "IO/DiskFileSystem.h"
+#include "IO/IdMipTextureReader.h"
+#include "IO/Path.h"
+#include "IO/TextureCollectionLoader.h"
+
+#include <memory>
+
+namespace TrenchBroom {
+    namespace IO {
+        TEST(TextureCollectionLoaderTest, loadTextureCollectionDefersDecoding) {
+            DiskFileSystem fs(IO::Disk::getCurrentWorkingDir());
+            const Assets::Palette palette = Assets::Palette::loadFile(fs, Path("data/palette.lmp"));
+
+            TextureReader::TextureNameStrategy nameStrategy;
+            const auto textureReader = std::make_shared<IdMipTextureReader>(nameStrategy, palette);
+
+            NullLogger logger;
+            FileTextureCollectionLoader loader(logger, { IO::Disk::getCurrentWorkingDir() });
+            const auto collection = loader.loadTextureCollection(Path("data/IO/Wad/cr8_czg.wad"), { "D" }, textureReader);
+            ASSERT_EQ(21u, collection->textureCount());
+
+            auto* texture = collection->textureByName("cr8_czg_3");
+            ASSERT_TRUE(texture != nullptr);
+            ASSERT_EQ(64u, texture->width());
+            ASSERT_EQ(128u, texture->height());
+            ASSERT_TRUE(texture->buffersIfUnprepared().empty());
+            ASSERT_TRUE(texture->decodePending());
+
+            auto job = texture->decodeJob();
+            job->run();
+            ASSERT_TRUE(texture->decodeFinished());
+
+            const auto decoded = job->takeResult();
+            ASSERT_TRUE(decoded != nullptr);
+            ASSERT_EQ(texture->name(), decoded->name());
+            ASSERT_EQ(texture->width(), decoded->width());
+            ASSERT_EQ(texture->height(), decoded->height());
+            ASSERT_EQ(4u, decoded->buffersIfUnprepared().size());
+        }
+    }
+}
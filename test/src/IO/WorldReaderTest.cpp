@@ -929,6 +929,166 @@ common/caulk
             ASSERT_STREQ("vm::line1\\nvm::line2", world->attribute("message").c_str());
         }
 
+        TEST(WorldReaderTest, parseManyBrushesInFileOrder) {
+            // enough brushes to have their geometry built on several threads
+            const size_t brushCount = 1000;
+            const size_t invalidBrushIndex = 500;
+
+            StringStream str;
+            str << "{\n"
+                << "\"classname\" \"worldspawn\"\n";
+            for (size_t i = 0; i < brushCount; ++i) {
+                const int x = static_cast<int>(i) * 64;
+                str << "{\n";
+                if (i == invalidBrushIndex) {
+                    str << "( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) none 0 0 0 1 1\n";
+                } else {
+                    const auto point = [x](const int px, const int py, const int pz) {
+                        StringStream p;
+                        p << "( " << x + px << " " << py << " " << pz << " ) ";
+                        return p.str();
+                    };
+                    str << point( 0,  0, -16) << point( 0,  0,   0) << point(64,  0, -16) << "none 0 0 0 1 1\n"
+                        << point( 0,  0, -16) << point( 0, 64, -16) << point( 0,  0,   0) << "none 0 0 0 1 1\n"
+                        << point( 0,  0, -16) << point(64,  0, -16) << point( 0, 64, -16) << "none 0 0 0 1 1\n"
+                        << point(64, 64,   0) << point( 0, 64,   0) << point(64, 64, -16) << "none 0 0 0 1 1\n"
+                        << point(64, 64,   0) << point(64, 64, -16) << point(64,  0,   0) << "none 0 0 0 1 1\n"
+                        << point(64, 64,   0) << point(64,  0,   0) << point( 0, 64,   0) << "none 0 0 0 1 1\n";
+                }
+                str << "}\n";
+            }
+            str << "}\n"
+                << "{\n"
+                << "\"classname\" \"info_player_deathmatch\"\n"
+                << "}\n";
+
+            const String data = str.str();
+            vm::bbox3 worldBounds(1 << 17);
+
+            IO::TestParserStatus status;
+            WorldReader reader(data, nullptr);
+
+            auto world = reader.read(Model::MapFormat::Standard, worldBounds, status);
+            ASSERT_TRUE(world != nullptr);
+
+            // one error for the degenerate face and one for the resulting empty brush
+            ASSERT_EQ(2u, status.countStatus(Logger::LogLevel_Error));
+
+            const Model::Node* defaultLayer = world->children().front();
+            ASSERT_EQ(brushCount, defaultLayer->childCount());
+
+            // the brushes are added in file order, followed by the entity
+            const Model::NodeList& children = defaultLayer->children();
+            size_t lastLine = 0;
+            for (size_t i = 0; i < brushCount - 1; ++i) {
+                const Model::Brush* brush = dynamic_cast<const Model::Brush*>(children[i]);
+                ASSERT_TRUE(brush != nullptr);
+                ASSERT_LT(lastLine, brush->lineNumber());
+
+                const size_t index = i < invalidBrushIndex ? i : i + 1;
+                ASSERT_DOUBLE_EQ(static_cast<double>(index * 64), brush->bounds().min.x());
+                lastLine = brush->lineNumber();
+            }
+            ASSERT_TRUE(dynamic_cast<const Model::Entity*>(children.back()) != nullptr);
+        }
+
+        TEST(WorldReaderTest, parseLargeMapInChunks) {
+            // large enough to be split into several chunks, including the worldspawn
+            const size_t worldBrushCount = 4000;
+            const size_t entityCount = 3000;
+            const size_t duplicateAttributeIndex = 2500;
+
+            std::vector<size_t> brushLines;
+            std::vector<size_t> entityLines;
+            size_t line = 1;
+
+            const auto brush = [&](StringStream& str, const int x, const String& textureName) {
+                const auto point = [x](const int px, const int py, const int pz) {
+                    StringStream p;
+                    p << "( " << x + px << " " << py << " " << pz << " ) ";
+                    return p.str();
+                };
+                brushLines.push_back(line);
+                str << "{\n"
+                    << point( 0,  0, -16) << point( 0,  0,   0) << point(64,  0, -16) << textureName << " 0 0 0 1 1\n"
+                    << point( 0,  0, -16) << point( 0, 64, -16) << point( 0,  0,   0) << textureName << " 0 0 0 1 1\n"
+                    << point( 0,  0, -16) << point(64,  0, -16) << point( 0, 64, -16) << textureName << " 0 0 0 1 1\n"
+                    << point(64, 64,   0) << point( 0, 64,   0) << point(64, 64, -16) << textureName << " 0 0 0 1 1\n"
+                    << point(64, 64,   0) << point(64, 64, -16) << point(64,  0,   0) << textureName << " 0 0 0 1 1\n"
+                    << point(64, 64,   0) << point(64,  0,   0) << point( 0, 64,   0) << textureName << " 0 0 0 1 1\n"
+                    << "}\n";
+                line += 8;
+            };
+
+            StringStream str;
+            str << "// Game: Quake\n"
+                << "{\n"
+                << "\"classname\" \"worldspawn\"\n"
+                << "\"message\" \"{ braces } in \\\"quotes\\\"\"\n";
+            entityLines.push_back(2);
+            line = 5;
+            for (size_t i = 0; i < worldBrushCount; ++i) {
+                brush(str, static_cast<int>(i) * 64, i % 2 == 0 ? "{grate" : "none");
+            }
+            str << "}\n";
+            ++line;
+
+            for (size_t i = 0; i < entityCount; ++i) {
+                entityLines.push_back(line);
+                str << "{\n"
+                    << "\"classname\" \"func_wall\"\n"
+                    << "\"targetname\" \"wall" << i << "\"\n";
+                line += 3;
+                if (i == duplicateAttributeIndex) {
+                    str << "\"targetname\" \"duplicate\"\n";
+                    ++line;
+                }
+                brush(str, static_cast<int>(i) * 64, "none");
+                str << "}\n";
+                ++line;
+            }
+
+            const String data = str.str();
+            ASSERT_LT(1024u * 1024u, data.size());
+
+            vm::bbox3 worldBounds(1 << 20);
+
+            IO::TestParserStatus status;
+            WorldReader reader(data, nullptr);
+            // parse in chunks even on a single hardware thread
+            reader.setThreadCount(2);
+
+            auto world = reader.read(Model::MapFormat::Standard, worldBounds, status);
+            ASSERT_TRUE(world != nullptr);
+            ASSERT_LT(1u, reader.parsedChunkCount());
+            ASSERT_EQ(0u, status.countStatus(Logger::LogLevel_Error));
+            ASSERT_EQ(1u, status.countStatus(Logger::LogLevel_Debug));
+
+            ASSERT_EQ("{ braces } in \\\"quotes\\\"", world->attribute("message"));
+            ASSERT_EQ(2u, world->lineNumber());
+
+            const Model::Node* defaultLayer = world->children().front();
+            ASSERT_EQ(worldBrushCount + entityCount, defaultLayer->childCount());
+
+            const Model::NodeList& children = defaultLayer->children();
+            for (size_t i = 0; i < worldBrushCount; ++i) {
+                const Model::Brush* brush = dynamic_cast<const Model::Brush*>(children[i]);
+                ASSERT_TRUE(brush != nullptr);
+                ASSERT_EQ(brushLines[i], brush->lineNumber());
+                ASSERT_EQ(i % 2 == 0 ? "{grate" : "none", brush->faces().front()->textureName());
+                ASSERT_DOUBLE_EQ(static_cast<double>(i * 64), brush->bounds().min.x());
+            }
+
+            for (size_t i = 0; i < entityCount; ++i) {
+                const Model::Entity* entity = dynamic_cast<const Model::Entity*>(children[worldBrushCount + i]);
+                ASSERT_TRUE(entity != nullptr);
+                ASSERT_EQ(entityLines[i + 1], entity->lineNumber());
+                ASSERT_EQ("wall" + std::to_string(i), entity->attribute("targetname"));
+                ASSERT_EQ(1u, entity->childCount());
+                ASSERT_EQ(brushLines[worldBrushCount + i], entity->children().front()->lineNumber());
+            }
+        }
+
         /*
         TEST(WorldReaderTest, parseIssueIgnoreFlags) {
             const String data("{"
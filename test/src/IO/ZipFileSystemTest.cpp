@@ -26,6 +26,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -149,5 +152,43 @@ namespace TrenchBroom {
 
             ASSERT_TRUE(fs.openFile(Path("amnet.cfg")) != nullptr);
         }
+
+        TEST(ZipFileSystemTest, openFileConcurrently) {
+            const Path zipPath = Disk::getCurrentWorkingDir() + Path("data/IO/Zip/zip_test.zip");
+            const MappedFile::Ptr zipFile = Disk::openFile(zipPath);
+            assert(zipFile != nullptr);
+
+            const ZipFileSystem fs(zipPath, zipFile);
+            const auto paths = fs.findItemsRecursively(Path(""), FileExtensionMatcher("wal"));
+            ASSERT_EQ(7u, paths.size());
+
+            std::vector<String> expected;
+            for (const auto& path : paths) {
+                const auto file = fs.openFile(path);
+                expected.push_back(String(file->begin(), file->end()));
+            }
+
+            std::vector<std::thread> threads;
+            // not vector<bool>, whose elements share words and cannot be written concurrently
+            std::vector<char> matches(4, true);
+            for (size_t t = 0; t < matches.size(); ++t) {
+                threads.emplace_back([&, t]() {
+                    for (size_t i = 0; i < 20; ++i) {
+                        const auto index = (i + t) % paths.size();
+                        const auto file = fs.openFile(paths[index]);
+                        if (String(file->begin(), file->end()) != expected[index]) {
+                            matches[t] = false;
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            for (const auto match : matches) {
+                ASSERT_TRUE(match);
+            }
+        }
     }
 }
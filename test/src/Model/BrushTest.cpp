@@ -28,6 +28,7 @@
 #include "Model/BrushBuilder.h"
 #include "Model/BrushContentTypeBuilder.h"
 #include "Model/BrushFace.h"
+#include "Model/BrushGeometry.h"
 #include "Model/BrushSnapshot.h"
 #include "Model/Hit.h"
 #include "Model/MapFormat.h"
@@ -36,6 +37,8 @@
 #include "Model/World.h"
 
 #include <vecmath/vec.h>
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/polygon.h>
 
 #include <algorithm>
@@ -104,6 +107,70 @@ namespace TrenchBroom {
                 ASSERT_EQ(faces[i], brushFaces[i]);
         }
 
+        TEST(BrushTest, constructBrushWithRedundantFace) {
+            const vm::bbox3 worldBounds(4096.0);
+
+            // a cube with length 16 at the origin and a face that does not touch it
+            BrushFaceList faces;
+            faces.push_back(BrushFace::createParaxial(vm::vec3(0.0, 0.0, 0.0), vm::vec3(0.0, 1.0, 0.0), vm::vec3(0.0, 0.0, 1.0)));
+            faces.push_back(BrushFace::createParaxial(vm::vec3(16.0, 0.0, 0.0), vm::vec3(16.0, 0.0, 1.0), vm::vec3(16.0, 1.0, 0.0)));
+            faces.push_back(BrushFace::createParaxial(vm::vec3(0.0, 0.0, 0.0), vm::vec3(0.0, 0.0, 1.0), vm::vec3(1.0, 0.0, 0.0)));
+            faces.push_back(BrushFace::createParaxial(vm::vec3(0.0, 16.0, 0.0), vm::vec3(1.0, 16.0, 0.0), vm::vec3(0.0, 16.0, 1.0)));
+            faces.push_back(BrushFace::createParaxial(vm::vec3(0.0, 0.0, 16.0), vm::vec3(0.0, 1.0, 16.0), vm::vec3(1.0, 0.0, 16.0)));
+            faces.push_back(BrushFace::createParaxial(vm::vec3(0.0, 0.0, 0.0), vm::vec3(1.0, 0.0, 0.0), vm::vec3(0.0, 1.0, 0.0)));
+            faces.push_back(BrushFace::createParaxial(vm::vec3(0.0, 0.0, 32.0), vm::vec3(0.0, 1.0, 32.0), vm::vec3(1.0, 0.0, 32.0)));
+
+            Brush brush(worldBounds, faces);
+            ASSERT_TRUE(brush.fullySpecified());
+            ASSERT_EQ(6u, brush.faceCount());
+            ASSERT_EQ(8u, brush.vertexCount());
+            ASSERT_EQ(vm::bbox3(vm::vec3(0.0, 0.0, 0.0), vm::vec3(16.0, 16.0, 16.0)), brush.bounds());
+        }
+
+        TEST(BrushTest, buildGeometryMatchesClipping) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+
+            const std::vector<std::vector<vm::vec3>> brushVertices {
+                // cuboid with a beveled corner
+                { vm::vec3(0, 0, 0), vm::vec3(64, 0, 0), vm::vec3(0, 32, 0), vm::vec3(64, 32, 0),
+                  vm::vec3(0, 0, 16), vm::vec3(48, 0, 16), vm::vec3(0, 32, 16), vm::vec3(64, 32, 16), vm::vec3(64, 16, 16), vm::vec3(64, 0, 8) },
+                // wedge
+                { vm::vec3(-16, -16, 0), vm::vec3(16, -16, 0), vm::vec3(-16, 16, 0), vm::vec3(16, 16, 0), vm::vec3(-16, -16, 32), vm::vec3(-16, 16, 32) },
+                // octagonal prism
+                { vm::vec3(-8, -20, 0), vm::vec3(8, -20, 0), vm::vec3(20, -8, 0), vm::vec3(20, 8, 0), vm::vec3(8, 20, 0), vm::vec3(-8, 20, 0), vm::vec3(-20, 8, 0), vm::vec3(-20, -8, 0),
+                  vm::vec3(-8, -20, 64), vm::vec3(8, -20, 64), vm::vec3(20, -8, 64), vm::vec3(20, 8, 64), vm::vec3(8, 20, 64), vm::vec3(-8, 20, 64), vm::vec3(-20, 8, 64), vm::vec3(-20, -8, 64) },
+                // square pyramid
+                { vm::vec3(1000, 1000, 0), vm::vec3(1032, 1000, 0), vm::vec3(1000, 1032, 0), vm::vec3(1032, 1032, 0), vm::vec3(1016, 1016, 24) }
+            };
+
+            for (const auto& vertices : brushVertices) {
+                Brush* brush = builder.createBrush(vertices, "texture");
+
+                BrushGeometry expected(worldBounds.expand(1.0));
+                for (const auto* face : brush->faces()) {
+                    expected.clip(face->boundary());
+                }
+                expected.correctVertexPositions();
+                expected.healEdges();
+
+                ASSERT_TRUE(brush->fullySpecified());
+                ASSERT_EQ(expected.vertexCount(), brush->vertexCount());
+                ASSERT_EQ(expected.edgeCount(), brush->edgeCount());
+                ASSERT_EQ(expected.faceCount(), brush->faceCount());
+                ASSERT_TRUE(brush->hasVertices(expected.vertexPositions(), vm::C::almostZero()));
+                ASSERT_TRUE(brush->hasVertices(vertices, vm::C::almostZero()));
+
+                for (const auto* face : brush->faces()) {
+                    ASSERT_EQ(face, face->geometry()->payload());
+                    ASSERT_VEC_EQ(face->boundary().normal, face->geometry()->normal());
+                }
+
+                delete brush;
+            }
+        }
+
         /*
          Regex to turn a face definition into a c++ statement to add a face to a vector of faces:
          Find: \(\s*(-?[\d\.+-]+)\s+(-?[\d\.+-]+)\s+(-?[\d\.+-]+)\s*\)\s*\(\s*(-?[\d\.+-]+)\s+(-?[\d\.+-]+)\s+(-?[\d\.+-]+)\s*\)\s*\(\s*(-?[\d\.+-]+)\s+(-?[\d\.+-]+)\s+(-?[\d\.+-]+)\s*\)\s*[^\n]+
@@ -2853,6 +2920,36 @@ namespace TrenchBroom {
             VectorUtils::deleteAll(result);
         }
 
+        TEST(BrushTest, subtractMergesConvexFragments) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+
+            // remove the upper half of the minuend with two subtrahends, each of which splits the minuend
+            BrushBuilder builder(&world, worldBounds);
+            Brush* minuend = builder.createCuboid(vm::bbox3(vm::vec3(0.0, 0.0, 0.0), vm::vec3(64.0, 64.0, 64.0)), "minuend");
+            Brush* left = builder.createCuboid(vm::bbox3(vm::vec3(-8.0, -8.0, 32.0), vm::vec3(32.0, 72.0, 72.0)), "subtrahend");
+            Brush* right = builder.createCuboid(vm::bbox3(vm::vec3(32.0, -8.0, 32.0), vm::vec3(72.0, 72.0, 72.0)), "subtrahend");
+            Brush* disjoint = builder.createCuboid(vm::bbox3(vm::vec3(128.0, 128.0, 128.0), vm::vec3(256.0, 256.0, 256.0)), "subtrahend");
+            const BrushList subtrahends { left, disjoint, right };
+
+            const BrushList fragments = minuend->subtract(world, worldBounds, "default", subtrahends, false);
+            ASSERT_EQ(2u, fragments.size());
+
+            const BrushList merged = minuend->subtract(world, worldBounds, "default", subtrahends, true);
+            ASSERT_EQ(1u, merged.size());
+
+            const Brush* brush = merged.front();
+            ASSERT_EQ(vm::bbox3(vm::vec3(0.0, 0.0, 0.0), vm::vec3(64.0, 64.0, 32.0)), brush->bounds());
+            ASSERT_EQ(6u, brush->faceCount());
+            ASSERT_EQ("minuend", brush->findFace(vm::vec3::neg_z)->textureName());
+            ASSERT_EQ("subtrahend", brush->findFace(vm::vec3::pos_z)->textureName());
+
+            delete minuend;
+            VectorUtils::deleteAll(subtrahends);
+            VectorUtils::deleteAll(fragments);
+            VectorUtils::deleteAll(merged);
+        }
+
         TEST(BrushTest, testAlmostDegenerateBrush) {
             // https://github.com/kduske/TrenchBroom/issues/1194
             const String data("{\n"
@@ -3589,6 +3686,51 @@ namespace TrenchBroom {
             EXPECT_FALSE(brush1->expand(worldBounds, -64, true));
         }
 
+        TEST(BrushTest, transformMatchesRebuiltGeometry) {
+            const vm::bbox3 worldBounds(4096.0);
+            World world(MapFormat::Standard, nullptr, worldBounds);
+            const BrushBuilder builder(&world, worldBounds);
+            const vm::bbox3 cuboid(vm::vec3(-16, -32, -64), vm::vec3(32, 16, 8));
+
+            const auto transformations = std::vector<vm::mat4x4> {
+                vm::translationMatrix(vm::vec3(16.0, -8.0, 0.5)),
+                vm::mat4x4::rot_90_z_cw,
+                vm::rotationMatrix(vm::vec3::pos_x, vm::toRadians(90.0)),
+                vm::mat4x4::mirror_y,
+                vm::scalingMatrix(vm::vec3(2.0, 2.0, 2.0)),
+                vm::scalingMatrix(vm::vec3(0.5, 0.5, 0.5)),
+                vm::rotationMatrix(vm::vec3::pos_z, vm::toRadians(30.0))
+            };
+
+            for (const auto& transformation : transformations) {
+                Brush* brush = builder.createCuboid(cuboid, "texture");
+
+                Brush* expected = brush->clone(worldBounds);
+                for (auto* face : expected->faces()) {
+                    face->transform(transformation, false);
+                }
+                expected->rebuildGeometry(worldBounds);
+
+                ASSERT_TRUE(brush->canTransform(transformation, worldBounds));
+                brush->transform(transformation, false, worldBounds);
+
+                ASSERT_EQ(expected->faceCount(), brush->faceCount());
+                ASSERT_TRUE(brush->fullySpecified());
+                ASSERT_TRUE(brush->hasVertices(expected->vertexPositions(), vm::C::almostZero()));
+                ASSERT_TRUE(isEqual(expected->bounds(), brush->bounds(), vm::C::almostZero()));
+                for (const auto* face : expected->faces()) {
+                    ASSERT_TRUE(brush->hasFace(face->polygon(), vm::C::almostZero()));
+                }
+
+                delete expected;
+                delete brush;
+            }
+
+            Brush* brush = builder.createCuboid(cuboid, "texture");
+            ASSERT_FALSE(brush->canTransform(vm::translationMatrix(vm::vec3(4096.0, 0.0, 0.0)), worldBounds));
+            delete brush;
+        }
+
         TEST(BrushTest, moveVerticesFail_2158) {
             // see https://github.com/kduske/TrenchBroom/issues/2158
             const vm::bbox3 worldBounds(4096.0);
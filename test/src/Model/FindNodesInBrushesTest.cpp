@@ -0,0 +1,152 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/CollectContainedNodesVisitor.h"
+#include "Model/CollectTouchingNodesVisitor.h"
+#include "Model/EditorContext.h"
+#include "Model/Entity.h"
+#include "Model/FindNodesInBrushes.h"
+#include "Model/Group.h"
+#include "Model/Layer.h"
+#include "Model/World.h"
+
+#include <random>
+#include <set>
+
+namespace TrenchBroom {
+    namespace Model {
+        class FindNodesInBrushesTest : public ::testing::Test {
+        protected:
+            vm::bbox3 worldBounds;
+            World* world;
+            EditorContext context;
+
+            void SetUp() override {
+                worldBounds = vm::bbox3(8192.0);
+                world = new World(MapFormat::Standard, nullptr, worldBounds);
+            }
+
+            void TearDown() override {
+                delete world;
+                world = nullptr;
+            }
+
+            Brush* createBrush(const vm::bbox3& bounds) const {
+                BrushBuilder builder(world, worldBounds);
+                return builder.createCuboid(bounds, "sometex");
+            }
+
+            /**
+             * Adds brushes at random positions, some of which are grouped or belong to a brush entity.
+             */
+            void createRandomWorld(const size_t count) {
+                std::mt19937 random(0);
+                std::uniform_real_distribution<FloatType> positions(-1024.0, 1024.0);
+                std::uniform_real_distribution<FloatType> sizes(8.0, 128.0);
+
+                Layer* layer = world->defaultLayer();
+                Group* group = world->createGroup("group");
+                Entity* entity = world->createEntity();
+                layer->addChild(group);
+                layer->addChild(entity);
+
+                for (size_t i = 0; i < count; ++i) {
+                    const auto min = vm::vec3(positions(random), positions(random), positions(random));
+                    const auto max = min + vm::vec3(sizes(random), sizes(random), sizes(random));
+                    Brush* brush = createBrush(vm::bbox3(min, max));
+                    switch (i % 4) {
+                        case 0:
+                            group->addChild(brush);
+                            break;
+                        case 1:
+                            entity->addChild(brush);
+                            break;
+                        default:
+                            layer->addChild(brush);
+                            break;
+                    }
+                }
+            }
+        };
+
+        static std::set<Node*> toSet(const NodeList& nodes) {
+            return std::set<Node*>(std::begin(nodes), std::end(nodes));
+        }
+
+        TEST_F(FindNodesInBrushesTest, findTouchingNodesMatchesVisitor) {
+            createRandomWorld(1000);
+
+            const BrushList queries {
+                createBrush(vm::bbox3(vm::vec3(-256.0, -256.0, -256.0), vm::vec3(256.0, 256.0, 256.0))),
+                createBrush(vm::bbox3(vm::vec3(512.0, 0.0, 0.0), vm::vec3(768.0, 1024.0, 64.0)))
+            };
+            world->defaultLayer()->addChildren(NodeList(std::begin(queries), std::end(queries)));
+
+            CollectTouchingNodesVisitor<BrushList::const_iterator> visitor(std::begin(queries), std::end(queries), context);
+            world->acceptAndRecurse(visitor);
+
+            const auto expected = visitor.nodes();
+            const auto actual = findNodesTouchingBrushes(*world, std::begin(queries), std::end(queries), context);
+            ASSERT_FALSE(expected.empty());
+            ASSERT_EQ(expected.size(), actual.size());
+            ASSERT_EQ(toSet(expected), toSet(actual));
+        }
+
+        TEST_F(FindNodesInBrushesTest, findContainedNodesMatchesVisitor) {
+            createRandomWorld(1000);
+
+            const BrushList queries {
+                createBrush(vm::bbox3(vm::vec3(-512.0, -512.0, -512.0), vm::vec3(512.0, 512.0, 512.0))),
+                createBrush(vm::bbox3(vm::vec3(256.0, 256.0, 256.0), vm::vec3(1024.0, 1024.0, 1024.0)))
+            };
+            world->defaultLayer()->addChildren(NodeList(std::begin(queries), std::end(queries)));
+
+            CollectContainedNodesVisitor<BrushList::const_iterator> visitor(std::begin(queries), std::end(queries), context);
+            world->acceptAndRecurse(visitor);
+
+            const auto expected = visitor.nodes();
+            const auto actual = findNodesContainedInBrushes(*world, std::begin(queries), std::end(queries), context);
+            ASSERT_FALSE(expected.empty());
+            ASSERT_EQ(expected.size(), actual.size());
+            ASSERT_EQ(toSet(expected), toSet(actual));
+        }
+
+        TEST_F(FindNodesInBrushesTest, findNodesInOpenGroup) {
+            Group* group = world->createGroup("group");
+            Brush* grouped = createBrush(vm::bbox3(vm::vec3(0.0, 0.0, 0.0), vm::vec3(32.0, 32.0, 32.0)));
+            group->addChild(grouped);
+            world->defaultLayer()->addChild(group);
+
+            const BrushList queries { createBrush(vm::bbox3(vm::vec3(-64.0, -64.0, -64.0), vm::vec3(64.0, 64.0, 64.0))) };
+            world->defaultLayer()->addChild(queries.front());
+
+            // a closed group is found as a whole
+            ASSERT_EQ(NodeList({ group }), findNodesContainedInBrushes(*world, std::begin(queries), std::end(queries), context));
+
+            // the brushes of an open group are found individually
+            context.pushGroup(group);
+            ASSERT_EQ(NodeList({ grouped }), findNodesContainedInBrushes(*world, std::begin(queries), std::end(queries), context));
+            context.popGroup();
+        }
+    }
+}
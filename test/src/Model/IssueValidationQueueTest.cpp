@@ -0,0 +1,155 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "Model/Entity.h"
+#include "Model/Issue.h"
+#include "Model/IssueGenerator.h"
+#include "Model/IssueValidationQueue.h"
+#include "Model/Layer.h"
+#include "Model/World.h"
+
+#include <set>
+
+namespace TrenchBroom {
+    namespace Model {
+        class MissingClassnameTestIssue : public Issue {
+        public:
+            static const IssueType Type;
+        public:
+            explicit MissingClassnameTestIssue(Node* node) :
+            Issue(node) {}
+        private:
+            IssueType doGetType() const override {
+                return Type;
+            }
+
+            const String doGetDescription() const override {
+                return "Entity has no classname";
+            }
+        };
+
+        const IssueType MissingClassnameTestIssue::Type = Issue::freeType();
+
+        class MissingClassnameTestIssueGenerator : public IssueGenerator {
+        public:
+            MissingClassnameTestIssueGenerator() :
+            IssueGenerator(MissingClassnameTestIssue::Type, "Missing classname") {}
+        private:
+            void doGenerate(AttributableNode* node, IssueList& issues) const override {
+                if (!node->hasAttribute(AttributeNames::Classname)) {
+                    issues.push_back(new MissingClassnameTestIssue(node));
+                }
+            }
+        };
+
+        class IssueValidationQueueTest : public ::testing::Test {
+        protected:
+            World* world;
+            EntityList entities;
+
+            void SetUp() override {
+                world = new World(MapFormat::Standard, nullptr, vm::bbox3(8192.0));
+                world->registerIssueGenerator(new MissingClassnameTestIssueGenerator());
+
+                // every third entity has no classname
+                for (size_t i = 0; i < 3000; ++i) {
+                    Entity* entity = world->createEntity();
+                    if (i % 3 != 0) {
+                        entity->addOrUpdateAttribute(AttributeNames::Classname, "info_null");
+                    }
+                    world->defaultLayer()->addChild(entity);
+                    entities.push_back(entity);
+                }
+            }
+
+            void TearDown() override {
+                delete world;
+                world = nullptr;
+                entities.clear();
+            }
+
+            IssueList validateAll(IssueValidationQueue& queue, const size_t batchSize) {
+                IssueList result;
+                while (!queue.done()) {
+                    const auto remaining = queue.remaining();
+                    const auto nodes = queue.validateNext(world->registeredIssueGenerators(), batchSize);
+                    EXPECT_EQ(std::min(batchSize, remaining), nodes.size());
+
+                    for (Node* node : nodes) {
+                        EXPECT_TRUE(node->issuesValid());
+                        const auto& issues = node->issues(world->registeredIssueGenerators());
+                        result.insert(std::end(result), std::begin(issues), std::end(issues));
+                    }
+                }
+                return result;
+            }
+        };
+
+        TEST_F(IssueValidationQueueTest, validateInBatches) {
+            IssueValidationQueue queue;
+            ASSERT_TRUE(queue.done());
+
+            queue.reset(world);
+            // the world, the default layer and the entities
+            ASSERT_EQ(entities.size() + 2u, queue.remaining());
+
+            const auto issues = validateAll(queue, 100);
+            ASSERT_EQ(1000u, issues.size());
+            ASSERT_EQ(0u, queue.remaining());
+
+            // issues that were generated on different threads still have unique sequence numbers
+            std::set<size_t> seqIds;
+            for (const Issue* issue : issues) {
+                seqIds.insert(issue->seqId());
+            }
+            ASSERT_EQ(issues.size(), seqIds.size());
+        }
+
+        TEST_F(IssueValidationQueueTest, revalidateChangedNodes) {
+            IssueValidationQueue queue;
+            queue.reset(world);
+            validateAll(queue, 1000);
+
+            entities[0]->addOrUpdateAttribute(AttributeNames::Classname, "info_null");
+            entities[1]->removeAttribute(AttributeNames::Classname);
+            ASSERT_FALSE(entities[0]->issuesValid());
+            ASSERT_FALSE(entities[1]->issuesValid());
+            ASSERT_TRUE(entities[2]->issuesValid());
+
+            queue.reset(world);
+            const auto issues = validateAll(queue, 1000);
+            ASSERT_EQ(1000u, issues.size());
+            ASSERT_TRUE(entities[0]->issues(world->registeredIssueGenerators()).empty());
+            ASSERT_EQ(1u, entities[1]->issues(world->registeredIssueGenerators()).size());
+        }
+
+        TEST_F(IssueValidationQueueTest, clear) {
+            IssueValidationQueue queue;
+            queue.reset(world);
+            queue.clear();
+
+            ASSERT_TRUE(queue.done());
+            ASSERT_TRUE(queue.validateNext(world->registeredIssueGenerators(), 100).empty());
+            ASSERT_FALSE(entities[0]->issuesValid());
+        }
+    }
+}
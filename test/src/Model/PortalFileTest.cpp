@@ -36,6 +36,12 @@ namespace TrenchBroom {
             EXPECT_ANY_THROW(const Model::PortalFile p = Model::PortalFile(path));
         }
 
+        TEST(PortalFileTest, parseInvalidNumberPRT1) {
+            const auto path = IO::Path("data/Model/PortalFile/portaltest_prt1_invalid_number.prt");
+
+            EXPECT_ANY_THROW(const Model::PortalFile p = Model::PortalFile(path));
+        }
+
         static const std::vector<vm::polygon3f> ExpectedPortals {
                 {{-96,-32,80}, {-96,160,80}, {0,160,80}, {0,-32,80}},
                 {{208,-64,80}, {64,-64,80}, {64,160,80}, {208,160,80}},
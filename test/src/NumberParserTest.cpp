@@ -0,0 +1,109 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "NumberParser.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+namespace NumberParser {
+    static double parse(const String& str) {
+        return toFloat<double>(str);
+    }
+
+    static size_t parsedLength(const String& str) {
+        double result = 0.0;
+        return static_cast<size_t>(parseDouble(str.data(), str.data() + str.size(), result) - str.data());
+    }
+
+    TEST(NumberParserTest, parseDouble) {
+        ASSERT_EQ(0.0, parse("0"));
+        ASSERT_EQ(0.0, parse("0.0"));
+        ASSERT_EQ(1.0, parse("1"));
+        ASSERT_EQ(-1.0, parse("-1"));
+        ASSERT_EQ(1.0, parse("+1"));
+        ASSERT_EQ(0.5, parse("0.5"));
+        ASSERT_EQ(0.5, parse(".5"));
+        ASSERT_EQ(5.0, parse("5."));
+        ASSERT_EQ(-16.0, parse("-16"));
+        ASSERT_EQ(0.1, parse("0.1"));
+        ASSERT_EQ(-0.001, parse("-0.001"));
+        ASSERT_EQ(1234.5678, parse("1234.5678"));
+        ASSERT_EQ(1.5e10, parse("1.5e10"));
+        ASSERT_EQ(1.5e-10, parse("1.5E-10"));
+        ASSERT_EQ(1.5e10, parse("1.5e+10"));
+        ASSERT_EQ(0.70710678118654757, parse("0.70710678118654757"));
+        ASSERT_EQ(123456789012345678901234567890.0, parse("123456789012345678901234567890"));
+        ASSERT_EQ(1e300, parse("1e300"));
+        ASSERT_EQ(1e-300, parse("1e-300"));
+        ASSERT_EQ(std::numeric_limits<double>::infinity(), parse("1e400"));
+        ASSERT_EQ(0.0, parse("1e-400"));
+        ASSERT_TRUE(std::signbit(parse("-0")));
+    }
+
+    TEST(NumberParserTest, parseDoubleStopsAtEndOfNumber) {
+        ASSERT_EQ(0.0, parse(""));
+        ASSERT_EQ(0.0, parse("-"));
+        ASSERT_EQ(0.0, parse("."));
+        ASSERT_EQ(0.0, parse("abc"));
+        ASSERT_EQ(1.5, parse("1.5)"));
+        ASSERT_EQ(1.0, parse("1e"));
+        ASSERT_EQ(1.0, parse("1e+"));
+
+        ASSERT_EQ(0u, parsedLength(""));
+        ASSERT_EQ(0u, parsedLength("-"));
+        ASSERT_EQ(0u, parsedLength(".e1"));
+        ASSERT_EQ(3u, parsedLength("1.5)"));
+        ASSERT_EQ(1u, parsedLength("1e"));
+        ASSERT_EQ(1u, parsedLength("1e+"));
+        ASSERT_EQ(4u, parsedLength("1e+1x"));
+    }
+
+    TEST(NumberParserTest, parseDoubleMatchesStrtod) {
+        std::mt19937 random(0);
+        std::uniform_real_distribution<double> values(-65536.0, 65536.0);
+        std::uniform_int_distribution<int> precisions(0, 20);
+
+        for (size_t i = 0; i < 10000; ++i) {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "%.*f", precisions(random), values(random));
+            ASSERT_EQ(std::strtod(buffer, nullptr), parse(buffer)) << buffer;
+        }
+    }
+
+    TEST(NumberParserTest, parseLongLong) {
+        ASSERT_EQ(0, toInteger<int>("0"));
+        ASSERT_EQ(1, toInteger<int>("1"));
+        ASSERT_EQ(-1, toInteger<int>("-1"));
+        ASSERT_EQ(1, toInteger<int>("+1"));
+        ASSERT_EQ(123, toInteger<int>("123abc"));
+        ASSERT_EQ(1, toInteger<int>("1.5"));
+        ASSERT_EQ(0, toInteger<int>(""));
+        ASSERT_EQ(0, toInteger<int>("-"));
+        ASSERT_EQ(0, toInteger<int>("abc"));
+        ASSERT_EQ(std::numeric_limits<long long>::max(), toInteger<long long>("9223372036854775807"));
+        ASSERT_EQ(std::numeric_limits<long long>::min(), toInteger<long long>("-9223372036854775808"));
+        ASSERT_EQ(std::numeric_limits<long long>::max(), toInteger<long long>("99999999999999999999"));
+        ASSERT_EQ(std::numeric_limits<long long>::min(), toInteger<long long>("-99999999999999999999"));
+    }
+}
@@ -25,6 +25,8 @@
 #include "Polyhedron_DefaultPayload.h"
 #include "TestUtils.h"
 
+#include <vecmath/mat.h>
+#include <vecmath/mat_ext.h>
 #include <vecmath/plane.h>
 #include <vecmath/scalar.h>
 
@@ -2369,6 +2371,148 @@ TEST(PolyhedronTest, intersection_polygon_polyhedron_same_plane_as_face) {
     }, cube);
 }
 
+TEST(PolyhedronTest, transform) {
+    const vm::vec3d p1(0.0, 0.0, 0.0);
+    const vm::vec3d p2(8.0, 0.0, 0.0);
+    const vm::vec3d p3(0.0, 4.0, 0.0);
+    const vm::vec3d p4(0.0, 0.0, 2.0);
+
+    const auto transformations = std::vector<vm::mat4x4d> {
+        vm::translationMatrix(vm::vec3d(16.0, -8.0, 4.0)),
+        vm::mat4x4d::rot_90_z_cw,
+        vm::mat4x4d::mirror_x,
+        vm::translationMatrix(vm::vec3d(16.0, 0.0, 0.0)) * vm::mat4x4d::mirror_y * vm::mat4x4d::rot_90_x_ccw,
+        vm::scalingMatrix(vm::vec3d(2.0, 2.0, 2.0))
+    };
+
+    for (const auto& transformation : transformations) {
+        Polyhedron3d p(p1, p2, p3, p4);
+        p.transform(transformation);
+
+        const Polyhedron3d expected(transformation * p1, transformation * p2, transformation * p3, transformation * p4);
+        ASSERT_EQ(expected, p);
+        ASSERT_EQ(expected.bounds(), p.bounds());
+
+        // the boundaries must still be counter clockwise, so the center must be below every face
+        const auto center = (transformation * p1 + transformation * p2 + transformation * p3 + transformation * p4) / 4.0;
+        const auto* firstFace = p.faces().front();
+        const auto* currentFace = firstFace;
+        do {
+            ASSERT_EQ(vm::point_status::below, currentFace->pointStatus(center));
+            currentFace = currentFace->next();
+        } while (currentFace != firstFace);
+    }
+}
+
+TEST(PolyhedronTest, volume) {
+    ASSERT_DOUBLE_EQ(0.0, Polyhedron3d().volume());
+    ASSERT_DOUBLE_EQ(0.0, (Polyhedron3d { vm::vec3d(0.0, 0.0, 0.0), vm::vec3d(1.0, 0.0, 0.0), vm::vec3d(0.0, 1.0, 0.0) }).volume());
+
+    const Polyhedron3d tetrahedron(vm::vec3d(0.0, 0.0, 0.0), vm::vec3d(8.0, 0.0, 0.0), vm::vec3d(0.0, 4.0, 0.0), vm::vec3d(0.0, 0.0, 2.0));
+    ASSERT_DOUBLE_EQ(64.0 / 6.0, tetrahedron.volume());
+
+    const Polyhedron3d cuboid(vm::bbox3d(vm::vec3d(1000.0, 2000.0, 3000.0), vm::vec3d(1064.0, 2032.0, 3016.0)));
+    ASSERT_DOUBLE_EQ(64.0 * 32.0 * 16.0, cuboid.volume());
+}
+
+static void assertFacesMatchPlanes(const std::vector<vm::plane3d>& planes, const std::vector<Polyhedron3d::Face*>& faces) {
+    ASSERT_EQ(planes.size(), faces.size());
+    for (size_t i = 0; i < planes.size(); ++i) {
+        ASSERT_VEC_EQ(planes[i].normal, faces[i]->normal());
+        for (const auto& position : faces[i]->vertexPositions()) {
+            ASSERT_NEAR(0.0, planes[i].pointDistance(position), vm::constants<double>::almostZero());
+        }
+    }
+}
+
+TEST(PolyhedronTest, buildFromPlanes_cube) {
+    const vm::bbox3d worldBounds(8192.0);
+    const std::vector<vm::plane3d> planes {
+        vm::plane3d(vm::vec3d(-16.0, 0.0, 0.0), vm::vec3d::neg_x),
+        vm::plane3d(vm::vec3d(+32.0, 0.0, 0.0), vm::vec3d::pos_x),
+        vm::plane3d(vm::vec3d(0.0, -16.0, 0.0), vm::vec3d::neg_y),
+        vm::plane3d(vm::vec3d(0.0, +32.0, 0.0), vm::vec3d::pos_y),
+        vm::plane3d(vm::vec3d(0.0, 0.0, -16.0), vm::vec3d::neg_z),
+        vm::plane3d(vm::vec3d(0.0, 0.0, +32.0), vm::vec3d::pos_z)
+    };
+
+    Polyhedron3d p;
+    const auto faces = p.buildFromPlanes(planes, worldBounds);
+    assertFacesMatchPlanes(planes, faces);
+    ASSERT_EQ(Polyhedron3d(vm::bbox3d(vm::vec3d(-16.0, -16.0, -16.0), vm::vec3d(32.0, 32.0, 32.0))), p);
+    ASSERT_EQ(vm::bbox3d(vm::vec3d(-16.0, -16.0, -16.0), vm::vec3d(32.0, 32.0, 32.0)), p.bounds());
+}
+
+TEST(PolyhedronTest, buildFromPlanes_pyramid) {
+    const vm::bbox3d worldBounds(8192.0);
+    const vm::vec3d apex(0.0, 0.0, 16.0);
+    const std::vector<vm::plane3d> planes {
+        vm::plane3d(vm::vec3d::zero, vm::vec3d::neg_z),
+        vm::plane3d(apex, normalize(vm::vec3d(+1.0, 0.0, 1.0))),
+        vm::plane3d(apex, normalize(vm::vec3d(-1.0, 0.0, 1.0))),
+        vm::plane3d(apex, normalize(vm::vec3d(0.0, +1.0, 1.0))),
+        vm::plane3d(apex, normalize(vm::vec3d(0.0, -1.0, 1.0)))
+    };
+
+    Polyhedron3d p;
+    const auto faces = p.buildFromPlanes(planes, worldBounds);
+    assertFacesMatchPlanes(planes, faces);
+
+    // four planes meet in the apex
+    ASSERT_EQ(5u, p.vertexCount());
+    ASSERT_EQ(8u, p.edgeCount());
+    ASSERT_EQ(5u, p.faceCount());
+    ASSERT_TRUE(p.hasVertex(vm::vec3d(-16.0, -16.0, 0.0), vm::constants<double>::almostZero()));
+    ASSERT_TRUE(p.hasVertex(vm::vec3d(-16.0, +16.0, 0.0), vm::constants<double>::almostZero()));
+    ASSERT_TRUE(p.hasVertex(vm::vec3d(+16.0, -16.0, 0.0), vm::constants<double>::almostZero()));
+    ASSERT_TRUE(p.hasVertex(vm::vec3d(+16.0, +16.0, 0.0), vm::constants<double>::almostZero()));
+    ASSERT_TRUE(p.hasVertex(apex, vm::constants<double>::almostZero()));
+}
+
+TEST(PolyhedronTest, buildFromPlanesFails) {
+    const vm::bbox3d worldBounds(8192.0);
+    const std::vector<vm::plane3d> cube {
+        vm::plane3d(vm::vec3d(-16.0, 0.0, 0.0), vm::vec3d::neg_x),
+        vm::plane3d(vm::vec3d(+16.0, 0.0, 0.0), vm::vec3d::pos_x),
+        vm::plane3d(vm::vec3d(0.0, -16.0, 0.0), vm::vec3d::neg_y),
+        vm::plane3d(vm::vec3d(0.0, +16.0, 0.0), vm::vec3d::pos_y),
+        vm::plane3d(vm::vec3d(0.0, 0.0, -16.0), vm::vec3d::neg_z),
+        vm::plane3d(vm::vec3d(0.0, 0.0, +16.0), vm::vec3d::pos_z)
+    };
+
+    const auto assertFails = [&](const std::vector<vm::plane3d>& planes, const vm::bbox3d& bounds) {
+        Polyhedron3d p;
+        ASSERT_TRUE(p.buildFromPlanes(planes, bounds).empty());
+        ASSERT_TRUE(p.empty());
+    };
+
+    // unbounded
+    assertFails(std::vector<vm::plane3d>(std::begin(cube), std::begin(cube) + 5), worldBounds);
+
+    // exceeds the bounds
+    assertFails(cube, vm::bbox3d(8.0));
+
+    // a redundant plane that does not touch the cube
+    auto redundant = cube;
+    redundant.push_back(vm::plane3d(vm::vec3d(0.0, 0.0, 32.0), vm::vec3d::pos_z));
+    assertFails(redundant, worldBounds);
+
+    // a plane that only touches an edge of the cube
+    auto touching = cube;
+    touching.push_back(vm::plane3d(vm::vec3d(16.0, 16.0, 0.0), normalize(vm::vec3d(1.0, 1.0, 0.0))));
+    assertFails(touching, worldBounds);
+
+    // two planes with the same face
+    auto duplicate = cube;
+    duplicate.push_back(cube.front());
+    assertFails(duplicate, worldBounds);
+
+    // empty
+    auto empty = cube;
+    empty.push_back(vm::plane3d(vm::vec3d(0.0, 0.0, -32.0), vm::vec3d::neg_z).flip());
+    assertFails(empty, worldBounds);
+}
+
 TEST(PolyhedronTest, intersection_polygon_polyhedron_any_orientation) {
     const Polyhedron3d cube {
         vm::vec3d(-1.0, -1.0, -1.0),
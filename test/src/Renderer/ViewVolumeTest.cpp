@@ -0,0 +1,87 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Renderer/OrthographicCamera.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "Renderer/ViewVolume.h"
+
+namespace TrenchBroom {
+    namespace Renderer {
+        using Containment = ViewVolume::Containment;
+
+        static vm::bbox3f box(const vm::vec3f& center, const float size) {
+            return vm::bbox3f(center - vm::vec3f(size, size, size), center + vm::vec3f(size, size, size));
+        }
+
+        TEST(ViewVolumeTest, emptyVolumeContainsEverything) {
+            const ViewVolume volume;
+            ASSERT_EQ(Containment::Inside, volume.classify(box(vm::vec3f(1000.0f, -5000.0f, 0.0f), 16.0f)));
+        }
+
+        TEST(ViewVolumeTest, classifyWithPerspectiveCamera) {
+            // looks along the positive X axis; the frustum widens by 0.75 units per unit of distance
+            const PerspectiveCamera camera(90.0f, 1.0f, 8192.0f, Camera::Viewport(0, 0, 800, 800),
+                                           vm::vec3f::zero, vm::vec3f::pos_x, vm::vec3f::pos_z);
+            const ViewVolume volume(camera);
+            ASSERT_EQ(5u, volume.planes().size());
+
+            ASSERT_EQ(Containment::Inside, volume.classify(box(vm::vec3f(512.0f, 0.0f, 0.0f), 16.0f)));
+            ASSERT_EQ(Containment::Inside, volume.classify(box(vm::vec3f(512.0f, 300.0f, -300.0f), 16.0f)));
+
+            // behind the camera
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(-512.0f, 0.0f, 0.0f), 16.0f)));
+            // left, right, above and below the field of view
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(512.0f, 1024.0f, 0.0f), 16.0f)));
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(512.0f, -1024.0f, 0.0f), 16.0f)));
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(512.0f, 0.0f, 1024.0f), 16.0f)));
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(512.0f, 0.0f, -1024.0f), 16.0f)));
+            // beyond the far plane
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(10000.0f, 0.0f, 0.0f), 16.0f)));
+
+            // boxes that contain the camera or cross the edges of the field of view
+            ASSERT_EQ(Containment::Intersects, volume.classify(box(vm::vec3f::zero, 16.0f)));
+            ASSERT_EQ(Containment::Intersects, volume.classify(box(vm::vec3f(512.0f, 384.0f, 0.0f), 16.0f)));
+            ASSERT_EQ(Containment::Intersects, volume.classify(box(vm::vec3f(8192.0f, 0.0f, 0.0f), 16.0f)));
+        }
+
+        TEST(ViewVolumeTest, classifyWithOrthographicCamera) {
+            // looks down the negative Z axis and shows the rectangle from (-400, -300) to (400, 300)
+            const OrthographicCamera camera(1.0f, 8192.0f, Camera::Viewport(0, 0, 800, 600),
+                                            vm::vec3f(0.0f, 0.0f, 4096.0f), vm::vec3f::neg_z, vm::vec3f::pos_y);
+            const ViewVolume volume(camera);
+            ASSERT_EQ(4u, volume.planes().size());
+
+            ASSERT_EQ(Containment::Inside, volume.classify(box(vm::vec3f::zero, 16.0f)));
+            // the volume is unbounded in viewing direction
+            ASSERT_EQ(Containment::Inside, volume.classify(box(vm::vec3f(100.0f, 100.0f, -100000.0f), 16.0f)));
+            ASSERT_EQ(Containment::Inside, volume.classify(box(vm::vec3f(100.0f, 100.0f, 100000.0f), 16.0f)));
+
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(500.0f, 0.0f, 0.0f), 16.0f)));
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(-500.0f, 0.0f, 0.0f), 16.0f)));
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(0.0f, 400.0f, 0.0f), 16.0f)));
+            ASSERT_EQ(Containment::Outside, volume.classify(box(vm::vec3f(0.0f, -400.0f, 0.0f), 16.0f)));
+
+            ASSERT_EQ(Containment::Intersects, volume.classify(box(vm::vec3f(400.0f, 0.0f, 0.0f), 16.0f)));
+            ASSERT_EQ(Containment::Intersects, volume.classify(box(vm::vec3f(0.0f, 0.0f, 0.0f), 1000.0f)));
+            ASSERT_TRUE(volume.intersects(box(vm::vec3f(0.0f, 300.0f, 0.0f), 16.0f)));
+        }
+    }
+}
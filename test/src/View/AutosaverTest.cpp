@@ -50,6 +50,7 @@ namespace TrenchBroom {
             NullLogger logger;
 
             document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            document->waitForPendingSaves();
             assert(env.fileExists(IO::Path("test.map")));
 
             Autosaver autosaver(document, 10, 0);
@@ -58,6 +59,7 @@ namespace TrenchBroom {
             document->addNode(createBrush("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            document->waitForPendingSaves();
 
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -68,10 +70,12 @@ namespace TrenchBroom {
             NullLogger logger;
 
             document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            document->waitForPendingSaves();
             assert(env.fileExists(IO::Path("test.map")));
 
             Autosaver autosaver(document, 0, 0);
             autosaver.triggerAutosave(logger);
+            document->waitForPendingSaves();
 
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -82,6 +86,7 @@ namespace TrenchBroom {
             NullLogger logger;
 
             document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            document->waitForPendingSaves();
             assert(env.fileExists(IO::Path("test.map")));
 
             Autosaver autosaver(document, 1, 0);
@@ -94,6 +99,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(2s);
 
             autosaver.triggerAutosave(logger);
+            document->waitForPendingSaves();
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_TRUE(env.directoryExists(IO::Path("autosave")));
@@ -104,6 +110,7 @@ namespace TrenchBroom {
             NullLogger logger;
 
             document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            document->waitForPendingSaves();
             assert(env.fileExists(IO::Path("test.map")));
 
             Autosaver autosaver(document, 0, 1);
@@ -112,6 +119,7 @@ namespace TrenchBroom {
             document->addNode(createBrush("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            document->waitForPendingSaves();
 
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_FALSE(env.directoryExists(IO::Path("autosave")));
@@ -123,6 +131,7 @@ namespace TrenchBroom {
             NullLogger logger;
 
             document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            document->waitForPendingSaves();
             assert(env.fileExists(IO::Path("test.map")));
 
             Autosaver autosaver(document, 0, 1);
@@ -135,6 +144,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(2s);
 
             autosaver.triggerAutosave(logger);
+            document->waitForPendingSaves();
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_TRUE(env.directoryExists(IO::Path("autosave")));
@@ -145,6 +155,7 @@ namespace TrenchBroom {
             NullLogger logger;
 
             document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            document->waitForPendingSaves();
             assert(env.fileExists(IO::Path("test.map")));
 
             Autosaver autosaver(document, 1, 0);
@@ -157,6 +168,7 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(2s);
 
             autosaver.triggerAutosave(logger);
+            document->waitForPendingSaves();
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
             ASSERT_TRUE(env.directoryExists(IO::Path("autosave")));
@@ -166,12 +178,14 @@ namespace TrenchBroom {
             std::this_thread::sleep_for(2s);
 
             autosaver.triggerAutosave(logger);
+            document->waitForPendingSaves();
             ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.2.map")));
 
             // modify the map
             document->addNode(createBrush("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            document->waitForPendingSaves();
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.2.map")));
         }
 
@@ -186,6 +200,7 @@ namespace TrenchBroom {
             NullLogger logger;
 
             document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            document->waitForPendingSaves();
             assert(env.fileExists(IO::Path("test.map")));
 
             Autosaver autosaver(document, 0, 0);
@@ -194,6 +209,7 @@ namespace TrenchBroom {
             document->addNode(createBrush("some_texture"), document->currentLayer());
 
             autosaver.triggerAutosave(logger);
+            document->waitForPendingSaves();
 
             ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.2.map")));
         }
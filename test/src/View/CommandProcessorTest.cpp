@@ -0,0 +1,146 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Brush.h"
+#include "Model/ModelUtils.h"
+#include "View/AddRemoveNodesCommand.h"
+#include "View/CommandProcessor.h"
+#include "View/MapDocumentCommandFacade.h"
+#include "View/MapDocumentTest.h"
+
+namespace TrenchBroom {
+    namespace View {
+        class CommandProcessorTest : public MapDocumentTest {};
+
+        class TestCommand : public UndoableCommand {
+        public:
+            static const CommandType Type;
+        private:
+            size_t m_memorySize;
+        public:
+            TestCommand(const String& name, const size_t memorySize) :
+            UndoableCommand(Type, name),
+            m_memorySize(memorySize) {}
+        private:
+            bool doPerformDo(MapDocumentCommandFacade* document) override {
+                return true;
+            }
+
+            bool doPerformUndo(MapDocumentCommandFacade* document) override {
+                return true;
+            }
+
+            bool doIsRepeatable(MapDocumentCommandFacade* document) const override {
+                return false;
+            }
+
+            bool doCollateWith(UndoableCommand::Ptr command) override {
+                return false;
+            }
+
+            size_t doGetMemorySize() const override {
+                return m_memorySize;
+            }
+        };
+
+        const TestCommand::CommandType TestCommand::Type = Command::freeType();
+
+        TEST_F(CommandProcessorTest, memoryBudgetDiscardsOldestCommands) {
+            CommandProcessor processor(static_cast<MapDocumentCommandFacade*>(document.get()));
+            processor.setMemoryBudget(250);
+
+            processor.submitAndStoreCommand(UndoableCommand::Ptr(new TestCommand("first", 100)));
+            processor.submitAndStoreCommand(UndoableCommand::Ptr(new TestCommand("second", 100)));
+            ASSERT_EQ(200u, processor.memoryUsage());
+
+            processor.submitAndStoreCommand(UndoableCommand::Ptr(new TestCommand("third", 100)));
+            ASSERT_EQ(200u, processor.memoryUsage());
+
+            ASSERT_EQ("third", processor.lastCommandName());
+            ASSERT_TRUE(processor.undoLastCommand());
+            ASSERT_EQ("second", processor.lastCommandName());
+            ASSERT_TRUE(processor.undoLastCommand());
+            ASSERT_FALSE(processor.hasLastCommand());
+
+            // the redo stack is accounted for, too
+            ASSERT_EQ(200u, processor.memoryUsage());
+        }
+
+        TEST_F(CommandProcessorTest, memoryBudgetDiscardsRedoCommands) {
+            CommandProcessor processor(static_cast<MapDocumentCommandFacade*>(document.get()));
+            processor.submitAndStoreCommand(UndoableCommand::Ptr(new TestCommand("first", 100)));
+            processor.submitAndStoreCommand(UndoableCommand::Ptr(new TestCommand("second", 100)));
+            processor.submitAndStoreCommand(UndoableCommand::Ptr(new TestCommand("third", 100)));
+
+            ASSERT_TRUE(processor.undoLastCommand());
+            ASSERT_TRUE(processor.undoLastCommand());
+            ASSERT_TRUE(processor.undoLastCommand());
+            ASSERT_EQ(300u, processor.memoryUsage());
+
+            // the command that would be redone last is discarded
+            processor.setMemoryBudget(250);
+            ASSERT_EQ(200u, processor.memoryUsage());
+
+            ASSERT_EQ("first", processor.nextCommandName());
+            ASSERT_TRUE(processor.redoNextCommand());
+            ASSERT_EQ("second", processor.nextCommandName());
+            ASSERT_TRUE(processor.redoNextCommand());
+            ASSERT_FALSE(processor.hasNextCommand());
+        }
+
+        TEST_F(CommandProcessorTest, memoryBudgetKeepsLastCommand) {
+            CommandProcessor processor(static_cast<MapDocumentCommandFacade*>(document.get()));
+            processor.submitAndStoreCommand(UndoableCommand::Ptr(new TestCommand("first", 100)));
+            processor.submitAndStoreCommand(UndoableCommand::Ptr(new TestCommand("second", 1000)));
+            ASSERT_EQ(1100u, processor.memoryUsage());
+
+            processor.setMemoryBudget(500);
+            ASSERT_EQ(1000u, processor.memoryUsage());
+            ASSERT_EQ("second", processor.lastCommandName());
+
+            processor.setMemoryBudget(0);
+            processor.submitAndStoreCommand(UndoableCommand::Ptr(new TestCommand("third", 1000)));
+            ASSERT_EQ(2000u, processor.memoryUsage());
+        }
+
+        TEST_F(CommandProcessorTest, memoryBudgetCountsRemovedNodes) {
+            Model::Brush* brush1 = createBrush();
+            Model::Brush* brush2 = createBrush();
+            document->addNode(brush1, document->currentParent());
+            document->addNode(brush2, document->currentParent());
+
+            CommandProcessor processor(static_cast<MapDocumentCommandFacade*>(document.get()));
+            processor.submitAndStoreCommand(AddRemoveNodesCommand::remove(Model::parentChildrenMap(Model::NodeList(1, brush1))));
+
+            // the removed brush is owned by the command now
+            const auto usage = processor.memoryUsage();
+            ASSERT_LE(Model::nodeMemorySize(Model::NodeList(1, brush1)), usage);
+
+            processor.setMemoryBudget(usage + usage / 2);
+            processor.submitAndStoreCommand(AddRemoveNodesCommand::remove(Model::parentChildrenMap(Model::NodeList(1, brush2))));
+            ASSERT_LE(processor.memoryUsage(), usage + usage / 2);
+
+            ASSERT_TRUE(processor.undoLastCommand());
+            ASSERT_EQ(document->currentParent(), brush2->parent());
+            ASSERT_FALSE(processor.hasLastCommand());
+        }
+    }
+}
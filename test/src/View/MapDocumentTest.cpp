@@ -703,6 +703,109 @@ namespace TrenchBroom {
             ASSERT_TRUE(hits.empty());
         }
 
+        TEST_F(MapDocumentTest, pickClosestHitOnly) {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+
+            auto* brush1 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)), "texture");
+            document->addNode(brush1, document->currentParent());
+
+            auto* brush2 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)).translate(vm::vec3(128, 0, 0)), "texture");
+            document->addNode(brush2, document->currentParent());
+
+            auto* brush3 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)).translate(vm::vec3(256, 0, 0)), "texture");
+            document->addNode(brush3, document->currentParent());
+
+            const auto ray = vm::ray3(vm::vec3(-32, 32, 32), vm::vec3::pos_x);
+
+            auto allHits = Model::PickResult::byDistance(document->editorContext());
+            document->pick(ray, allHits);
+            ASSERT_EQ(3u, allHits.query().type(Model::Brush::BrushHit).all().size());
+
+            // the other brushes are farther away than the first hit, so they are not picked
+            auto closestHit = Model::PickResult::closestByDistance(document->editorContext());
+            document->pick(ray, closestHit);
+
+            auto hits = closestHit.query().type(Model::Brush::BrushHit).all();
+            ASSERT_EQ(1u, hits.size());
+            ASSERT_EQ(brush1->findFace(vm::vec3::neg_x), hits.front().target<Model::BrushFace*>());
+            ASSERT_EQ(allHits.query().first().target<Model::BrushFace*>(), closestHit.query().first().target<Model::BrushFace*>());
+
+            // hidden objects don't count as the closest hit
+            document->hide(Model::NodeList({ brush1 }));
+
+            closestHit.clear();
+            document->pick(ray, closestHit);
+
+            hits = closestHit.query().type(Model::Brush::BrushHit).all();
+            ASSERT_EQ(2u, hits.size());
+            ASSERT_EQ(brush2->findFace(vm::vec3::neg_x), closestHit.query().first().target<Model::BrushFace*>());
+        }
+
+        TEST_F(MapDocumentTest, pickClosestBrushBehindEntity) {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            auto* entity = new Model::Entity();
+            document->addNode(entity, document->currentParent());
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+            auto* brush = builder.createCuboid(vm::bbox3(vm::vec3(32, -32, -32), vm::vec3(96, 32, 32)), "texture");
+            document->addNode(brush, document->currentParent());
+
+            const auto ray = vm::ray3(vm::vec3(-64, 0, 0), vm::vec3::pos_x);
+
+            auto pickResult = Model::PickResult::closestByDistance(document->editorContext(), Model::Brush::BrushHit);
+            document->pick(ray, pickResult);
+            ASSERT_EQ(entity, pickResult.query().first().target<Model::Entity*>());
+
+            // the entity in front of the brush does not stop picking
+            const auto& hit = pickResult.query().pickable().type(Model::Brush::BrushHit).occluded(Model::Entity::EntityHit | Model::Group::GroupHit).first();
+            ASSERT_TRUE(hit.isMatch());
+            ASSERT_EQ(brush->findFace(vm::vec3::neg_x), hit.target<Model::BrushFace*>());
+            ASSERT_DOUBLE_EQ(96.0, hit.distance());
+        }
+
+        TEST_F(MapDocumentTest, pickClosestPickableBrush) {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            const Model::BrushBuilder builder(document->world(), document->worldBounds());
+
+            auto* brush1 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)), "texture");
+            document->addNode(brush1, document->currentParent());
+
+            auto* brush2 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)).translate(vm::vec3(128, 0, 0)), "texture");
+            document->addNode(brush2, document->currentParent());
+
+            auto* brush3 = builder.createCuboid(vm::bbox3(vm::vec3(0, 0, 0), vm::vec3(64, 64, 64)).translate(vm::vec3(256, 0, 0)), "texture");
+            document->addNode(brush3, document->currentParent());
+
+            // a locked brush is visible, but tools look behind it
+            document->lock(Model::NodeList({ brush1 }));
+
+            const auto ray = vm::ray3(vm::vec3(-32, 32, 32), vm::vec3::pos_x);
+
+            auto allHits = Model::PickResult::byDistance(document->editorContext());
+            document->pick(ray, allHits);
+            ASSERT_EQ(3u, allHits.query().type(Model::Brush::BrushHit).all().size());
+
+            auto closestHit = Model::PickResult::closestByDistance(document->editorContext(), Model::Brush::BrushHit);
+            document->pick(ray, closestHit);
+            ASSERT_EQ(2u, closestHit.query().type(Model::Brush::BrushHit).all().size());
+
+            const auto& expected = allHits.query().pickable().type(Model::Brush::BrushHit).occluded().first();
+            const auto& actual = closestHit.query().pickable().type(Model::Brush::BrushHit).occluded().first();
+            ASSERT_EQ(brush2->findFace(vm::vec3::neg_x), expected.target<Model::BrushFace*>());
+            ASSERT_EQ(expected.target<Model::BrushFace*>(), actual.target<Model::BrushFace*>());
+            ASSERT_EQ(allHits.query().first().target<Model::BrushFace*>(), closestHit.query().first().target<Model::BrushFace*>());
+        }
+
         TEST_F(MapDocumentTest, pickNestedGroup) {
             // delete default brush
             document->selectAllNodes();
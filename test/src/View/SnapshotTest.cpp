@@ -24,6 +24,7 @@
 #include "Assets/TextureManager.h"
 #include "Model/Brush.h"
 #include "Model/BrushFace.h"
+#include "Model/BrushFaceAttributes.h"
 #include "Model/Entity.h"
 #include "Model/Group.h"
 #include "Model/Layer.h"
@@ -32,6 +33,7 @@
 #include "View/MapDocument.h"
 
 #include <cassert>
+#include <vector>
 
 namespace TrenchBroom {
     namespace View {
@@ -58,5 +60,35 @@ namespace TrenchBroom {
             for (Model::BrushFace* face : brush->faces())
                 ASSERT_EQ(texture, face->texture());
         }
+
+        TEST_F(SnapshotTest, restoreFacesAfterUndo) {
+            Model::Brush* brush = createBrush("texture");
+            document->addNode(brush, document->currentParent());
+
+            Model::BrushFace* face = brush->faces().front();
+            face->setFilePosition(7, 1);
+            Model::BrushFaceAttributes attribs = face->attribs().takeSnapshot();
+            attribs.setXOffset(12.0f);
+            attribs.setRotation(45.0f);
+            face->setAttribs(attribs);
+
+            std::vector<vm::vec3> points;
+            for (const Model::BrushFace* f : brush->faces())
+                points.insert(std::end(points), std::begin(f->points()), std::end(f->points()));
+
+            document->select(brush);
+            document->translateObjects(vm::vec3(16, 16, 16));
+            ASSERT_NE(points.front(), brush->faces().front()->points()[0]);
+
+            document->undoLastCommand();
+            ASSERT_EQ(points.size(), 3u * brush->faces().size());
+            for (size_t i = 0; i < points.size(); ++i)
+                ASSERT_EQ(points[i], brush->faces()[i / 3]->points()[i % 3]);
+
+            const Model::BrushFace* restored = brush->faces().front();
+            ASSERT_EQ(7u, restored->lineNumber());
+            ASSERT_EQ(1u, restored->lineCount());
+            ASSERT_EQ(attribs.takeSnapshot(), restored->attribs().takeSnapshot());
+        }
     }
 }
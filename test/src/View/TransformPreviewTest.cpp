@@ -0,0 +1,180 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "Model/Brush.h"
+#include "Model/Group.h"
+#include "Model/World.h"
+#include "View/MapDocumentTest.h"
+#include "View/MapDocument.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/scalar.h>
+#include <vecmath/vec.h>
+
+namespace TrenchBroom {
+    namespace View {
+        class TransformPreviewTest : public MapDocumentTest {};
+
+        class NodesDidChangeCounter {
+        public:
+            size_t count;
+        private:
+            MapDocumentSPtr m_document;
+        public:
+            explicit NodesDidChangeCounter(MapDocumentSPtr document) :
+            count(0),
+            m_document(document) {
+                m_document->nodesDidChangeNotifier.addObserver(this, &NodesDidChangeCounter::nodesDidChange);
+            }
+
+            ~NodesDidChangeCounter() {
+                m_document->nodesDidChangeNotifier.removeObserver(this, &NodesDidChangeCounter::nodesDidChange);
+            }
+        private:
+            void nodesDidChange(const Model::NodeList& nodes) {
+                ++count;
+            }
+        };
+
+        TEST_F(TransformPreviewTest, dragChangesNodesOnlyOnCommit) {
+            Model::Brush* brush = createBrush();
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+
+            const auto originalBounds = brush->bounds();
+            const auto delta = vm::vec3(1.0, 2.0, 0.0);
+
+            NodesDidChangeCounter counter(document);
+            document->beginTransaction("Move Objects");
+            document->beginTransformPreview();
+            for (size_t i = 0; i < 100; ++i) {
+                ASSERT_TRUE(document->translateObjects(delta));
+            }
+
+            ASSERT_EQ(0u, counter.count);
+            ASSERT_EQ(originalBounds, brush->bounds());
+            ASSERT_EQ(originalBounds.translate(100.0 * delta), document->selectionBounds());
+
+            ASSERT_TRUE(document->commitTransformPreview());
+            document->commitTransaction();
+
+            ASSERT_EQ(1u, counter.count);
+            ASSERT_FALSE(document->transformPreviewActive());
+            ASSERT_EQ(originalBounds.translate(100.0 * delta), brush->bounds());
+
+            // the whole drag is undone at once
+            document->undoLastCommand();
+            ASSERT_EQ(originalBounds, brush->bounds());
+        }
+
+        TEST_F(TransformPreviewTest, cancelDragLeavesNodesUnchanged) {
+            Model::Brush* brush = createBrush();
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+
+            const auto originalBounds = brush->bounds();
+            const auto lastCommandName = document->lastCommandName();
+
+            NodesDidChangeCounter counter(document);
+            document->beginTransaction("Rotate Objects");
+            document->beginTransformPreview();
+            for (size_t i = 0; i < 100; ++i) {
+                document->resetTransformPreview();
+                ASSERT_TRUE(document->rotateObjects(vm::vec3::zero, vm::vec3::pos_z, vm::toRadians(static_cast<FloatType>(i))));
+            }
+            document->cancelTransformPreview();
+            document->cancelTransaction();
+
+            ASSERT_EQ(0u, counter.count);
+            ASSERT_EQ(originalBounds, brush->bounds());
+            ASSERT_EQ(originalBounds, document->selectionBounds());
+            ASSERT_EQ(lastCommandName, document->lastCommandName());
+        }
+
+        TEST_F(TransformPreviewTest, previewMatchesAppliedTransformation) {
+            Model::Brush* brush = createBrush();
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+
+            const auto originalBounds = brush->bounds();
+            const auto newBounds = vm::bbox3(vm::vec3(-16.0, -16.0, -16.0), vm::vec3(48.0, 16.0, 16.0));
+
+            document->beginTransaction("Scale Objects");
+            document->beginTransformPreview();
+            ASSERT_TRUE(document->scaleObjects(originalBounds, newBounds));
+            ASSERT_TRUE(document->shearObjects(document->selectionBounds(), vm::vec3::pos_z, vm::vec3(8.0, 0.0, 0.0)));
+            ASSERT_TRUE(document->translateObjects(vm::vec3(0.0, 0.0, 16.0)));
+            const auto previewBounds = document->selectionBounds();
+
+            ASSERT_TRUE(document->commitTransformPreview());
+            document->commitTransaction();
+
+            ASSERT_TRUE(vm::isEqual(previewBounds, brush->bounds(), vm::C::almostZero()));
+            ASSERT_TRUE(vm::isEqual(previewBounds, document->selectionBounds(), vm::C::almostZero()));
+        }
+
+        TEST_F(TransformPreviewTest, previewMatchesAppliedTransformationOfEntitiesAndGroups) {
+            // delete default brush
+            document->selectAllNodes();
+            document->deleteObjects();
+
+            Model::Brush* brush1 = createBrush();
+            Model::Brush* brush2 = createBrush();
+            document->addNode(brush1, document->currentParent());
+            document->addNode(brush2, document->currentParent());
+
+            document->select(brush2);
+            ASSERT_TRUE(document->translateObjects(vm::vec3(64.0, 0.0, 0.0)));
+            document->select(brush1);
+            Model::Group* group = document->groupSelection("group");
+
+            // point entities only move their origin, which is rounded
+            document->createPointEntity(m_pointEntityDef, vm::vec3(0.0, 64.0, 0.0));
+            document->select(group);
+
+            document->beginTransaction("Rotate Objects");
+            document->beginTransformPreview();
+            ASSERT_TRUE(document->rotateObjects(vm::vec3::zero, vm::vec3::pos_z, vm::toRadians(30.0)));
+            ASSERT_TRUE(document->scaleObjects(vm::vec3::zero, vm::vec3(1.5, 0.5, 2.0)));
+            const auto previewBounds = document->selectionBounds();
+
+            ASSERT_TRUE(document->commitTransformPreview());
+            document->commitTransaction();
+
+            ASSERT_TRUE(vm::isEqual(previewBounds, document->selectionBounds(), vm::C::almostZero()));
+        }
+
+        TEST_F(TransformPreviewTest, rejectTransformationOutsideWorldBounds) {
+            Model::Brush* brush = createBrush();
+            document->addNode(brush, document->currentParent());
+            document->select(brush);
+
+            const auto originalBounds = brush->bounds();
+
+            document->beginTransaction("Move Objects");
+            document->beginTransformPreview();
+            ASSERT_FALSE(document->translateObjects(vm::vec3(document->worldBounds().size().x(), 0.0, 0.0)));
+            ASSERT_EQ(originalBounds, document->selectionBounds());
+            document->cancelTransformPreview();
+            document->cancelTransaction();
+        }
+    }
+}